@@ -362,10 +362,26 @@ typedef struct SSortExecInfo {
   int32_t sortMethod;
   int32_t sortBuffer;
   int32_t loops;       // loop count
-  int32_t writeBytes;  // write io bytes
-  int32_t readBytes;   // read io bytes
+  int32_t writeBytes;     // write io bytes
+  int32_t readBytes;      // read io bytes
+  int32_t rawWriteBytes;  // spilled bytes before compression
+  int32_t prefetchPages;  // spilled pages loaded without read io
 } SSortExecInfo;
 
+typedef struct SExchangeExecInfo {
+  int64_t totalRows;
+  int64_t totalSize;  // bytes received from the sources
+  int64_t waitTime;   // in us, blocked on the responses of the sources
+} SExchangeExecInfo;
+
+// for the hash aggregate and the hash join
+typedef struct SHashExecInfo {
+  int64_t hashEntries;
+  int64_t hashBytes;   // memory of the hash table
+  int64_t spillBytes;  // bytes flushed to disk
+  int64_t loadBytes;   // bytes loaded back from disk
+} SHashExecInfo;
+
 typedef struct STUidTagInfo {
   char*    name;
   uint64_t uid;
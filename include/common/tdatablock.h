@@ -242,6 +242,25 @@ int32_t blockGetEncodeSize(const SSDataBlock* pBlock);
 int32_t blockEncode(const SSDataBlock* pBlock, char* data, int32_t numOfCols);
 const char* blockDecode(SSDataBlock* pBlock, const char* pData);
 
+// Recycles the fixed-length column payloads of the data blocks freed by the thread the pool is bound to, so that the
+// blocks created afterwards by the other operators of the same task reuse them instead of calling the allocator.
+// Buffers are kept in power-of-2 size classes, and remain ordinary heap memory that could be freed anywhere.
+typedef struct SBlockMemPoolStat {
+  int64_t numOfAlloc;    // payloads requested while the pool is bound
+  int64_t numOfReuse;    // requests served by a recycled payload
+  int64_t numOfRecycle;  // payloads kept by the pool instead of being freed
+  int64_t cachedBytes;
+  int64_t peakCachedBytes;
+} SBlockMemPoolStat;
+
+typedef struct SBlockMemPool SBlockMemPool;
+
+SBlockMemPool* blockMemPoolCreate(int64_t maxCachedBytes);
+void           blockMemPoolDestroy(SBlockMemPool* pPool);
+SBlockMemPool* blockMemPoolAcquire(SBlockMemPool* pPool);  // bind to the current thread, return the one bound before
+void           blockMemPoolRelease(SBlockMemPool* pPrev);  // rebind the pool returned by the acquire
+void           blockMemPoolGetStat(const SBlockMemPool* pPool, SBlockMemPoolStat* pStat);
+
 // for debug
 char* dumpBlockData(SSDataBlock* pDataBlock, const char* flag, char** dumpBuf, const char* taskIdStr);
 
@@ -120,6 +120,7 @@ extern char    *tsSvrCrashReportUri;
 // query buffer management
 extern int32_t tsQueryBufferSize;  // maximum allowed usage buffer size in MB for each data node during query processing
 extern int64_t tsQueryBufferSizeBytes;    // maximum allowed usage buffer size in byte for each data node
+extern int32_t tsQueryBufferSizePerQuery;  // maximum allowed usage buffer size in MB for each query task
 extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row loading cache as much as possible
 
 // query client
@@ -130,12 +131,16 @@ extern int32_t tsQuerySmaOptimize;
 extern int32_t tsQueryRsmaTolerance;
 extern bool    tsQueryPlannerTrace;
 extern int32_t tsQueryNodeChunkSize;
+extern int32_t tsQueryExchangeBufferSize;  // maximum size in MB of the blocks prefetched by an exchange operator
+extern int32_t tsQueryScanParallelism;     // number of parallel scan subplans of each vgroup for super table aggregates
 extern bool    tsQueryUseNodeAllocator;
 extern bool    tsKeepColumnName;
 extern bool    tsEnableQueryHb;
 extern bool    tsEnableScience;
 extern bool    tsTtlChangeOnWrite;
 extern int32_t tsTtlFlushThreshold;
+extern bool    tsTagColumnStore;
+extern int32_t tsTagColumnStoreCacheSize;
 extern int32_t tsRedirectPeriod;
 extern int32_t tsRedirectFactor;
 extern int32_t tsRedirectMaxPeriod;
@@ -187,6 +192,17 @@ extern int32_t tmqMaxTopicNum;
 // wal
 extern int64_t tsWalFsyncDataSizeLimit;
 
+// tsdb
+extern int32_t tsSttMergePolicy;    // policy to merge stt files, 0: tiered, 1: leveled
+extern int32_t tsSttLevelBaseSize;  // target size in MB of stt level 1 with the leveled policy
+extern bool    tsSttBloomFilter;    // write a bloom filter of table uids into each stt file
+extern char    tsAlpColumns[];      // float/double column types encoded with ALP, "float|double"
+extern int32_t tsRetentionParallelism;   // files copied at the same time by retentions of the dnode
+extern int32_t tsRetentionSpeedLimitMB;  // MB per second copied from or to each disk by retentions, 0: no limit
+extern int32_t tsS3BlockSize;            // KB of a data file fetched from S3 and cached as one block
+extern int32_t tsS3BlockCacheSize;       // MB of local disk used by each vnode to cache blocks fetched from S3
+extern int32_t tsS3ReadAheadBlocks;      // blocks fetched ahead of a missed one from S3
+
 // internal
 extern int32_t tsTransPullupInterval;
 extern int32_t tsMqRebalanceInterval;
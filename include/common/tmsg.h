@@ -1429,6 +1429,19 @@ typedef struct {
   int64_t numOfBatchInsertSuccessReqs;
   int32_t numOfCachedTables;
   int32_t learnerProgress; // use one reservered
+  int64_t numOfTagFilterCacheHits;
+  int64_t numOfTagFilterCachePatches;
+  int64_t numOfTagFilterCacheRebuilds;
+  int64_t ingestBytes;      // written by commits since the vnode opened
+  int64_t mergeWriteBytes;  // written by stt merges since the vnode opened
+  int64_t mergeReadBytes;   // read by stt merges since the vnode opened
+  int32_t numOfFSets;
+  int32_t numOfSttFiles;
+  int64_t migrateBytes;  // copied to other tiers or s3 by retentions since the vnode opened
+  int32_t migrateQueue;  // files waiting to be copied by retentions
+  int64_t s3CacheHits;    // blocks of s3 data files read from the local cache since the vnode opened
+  int64_t s3CacheMisses;  // blocks of s3 data files fetched from s3 since the vnode opened
+  int64_t s3FetchBytes;   // fetched from s3 since the vnode opened
 } SVnodeLoad;
 
 typedef struct {
@@ -1869,6 +1882,11 @@ typedef struct STableScanAnalyzeInfo {
   uint32_t filterOutBlocks;
   double   elapsedTime;
   double   filterTime;
+  uint64_t memRows;         // rows of the blocks built from the memtables
+  uint64_t fileRows;        // rows of the blocks loaded from the data and stt files
+  int64_t  diskReadBytes;   // bytes of the file pages read from the disk
+  int64_t  cacheReadBytes;  // bytes served by the file page already buffered
+  double   decompressTime[TSDB_DATA_TYPE_MAX];  // in ms, by column type
 } STableScanAnalyzeInfo;
 
 int32_t tSerializeSExplainRsp(void* buf, int32_t bufLen, SExplainRsp* pRsp);
@@ -3560,6 +3578,7 @@ typedef struct {
   int64_t      consumerId;
   int64_t      timeout;
   STqOffsetVal reqOffset;
+  int32_t      maxRows;  // max rows returned by one poll, 0 means the server default
 } SMqPollReq;
 
 int32_t tSerializeSMqPollReq(void* buf, int32_t bufLen, SMqPollReq* pReq);
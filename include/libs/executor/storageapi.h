@@ -165,6 +165,7 @@ typedef struct TsdReader {
                            SHashObj** pIgnoreTables);
   void         (*tsdReaderClose)();
   void         (*tsdSetReaderTaskId)(void *pReader, const char *pId);
+  void         (*tsdSetReaderProfile)(void *pReader, STableScanAnalyzeInfo *pProfile);
   int32_t      (*tsdSetQueryTableList)();
   int32_t      (*tsdNextDataBlock)();
 
@@ -256,6 +257,7 @@ typedef struct SStoreMeta {
 
   int32_t (*getTableTags)(void* pVnode, uint64_t suid, SArray* uidList);
   int32_t (*getTableTagsByUid)(void* pVnode, int64_t suid, SArray* uidList);
+  int32_t (*getTableTagCols)(void* pVnode, uint64_t suid, SArray* pUidTagList, SSDataBlock* pBlock);
   const void* (*extractTagVal)(const void* tag, int16_t type, STagVal* tagVal);  // todo remove it
 
   int32_t (*getTableUidByName)(void* pVnode, char* tbName, uint64_t* uid);
@@ -268,9 +270,9 @@ typedef struct SStoreMeta {
                                    int32_t payloadLen);
 
   int32_t (*getCachedTableList)(void* pVnode, tb_uid_t suid, const uint8_t* pKey, int32_t keyLen, SArray* pList1,
-                                bool* acquireRes);
+                                bool* acquireRes, SArray* pChangedList, int64_t* pVer, int64_t* pCachedVer);
   int32_t (*putCachedTableList)(void* pVnode, uint64_t suid, const void* pKey, int32_t keyLen, void* pPayload,
-                                int32_t payloadLen, double selectivityRatio);
+                                int32_t payloadLen, double selectivityRatio, int64_t ver);
 
   void* (*storeGetIndexInfo)();
   void* (*getInvertIndex)(void* pVnode);
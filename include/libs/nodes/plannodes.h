@@ -111,6 +111,8 @@ typedef struct SScanLogicNode {
   bool          igLastNull;
   bool          groupOrderScan;
   bool          onlyMetaCtbIdx; // for tag scan with no tbname
+  int32_t       tableSliceIdx;  // scan the tables with uid % tableSliceNum == tableSliceIdx only
+  int32_t       tableSliceNum;
 } SScanLogicNode;
 
 typedef struct SJoinLogicNode {
@@ -411,6 +413,8 @@ typedef struct STableScanPhysiNode {
   int8_t         igExpired;
   bool           assignBlockUid;
   int8_t         igCheckUpdate;
+  int32_t        tableSliceIdx;
+  int32_t        tableSliceNum;
 } STableScanPhysiNode;
 
 typedef STableScanPhysiNode STableSeqScanPhysiNode;
@@ -43,6 +43,14 @@ extern "C" {
 #define WAL_FILE_LEN      (WAL_PATH_LEN + 32)
 #define WAL_MAGIC         0xFAFBFCFDF4F3F2F1ULL
 #define WAL_SCAN_BUF_SIZE (1024 * 1024 * 3)
+#define WAL_READ_BUF_SIZE (1024 * 512)
+#define WAL_READ_IDX_NUM  1024
+
+#define WAL_READ_CACHE_SLOTS     4096
+#define WAL_READ_CACHE_SIZE      (1024 * 1024 * 16)
+#define WAL_READ_CACHE_ENTRY_MAX (1024 * 256)
+#define WAL_READ_CACHE_IDLE_MS   (1000 * 5)
+#define WAL_READ_CACHE_SWEEP_MS  1000
 
 typedef enum {
   TAOS_WAL_WRITE = 1,
@@ -116,8 +124,11 @@ typedef struct SWal {
   // ctl
   int64_t       refId;
   TdThreadMutex mutex;
+  int64_t       rollbackSeq;  // bumped by every rollback, readers drop their read-ahead data once it changes
   // ref
   SHashObj *pRefHash;  // refId -> SWalRef
+  // entries read by one tq reader and shared with the others scanning nearby
+  struct SWalReadCache *pReadCache;
   // path
   char path[WAL_PATH_LEN];
   // reusable write head
@@ -154,6 +165,19 @@ struct SWalReader {
   TdThreadMutex  mutex;
   SWalFilterCond cond;
   SWalCkHead *pHead;
+  // read-ahead of the current log file and a window of its idx entries, so that sequential scans of
+  // lagging consumers do not issue a seek and a read syscall for every single entry
+  char               *pReadBuf;
+  int64_t             readBufOffset;  // file offset of pReadBuf[0]
+  int64_t             readBufLen;
+  int64_t             logOffset;      // read position in pLogFile
+  struct WalIdxEntry *pIdxCache;
+  int64_t             idxCacheFirstVer;
+  int32_t             idxCacheNum;
+  int64_t             rollbackSeq;
+  int64_t             lastFetchTs;  // readers idle for WAL_READ_CACHE_IDLE_MS are not counted by the read cache
+  int8_t              sharedScan;  // registered to the read cache of pWal
+  int8_t              bodyCached;  // body of pHead is already filled by the read cache
 };
 
 // module initialization
@@ -106,6 +106,10 @@ void taosGetTmpfilePath(const char *inputTmpDir, const char *fileNamePrefix, cha
 
 int64_t taosFSendFile(TdFilePtr pFileOut, TdFilePtr pFileIn, int64_t *offset, int64_t size);
 
+// map the first size bytes of the file read-only, NULL is returned where mapping is not supported
+void   *taosMmapReadOnlyFile(TdFilePtr pFile, int64_t size);
+int32_t taosMunmapFile(void *ptr, int64_t size);
+
 bool taosValidFile(TdFilePtr pFile);
 
 int32_t taosGetErrorFile(TdFilePtr pFile);
@@ -48,7 +48,7 @@ typedef void (*TArray2Cb)(void *);
 #define TARRAY2_DATA_LEN(a)   ((a)->size * sizeof(((a)->data[0])))
 
 static FORCE_INLINE int32_t tarray2_make_room(void *arr, int32_t expSize, int32_t eleSize) {
-  TARRAY2(void) *a = arr;
+  TARRAY2(void) *a = (__typeof__(a))arr;
 
   int32_t capacity = (a->capacity > 0) ? (a->capacity << 1) : 32;
   while (capacity < expSize) {
@@ -63,7 +63,7 @@ static FORCE_INLINE int32_t tarray2_make_room(void *arr, int32_t expSize, int32_
 
 static FORCE_INLINE int32_t tarray2InsertBatch(void *arr, int32_t idx, const void *elePtr, int32_t numEle,
                                                int32_t eleSize) {
-  TARRAY2(uint8_t) *a = arr;
+  TARRAY2(uint8_t) *a = (__typeof__(a))arr;
 
   int32_t ret = 0;
   if (a->size + numEle > a->capacity) {
@@ -81,13 +81,13 @@ static FORCE_INLINE int32_t tarray2InsertBatch(void *arr, int32_t idx, const voi
 
 static FORCE_INLINE void *tarray2Search(void *arr, const void *elePtr, int32_t eleSize, __compar_fn_t compar,
                                         int32_t flag) {
-  TARRAY2(void) *a = arr;
+  TARRAY2(void) *a = (__typeof__(a))arr;
   return taosbsearch(elePtr, a->data, a->size, eleSize, compar, flag);
 }
 
 static FORCE_INLINE int32_t tarray2SearchIdx(void *arr, const void *elePtr, int32_t eleSize, __compar_fn_t compar,
                                              int32_t flag) {
-  TARRAY2(void) *a = arr;
+  TARRAY2(void) *a = (__typeof__(a))arr;
   void *p = taosbsearch(elePtr, a->data, a->size, eleSize, compar, flag);
   if (p == NULL) {
     return -1;
@@ -97,7 +97,7 @@ static FORCE_INLINE int32_t tarray2SearchIdx(void *arr, const void *elePtr, int3
 }
 
 static FORCE_INLINE int32_t tarray2SortInsert(void *arr, const void *elePtr, int32_t eleSize, __compar_fn_t compar) {
-  TARRAY2(void) *a = arr;
+  TARRAY2(void) *a = (__typeof__(a))arr;
   int32_t idx = tarray2SearchIdx(arr, elePtr, eleSize, compar, TD_GT);
   return tarray2InsertBatch(arr, idx < 0 ? a->size : idx, elePtr, 1, eleSize);
 }
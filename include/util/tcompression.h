@@ -51,6 +51,13 @@ extern "C" {
 #define HEAD_MODE(x) x % 2
 #define HEAD_ALGO(x) x / 2
 
+// first byte of a lossless float/double stream encoded as scaled integers (ALP), clear of the lossy algorithm bits
+#define FP_ALP_MODE 4
+
+// float/double columns encoded with ALP instead of XOR with the previous value when it comes out smaller
+extern bool tsAlpFloat;
+extern bool tsAlpDouble;
+
 #ifdef TD_TSZ
 extern bool lossyFloat;
 extern bool lossyDouble;
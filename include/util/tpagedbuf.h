@@ -39,6 +39,9 @@ typedef struct SDiskbasedBufStatis {
   int32_t getPages;
   int32_t releasePages;
   int32_t flushPages;
+  int64_t rawBytes;       // size of the flushed pages before compression
+  int32_t flushWrites;    // number of write io, pages are staged and written in batches
+  int32_t prefetchPages;  // pages loaded from the staged or read ahead data without io
 } SDiskbasedBufStatis;
 
 /**
@@ -50,6 +53,17 @@ typedef struct SDiskbasedBufStatis {
  * @param handle
  * @return
  */
+// Memory budget shared by the in-memory pages of a group of buffers, e.g. all buffers of one query. A buffer spills
+// its least recently used page instead of allocating a new one once any budget in the chain is used up. No limit is
+// applied if the limit is not greater than 0.
+typedef struct SDBufMemBudget {
+  int64_t                limit;
+  int64_t                used;
+  int64_t                peak;
+  int64_t                spillPages;  // pages spilled to stay within the budget
+  struct SDBufMemBudget* parent;
+} SDBufMemBudget;
+
 int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMemBufSize, const char* id,
                            const char* dir);
 
@@ -184,6 +198,26 @@ void dBufPrintStatis(const SDiskbasedBuf* pBuf);
  */
 void clearDiskbasedBuf(SDiskbasedBuf* pBuf);
 
+/**
+ * charge the in-memory pages of the buffer to the budget, the budget must outlive the buffer
+ * @param pBuf
+ * @param pBudget
+ */
+void dBufSetMemBudget(SDiskbasedBuf* pBuf, SDBufMemBudget* pBudget);
+
+void dBufMemBudgetInit(SDBufMemBudget* pBudget, int64_t limit, SDBufMemBudget* parent);
+
+/**
+ * charge size bytes to the budget and all its parents
+ * @param pBudget
+ * @param size
+ * @param force charge it even if the limit is exceeded
+ * @return false if any budget in the chain is used up, nothing is charged then
+ */
+bool dBufMemBudgetAcquire(SDBufMemBudget* pBudget, int64_t size, bool force);
+
+void dBufMemBudgetRelease(SDBufMemBudget* pBudget, int64_t size);
+
 #ifdef __cplusplus
 }
 #endif
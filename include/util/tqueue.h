@@ -33,6 +33,9 @@ Notes:
 1: taosOpenQueue/taosCloseQueue, taosOpenQset/taosCloseQset is NOT multi-thread safe
 2: after taosCloseQueue/taosCloseQset is called, read/write operation APIs are not safe.
 3: read/write operation APIs are multi-thread safe
+4: a queue set to lock free mode by taosSetQueueLockFree is written without the queue mutex, writers push the
+   items into an inbox by compare-and-swap and the readers move the whole inbox out at once. It shall be set
+   right after the queue is opened, and the queue added into its qset before being written.
 
 To remove the limitation and make this set of queue APIs multi-thread safe, REF(tref.c)
 shall be used to set up the protection.
@@ -75,6 +78,7 @@ struct STaosQnode {
 struct STaosQueue {
   STaosQnode   *head;
   STaosQnode   *tail;
+  STaosQnode   *inbox;  // lock free mode only, items written and not yet read, latest first
   STaosQueue   *next;     // for queue set
   STaosQset    *qset;     // for queue set
   void         *ahandle;  // for queue set
@@ -86,6 +90,9 @@ struct STaosQueue {
   int64_t       threadId;
   int64_t       memLimit;
   int64_t       itemLimit;
+  int32_t       numOfHeadItems;  // lock free mode only, items between head and tail
+  int64_t       memOfHeadItems;
+  bool          lockFree;
 };
 
 struct STaosQset {
@@ -116,6 +123,7 @@ int32_t     taosQueueItemSize(STaosQueue *queue);
 int64_t     taosQueueMemorySize(STaosQueue *queue);
 void        taosSetQueueCapacity(STaosQueue *queue, int64_t size);
 void        taosSetQueueMemoryCapacity(STaosQueue *queue, int64_t mem);
+void        taosSetQueueLockFree(STaosQueue *queue, bool lockFree);
 
 STaosQall *taosAllocateQall();
 void       taosFreeQall(STaosQall *qall);
@@ -67,6 +67,7 @@ typedef struct SWWorkerPool {
   const char   *name;
   SWWorker     *workers;
   TdThreadMutex mutex;
+  bool          lockFree;  // queues of the pool are written lock free
 } SWWorkerPool;
 
 int32_t     tQWorkerInit(SQWorkerPool *pool);
@@ -103,6 +104,7 @@ typedef struct {
   int32_t     max;
   FItems      fp;
   void       *param;
+  bool        lockFree;
 } SMultiWorkerCfg;
 
 typedef struct {
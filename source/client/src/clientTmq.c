@@ -67,6 +67,7 @@ struct tmq_conf_t {
   bool           hbBgEnable;
   uint16_t       port;
   int32_t        autoCommitInterval;
+  int32_t        maxPollRows;
   char*          ip;
   char*          user;
   char*          pass;
@@ -82,6 +83,7 @@ struct tmq_t {
   int8_t         useSnapshot;
   int8_t         autoCommit;
   int32_t        autoCommitInterval;
+  int32_t        maxPollRows;
   int8_t         resetOffsetCfg;
   uint64_t       consumerId;
   bool           hbBgEnable;
@@ -328,6 +330,15 @@ tmq_conf_res_t tmq_conf_set(tmq_conf_t* conf, const char* key, const char* value
     return TMQ_CONF_OK;
   }
 
+  if (strcasecmp(key, "max.poll.rows") == 0) {
+    int64_t maxPollRows = taosStr2int64(value);
+    if (maxPollRows <= 0 || maxPollRows > INT32_MAX) {
+      return TMQ_CONF_INVALID;
+    }
+    conf->maxPollRows = maxPollRows;
+    return TMQ_CONF_OK;
+  }
+
   if (strcasecmp(key, "auto.offset.reset") == 0) {
     if (strcasecmp(value, "none") == 0) {
       conf->resetOffset = TMQ_OFFSET__RESET_NONE;
@@ -1101,6 +1112,7 @@ tmq_t* tmq_consumer_new(tmq_conf_t* conf, char* errstr, int32_t errstrLen) {
   pTmq->useSnapshot = conf->snapEnable;
   pTmq->autoCommit = conf->autoCommit;
   pTmq->autoCommitInterval = conf->autoCommitInterval;
+  pTmq->maxPollRows = conf->maxPollRows;
   pTmq->commitCb = conf->commitCb;
   pTmq->commitCbUserParam = conf->commitCbUserParam;
   pTmq->resetOffsetCfg = conf->resetOffset;
@@ -1665,6 +1677,7 @@ void tmqBuildConsumeReqImpl(SMqPollReq* pReq, tmq_t* tmq, int64_t timeout, SMqCl
   pReq->reqOffset = pVg->offsetInfo.endOffset;
   pReq->head.vgId = pVg->vgId;
   pReq->useSnapshot = tmq->useSnapshot;
+  pReq->maxRows = tmq->maxPollRows;
   pReq->reqId = generateRequestId();
 }
 
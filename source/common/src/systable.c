@@ -241,6 +241,18 @@ static const SSysDbTableSchema vgroupsSchema[] = {
     {.name = "cacheload", .bytes = 4, .type = TSDB_DATA_TYPE_INT, .sysInfo = true},
     {.name = "cacheelements", .bytes = 4, .type = TSDB_DATA_TYPE_INT, .sysInfo = true},
     {.name = "tsma", .bytes = 1, .type = TSDB_DATA_TYPE_TINYINT, .sysInfo = true},
+    {.name = "tag_cache_hits", .bytes = 8, .type = TSDB_DATA_TYPE_BIGINT, .sysInfo = true},
+    {.name = "tag_cache_patches", .bytes = 8, .type = TSDB_DATA_TYPE_BIGINT, .sysInfo = true},
+    {.name = "tag_cache_rebuilds", .bytes = 8, .type = TSDB_DATA_TYPE_BIGINT, .sysInfo = true},
+    {.name = "ingest_bytes", .bytes = 8, .type = TSDB_DATA_TYPE_BIGINT, .sysInfo = true},
+    {.name = "merge_write_bytes", .bytes = 8, .type = TSDB_DATA_TYPE_BIGINT, .sysInfo = true},
+    {.name = "merge_read_bytes", .bytes = 8, .type = TSDB_DATA_TYPE_BIGINT, .sysInfo = true},
+    {.name = "write_amp", .bytes = 8, .type = TSDB_DATA_TYPE_DOUBLE, .sysInfo = true},
+    {.name = "read_amp", .bytes = 8, .type = TSDB_DATA_TYPE_DOUBLE, .sysInfo = true},
+    {.name = "migrate_bytes", .bytes = 8, .type = TSDB_DATA_TYPE_BIGINT, .sysInfo = true},
+    {.name = "migrate_queue", .bytes = 4, .type = TSDB_DATA_TYPE_INT, .sysInfo = true},
+    {.name = "s3_cache_hit_rate", .bytes = 8, .type = TSDB_DATA_TYPE_DOUBLE, .sysInfo = true},
+    {.name = "s3_fetch_bytes", .bytes = 8, .type = TSDB_DATA_TYPE_BIGINT, .sysInfo = true},
     // {.name = "compact_start_time", .bytes = 8, .type = TSDB_DATA_TYPE_TIMESTAMP, .sysInfo = false},
 };
 
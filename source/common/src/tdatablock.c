@@ -1156,6 +1156,113 @@ void blockDataEmpty(SSDataBlock* pDataBlock) {
   pInfo->window.skey = 0;
 }
 
+#define BLOCK_MEM_POOL_MIN_SHIFT 10  // payloads smaller than 1 KB are cheap enough for the allocator
+#define BLOCK_MEM_POOL_MAX_SHIFT 24
+#define BLOCK_MEM_POOL_CLASSES   (BLOCK_MEM_POOL_MAX_SHIFT - BLOCK_MEM_POOL_MIN_SHIFT + 1)
+
+struct SBlockMemPool {
+  void*             freeList[BLOCK_MEM_POOL_CLASSES];  // linked through the first word of the cached payloads
+  int64_t           maxCachedBytes;
+  SBlockMemPoolStat stat;
+};
+
+static threadlocal SBlockMemPool* g_pBlockMemPool = NULL;
+
+SBlockMemPool* blockMemPoolCreate(int64_t maxCachedBytes) {
+  SBlockMemPool* pPool = taosMemoryCalloc(1, sizeof(SBlockMemPool));
+  if (pPool == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pPool->maxCachedBytes = maxCachedBytes;
+  return pPool;
+}
+
+void blockMemPoolDestroy(SBlockMemPool* pPool) {
+  if (pPool == NULL) {
+    return;
+  }
+
+  for (int32_t i = 0; i < BLOCK_MEM_POOL_CLASSES; ++i) {
+    void* p = pPool->freeList[i];
+    while (p != NULL) {
+      void* next = *(void**)p;
+      taosMemoryFree(p);
+      p = next;
+    }
+  }
+
+  taosMemoryFree(pPool);
+}
+
+SBlockMemPool* blockMemPoolAcquire(SBlockMemPool* pPool) {
+  SBlockMemPool* pPrev = g_pBlockMemPool;
+  g_pBlockMemPool = pPool;
+  return pPrev;
+}
+
+void blockMemPoolRelease(SBlockMemPool* pPrev) { g_pBlockMemPool = pPrev; }
+
+void blockMemPoolGetStat(const SBlockMemPool* pPool, SBlockMemPoolStat* pStat) {
+  if (pPool == NULL) {
+    memset(pStat, 0, sizeof(SBlockMemPoolStat));
+  } else {
+    *pStat = pPool->stat;
+  }
+}
+
+// A miss allocates the whole size class, so that the payload could serve any later request of the same class.
+static char* blockMemPoolAlloc(int64_t size) {
+  SBlockMemPool* pPool = g_pBlockMemPool;
+  if (pPool == NULL || size <= (1LL << BLOCK_MEM_POOL_MIN_SHIFT) || size > (1LL << BLOCK_MEM_POOL_MAX_SHIFT)) {
+    return taosMemoryMallocAlign(MALLOC_ALIGN_BYTES, size);
+  }
+
+  int32_t shift = 64 - BUILDIN_CLZL((uint64_t)size - 1);
+  int32_t index = shift - BLOCK_MEM_POOL_MIN_SHIFT;
+
+  pPool->stat.numOfAlloc += 1;
+
+  char* p = pPool->freeList[index];
+  if (p != NULL) {
+    pPool->freeList[index] = *(void**)p;
+    pPool->stat.numOfReuse += 1;
+    pPool->stat.cachedBytes -= (1LL << shift);
+    return p;
+  }
+
+  return taosMemoryMallocAlign(MALLOC_ALIGN_BYTES, 1LL << shift);
+}
+
+// The payload is filed under the largest class its usable size covers. Payloads not allocated by the aligned
+// malloc, e.g. the ones assigned to the column by others, are simply freed.
+static void blockMemPoolFree(void* p) {
+  SBlockMemPool* pPool = g_pBlockMemPool;
+  if (p == NULL) {
+    return;
+  }
+
+  if (pPool != NULL && (((uint64_t)p) & (MALLOC_ALIGN_BYTES - 1)) == 0) {
+    int64_t size = taosMemorySize(p);
+    if (size >= (1LL << BLOCK_MEM_POOL_MIN_SHIFT)) {
+      int32_t shift = TMIN(63 - BUILDIN_CLZL((uint64_t)size), BLOCK_MEM_POOL_MAX_SHIFT);
+      if (pPool->stat.cachedBytes + (1LL << shift) <= pPool->maxCachedBytes) {
+        int32_t index = shift - BLOCK_MEM_POOL_MIN_SHIFT;
+        *(void**)p = pPool->freeList[index];
+        pPool->freeList[index] = p;
+
+        pPool->stat.numOfRecycle += 1;
+        pPool->stat.cachedBytes += (1LL << shift);
+        pPool->stat.peakCachedBytes = TMAX(pPool->stat.peakCachedBytes, pPool->stat.cachedBytes);
+        return;
+      }
+    }
+  }
+
+  taosMemoryFree(p);
+}
+
 /*
  * NOTE: the type of the input column may be TSDB_DATA_TYPE_NULL, which is used to denote
  * the all NULL value in this column. It is an internal representation of all NULL value column, and no visible to
@@ -1193,7 +1300,7 @@ static int32_t doEnsureCapacity(SColumnInfoData* pColumn, const SDataBlockInfo*
 
     // here we employ the aligned malloc function, to make sure that the address of allocated memory is aligned
     // to MALLOC_ALIGN_BYTES
-    tmp = taosMemoryMallocAlign(MALLOC_ALIGN_BYTES, numOfRows * pColumn->info.bytes);
+    tmp = blockMemPoolAlloc((int64_t)numOfRows * pColumn->info.bytes);
     if (tmp == NULL) {
       return TSDB_CODE_OUT_OF_MEMORY;
     }
@@ -1202,7 +1309,8 @@ static int32_t doEnsureCapacity(SColumnInfoData* pColumn, const SDataBlockInfo*
     // copy back the existed data
     if (pColumn->pData != NULL) {
       memcpy(tmp, pColumn->pData, existedRows * pColumn->info.bytes);
-      taosMemoryFreeClear(pColumn->pData);
+      blockMemPoolFree(pColumn->pData);
+      pColumn->pData = NULL;
     }
 
     pColumn->pData = tmp;
@@ -1566,11 +1674,12 @@ void colDataDestroy(SColumnInfoData* pColData) {
 
   if (IS_VAR_DATA_TYPE(pColData->info.type)) {
     taosMemoryFreeClear(pColData->varmeta.offset);
+    taosMemoryFreeClear(pColData->pData);
   } else {
     taosMemoryFreeClear(pColData->nullbitmap);
+    blockMemPoolFree(pColData->pData);
+    pColData->pData = NULL;
   }
-
-  taosMemoryFreeClear(pColData->pData);
 }
 
 static void doShiftBitmap(char* nullBitmap, size_t n, size_t total) {
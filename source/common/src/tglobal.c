@@ -20,6 +20,7 @@
 #include "tgrant.h"
 #include "tlog.h"
 #include "tmisce.h"
+#include "tcompression.h"
 
 #if defined(CUS_NAME) || defined(CUS_PROMPT) || defined(CUS_EMAIL)
 #include "cus_name.h"
@@ -133,6 +134,8 @@ int32_t tsQuerySmaOptimize = 0;
 int32_t tsQueryRsmaTolerance = 1000;  // the tolerance time (ms) to judge from which level to query rsma data.
 bool    tsQueryPlannerTrace = false;
 int32_t tsQueryNodeChunkSize = 32 * 1024;
+int32_t tsQueryExchangeBufferSize = 64;
+int32_t tsQueryScanParallelism = 1;
 bool    tsQueryUseNodeAllocator = true;
 bool    tsKeepColumnName = false;
 int32_t tsRedirectPeriod = 10;
@@ -186,6 +189,7 @@ char    tsTagFilterCache = 0;
 // positive value (in MB)
 int32_t tsQueryBufferSize = -1;
 int64_t tsQueryBufferSizeBytes = -1;
+int32_t tsQueryBufferSizePerQuery = -1;
 int32_t tsCacheLazyLoadThreshold = 500;
 
 int32_t  tsDiskCfgNum = 0;
@@ -230,6 +234,17 @@ bool    tsStartUdfd = true;
 // wal
 int64_t tsWalFsyncDataSizeLimit = (100 * 1024 * 1024L);
 
+// tsdb
+int32_t tsSttMergePolicy = 0;
+int32_t tsSttLevelBaseSize = 64;
+bool    tsSttBloomFilter = true;
+int32_t tsRetentionParallelism = 2;
+int32_t tsRetentionSpeedLimitMB = 0;  // 0 means no limit
+int32_t tsS3BlockSize = 4096;
+int32_t tsS3BlockCacheSize = 1024;
+int32_t tsS3ReadAheadBlocks = 1;
+char    tsAlpColumns[32] = "";  // "float|double" means all float and double columns are encoded with ALP
+
 // ttl
 bool    tsTtlChangeOnWrite = false;  // if true, ttl delete time changes on last write
 int32_t tsTtlFlushThreshold = 100;   /* maximum number of dirty items in memory.
@@ -237,6 +252,11 @@ int32_t tsTtlFlushThreshold = 100;   /* maximum number of dirty items in memory.
                                       */
 int32_t tsTtlBatchDropNum = 10000;   // number of tables dropped per batch
 
+// meta
+// keep the tags of the child tables of each super table column by column in memory
+bool    tsTagColumnStore = false;
+int32_t tsTagColumnStoreCacheSize = 64;  // MB, the memory the tag column stores of a vnode are kept in
+
 // internal
 int32_t tsTransPullupInterval = 2;
 int32_t tsMqRebalanceInterval = 2;
@@ -429,6 +449,8 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "querySmaOptimize", tsQuerySmaOptimize, 0, 1, CFG_SCOPE_CLIENT) != 0) return -1;
   if (cfgAddBool(pCfg, "queryPlannerTrace", tsQueryPlannerTrace, CFG_SCOPE_CLIENT) != 0) return -1;
   if (cfgAddInt32(pCfg, "queryNodeChunkSize", tsQueryNodeChunkSize, 1024, 128 * 1024, CFG_SCOPE_CLIENT) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryExchangeBufferSize", tsQueryExchangeBufferSize, 1, 10240, CFG_SCOPE_BOTH) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryScanParallelism", tsQueryScanParallelism, 1, 64, CFG_SCOPE_CLIENT) != 0) return -1;
   if (cfgAddBool(pCfg, "queryUseNodeAllocator", tsQueryUseNodeAllocator, CFG_SCOPE_CLIENT) != 0) return -1;
   if (cfgAddBool(pCfg, "keepColumnName", tsKeepColumnName, CFG_SCOPE_CLIENT) != 0) return -1;
   if (cfgAddString(pCfg, "smlChildTableName", "", CFG_SCOPE_CLIENT) != 0) return -1;
@@ -525,6 +547,8 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
     return -1;
   if (cfgAddInt32(pCfg, "countAlwaysReturnValue", tsCountAlwaysReturnValue, 0, 1, CFG_SCOPE_BOTH) != 0) return -1;
   if (cfgAddInt32(pCfg, "queryBufferSize", tsQueryBufferSize, -1, 500000000000, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryBufferSizePerQuery", tsQueryBufferSizePerQuery, -1, INT32_MAX, CFG_SCOPE_SERVER) != 0)
+    return -1;
   if (cfgAddBool(pCfg, "printAuth", tsPrintAuth, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "queryRspPolicy", tsQueryRspPolicy, 0, 1, CFG_SCOPE_SERVER) != 0) return -1;
 
@@ -627,6 +651,9 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "ttlBatchDropNum", tsTtlBatchDropNum, 0, INT32_MAX, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddBool(pCfg, "ttlChangeOnWrite", tsTtlChangeOnWrite, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "ttlFlushThreshold", tsTtlFlushThreshold, -1, 1000000, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddBool(pCfg, "tagColumnStore", tsTagColumnStore, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "tagColumnStoreCacheSize", tsTagColumnStoreCacheSize, 1, 65536, CFG_SCOPE_SERVER) != 0)
+    return -1;
   if (cfgAddInt32(pCfg, "trimVDbIntervalSec", tsTrimVDbIntervalSec, 1, 100000, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "uptimeInterval", tsUptimeInterval, 1, 100000, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "queryRsmaTolerance", tsQueryRsmaTolerance, 0, 900000, CFG_SCOPE_SERVER) != 0) return -1;
@@ -635,6 +662,14 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
                   CFG_SCOPE_SERVER) != 0)
     return -1;
 
+  if (cfgAddInt32(pCfg, "sttMergePolicy", tsSttMergePolicy, 0, 1, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "sttLevelBaseSize", tsSttLevelBaseSize, 1, 1024 * 1024, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddBool(pCfg, "sttBloomFilter", tsSttBloomFilter, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddString(pCfg, "alpColumns", tsAlpColumns, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "retentionParallelism", tsRetentionParallelism, 1, 64, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "retentionSpeedLimitMB", tsRetentionSpeedLimitMB, 0, 1024 * 1024, CFG_SCOPE_SERVER) != 0)
+    return -1;
+
   if (cfgAddBool(pCfg, "udf", tsStartUdfd, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddString(pCfg, "udfdResFuncs", tsUdfdResFuncs, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddString(pCfg, "udfdLdLibPath", tsUdfdLdLibPath, CFG_SCOPE_SERVER) != 0) return -1;
@@ -655,6 +690,9 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddString(pCfg, "s3Accesskey", tsS3AccessKey, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddString(pCfg, "s3Endpoint", tsS3Endpoint, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddString(pCfg, "s3BucketName", tsS3BucketName, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "s3BlockSize", tsS3BlockSize, 64, 1024 * 1024, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "s3BlockCacheSize", tsS3BlockCacheSize, 1, 1024 * 1024, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "s3ReadAheadBlocks", tsS3ReadAheadBlocks, 0, 64, CFG_SCOPE_SERVER) != 0) return -1;
 
   // min free disk space used to check if the disk is full [50MB, 1GB]
   if (cfgAddInt64(pCfg, "minDiskFreeSize", tsMinDiskFreeSize, TFS_MIN_DISK_FREE_SIZE, 1024 * 1024 * 1024,
@@ -931,6 +969,8 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   tsQuerySmaOptimize = cfgGetItem(pCfg, "querySmaOptimize")->i32;
   tsQueryPlannerTrace = cfgGetItem(pCfg, "queryPlannerTrace")->bval;
   tsQueryNodeChunkSize = cfgGetItem(pCfg, "queryNodeChunkSize")->i32;
+  tsQueryExchangeBufferSize = cfgGetItem(pCfg, "queryExchangeBufferSize")->i32;
+  tsQueryScanParallelism = cfgGetItem(pCfg, "queryScanParallelism")->i32;
   tsQueryUseNodeAllocator = cfgGetItem(pCfg, "queryUseNodeAllocator")->bval;
   tsKeepColumnName = cfgGetItem(pCfg, "keepColumnName")->bval;
   tsUseAdapter = cfgGetItem(pCfg, "useAdapter")->bval;
@@ -973,6 +1013,12 @@ static void taosSetSystemCfg(SConfig *pCfg) {
   tsVersion = 30000000;
 }
 
+static void taosSetAlpColumns(const char *columns) {
+  tstrncpy(tsAlpColumns, columns, sizeof(tsAlpColumns));
+  tsAlpFloat = (strstr(tsAlpColumns, "float") != NULL);
+  tsAlpDouble = (strstr(tsAlpColumns, "double") != NULL);
+}
+
 static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsDataSpace.reserved = (int64_t)(((double)cfgGetItem(pCfg, "minimalDataDirGB")->fval) * 1024 * 1024 * 1024);
   tsNumOfSupportVnodes = cfgGetItem(pCfg, "supportVnodes")->i32;
@@ -983,6 +1029,7 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsMaxNumOfDistinctResults = cfgGetItem(pCfg, "maxNumOfDistinctRes")->i32;
   tsCountAlwaysReturnValue = cfgGetItem(pCfg, "countAlwaysReturnValue")->i32;
   tsQueryBufferSize = cfgGetItem(pCfg, "queryBufferSize")->i32;
+  tsQueryBufferSizePerQuery = cfgGetItem(pCfg, "queryBufferSizePerQuery")->i32;
   tsPrintAuth = cfgGetItem(pCfg, "printAuth")->bval;
 
   tsNumOfRpcThreads = cfgGetItem(pCfg, "numOfRpcThreads")->i32;
@@ -1022,6 +1069,8 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsEnableCrashReport = cfgGetItem(pCfg, "crashReporting")->bval;
   tsTtlChangeOnWrite = cfgGetItem(pCfg, "ttlChangeOnWrite")->bval;
   tsTtlFlushThreshold = cfgGetItem(pCfg, "ttlFlushThreshold")->i32;
+  tsTagColumnStore = cfgGetItem(pCfg, "tagColumnStore")->bval;
+  tsTagColumnStoreCacheSize = cfgGetItem(pCfg, "tagColumnStoreCacheSize")->i32;
   tsTelemInterval = cfgGetItem(pCfg, "telemetryInterval")->i32;
   tstrncpy(tsTelemServer, cfgGetItem(pCfg, "telemetryServer")->str, TSDB_FQDN_LEN);
   tsTelemPort = (uint16_t)cfgGetItem(pCfg, "telemetryPort")->i32;
@@ -1039,6 +1088,16 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
 
   tsWalFsyncDataSizeLimit = cfgGetItem(pCfg, "walFsyncDataSizeLimit")->i64;
 
+  tsSttMergePolicy = cfgGetItem(pCfg, "sttMergePolicy")->i32;
+  tsSttLevelBaseSize = cfgGetItem(pCfg, "sttLevelBaseSize")->i32;
+  tsSttBloomFilter = cfgGetItem(pCfg, "sttBloomFilter")->bval;
+  taosSetAlpColumns(cfgGetItem(pCfg, "alpColumns")->str);
+  tsRetentionParallelism = cfgGetItem(pCfg, "retentionParallelism")->i32;
+  tsRetentionSpeedLimitMB = cfgGetItem(pCfg, "retentionSpeedLimitMB")->i32;
+  tsS3BlockSize = cfgGetItem(pCfg, "s3BlockSize")->i32;
+  tsS3BlockCacheSize = cfgGetItem(pCfg, "s3BlockCacheSize")->i32;
+  tsS3ReadAheadBlocks = cfgGetItem(pCfg, "s3ReadAheadBlocks")->i32;
+
   tsElectInterval = cfgGetItem(pCfg, "syncElectInterval")->i32;
   tsHeartbeatInterval = cfgGetItem(pCfg, "syncHeartbeatInterval")->i32;
   tsHeartbeatTimeout = cfgGetItem(pCfg, "syncHeartbeatTimeout")->i32;
@@ -1104,6 +1163,8 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         tsAsyncLog = cfgGetItem(pCfg, "asyncLog")->bval;
       } else if (strcasecmp("assert", name) == 0) {
         tsAssert = cfgGetItem(pCfg, "assert")->bval;
+      } else if (strcasecmp("alpColumns", name) == 0) {
+        taosSetAlpColumns(cfgGetItem(pCfg, "alpColumns")->str);
       }
       break;
     }
@@ -1334,12 +1395,18 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         if (tsQueryBufferSize >= 0) {
           tsQueryBufferSizeBytes = tsQueryBufferSize * 1048576UL;
         }
+      } else if (strcasecmp("queryBufferSizePerQuery", name) == 0) {
+        tsQueryBufferSizePerQuery = cfgGetItem(pCfg, "queryBufferSizePerQuery")->i32;
       } else if (strcasecmp("qDebugFlag", name) == 0) {
         qDebugFlag = cfgGetItem(pCfg, "qDebugFlag")->i32;
       } else if (strcasecmp("queryPlannerTrace", name) == 0) {
         tsQueryPlannerTrace = cfgGetItem(pCfg, "queryPlannerTrace")->bval;
       } else if (strcasecmp("queryNodeChunkSize", name) == 0) {
         tsQueryNodeChunkSize = cfgGetItem(pCfg, "queryNodeChunkSize")->i32;
+      } else if (strcasecmp("queryExchangeBufferSize", name) == 0) {
+        tsQueryExchangeBufferSize = cfgGetItem(pCfg, "queryExchangeBufferSize")->i32;
+      } else if (strcasecmp("queryScanParallelism", name) == 0) {
+        tsQueryScanParallelism = cfgGetItem(pCfg, "queryScanParallelism")->i32;
       } else if (strcasecmp("queryUseNodeAllocator", name) == 0) {
         tsQueryUseNodeAllocator = cfgGetItem(pCfg, "queryUseNodeAllocator")->bval;
       } else if (strcasecmp("queryRsmaTolerance", name) == 0) {
@@ -1352,6 +1419,8 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         tsRpcQueueMemoryAllowed = cfgGetItem(pCfg, "rpcQueueMemoryAllowed")->i64;
       } else if (strcasecmp("rpcDebugFlag", name) == 0) {
         rpcDebugFlag = cfgGetItem(pCfg, "rpcDebugFlag")->i32;
+      } else if (strcasecmp("retentionSpeedLimitMB", name) == 0) {
+        tsRetentionSpeedLimitMB = cfgGetItem(pCfg, "retentionSpeedLimitMB")->i32;
       }
       break;
     }
@@ -1362,6 +1431,12 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         taosGetFqdnPortFromEp(strlen(pSecondpItem->str) == 0 ? tsFirst : pSecondpItem->str, &secondEp);
         snprintf(tsSecond, sizeof(tsSecond), "%s:%u", secondEp.fqdn, secondEp.port);
         cfgSetItem(pCfg, "secondEp", tsSecond, pSecondpItem->stype);
+      } else if (strcasecmp("sttMergePolicy", name) == 0) {
+        tsSttMergePolicy = cfgGetItem(pCfg, "sttMergePolicy")->i32;
+      } else if (strcasecmp("sttLevelBaseSize", name) == 0) {
+        tsSttLevelBaseSize = cfgGetItem(pCfg, "sttLevelBaseSize")->i32;
+      } else if (strcasecmp("sttBloomFilter", name) == 0) {
+        tsSttBloomFilter = cfgGetItem(pCfg, "sttBloomFilter")->bval;
       } else if (strcasecmp("smlChildTableName", name) == 0) {
         tstrncpy(tsSmlChildTableName, cfgGetItem(pCfg, "smlChildTableName")->str, TSDB_TABLE_NAME_LEN);
       } else if (strcasecmp("smlTagName", name) == 0) {
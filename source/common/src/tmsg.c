@@ -1151,11 +1151,35 @@ int32_t tSerializeSStatusReq(void *buf, int32_t bufLen, SStatusReq *pReq) {
   // vnode extra
   for (int32_t i = 0; i < vlen; ++i) {
     SVnodeLoad *pload = taosArrayGet(pReq->pVloads, i);
-    int64_t     reserved = 0;
     if (tEncodeI64(&encoder, pload->syncTerm) < 0) return -1;
-    if (tEncodeI64(&encoder, reserved) < 0) return -1;
-    if (tEncodeI64(&encoder, reserved) < 0) return -1;
-    if (tEncodeI64(&encoder, reserved) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->numOfTagFilterCacheHits) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->numOfTagFilterCachePatches) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->numOfTagFilterCacheRebuilds) < 0) return -1;
+  }
+
+  // vnode amplification
+  for (int32_t i = 0; i < vlen; ++i) {
+    SVnodeLoad *pload = taosArrayGet(pReq->pVloads, i);
+    if (tEncodeI64(&encoder, pload->ingestBytes) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->mergeWriteBytes) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->mergeReadBytes) < 0) return -1;
+    if (tEncodeI32(&encoder, pload->numOfFSets) < 0) return -1;
+    if (tEncodeI32(&encoder, pload->numOfSttFiles) < 0) return -1;
+  }
+
+  // vnode migration
+  for (int32_t i = 0; i < vlen; ++i) {
+    SVnodeLoad *pload = taosArrayGet(pReq->pVloads, i);
+    if (tEncodeI64(&encoder, pload->migrateBytes) < 0) return -1;
+    if (tEncodeI32(&encoder, pload->migrateQueue) < 0) return -1;
+  }
+
+  // vnode s3 block cache
+  for (int32_t i = 0; i < vlen; ++i) {
+    SVnodeLoad *pload = taosArrayGet(pReq->pVloads, i);
+    if (tEncodeI64(&encoder, pload->s3CacheHits) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->s3CacheMisses) < 0) return -1;
+    if (tEncodeI64(&encoder, pload->s3FetchBytes) < 0) return -1;
   }
   tEndEncode(&encoder);
 
@@ -1259,11 +1283,41 @@ int32_t tDeserializeSStatusReq(void *buf, int32_t bufLen, SStatusReq *pReq) {
   if (!tDecodeIsEnd(&decoder)) {
     for (int32_t i = 0; i < vlen; ++i) {
       SVnodeLoad *pLoad = taosArrayGet(pReq->pVloads, i);
-      int64_t     reserved = 0;
       if (tDecodeI64(&decoder, &pLoad->syncTerm) < 0) return -1;
-      if (tDecodeI64(&decoder, &reserved) < 0) return -1;
-      if (tDecodeI64(&decoder, &reserved) < 0) return -1;
-      if (tDecodeI64(&decoder, &reserved) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->numOfTagFilterCacheHits) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->numOfTagFilterCachePatches) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->numOfTagFilterCacheRebuilds) < 0) return -1;
+    }
+  }
+
+  // vnode amplification
+  if (!tDecodeIsEnd(&decoder)) {
+    for (int32_t i = 0; i < vlen; ++i) {
+      SVnodeLoad *pLoad = taosArrayGet(pReq->pVloads, i);
+      if (tDecodeI64(&decoder, &pLoad->ingestBytes) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->mergeWriteBytes) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->mergeReadBytes) < 0) return -1;
+      if (tDecodeI32(&decoder, &pLoad->numOfFSets) < 0) return -1;
+      if (tDecodeI32(&decoder, &pLoad->numOfSttFiles) < 0) return -1;
+    }
+  }
+
+  // vnode migration
+  if (!tDecodeIsEnd(&decoder)) {
+    for (int32_t i = 0; i < vlen; ++i) {
+      SVnodeLoad *pLoad = taosArrayGet(pReq->pVloads, i);
+      if (tDecodeI64(&decoder, &pLoad->migrateBytes) < 0) return -1;
+      if (tDecodeI32(&decoder, &pLoad->migrateQueue) < 0) return -1;
+    }
+  }
+
+  // vnode s3 block cache
+  if (!tDecodeIsEnd(&decoder)) {
+    for (int32_t i = 0; i < vlen; ++i) {
+      SVnodeLoad *pLoad = taosArrayGet(pReq->pVloads, i);
+      if (tDecodeI64(&decoder, &pLoad->s3CacheHits) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->s3CacheMisses) < 0) return -1;
+      if (tDecodeI64(&decoder, &pLoad->s3FetchBytes) < 0) return -1;
     }
   }
   tEndDecode(&decoder);
@@ -5919,6 +5973,7 @@ int32_t tSerializeSMqPollReq(void *buf, int32_t bufLen, SMqPollReq *pReq) {
   if (tEncodeI64(&encoder, pReq->consumerId) < 0) return -1;
   if (tEncodeI64(&encoder, pReq->timeout) < 0) return -1;
   if (tSerializeSTqOffsetVal(&encoder, &pReq->reqOffset) < 0) return -1;
+  if (tEncodeI32(&encoder, pReq->maxRows) < 0) return -1;
 
   tEndEncode(&encoder);
 
@@ -5955,6 +6010,10 @@ int32_t tDeserializeSMqPollReq(void *buf, int32_t bufLen, SMqPollReq *pReq) {
   if (tDecodeI64(&decoder, &pReq->timeout) < 0) return -1;
   if (tDerializeSTqOffsetVal(&decoder, &pReq->reqOffset) < 0) return -1;
 
+  if (!tDecodeIsEnd(&decoder)) {
+    if (tDecodeI32(&decoder, &pReq->maxRows) < 0) return -1;
+  }
+
   tEndDecode(&decoder);
 
   tDecoderClear(&decoder);
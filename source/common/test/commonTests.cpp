@@ -154,6 +154,37 @@ TEST(testCase, Datablock_test) {
   taosArrayDestroy(pOrderInfo);
 }
 
+TEST(testCase, Datablock_mem_pool_test) {
+  SBlockMemPool* pPool = blockMemPoolCreate(1024 * 1024);
+  SBlockMemPool* pPrev = blockMemPoolAcquire(pPool);
+
+  for (int32_t i = 0; i < 4; ++i) {
+    SSDataBlock*    b = createDataBlock();
+    SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, 8, 1);
+    blockDataAppendColInfo(b, &infoData);
+    ASSERT_EQ(blockDataEnsureCapacity(b, 4000 + i), 0);
+
+    SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 0);
+    ASSERT_EQ(((uint64_t)p0->pData) & 31, 0);
+    for (int64_t j = 0; j < 4000 + i; ++j) {
+      colDataSetVal(p0, j, (const char*)&j, false);
+    }
+    ASSERT_EQ(*(int64_t*)colDataGetData(p0, 3999), 3999);
+    blockDataDestroy(b);
+  }
+
+  blockMemPoolRelease(pPrev);
+
+  SBlockMemPoolStat stat = {0};
+  blockMemPoolGetStat(pPool, &stat);
+  ASSERT_EQ(stat.numOfAlloc, 4);
+  ASSERT_EQ(stat.numOfReuse, 3);
+  ASSERT_EQ(stat.numOfRecycle, 4);
+  ASSERT_EQ(stat.cachedBytes, 32768);
+
+  blockMemPoolDestroy(pPool);
+}
+
 #if 0
 TEST(testCase, non_var_dataBlock_split_test) {
   SSDataBlock* b = static_cast<SSDataBlock*>(taosMemoryCalloc(1, sizeof(SSDataBlock)));
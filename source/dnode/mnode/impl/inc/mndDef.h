@@ -380,6 +380,19 @@ typedef struct {
   void*     pTsma;
   int32_t   numOfCachedTables;
   int32_t   syncConfChangeVer;
+  int64_t   numOfTagFilterCacheHits;
+  int64_t   numOfTagFilterCachePatches;
+  int64_t   numOfTagFilterCacheRebuilds;
+  int64_t   ingestBytes;
+  int64_t   mergeWriteBytes;
+  int64_t   mergeReadBytes;
+  int32_t   numOfFSets;
+  int32_t   numOfSttFiles;
+  int64_t   migrateBytes;
+  int32_t   migrateQueue;
+  int64_t   s3CacheHits;
+  int64_t   s3CacheMisses;
+  int64_t   s3FetchBytes;
 } SVgObj;
 
 typedef struct {
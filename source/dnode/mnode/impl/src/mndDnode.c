@@ -533,6 +533,19 @@ static int32_t mndProcessStatusReq(SRpcMsg *pReq) {
       if (pVload->syncState == TAOS_SYNC_STATE_LEADER) {
         pVgroup->cacheUsage = pVload->cacheUsage;
         pVgroup->numOfCachedTables = pVload->numOfCachedTables;
+        pVgroup->numOfTagFilterCacheHits = pVload->numOfTagFilterCacheHits;
+        pVgroup->numOfTagFilterCachePatches = pVload->numOfTagFilterCachePatches;
+        pVgroup->numOfTagFilterCacheRebuilds = pVload->numOfTagFilterCacheRebuilds;
+        pVgroup->ingestBytes = pVload->ingestBytes;
+        pVgroup->mergeWriteBytes = pVload->mergeWriteBytes;
+        pVgroup->mergeReadBytes = pVload->mergeReadBytes;
+        pVgroup->numOfFSets = pVload->numOfFSets;
+        pVgroup->numOfSttFiles = pVload->numOfSttFiles;
+        pVgroup->migrateBytes = pVload->migrateBytes;
+        pVgroup->migrateQueue = pVload->migrateQueue;
+        pVgroup->s3CacheHits = pVload->s3CacheHits;
+        pVgroup->s3CacheMisses = pVload->s3CacheMisses;
+        pVgroup->s3FetchBytes = pVload->s3FetchBytes;
         pVgroup->numOfTables = pVload->numOfTables;
         pVgroup->numOfTimeSeries = pVload->numOfTimeSeries;
         pVgroup->totalStorage = pVload->totalStorage;
@@ -226,6 +226,16 @@ static int32_t mndVgroupActionUpdate(SSdb *pSdb, SVgObj *pOld, SVgObj *pNew) {
   pNew->totalStorage = pOld->totalStorage;
   pNew->compStorage = pOld->compStorage;
   pNew->pointsWritten = pOld->pointsWritten;
+  pNew->ingestBytes = pOld->ingestBytes;
+  pNew->mergeWriteBytes = pOld->mergeWriteBytes;
+  pNew->mergeReadBytes = pOld->mergeReadBytes;
+  pNew->numOfFSets = pOld->numOfFSets;
+  pNew->numOfSttFiles = pOld->numOfSttFiles;
+  pNew->migrateBytes = pOld->migrateBytes;
+  pNew->migrateQueue = pOld->migrateQueue;
+  pNew->s3CacheHits = pOld->s3CacheHits;
+  pNew->s3CacheMisses = pOld->s3CacheMisses;
+  pNew->s3FetchBytes = pOld->s3FetchBytes;
   pNew->compact = pOld->compact;
   memcpy(pOld->vnodeGid, pNew->vnodeGid, (TSDB_MAX_REPLICA + TSDB_MAX_LEARNER_REPLICA) * sizeof(SVnodeGid));
   pOld->syncConfChangeVer = pNew->syncConfChangeVer;
@@ -999,6 +1009,59 @@ static int32_t mndRetrieveVgroups(SRpcMsg *pReq, SShowObj *pShow, SSDataBlock *p
     pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
     colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->isTsma, false);
 
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->numOfTagFilterCacheHits, false);
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->numOfTagFilterCachePatches, false);
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->numOfTagFilterCacheRebuilds, false);
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->ingestBytes, false);
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->mergeWriteBytes, false);
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->mergeReadBytes, false);
+
+    // bytes written to disk per byte committed
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    if (pVgroup->ingestBytes <= 0) {
+      colDataSetNULL(pColInfo, numOfRows);
+    } else {
+      double writeAmp = (double)(pVgroup->ingestBytes + pVgroup->mergeWriteBytes) / pVgroup->ingestBytes;
+      colDataSetVal(pColInfo, numOfRows, (const char *)&writeAmp, false);
+    }
+
+    // files a point read of one file set visits
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    if (pVgroup->numOfFSets <= 0) {
+      colDataSetNULL(pColInfo, numOfRows);
+    } else {
+      double readAmp = (double)(pVgroup->numOfSttFiles + pVgroup->numOfFSets) / pVgroup->numOfFSets;
+      colDataSetVal(pColInfo, numOfRows, (const char *)&readAmp, false);
+    }
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->migrateBytes, false);
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->migrateQueue, false);
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    if (pVgroup->s3CacheHits + pVgroup->s3CacheMisses <= 0) {
+      colDataSetNULL(pColInfo, numOfRows);
+    } else {
+      double hitRate = (double)pVgroup->s3CacheHits / (pVgroup->s3CacheHits + pVgroup->s3CacheMisses);
+      colDataSetVal(pColInfo, numOfRows, (const char *)&hitRate, false);
+    }
+
+    pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
+    colDataSetVal(pColInfo, numOfRows, (const char *)&pVgroup->s3FetchBytes, false);
+
     // pColInfo = taosArrayGet(pBlock->pDataBlock, cols++);
     // if (pDb == NULL || pDb->compactStartTime <= 0) {
     //   colDataSetNULL(pColInfo, numOfRows);
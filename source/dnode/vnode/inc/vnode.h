@@ -113,6 +113,7 @@ int32_t     metaReaderGetTableEntryByUid(SMetaReader *pReader, tb_uid_t uid);
 int32_t     metaReaderGetTableEntryByUidCache(SMetaReader *pReader, tb_uid_t uid);
 int32_t     metaGetTableTags(void *pVnode, uint64_t suid, SArray *uidList);
 int32_t     metaGetTableTagsByUids(void *pVnode, int64_t suid, SArray *uidList);
+int32_t     metaGetTableTagCols(void *pVnode, uint64_t suid, SArray *pUidTagList, SSDataBlock *pBlock);
 int32_t     metaReadNext(SMetaReader *pReader);
 const void *metaGetTableTagVal(const void *tag, int16_t type, STagVal *tagVal);
 int         metaGetTableNameByUid(void *meta, uint64_t uid, char *tbName);
@@ -123,9 +124,9 @@ int      metaGetTableTypeByName(void *meta, char *tbName, ETableType *tbType);
 int      metaGetTableTtlByUid(void *meta, uint64_t uid, int64_t *ttlDays);
 bool     metaIsTableExist(void *pVnode, tb_uid_t uid);
 int32_t  metaGetCachedTableUidList(void *pVnode, tb_uid_t suid, const uint8_t *key, int32_t keyLen, SArray *pList,
-                                   bool *acquired);
+                                   bool *acquired, SArray *pChangedList, int64_t *pVer, int64_t *pCachedVer);
 int32_t  metaUidFilterCachePut(void *pVnode, uint64_t suid, const void *pKey, int32_t keyLen, void *pPayload,
-                               int32_t payloadLen, double selectivityRatio);
+                               int32_t payloadLen, double selectivityRatio, int64_t ver);
 tb_uid_t metaGetTableEntryUidByName(SMeta *pMeta, const char *name);
 int32_t  metaGetCachedTbGroup(void *pVnode, tb_uid_t suid, const uint8_t *pKey, int32_t keyLen, SArray **pList);
 int32_t  metaPutTbGroupToCache(void *pVnode, uint64_t suid, const void *pKey, int32_t keyLen, void *pPayload,
@@ -175,6 +176,7 @@ int32_t      tsdbReaderOpen2(void *pVnode, SQueryTableDataCond *pCond, void *pTa
                              SHashObj **pIgnoreTables);
 int32_t      tsdbSetTableList2(STsdbReader *pReader, const void *pTableList, int32_t num);
 void         tsdbReaderSetId2(STsdbReader *pReader, const char *idstr);
+void         tsdbReaderSetProfile2(STsdbReader *pReader, STableScanAnalyzeInfo *pProfile);
 void         tsdbReaderClose2(STsdbReader *pReader);
 int32_t      tsdbNextDataBlock2(STsdbReader *pReader, bool *hasNext);
 int32_t      tsdbRetrieveDatablockSMA2(STsdbReader *pReader, SSDataBlock *pDataBlock, bool *allHave, bool *hasNullSMA);
@@ -222,6 +224,7 @@ typedef struct STqReader {
   int64_t         cachedSchemaSuid;
   int64_t         cachedSchemaUid;
   SSchemaWrapper *pSchemaWrapper;
+  STSchema       *pTSchema;  // built from pSchemaWrapper, used to decode rows of the submit msg
   SSDataBlock    *pResBlock;
 } STqReader;
 
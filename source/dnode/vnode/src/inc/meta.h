@@ -59,6 +59,9 @@ int  metaRemoveTableFromIdx(SMeta* pMeta, tb_uid_t uid);
 // metaCommit ==================
 static FORCE_INLINE tb_uid_t metaGenerateUid(SMeta* pMeta) { return tGenIdPI64(); }
 
+// metaOpen ==================
+int tagIdxKeyCmpr(const void* pKey1, int kLen1, const void* pKey2, int kLen2);
+
 // metaTable ==================
 int metaHandleEntry(SMeta* pMeta, const SMetaEntry* pME);
 
@@ -47,6 +47,9 @@ typedef struct STqOffsetStore STqOffsetStore;
 #define STREAM_EXEC_EXTRACT_DATA_IN_WAL_ID (-1)
 #define STREAM_EXEC_TASK_STATUS_CHECK_ID     (-2)
 
+#define TQ_DEFAULT_POLL_ROWS 4096
+#define TQ_POLL_ROWS(_req)   (((_req)->maxRows > 0) ? (_req)->maxRows : TQ_DEFAULT_POLL_ROWS)
+
 // tqExec
 typedef struct {
   char* qmsg;  // SubPlanToString
@@ -121,7 +124,7 @@ void    tqDestroyTqHandle(void* data);
 
 // tqRead
 int32_t tqScanTaosx(STQ* pTq, const STqHandle* pHandle, STaosxRsp* pRsp, SMqMetaRsp* pMetaRsp, STqOffsetVal* offset);
-int32_t tqScanData(STQ* pTq, const STqHandle* pHandle, SMqDataRsp* pRsp, STqOffsetVal* pOffset);
+int32_t tqScanData(STQ* pTq, const STqHandle* pHandle, SMqDataRsp* pRsp, STqOffsetVal* pOffset, int32_t maxRows);
 int32_t tqFetchLog(STQ* pTq, STqHandle* pHandle, int64_t* fetchOffset, uint64_t reqId);
 
 // tqExec
@@ -74,6 +74,7 @@ typedef struct SDiskDataBuilder SDiskDataBuilder;
 typedef struct SBlkInfo         SBlkInfo;
 typedef struct STsdbDataIter2   STsdbDataIter2;
 typedef struct STsdbFilterInfo  STsdbFilterInfo;
+typedef struct STsdbWriteProfile STsdbWriteProfile;
 
 #define TSDBROW_ROW_FMT ((int8_t)0x0)
 #define TSDBROW_COL_FMT ((int8_t)0x1)
@@ -81,6 +82,14 @@ typedef struct STsdbFilterInfo  STsdbFilterInfo;
 #define TSDB_FILE_DLMT ((uint32_t)0xF00AFA0F)
 #define TSDB_FHDR_SIZE 512
 
+// SDiskDataHdr.fmtVer, from version 1 on the SBlockCol of a variant data type column carries its encoding
+#define TSDB_DISK_DATA_FMT_VER 1
+
+#define TSDB_COL_ENCODING_PLAIN ((int8_t)0x0)
+#define TSDB_COL_ENCODING_DICT  ((int8_t)0x1)  // values as codes into a per-block dictionary of the distinct values
+#define TSDB_COL_DICT_MAX_SIZE  256
+#define TSDB_COL_DICT_MIN_ROWS  64
+
 #define VERSION_MIN 0
 #define VERSION_MAX INT64_MAX
 
@@ -138,8 +147,8 @@ int32_t tTABLEIDCmprFn(const void *p1, const void *p2);
 #define MIN_TSDBKEY(KEY1, KEY2) ((tsdbKeyCmprFn(&(KEY1), &(KEY2)) < 0) ? (KEY1) : (KEY2))
 #define MAX_TSDBKEY(KEY1, KEY2) ((tsdbKeyCmprFn(&(KEY1), &(KEY2)) > 0) ? (KEY1) : (KEY2))
 // SBlockCol
-int32_t tPutBlockCol(uint8_t *p, void *ph);
-int32_t tGetBlockCol(uint8_t *p, void *ph);
+int32_t tPutBlockCol(uint8_t *p, void *ph, int32_t fmtVer);
+int32_t tGetBlockCol(uint8_t *p, void *ph, int32_t fmtVer);
 int32_t tBlockColCmprFn(const void *p1, const void *p2);
 // SDataBlk
 void    tDataBlkReset(SDataBlk *pBlock);
@@ -266,7 +275,20 @@ void    tsdbFSUnref(STsdb *pTsdb, STsdbFS *pFS);
 
 int32_t tsdbFSUpsertFSet(STsdbFS *pFS, SDFileSet *pSet);
 int32_t tsdbFSUpsertDelFile(STsdbFS *pFS, SDelFile *pDelFile);
+// tsdbFS2.c ======================================================================================================
+// bytes written by commits, written and read by merges since open, and the current file set and stt file counts
+void tsdbGetAmpStat(STsdb *pTsdb, int64_t *ingestBytes, int64_t *mergeWriteBytes, int64_t *mergeReadBytes,
+                    int32_t *numOfFSets, int32_t *numOfSttFiles);
+// tsdbRetention.c ================================================================================================
+// bytes copied to other tiers or s3 since open, and the files waiting to be copied
+void tsdbGetMigrateStat(STsdb *pTsdb, int64_t *migrateBytes, int32_t *migrateQueue);
 // tsdbReaderWriter.c ==============================================================================================
+// the profile of the query reader running on the current thread, the file reads and decompressions are charged to
+STableScanAnalyzeInfo *tsdbBindReadProfile(STableScanAnalyzeInfo *pProfile);  // return the one bound before
+STableScanAnalyzeInfo *tsdbGetReadProfile();
+// the profile of the file set writer running on the current thread, the compressions, writes and fsyncs are charged to
+STsdbWriteProfile *tsdbBindWriteProfile(STsdbWriteProfile *pProfile);  // return the one bound before
+STsdbWriteProfile *tsdbGetWriteProfile();
 // SDataFWriter
 int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pSet);
 int32_t tsdbDataFWriterClose(SDataFWriter **ppWriter, int8_t sync);
@@ -379,6 +401,11 @@ struct STsdb {
   TdThreadMutex        lruMutex;
   SLRUCache           *biCache;
   TdThreadMutex        biMutex;
+  SLRUCache           *s3Cache;  // blocks of data files on S3
+  TdThreadMutex        s3Mutex;
+  int64_t              s3CacheHits;
+  int64_t              s3CacheMisses;
+  int64_t              s3FetchBytes;
   struct STFileSystem *pFS;  // new
   SRocksCache          rCache;
 };
@@ -470,6 +497,7 @@ struct SBlockCol {
   int8_t  smaOn;
   int8_t  flag;      // HAS_NONE|HAS_NULL|HAS_VALUE
   int32_t szOrigin;  // original column value size (only save for variant data type)
+  int8_t  encoding;  // TSDB_COL_ENCODING_PLAIN|TSDB_COL_ENCODING_DICT (only save for variant data type)
   int32_t szBitmap;  // bitmap size, 0 only for flag == HAS_VAL
   int32_t szOffset;  // offset size, 0 only for non-variant-length type
   int32_t szValue;   // value size, 0 when flag == (HAS_NULL | HAS_NONE)
@@ -643,14 +671,25 @@ struct SRowMerger {
 
 typedef struct {
   char     *path;
+  STsdb    *pTsdb;
   int32_t   szPage;
   int32_t   flag;
   TdFilePtr pFD;
   int64_t   pgno;
   uint8_t  *pBuf;
   int64_t   szFile;
+  bool      s3File;  // read through the S3 block cache
 } STsdbFD;
 
+// time spent in each phase of writing file sets, in us
+struct STsdbWriteProfile {
+  int64_t iterTime;
+  int64_t encodeTime;
+  int64_t cmprTime;
+  int64_t writeTime;
+  int64_t fsyncTime;
+};
+
 struct SDelFWriter {
   STsdb   *pTsdb;
   SDelFile fDel;
@@ -710,6 +749,7 @@ typedef struct {
 typedef struct SSttBlockLoadCostInfo {
   int64_t loadBlocks;
   int64_t loadStatisBlocks;
+  int64_t skipFiles;  // stt files the bloom filter rules the table out of
   double  blockElapsedTime;
   double  statisElapsedTime;
 } SSttBlockLoadCostInfo;
@@ -859,6 +899,10 @@ int32_t tsdbCacheRelease(SLRUCache *pCache, LRUHandle *h);
 int32_t tsdbCacheGetBlockIdx(SLRUCache *pCache, SDataFReader *pFileReader, LRUHandle **handle);
 int32_t tsdbBICacheRelease(SLRUCache *pCache, LRUHandle *h);
 
+int32_t tsdbCacheLoadS3Pages(STsdbFD *pFD, int64_t fPgno, int64_t lPgno);
+int32_t tsdbCacheReadS3Page(STsdbFD *pFD, int64_t pgno, uint8_t *pBuf);
+void    tsdbGetS3CacheStat(STsdb *pTsdb, int64_t *hits, int64_t *misses, int64_t *fetchBytes);
+
 int32_t tsdbCacheDeleteLastrow(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDeleteLast(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
 int32_t tsdbCacheDelete(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
@@ -905,9 +949,9 @@ static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
 
   pIter->pRow = &pIter->row;
   if (pIter->pNode->flag == TSDBROW_ROW_FMT) {
-    pIter->row = tsdbRowFromTSRow(pIter->pNode->version, pIter->pNode->pData);
+    pIter->row = tsdbRowFromTSRow(pIter->pNode->version, (SRow *)pIter->pNode->pData);
   } else if (pIter->pNode->flag == TSDBROW_COL_FMT) {
-    pIter->row = tsdbRowFromBlockData(pIter->pNode->pData, pIter->pNode->iRow);
+    pIter->row = tsdbRowFromBlockData((SBlockData *)pIter->pNode->pData, pIter->pNode->iRow);
   } else {
     ASSERT(0);
   }
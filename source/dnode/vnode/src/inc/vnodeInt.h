@@ -150,6 +150,8 @@ int             metaCreateSTable(SMeta* pMeta, int64_t version, SVCreateStbReq*
 int             metaAlterSTable(SMeta* pMeta, int64_t version, SVCreateStbReq* pReq);
 int             metaDropSTable(SMeta* pMeta, int64_t verison, SVDropStbReq* pReq, SArray* tbUidList);
 int             metaCreateTable(SMeta* pMeta, int64_t version, SVCreateTbReq* pReq, STableMetaRsp** pMetaRsp);
+int             metaCreateTables(SMeta* pMeta, int64_t version, SVCreateTbReq** ppReq, int32_t nReq,
+                                 SVCreateTbRsp* aRsp);
 int             metaDropTable(SMeta* pMeta, int64_t version, SVDropTbReq* pReq, SArray* tbUids, int64_t* tbUid);
 int32_t         metaTrimTables(SMeta* pMeta);
 void            metaDropTables(SMeta* pMeta, SArray* tbUids);
@@ -163,7 +165,12 @@ int             metaGetTableEntryByName(SMetaReader* pReader, const char* name);
 int             metaAlterCache(SMeta* pMeta, int32_t nPage);
 
 int32_t metaUidCacheClear(SMeta* pMeta, uint64_t suid);
+int32_t metaUidCacheTableChanged(SMeta* pMeta, uint64_t suid, tb_uid_t uid, bool drop);
+void    metaGetUidCacheStats(SMeta* pMeta, int64_t* hits, int64_t* patches, int64_t* rebuilds);
 int32_t metaTbGroupCacheClear(SMeta* pMeta, uint64_t suid);
+int32_t metaTagColStoreTableChanged(SMeta* pMeta, uint64_t suid, tb_uid_t uid, const char* name, const STag* pTag);
+int32_t metaTagColStoreClear(SMeta* pMeta, uint64_t suid);
+void    metaGetTagColStoreStats(SMeta* pMeta, int64_t* loads);
 
 int metaAddIndexToSTable(SMeta* pMeta, int64_t version, SVCreateStbReq* pReq);
 int metaDropIndexFromSTable(SMeta* pMeta, int64_t version, SDropIndexReq* pReq);
@@ -15,6 +15,7 @@
 #include "meta.h"
 
 #define TAG_FILTER_RES_KEY_LEN  32
+#define TAG_FILTER_CHANGE_MAX   4096
 #define META_CACHE_BASE_BUCKET  1024
 #define META_CACHE_STATS_BUCKET 16
 
@@ -35,8 +36,31 @@ typedef struct SMetaStbStatsEntry {
 typedef struct STagFilterResEntry {
   SList    list;      // the linked list of md5 digest, extracted from the serialized tag query condition
   uint32_t hitTimes;  // queried times for current super table
+  int64_t  baseVer;   // change version of the first item in pChanges
+  SArray*  pChanges;  // child tables created, dropped or retagged since baseVer, uid list cache only
 } STagFilterResEntry;
 
+// the item of the uid list cache linked list, the cached list is consistent with all changes before ver
+typedef struct STagFilterResKey {
+  uint64_t digest[2];
+  int64_t  ver;
+} STagFilterResKey;
+
+typedef struct STagFilterChange {
+  tb_uid_t uid;
+  int8_t   drop;
+} STagFilterChange;
+
+// the tags of the child tables of a super table column by column, row i holds the tags of child table aUid[i]
+typedef struct STagColStore {
+  TdThreadRwlock lock;     // readers copy the tags out while the changes of the child tables are applied in place
+  SSDataBlock*   pBlock;   // a column per tag in the order of the tag schema, then the table name if it is loaded
+  SArray*        aUid;     // SArray<tb_uid_t>
+  SHashObj*      pUidIdx;  // uid -> row
+  char*          pVarBuf;  // a var data tag value is built here before it is set into its column
+  int32_t        nStale;   // rows dropped or rewritten since the store is loaded, their var data is left behind
+} STagColStore;
+
 struct SMetaCache {
   // child, normal, super, table entry cache
   struct SEntryCache {
@@ -58,6 +82,9 @@ struct SMetaCache {
     uint32_t      accTimes;
     SHashObj*     pTableEntry;
     SLRUCache*    pUidResCache;
+    int64_t       hits;      // served as cached
+    int64_t       patches;   // served after re-evaluating the changed child tables only
+    int64_t       rebuilds;  // evaluated over all child tables
   } sTagFilterResCache;
 
   struct STbGroupResCache {
@@ -70,6 +97,11 @@ struct SMetaCache {
   struct STbFilterCache {
     SHashObj* pStb;
   } STbFilterCache;
+
+  struct STagColCache {
+    SLRUCache* pStore;  // suid -> STagColStore*, a store is freed once it is evicted and the last reader is done
+    int64_t    loads;
+  } sTagColCache;
 };
 
 static void entryCacheClose(SMeta* pMeta) {
@@ -105,9 +137,23 @@ static void statsCacheClose(SMeta* pMeta) {
 static void freeCacheEntryFp(void* param) {
   STagFilterResEntry** p = param;
   tdListEmpty(&(*p)->list);
+  taosArrayDestroy((*p)->pChanges);
   taosMemoryFreeClear(*p);
 }
 
+static void tagColStoreDestroy(STagColStore* pStore) {
+  if (pStore) {
+    blockDataDestroy(pStore->pBlock);
+    taosArrayDestroy(pStore->aUid);
+    taosHashCleanup(pStore->pUidIdx);
+    taosMemoryFree(pStore->pVarBuf);
+    taosThreadRwlockDestroy(&pStore->lock);
+    taosMemoryFree(pStore);
+  }
+}
+
+static void freeTagColStore(const void* key, size_t keyLen, void* value, void* ud) { tagColStoreDestroy(value); }
+
 int32_t metaCacheOpen(SMeta* pMeta) {
   int32_t     code = 0;
   SMetaCache* pCache = NULL;
@@ -145,6 +191,9 @@ int32_t metaCacheOpen(SMeta* pMeta) {
   }
 
   pCache->sTagFilterResCache.accTimes = 0;
+  pCache->sTagFilterResCache.hits = 0;
+  pCache->sTagFilterResCache.patches = 0;
+  pCache->sTagFilterResCache.rebuilds = 0;
   pCache->sTagFilterResCache.pTableEntry =
       taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_VARCHAR), false, HASH_NO_LOCK);
   if (pCache->sTagFilterResCache.pTableEntry == NULL) {
@@ -178,6 +227,14 @@ int32_t metaCacheOpen(SMeta* pMeta) {
     goto _err2;
   }
 
+  // a single shard, so a store may take the whole capacity
+  pCache->sTagColCache.pStore = taosLRUCacheInit((int64_t)tsTagColumnStoreCacheSize * 1048576, 0, 0.5);
+  if (pCache->sTagColCache.pStore == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err2;
+  }
+  pCache->sTagColCache.loads = 0;
+
   pMeta->pCache = pCache;
   return code;
 
@@ -205,6 +262,8 @@ void metaCacheClose(SMeta* pMeta) {
 
     taosHashCleanup(pMeta->pCache->STbFilterCache.pStb);
 
+    taosLRUCacheCleanup(pMeta->pCache->sTagColCache.pStore);
+
     taosMemoryFree(pMeta->pCache);
     pMeta->pCache = NULL;
   }
@@ -509,10 +568,97 @@ static void initCacheKey(uint64_t* buf, const SHashObj* pHashMap, uint64_t suid,
   ASSERT(keyLen == sizeof(uint64_t) * 2);
 }
 
+static STagFilterResEntry* uidCacheAcquireEntry(SHashObj* pTableEntry, uint64_t suid) {
+  STagFilterResEntry** pEntry = taosHashGet(pTableEntry, &suid, sizeof(uint64_t));
+  if (pEntry != NULL) {
+    return *pEntry;
+  }
+
+  STagFilterResEntry* p = taosMemoryCalloc(1, sizeof(STagFilterResEntry));
+  if (p == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  tdListInit(&p->list, sizeof(STagFilterResKey));
+  if (taosHashPut(pTableEntry, &suid, sizeof(uint64_t), &p, POINTER_BYTES) != 0) {
+    taosMemoryFree(p);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  return p;
+}
+
+static SListNode* uidCacheFindNode(STagFilterResEntry* pEntry, const void* pKey) {
+  SListIter iter = {0};
+  tdListInitIter(&pEntry->list, &iter, TD_LIST_FORWARD);
+
+  SListNode* pNode = NULL;
+  while ((pNode = tdListNext(&iter)) != NULL) {
+    STagFilterResKey* pResKey = (STagFilterResKey*)pNode->data;
+    if (pResKey->digest[0] == ((uint64_t*)pKey)[0] && pResKey->digest[1] == ((uint64_t*)pKey)[1]) {
+      return pNode;
+    }
+  }
+
+  return NULL;
+}
+
+static FORCE_INLINE int64_t uidCacheCurrentVer(const STagFilterResEntry* pEntry) {
+  return pEntry->baseVer + taosArrayGetSize(pEntry->pChanges);
+}
+
+// Move the uid list cached at an older version to the current one: the cached uids of changed child tables are
+// removed, and the changed ones that still exist are returned in pChangedList, to be evaluated by the caller.
+static int32_t uidCachePatchList(STagFilterResEntry* pEntry, int64_t ver, const char* pPayload, SArray* pList,
+                                 SArray* pChangedList) {
+  int32_t   start = (int32_t)(ver - pEntry->baseVer);
+  int32_t   numOfChanges = taosArrayGetSize(pEntry->pChanges);
+  SHashObj* pChanged =
+      taosHashInit(numOfChanges - start, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  if (pChanged == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  // the later change of the same table overwrites the former one
+  for (int32_t i = start; i < numOfChanges; ++i) {
+    STagFilterChange* pChange = taosArrayGet(pEntry->pChanges, i);
+    taosHashPut(pChanged, &pChange->uid, sizeof(tb_uid_t), &pChange->drop, sizeof(int8_t));
+  }
+
+  int32_t         size = *(int32_t*)pPayload;
+  const uint64_t* pUid = (const uint64_t*)(pPayload + sizeof(int32_t));
+  for (int32_t i = 0; i < size; ++i) {
+    if (taosHashGet(pChanged, &pUid[i], sizeof(tb_uid_t)) == NULL) {
+      taosArrayPush(pList, &pUid[i]);
+    }
+  }
+
+  for (int32_t i = start; i < numOfChanges; ++i) {
+    STagFilterChange* pChange = taosArrayGet(pEntry->pChanges, i);
+    int8_t*           drop = taosHashGet(pChanged, &pChange->uid, sizeof(tb_uid_t));
+    if (drop != NULL) {
+      if (*drop == 0) {
+        taosArrayPush(pChangedList, &pChange->uid);
+      }
+      taosHashRemove(pChanged, &pChange->uid, sizeof(tb_uid_t));
+    }
+  }
+
+  taosHashCleanup(pChanged);
+  return TSDB_CODE_SUCCESS;
+}
+
+// *pVer is the change version of the super table observed, it should be passed back when putting the result that is
+// evaluated, or patched, after this call. *pCachedVer is the version the acquired list was cached at, the list is
+// patched if it is older than *pVer: the uids in pChangedList are not in pList1 yet, the caller should append the ones
+// satisfying the tag condition, and put the patched list back even if none changed, so the changes can be discarded.
 int32_t metaGetCachedTableUidList(void* pVnode, tb_uid_t suid, const uint8_t* pKey, int32_t keyLen, SArray* pList1,
-                                  bool* acquireRes) {
+                                  bool* acquireRes, SArray* pChangedList, int64_t* pVer, int64_t* pCachedVer) {
   SMeta*  pMeta = ((SVnode*)pVnode)->pMeta;
   int32_t vgId = TD_VID(pMeta->pVnode);
+  int32_t code = TSDB_CODE_SUCCESS;
 
   // generate the composed key for LRU cache
   SLRUCache*     pCache = pMeta->pCache->sTagFilterResCache.pUidResCache;
@@ -526,33 +672,67 @@ int32_t metaGetCachedTableUidList(void* pVnode, tb_uid_t suid, const uint8_t* pK
   taosThreadMutexLock(pLock);
   pMeta->pCache->sTagFilterResCache.accTimes += 1;
 
+  // the entry is kept since the first query of the super table, so that the changes are recorded from now on
+  STagFilterResEntry* pEntry = uidCacheAcquireEntry(pTableMap, suid);
+  if (pEntry == NULL) {
+    taosThreadMutexUnlock(pLock);
+    return terrno;
+  }
+
+  *pVer = uidCacheCurrentVer(pEntry);
+
   LRUHandle* pHandle = taosLRUCacheLookup(pCache, key, TAG_FILTER_RES_KEY_LEN);
   if (pHandle == NULL) {
+    pMeta->pCache->sTagFilterResCache.rebuilds += 1;
     taosThreadMutexUnlock(pLock);
     return TSDB_CODE_SUCCESS;
   }
 
-  // do some book mark work after acquiring the filter result from cache
-  STagFilterResEntry** pEntry = taosHashGet(pTableMap, &suid, sizeof(uint64_t));
-  if (NULL == pEntry) {
-    metaError("meta/cache: pEntry should not be NULL.");
+  SListNode* pNode = uidCacheFindNode(pEntry, pKey);
+  if (pNode == NULL) {
+    taosLRUCacheRelease(pCache, pHandle, false);
+    taosThreadMutexUnlock(pLock);
+    metaError("meta/cache: cached uid list of suid:%" PRIu64 " not in the linked list.", suid);
     return TSDB_CODE_FAILED;
   }
 
-  *acquireRes = 1;
-
+  int64_t     ver = ((STagFilterResKey*)pNode->data)->ver;
   const char* p = taosLRUCacheValue(pCache, pHandle);
-  int32_t     size = *(int32_t*)p;
+  *pCachedVer = ver;
 
-  // set the result into the buffer
-  taosArrayAddBatch(pList1, p + sizeof(int32_t), size);
+  if (ver < pEntry->baseVer) {
+    // the changes after ver have been discarded, the list cannot be patched any more
+    taosLRUCacheRelease(pCache, pHandle, false);
+    taosLRUCacheErase(pCache, key, TAG_FILTER_RES_KEY_LEN);
+    pMeta->pCache->sTagFilterResCache.rebuilds += 1;
+    taosThreadMutexUnlock(pLock);
+    return TSDB_CODE_SUCCESS;
+  }
 
-  (*pEntry)->hitTimes += 1;
+  if (ver == *pVer) {
+    // set the result into the buffer
+    taosArrayAddBatch(pList1, p + sizeof(int32_t), *(int32_t*)p);
+    pMeta->pCache->sTagFilterResCache.hits += 1;
+  } else {
+    code = uidCachePatchList(pEntry, ver, p, pList1, pChangedList);
+    if (code != TSDB_CODE_SUCCESS) {
+      taosArrayClear(pList1);
+      taosArrayClear(pChangedList);
+      taosLRUCacheRelease(pCache, pHandle, false);
+      taosThreadMutexUnlock(pLock);
+      return code;
+    }
+    pMeta->pCache->sTagFilterResCache.patches += 1;
+  }
+
+  *acquireRes = 1;
+  pEntry->hitTimes += 1;
 
   uint32_t acc = pMeta->pCache->sTagFilterResCache.accTimes;
-  if ((*pEntry)->hitTimes % 5000 == 0 && (*pEntry)->hitTimes > 0) {
-    metaInfo("vgId:%d cache hit:%d, total acc:%d, rate:%.2f", vgId, (*pEntry)->hitTimes, acc,
-             ((double)(*pEntry)->hitTimes) / acc);
+  if (pEntry->hitTimes % 5000 == 0 && pEntry->hitTimes > 0) {
+    metaInfo("vgId:%d cache hit:%d, total acc:%d, rate:%.2f, hits:%" PRId64 ", patches:%" PRId64 ", rebuilds:%" PRId64,
+             vgId, pEntry->hitTimes, acc, ((double)pEntry->hitTimes) / acc, pMeta->pCache->sTagFilterResCache.hits,
+             pMeta->pCache->sTagFilterResCache.patches, pMeta->pCache->sTagFilterResCache.rebuilds);
   }
 
   taosLRUCacheRelease(pCache, pHandle, false);
@@ -603,21 +783,21 @@ static void freeUidCachePayload(const void* key, size_t keyLen, void* value, voi
 }
 
 static int32_t addNewEntry(SHashObj* pTableEntry, const void* pKey, int32_t keyLen, uint64_t suid) {
-  STagFilterResEntry* p = taosMemoryMalloc(sizeof(STagFilterResEntry));
+  STagFilterResEntry* p = taosMemoryCalloc(1, sizeof(STagFilterResEntry));
   if (p == NULL) {
     return TSDB_CODE_OUT_OF_MEMORY;
   }
 
-  p->hitTimes = 0;
   tdListInit(&p->list, keyLen);
   taosHashPut(pTableEntry, &suid, sizeof(uint64_t), &p, POINTER_BYTES);
   tdListAppend(&p->list, pKey);
   return 0;
 }
 
-// check both the payload size and selectivity ratio
+// check both the payload size and selectivity ratio, ver is the one returned by metaGetCachedTableUidList before the
+// list is evaluated
 int32_t metaUidFilterCachePut(void* pVnode, uint64_t suid, const void* pKey, int32_t keyLen, void* pPayload,
-                              int32_t payloadLen, double selectivityRatio) {
+                              int32_t payloadLen, double selectivityRatio, int64_t ver) {
   int32_t code = 0;
   SMeta*  pMeta = ((SVnode*)pVnode)->pMeta;
   int32_t vgId = TD_VID(pMeta->pVnode);
@@ -646,29 +826,38 @@ int32_t metaUidFilterCachePut(void* pVnode, uint64_t suid, const void* pKey, int
   initCacheKey(key, pTableEntry, suid, pKey, keyLen);
 
   taosThreadMutexLock(pLock);
-  STagFilterResEntry** pEntry = taosHashGet(pTableEntry, &suid, sizeof(uint64_t));
+  STagFilterResEntry* pEntry = uidCacheAcquireEntry(pTableEntry, suid);
   if (pEntry == NULL) {
-    code = addNewEntry(pTableEntry, pKey, keyLen, suid);
-    if (code != TSDB_CODE_SUCCESS) {
+    code = terrno;
+    taosMemoryFree(pPayload);
+    goto _end;
+  }
+
+  if (ver < pEntry->baseVer) {
+    // part of the changes happened during the evaluation are discarded, the list cannot be patched later
+    taosMemoryFree(pPayload);
+    goto _end;
+  }
+
+  SListNode* pNode = uidCacheFindNode(pEntry, pKey);
+  if (pNode != NULL) {
+    if (((STagFilterResKey*)pNode->data)->ver >= ver) {
+      // we have already found the existed items, no need to added to cache anymore.
+      taosMemoryFree(pPayload);
       goto _end;
     }
-  } else {  // check if it exists or not
-    size_t size = listNEles(&(*pEntry)->list);
-    if (size == 0) {
-      tdListAppend(&(*pEntry)->list, pKey);
-    } else {
-      SListNode* pNode = listHead(&(*pEntry)->list);
-      uint64_t*  p = (uint64_t*)pNode->data;
-      if (p[1] == ((uint64_t*)pKey)[1] && p[0] == ((uint64_t*)pKey)[0]) {
-        // we have already found the existed items, no need to added to cache anymore.
-        taosThreadMutexUnlock(pLock);
-        return TSDB_CODE_SUCCESS;
-      } else {  // not equal, append it
-        tdListAppend(&(*pEntry)->list, pKey);
-      }
+
+    // replace the older one, the linked list node is removed along with the payload
+    taosLRUCacheErase(pCache, key, TAG_FILTER_RES_KEY_LEN);
+    if ((pNode = uidCacheFindNode(pEntry, pKey)) != NULL) {
+      taosMemoryFree(tdListPopNode(&pEntry->list, pNode));
     }
   }
 
+  STagFilterResKey resKey = {.ver = ver};
+  memcpy(resKey.digest, pKey, sizeof(resKey.digest));
+  tdListAppend(&pEntry->list, &resKey);
+
   // add to cache.
   taosLRUCacheInsert(pCache, key, TAG_FILTER_RES_KEY_LEN, pPayload, payloadLen, freeUidCachePayload, NULL,
                      TAOS_LRU_PRIORITY_LOW, NULL);
@@ -680,42 +869,118 @@ _end:
   return code;
 }
 
-// remove the lru cache that are expired due to the tags value update, or creating, or dropping, of child tables
+static void uidCacheClearImpl(SMeta* pMeta, STagFilterResEntry* pEntry, uint64_t suid) {
+  uint64_t p[4] = {0};
+  uint64_t dummy[2] = {0};
+  initCacheKey(p, pMeta->pCache->sTagFilterResCache.pTableEntry, suid, (char*)&dummy[0], 16);
+
+  pEntry->hitTimes = 0;
+
+  // the lru deleter pops the node from the linked list, so always erase the head
+  SListNode* pNode = NULL;
+  while ((pNode = listHead(&pEntry->list)) != NULL) {
+    setMD5DigestInKey(p, pNode->data, 2 * sizeof(uint64_t));
+    taosLRUCacheErase(pMeta->pCache->sTagFilterResCache.pUidResCache, p, TAG_FILTER_RES_KEY_LEN);
+    if (listHead(&pEntry->list) == pNode) {
+      taosMemoryFree(tdListPopNode(&pEntry->list, pNode));
+    }
+  }
+
+  // the lists evaluated before now cannot be put any more
+  pEntry->baseVer = uidCacheCurrentVer(pEntry);
+  taosArrayClear(pEntry->pChanges);
+}
+
+// remove the lru cache that are expired due to dropping of the super table
 int32_t metaUidCacheClear(SMeta* pMeta, uint64_t suid) {
-  uint64_t  p[4] = {0};
   int32_t   vgId = TD_VID(pMeta->pVnode);
   SHashObj* pEntryHashMap = pMeta->pCache->sTagFilterResCache.pTableEntry;
 
-  uint64_t dummy[2] = {0};
-  initCacheKey(p, pEntryHashMap, suid, (char*)&dummy[0], 16);
-
   TdThreadMutex* pLock = &pMeta->pCache->sTagFilterResCache.lock;
   taosThreadMutexLock(pLock);
 
   STagFilterResEntry** pEntry = taosHashGet(pEntryHashMap, &suid, sizeof(uint64_t));
-  if (pEntry == NULL || listNEles(&(*pEntry)->list) == 0) {
+  if (pEntry == NULL) {
     taosThreadMutexUnlock(pLock);
     return TSDB_CODE_SUCCESS;
   }
 
-  (*pEntry)->hitTimes = 0;
+  uidCacheClearImpl(pMeta, *pEntry, suid);
+  taosThreadMutexUnlock(pLock);
 
-  SListIter iter = {0};
-  tdListInitIter(&(*pEntry)->list, &iter, TD_LIST_FORWARD);
+  metaDebug("vgId:%d suid:%" PRId64 " cached related tag filter uid list cleared", vgId, suid);
+  return TSDB_CODE_SUCCESS;
+}
 
-  SListNode* pNode = NULL;
-  while ((pNode = tdListNext(&iter)) != NULL) {
-    setMD5DigestInKey(p, pNode->data, 2 * sizeof(uint64_t));
-    taosLRUCacheErase(pMeta->pCache->sTagFilterResCache.pUidResCache, p, TAG_FILTER_RES_KEY_LEN);
+// record the creating, dropping, or tags value update of a child table, the cached uid lists of the super table are
+// patched by the next query instead of being evaluated again over all child tables.
+int32_t metaUidCacheTableChanged(SMeta* pMeta, uint64_t suid, tb_uid_t uid, bool drop) {
+  int32_t   vgId = TD_VID(pMeta->pVnode);
+  SHashObj* pEntryHashMap = pMeta->pCache->sTagFilterResCache.pTableEntry;
+
+  TdThreadMutex* pLock = &pMeta->pCache->sTagFilterResCache.lock;
+  taosThreadMutexLock(pLock);
+
+  // no query on this super table yet, nothing to patch
+  STagFilterResEntry** ppEntry = taosHashGet(pEntryHashMap, &suid, sizeof(uint64_t));
+  if (ppEntry == NULL) {
+    taosThreadMutexUnlock(pLock);
+    return TSDB_CODE_SUCCESS;
   }
 
-  tdListEmpty(&(*pEntry)->list);
-  taosThreadMutexUnlock(pLock);
+  STagFilterResEntry* pEntry = *ppEntry;
+  if (pEntry->pChanges == NULL) {
+    pEntry->pChanges = taosArrayInit(16, sizeof(STagFilterChange));
+    if (pEntry->pChanges == NULL) {
+      uidCacheClearImpl(pMeta, pEntry, suid);
+      taosThreadMutexUnlock(pLock);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
 
-  metaDebug("vgId:%d suid:%" PRId64 " cached related tag filter uid list cleared", vgId, suid);
+  if (taosArrayGetSize(pEntry->pChanges) >= TAG_FILTER_CHANGE_MAX) {
+    // discard the changes that all cached lists have been patched with
+    int64_t minVer = uidCacheCurrentVer(pEntry);
+
+    SListIter iter = {0};
+    tdListInitIter(&pEntry->list, &iter, TD_LIST_FORWARD);
+
+    SListNode* pNode = NULL;
+    while ((pNode = tdListNext(&iter)) != NULL) {
+      minVer = TMIN(minVer, ((STagFilterResKey*)pNode->data)->ver);
+    }
+
+    if (minVer > pEntry->baseVer) {
+      taosArrayPopFrontBatch(pEntry->pChanges, minVer - pEntry->baseVer);
+      pEntry->baseVer = minVer;
+    } else {
+      // too many changes on the list not queried for a long time, let them be evaluated again
+      uidCacheClearImpl(pMeta, pEntry, suid);
+      metaDebug("vgId:%d suid:%" PRId64 " too many child table changes, cached tag filter uid list cleared", vgId,
+                suid);
+    }
+  }
+
+  STagFilterChange change = {.uid = uid, .drop = drop};
+  if (taosArrayPush(pEntry->pChanges, &change) == NULL) {
+    uidCacheClearImpl(pMeta, pEntry, suid);
+    taosThreadMutexUnlock(pLock);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  taosThreadMutexUnlock(pLock);
   return TSDB_CODE_SUCCESS;
 }
 
+void metaGetUidCacheStats(SMeta* pMeta, int64_t* hits, int64_t* patches, int64_t* rebuilds) {
+  TdThreadMutex* pLock = &pMeta->pCache->sTagFilterResCache.lock;
+  taosThreadMutexLock(pLock);
+  *hits = pMeta->pCache->sTagFilterResCache.hits;
+  *patches = pMeta->pCache->sTagFilterResCache.patches;
+  *rebuilds = pMeta->pCache->sTagFilterResCache.rebuilds;
+  taosThreadMutexUnlock(pLock);
+}
+
 int32_t metaGetCachedTbGroup(void* pVnode, tb_uid_t suid, const uint8_t* pKey, int32_t keyLen, SArray** pList) {
   SMeta*  pMeta = ((SVnode*)pVnode)->pMeta;
   int32_t vgId = TD_VID(pMeta->pVnode);
@@ -919,4 +1184,375 @@ int32_t metaSizeOfTbFilterCache(void* pVnode, int8_t type) {
     return taosHashGetSize(pMeta->pCache->STbFilterCache.pStb);
   }
   return 0;
-}
\ No newline at end of file
+}
+static int32_t tagColStoreSetRow(STagColStore* pStore, int32_t row, const char* name, const STag* pTag) {
+  int32_t code = 0;
+  int32_t numOfCols = taosArrayGetSize(pStore->pBlock->pDataBlock);
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pCol = taosArrayGet(pStore->pBlock->pDataBlock, i);
+
+    if (pCol->info.colId == -1) {  // tbname
+      STR_TO_VARSTR(pStore->pVarBuf, name);
+      code = colDataSetVal(pCol, row, pStore->pVarBuf, false);
+    } else {
+      STagVal tagVal = {.cid = pCol->info.colId};
+      if (!tTagGet(pTag, &tagVal)) {
+        code = colDataSetVal(pCol, row, NULL, true);
+      } else if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+        varDataSetLen(pStore->pVarBuf, tagVal.nData);
+        memcpy(varDataVal(pStore->pVarBuf), tagVal.pData, tagVal.nData);
+        code = colDataSetVal(pCol, row, pStore->pVarBuf, false);
+      } else {
+        code = colDataSetVal(pCol, row, (const char*)&tagVal.i64, false);
+      }
+    }
+    if (code) return code;
+  }
+
+  return code;
+}
+
+static int32_t tagColStoreAppend(STagColStore* pStore, tb_uid_t uid, const char* name, const STag* pTag) {
+  int32_t      code = 0;
+  SSDataBlock* pBlock = pStore->pBlock;
+  int32_t      row = pBlock->info.rows;
+
+  if (row >= pBlock->info.capacity) {
+    code = blockDataEnsureCapacity(pBlock, TMAX(1024, pBlock->info.capacity * 2));
+    if (code) return code;
+  }
+
+  code = tagColStoreSetRow(pStore, row, name, pTag);
+  if (code) return code;
+
+  if (taosArrayPush(pStore->aUid, &uid) == NULL ||
+      taosHashPut(pStore->pUidIdx, &uid, sizeof(uid), &row, sizeof(row)) != 0) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pBlock->info.rows++;
+  return code;
+}
+
+// the last row takes the place of the dropped one
+static void tagColStoreDropRow(STagColStore* pStore, int32_t row) {
+  SSDataBlock* pBlock = pStore->pBlock;
+  int32_t      last = pBlock->info.rows - 1;
+  tb_uid_t     uid = *(tb_uid_t*)taosArrayGet(pStore->aUid, row);
+
+  if (row != last) {
+    for (int32_t i = 0; i < taosArrayGetSize(pBlock->pDataBlock); ++i) {
+      SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, i);
+      if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+        pCol->varmeta.offset[row] = pCol->varmeta.offset[last];
+      } else {
+        colDataSetVal(pCol, row, colDataGetNumData(pCol, last), colDataIsNull_f(pCol->nullbitmap, last));
+      }
+    }
+
+    tb_uid_t lastUid = *(tb_uid_t*)taosArrayGet(pStore->aUid, last);
+    taosArraySet(pStore->aUid, row, &lastUid);
+    taosHashPut(pStore->pUidIdx, &lastUid, sizeof(lastUid), &row, sizeof(row));
+  }
+
+  taosHashRemove(pStore->pUidIdx, &uid, sizeof(uid));
+  taosArrayPop(pStore->aUid);
+  pBlock->info.rows--;
+  pStore->nStale++;
+}
+
+// the memory the store is charged with in the cache, the rows appended after the load are not counted
+static size_t tagColStoreSize(const STagColStore* pStore) {
+  size_t rows = pStore->pBlock->info.rows;
+  return sizeof(STagColStore) + blockDataGetSize(pStore->pBlock) + rows * (sizeof(tb_uid_t) * 2 + sizeof(int32_t));
+}
+
+// load the tags of all child tables of the super table, and put the store into the cache while the meta is still
+// locked, so each change made after the load comes after it to the store. The store is returned held by *ppHandle,
+// or in *ppStore, to be destroyed by the caller once used, when it does not fit into the cache.
+static int32_t tagColStoreLoad(SMeta* pMeta, uint64_t suid, bool withName, LRUHandle** ppHandle,
+                               STagColStore** ppStore) {
+  SLRUCache*    pCache = pMeta->pCache->sTagColCache.pStore;
+  int32_t       code = 0;
+  STagColStore* pStore = NULL;
+  SMCtbCursor*  pCur = NULL;
+  SMetaReader   mr = {0};
+  SMetaReader   nr = {0};
+
+  metaRLock(pMeta);
+  metaReaderDoInit(&mr, pMeta, META_READER_NOLOCK);
+  metaReaderDoInit(&nr, pMeta, META_READER_NOLOCK);
+
+  if (metaReaderGetTableEntryByUidCache(&mr, suid) < 0 || mr.me.type != TSDB_SUPER_TABLE) {
+    code = TSDB_CODE_PAR_TABLE_NOT_EXIST;
+    goto _exit;
+  }
+
+  // the json tag is left to the tag blob
+  SSchemaWrapper* pSchemaTag = &mr.me.stbEntry.schemaTag;
+  if (pSchemaTag->nCols == 0 || pSchemaTag->pSchema[0].type == TSDB_DATA_TYPE_JSON) {
+    code = TSDB_CODE_OPS_NOT_SUPPORT;
+    goto _exit;
+  }
+
+  pStore = taosMemoryCalloc(1, sizeof(*pStore));
+  if (pStore == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+  taosThreadRwlockInit(&pStore->lock, NULL);
+  pStore->pBlock = createDataBlock();
+  pStore->aUid = taosArrayInit(1024, sizeof(tb_uid_t));
+  pStore->pUidIdx = taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  if (pStore->pBlock == NULL || pStore->aUid == NULL || pStore->pUidIdx == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  int32_t maxBytes = TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE;
+  for (int32_t i = 0; i < pSchemaTag->nCols; ++i) {
+    SSchema*        pSchema = &pSchemaTag->pSchema[i];
+    SColumnInfoData colInfo = createColumnInfoData(pSchema->type, pSchema->bytes, pSchema->colId);
+    blockDataAppendColInfo(pStore->pBlock, &colInfo);
+    maxBytes = TMAX(maxBytes, pSchema->bytes);
+  }
+  if (withName) {
+    SColumnInfoData colInfo =
+        createColumnInfoData(TSDB_DATA_TYPE_VARCHAR, TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE, -1);
+    blockDataAppendColInfo(pStore->pBlock, &colInfo);
+  }
+
+  pStore->pVarBuf = taosMemoryMalloc(maxBytes + VARSTR_HEADER_SIZE);
+  pCur = metaOpenCtbCursor(pMeta->pVnode, suid, 0);
+  if (pStore->pVarBuf == NULL || pCur == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  tb_uid_t uid;
+  while ((uid = metaCtbCursorNext(pCur)) != 0) {
+    const char* name = NULL;
+    if (withName) {
+      if (metaReaderGetTableEntryByUidCache(&nr, uid) < 0) {
+        code = terrno;
+        goto _exit;
+      }
+      name = nr.me.name;
+    }
+
+    code = tagColStoreAppend(pStore, uid, name, pCur->pVal);
+    tDecoderClear(&nr.coder);
+    if (code) goto _exit;
+  }
+
+  int32_t   numOfTables = pStore->pBlock->info.rows;
+  size_t    size = tagColStoreSize(pStore);
+  LRUStatus status = taosLRUCacheInsert(pCache, &suid, sizeof(suid), pStore, size, freeTagColStore, ppHandle,
+                                        TAOS_LRU_PRIORITY_LOW, NULL);
+  atomic_add_fetch_64(&pMeta->pCache->sTagColCache.loads, 1);
+  if (status != TAOS_LRU_STATUS_OK && status != TAOS_LRU_STATUS_OK_OVERWRITTEN) {
+    // the entry is freed on a failed insert but the store is left to us, it serves this call only
+    metaDebug("vgId:%d, suid:%" PRIu64 " tags of %d child tables loaded, %" PRIzu
+              " bytes do not fit into the column store cache",
+              TD_VID(pMeta->pVnode), suid, numOfTables, size);
+    *ppHandle = NULL;
+    *ppStore = pStore;
+    pStore = NULL;
+    goto _exit;
+  }
+
+  pStore = NULL;  // owned by the cache
+  metaDebug("vgId:%d, suid:%" PRIu64 " tags of %d child tables loaded into the column store", TD_VID(pMeta->pVnode),
+            suid, numOfTables);
+
+_exit:
+  metaCloseCtbCursor(pCur);
+  metaReaderClear(&nr);
+  metaReaderClear(&mr);
+  metaULock(pMeta);
+
+  tagColStoreDestroy(pStore);
+  return code;
+}
+
+static int32_t tagColStoreGetTags(STagColStore* pStore, SArray* pUidTagList, SSDataBlock* pBlock) {
+  int32_t  code = 0;
+  int32_t  numOfCols = taosArrayGetSize(pBlock->pDataBlock);
+  int32_t  numOfRows = taosArrayGetSize(pUidTagList);
+  bool     all = (numOfRows == 0);
+  int32_t* aSrcCol = NULL;
+  int32_t* aRow = NULL;
+
+  if (all) numOfRows = pStore->pBlock->info.rows;
+
+  aSrcCol = taosMemoryMalloc(sizeof(int32_t) * numOfCols);
+  aRow = all ? NULL : taosMemoryMalloc(sizeof(int32_t) * numOfRows);
+  if (aSrcCol == NULL || (!all && aRow == NULL)) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  // all wanted columns and tables must be in the store, otherwise the tags are taken from the tag blob
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pDst = taosArrayGet(pBlock->pDataBlock, i);
+
+    aSrcCol[i] = -1;
+    for (int32_t j = 0; j < taosArrayGetSize(pStore->pBlock->pDataBlock); ++j) {
+      SColumnInfoData* pSrc = taosArrayGet(pStore->pBlock->pDataBlock, j);
+      if (pSrc->info.colId == pDst->info.colId && pSrc->info.type == pDst->info.type) {
+        aSrcCol[i] = j;
+        break;
+      }
+    }
+    if (aSrcCol[i] < 0) {
+      code = TSDB_CODE_OPS_NOT_SUPPORT;
+      goto _exit;
+    }
+  }
+
+  for (int32_t i = 0; !all && i < numOfRows; ++i) {
+    STUidTagInfo* pInfo = taosArrayGet(pUidTagList, i);
+    int32_t*      pRow = taosHashGet(pStore->pUidIdx, &pInfo->uid, sizeof(pInfo->uid));
+    if (pRow == NULL) {
+      code = TSDB_CODE_OPS_NOT_SUPPORT;
+      goto _exit;
+    }
+    aRow[i] = *pRow;
+  }
+
+  code = blockDataEnsureCapacity(pBlock, numOfRows);
+  if (code) goto _exit;
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pDst = taosArrayGet(pBlock->pDataBlock, i);
+    SColumnInfoData* pSrc = taosArrayGet(pStore->pBlock->pDataBlock, aSrcCol[i]);
+
+    if (all) {
+      SColumnInfo info = pDst->info;
+      code = colDataAssign(pDst, pSrc, numOfRows, &pBlock->info);
+      pDst->info = info;
+    } else {
+      for (int32_t j = 0; j < numOfRows && code == 0; ++j) {
+        bool isNull = colDataIsNull_s(pSrc, aRow[j]);
+        code = colDataSetVal(pDst, j, isNull ? NULL : colDataGetData(pSrc, aRow[j]), isNull);
+      }
+    }
+    if (code) goto _exit;
+  }
+
+  if (all) {
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      STUidTagInfo info = {.uid = *(tb_uid_t*)taosArrayGet(pStore->aUid, i)};
+      if (taosArrayPush(pUidTagList, &info) == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+    }
+  }
+  pBlock->info.rows = numOfRows;
+
+_exit:
+  if (code && all) taosArrayClear(pUidTagList);
+  taosMemoryFree(aSrcCol);
+  taosMemoryFree(aRow);
+  return code;
+}
+
+// Fill the columns of pBlock, tags and tbname (colId -1), from the column store of the super table. The tables are
+// the ones in pUidTagList, or all child tables appended to the empty pUidTagList. It fails when the store is disabled
+// or does not hold one of the tables or columns, and the caller goes on with the tag blobs.
+int32_t metaGetTableTagCols(void* pVnode, uint64_t suid, SArray* pUidTagList, SSDataBlock* pBlock) {
+  SMeta*     pMeta = ((SVnode*)pVnode)->pMeta;
+  SLRUCache* pCache = pMeta->pCache->sTagColCache.pStore;
+  int32_t    code = 0;
+  bool       withName = false;
+
+  if (!tsTagColumnStore) {
+    return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pBlock->pDataBlock); ++i) {
+    SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, i);
+    if (pCol->info.colId == -1) withName = true;
+  }
+
+  // the columns of a store are fixed once it is loaded, only its rows change
+  LRUHandle* pHandle = taosLRUCacheLookup(pCache, &suid, sizeof(suid));
+  if (pHandle != NULL && withName) {
+    STagColStore*    pStore = taosLRUCacheValue(pCache, pHandle);
+    SColumnInfoData* pLast = taosArrayGetLast(pStore->pBlock->pDataBlock);
+    if (pLast->info.colId != -1) {
+      taosLRUCacheRelease(pCache, pHandle, false);
+      pHandle = NULL;
+    }
+  }
+
+  STagColStore* pUncached = NULL;
+  if (pHandle == NULL) {
+    code = tagColStoreLoad(pMeta, suid, withName, &pHandle, &pUncached);
+    if (code) {
+      metaDebug("vgId:%d, suid:%" PRIu64 " tags are not served by the column store since %s", TD_VID(pMeta->pVnode),
+                suid, tstrerror(code));
+      return code;
+    }
+  }
+
+  if (pUncached != NULL) {
+    code = tagColStoreGetTags(pUncached, pUidTagList, pBlock);
+    tagColStoreDestroy(pUncached);
+    return code;
+  }
+
+  // the handle keeps the store alive even if it is evicted or dropped meanwhile
+  STagColStore* pStore = taosLRUCacheValue(pCache, pHandle);
+  taosThreadRwlockRdlock(&pStore->lock);
+  code = tagColStoreGetTags(pStore, pUidTagList, pBlock);
+  taosThreadRwlockUnlock(&pStore->lock);
+
+  taosLRUCacheRelease(pCache, pHandle, false);
+  return code;
+}
+
+// apply a created, retagged (pTag is the new tags) or dropped (pTag is NULL) child table to the column store
+int32_t metaTagColStoreTableChanged(SMeta* pMeta, uint64_t suid, tb_uid_t uid, const char* name, const STag* pTag) {
+  SLRUCache* pCache = pMeta->pCache->sTagColCache.pStore;
+  int32_t    code = 0;
+
+  LRUHandle* pHandle = taosLRUCacheLookup(pCache, &suid, sizeof(suid));
+  if (pHandle == NULL) {
+    return code;
+  }
+
+  STagColStore* pStore = taosLRUCacheValue(pCache, pHandle);
+  taosThreadRwlockWrlock(&pStore->lock);
+  int32_t* pRow = taosHashGet(pStore->pUidIdx, &uid, sizeof(uid));
+  if (pTag == NULL) {
+    if (pRow) tagColStoreDropRow(pStore, *pRow);
+  } else if (pRow) {
+    code = tagColStoreSetRow(pStore, *pRow, name, pTag);
+    pStore->nStale++;
+  } else {
+    code = tagColStoreAppend(pStore, uid, name, pTag);
+  }
+
+  // reload the store on the next use once it is in doubt, or more than half of it is left behind
+  bool reload = (code != 0) || pStore->nStale > TMAX(1024, pStore->pBlock->info.rows / 2);
+  taosThreadRwlockUnlock(&pStore->lock);
+
+  if (reload) {
+    taosLRUCacheErase(pCache, &suid, sizeof(suid));
+  }
+  taosLRUCacheRelease(pCache, pHandle, false);
+  return code;
+}
+
+// remove the column store of the super table, whose tag schema is changed or which is dropped
+int32_t metaTagColStoreClear(SMeta* pMeta, uint64_t suid) {
+  taosLRUCacheErase(pMeta->pCache->sTagColCache.pStore, &suid, sizeof(suid));
+  return TSDB_CODE_SUCCESS;
+}
+
+void metaGetTagColStoreStats(SMeta* pMeta, int64_t* loads) {
+  *loads = atomic_load_64(&pMeta->pCache->sTagColCache.loads);
+}
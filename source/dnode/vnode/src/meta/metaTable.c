@@ -26,6 +26,7 @@ static int  metaSaveToSkmDb(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateCtbIdx(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateSuidIdx(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry);
+static int  metaHandleEntries(SMeta *pMeta, SArray *aEntryP);
 static int  metaDropTableByUid(SMeta *pMeta, tb_uid_t uid, int *type);
 static void metaDestroyTagIdxKey(STagIdxKey *pTagIdxKey);
 // opt ins_tables query
@@ -390,6 +391,10 @@ int metaAlterSTable(SMeta *pMeta, int64_t version, SVCreateStbReq *pReq) {
 
   // metaStatsCacheDrop(pMeta, nStbEntry.uid);
 
+  if (oStbEntry.stbEntry.schemaTag.version != pReq->schemaTag.version) {
+    metaTagColStoreClear(pMeta, pReq->suid);
+  }
+
   metaULock(pMeta);
 
   if (oStbEntry.pBuf) taosMemoryFree(oStbEntry.pBuf);
@@ -695,21 +700,18 @@ _err:
   return -1;
 }
 
-int metaCreateTable(SMeta *pMeta, int64_t ver, SVCreateTbReq *pReq, STableMetaRsp **pMetaRsp) {
-  SMetaEntry  me = {0};
+static int32_t metaCheckCreateTbReq(SMeta *pMeta, SVCreateTbReq *pReq) {
   SMetaReader mr = {0};
 
   // validate message
   if (pReq->type != TSDB_CHILD_TABLE && pReq->type != TSDB_NORMAL_TABLE) {
-    terrno = TSDB_CODE_INVALID_MSG;
-    goto _err;
+    return TSDB_CODE_INVALID_MSG;
   }
 
   if (pReq->type == TSDB_CHILD_TABLE) {
     tb_uid_t suid = metaGetTableEntryUidByName(pMeta, pReq->ctb.stbName);
     if (suid != pReq->ctb.suid) {
-      terrno = TSDB_CODE_PAR_TABLE_NOT_EXIST;
-      return -1;
+      return TSDB_CODE_PAR_TABLE_NOT_EXIST;
     }
   }
 
@@ -717,34 +719,35 @@ int metaCreateTable(SMeta *pMeta, int64_t ver, SVCreateTbReq *pReq, STableMetaRs
   metaReaderDoInit(&mr, pMeta, 0);
   if (metaGetTableEntryByName(&mr, pReq->name) == 0) {
     if (pReq->type == TSDB_CHILD_TABLE && pReq->ctb.suid != mr.me.ctbEntry.suid) {
-      terrno = TSDB_CODE_TDB_TABLE_IN_OTHER_STABLE;
       metaReaderClear(&mr);
-      return -1;
+      return TSDB_CODE_TDB_TABLE_IN_OTHER_STABLE;
     }
     pReq->uid = mr.me.uid;
     if (pReq->type == TSDB_CHILD_TABLE) {
       pReq->ctb.suid = mr.me.ctbEntry.suid;
     }
-    terrno = TSDB_CODE_TDB_TABLE_ALREADY_EXIST;
     metaReaderClear(&mr);
-    return -1;
+    return TSDB_CODE_TDB_TABLE_ALREADY_EXIST;
   } else if (terrno == TSDB_CODE_PAR_TABLE_NOT_EXIST) {
     terrno = TSDB_CODE_SUCCESS;
   }
   metaReaderClear(&mr);
 
-  // build SMetaEntry
-  me.version = ver;
-  me.type = pReq->type;
-  me.uid = pReq->uid;
-  me.name = pReq->name;
-  if (me.type == TSDB_CHILD_TABLE) {
-    me.ctbEntry.btime = pReq->btime;
-    me.ctbEntry.ttlDays = pReq->ttl;
-    me.ctbEntry.commentLen = pReq->commentLen;
-    me.ctbEntry.comment = pReq->comment;
-    me.ctbEntry.suid = pReq->ctb.suid;
-    me.ctbEntry.pTags = pReq->ctb.pTag;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void metaBuildCreateTbEntry(int64_t ver, SVCreateTbReq *pReq, SMetaEntry *pME) {
+  pME->version = ver;
+  pME->type = pReq->type;
+  pME->uid = pReq->uid;
+  pME->name = pReq->name;
+  if (pME->type == TSDB_CHILD_TABLE) {
+    pME->ctbEntry.btime = pReq->btime;
+    pME->ctbEntry.ttlDays = pReq->ttl;
+    pME->ctbEntry.commentLen = pReq->commentLen;
+    pME->ctbEntry.comment = pReq->comment;
+    pME->ctbEntry.suid = pReq->ctb.suid;
+    pME->ctbEntry.pTags = pReq->ctb.pTag;
 
 #ifdef TAG_FILTER_DEBUG
     SArray *pTagVals = NULL;
@@ -766,51 +769,139 @@ int metaCreateTable(SMeta *pMeta, int64_t ver, SVCreateTbReq *pReq, STableMetaRs
       }
     }
 #endif
+  } else {
+    pME->ntbEntry.btime = pReq->btime;
+    pME->ntbEntry.ttlDays = pReq->ttl;
+    pME->ntbEntry.commentLen = pReq->commentLen;
+    pME->ntbEntry.comment = pReq->comment;
+    pME->ntbEntry.schemaRow = pReq->ntb.schemaRow;
+    pME->ntbEntry.ncid = pME->ntbEntry.schemaRow.pSchema[pME->ntbEntry.schemaRow.nCols - 1].colId + 1;
+  }
+}
 
-    ++pMeta->pVnode->config.vndStats.numOfCTables;
+int metaCreateTable(SMeta *pMeta, int64_t ver, SVCreateTbReq *pReq, STableMetaRsp **pMetaRsp) {
+  SVCreateTbRsp rsp = {0};
 
-    metaWLock(pMeta);
-    metaUpdateStbStats(pMeta, me.ctbEntry.suid, 1);
-    metaUidCacheClear(pMeta, me.ctbEntry.suid);
-    metaTbGroupCacheClear(pMeta, me.ctbEntry.suid);
-    metaULock(pMeta);
+  metaCreateTables(pMeta, ver, &pReq, 1, &rsp);
+  if (pMetaRsp) {
+    *pMetaRsp = rsp.pMeta;
   } else {
-    me.ntbEntry.btime = pReq->btime;
-    me.ntbEntry.ttlDays = pReq->ttl;
-    me.ntbEntry.commentLen = pReq->commentLen;
-    me.ntbEntry.comment = pReq->comment;
-    me.ntbEntry.schemaRow = pReq->ntb.schemaRow;
-    me.ntbEntry.ncid = me.ntbEntry.schemaRow.pSchema[me.ntbEntry.schemaRow.nCols - 1].colId + 1;
+    tFreeSVCreateTbRsp(&rsp);
+  }
 
-    ++pMeta->pVnode->config.vndStats.numOfNTables;
-    pMeta->pVnode->config.vndStats.numOfNTimeSeries += me.ntbEntry.schemaRow.nCols - 1;
+  if (rsp.code) {
+    terrno = rsp.code;
+    return -1;
   }
+  return 0;
+}
 
-  if (metaHandleEntry(pMeta, &me) < 0) goto _err;
+int metaCreateTables(SMeta *pMeta, int64_t ver, SVCreateTbReq **ppReq, int32_t nReq, SVCreateTbRsp *aRsp) {
+  int32_t     code = 0;
+  SMetaEntry *aEntry = NULL;
+  SArray     *aEntryP = NULL;
+  SHashObj   *pNames = NULL;
 
-  if (pMetaRsp) {
-    *pMetaRsp = taosMemoryCalloc(1, sizeof(STableMetaRsp));
-
-    if (*pMetaRsp) {
-      if (me.type == TSDB_CHILD_TABLE) {
-        (*pMetaRsp)->tableType = TSDB_CHILD_TABLE;
-        (*pMetaRsp)->tuid = pReq->uid;
-        (*pMetaRsp)->suid = pReq->ctb.suid;
-        strcpy((*pMetaRsp)->tbName, pReq->name);
-      } else {
-        metaUpdateMetaRsp(pReq->uid, pReq->name, &pReq->ntb.schemaRow, *pMetaRsp);
+  aEntry = taosMemoryCalloc(nReq, sizeof(SMetaEntry));
+  aEntryP = taosArrayInit(nReq, POINTER_BYTES);
+  if (nReq > 1) {
+    pNames = taosHashInit(nReq, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  }
+  if (aEntry == NULL || aEntryP == NULL || (nReq > 1 && pNames == NULL)) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  // check requests, a name repeated in the batch is an existing table for all but the first request
+  for (int32_t iReq = 0; iReq < nReq; iReq++) {
+    SVCreateTbReq *pReq = ppReq[iReq];
+
+    aRsp[iReq].code = metaCheckCreateTbReq(pMeta, pReq);
+    if (aRsp[iReq].code == TSDB_CODE_SUCCESS && pNames) {
+      SVCreateTbReq **ppFirst = taosHashGet(pNames, pReq->name, strlen(pReq->name));
+      if (ppFirst) {
+        if (pReq->type == TSDB_CHILD_TABLE && ((*ppFirst)->type != TSDB_CHILD_TABLE ||
+                                               (*ppFirst)->ctb.suid != pReq->ctb.suid)) {
+          aRsp[iReq].code = TSDB_CODE_TDB_TABLE_IN_OTHER_STABLE;
+        } else {
+          pReq->uid = (*ppFirst)->uid;
+          aRsp[iReq].code = TSDB_CODE_TDB_TABLE_ALREADY_EXIST;
+        }
+      } else if (taosHashPut(pNames, pReq->name, strlen(pReq->name), &pReq, POINTER_BYTES) != 0) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
       }
     }
+    if (aRsp[iReq].code) continue;
+
+    SMetaEntry *pME = &aEntry[iReq];
+    metaBuildCreateTbEntry(ver, pReq, pME);
+    taosArrayPush(aEntryP, &pME);
   }
 
-  metaDebug("vgId:%d, table:%s uid %" PRId64 " is created, type:%" PRId8, TD_VID(pMeta->pVnode), pReq->name, pReq->uid,
-            pReq->type);
-  return 0;
+  if (taosArrayGetSize(aEntryP) == 0) goto _exit;
 
-_err:
-  metaError("vgId:%d, failed to create table:%s type:%s since %s", TD_VID(pMeta->pVnode), pReq->name,
-            pReq->type == TSDB_CHILD_TABLE ? "child table" : "normal table", tstrerror(terrno));
-  return -1;
+  metaWLock(pMeta);
+  for (int32_t iReq = 0; iReq < nReq; iReq++) {
+    if (aRsp[iReq].code) continue;
+
+    if (aEntry[iReq].type == TSDB_CHILD_TABLE) {
+      ++pMeta->pVnode->config.vndStats.numOfCTables;
+      metaUpdateStbStats(pMeta, aEntry[iReq].ctbEntry.suid, 1);
+      metaTbGroupCacheClear(pMeta, aEntry[iReq].ctbEntry.suid);
+    } else {
+      ++pMeta->pVnode->config.vndStats.numOfNTables;
+      pMeta->pVnode->config.vndStats.numOfNTimeSeries += aEntry[iReq].ntbEntry.schemaRow.nCols - 1;
+    }
+  }
+  metaULock(pMeta);
+
+  if (metaHandleEntries(pMeta, aEntryP) < 0) {
+    code = terrno;
+    goto _exit;
+  }
+
+  for (int32_t iReq = 0; iReq < nReq; iReq++) {
+    SVCreateTbReq *pReq = ppReq[iReq];
+    if (aRsp[iReq].code) continue;
+
+    // recorded once the entry is visible, so the cached tag filter results are patched with its tags
+    if (pReq->type == TSDB_CHILD_TABLE) {
+      metaUidCacheTableChanged(pMeta, pReq->ctb.suid, pReq->uid, false);
+      metaTagColStoreTableChanged(pMeta, pReq->ctb.suid, pReq->uid, pReq->name, (const STag *)pReq->ctb.pTag);
+    }
+
+    aRsp[iReq].pMeta = taosMemoryCalloc(1, sizeof(STableMetaRsp));
+    if (aRsp[iReq].pMeta) {
+      if (pReq->type == TSDB_CHILD_TABLE) {
+        aRsp[iReq].pMeta->tableType = TSDB_CHILD_TABLE;
+        aRsp[iReq].pMeta->tuid = pReq->uid;
+        aRsp[iReq].pMeta->suid = pReq->ctb.suid;
+        strcpy(aRsp[iReq].pMeta->tbName, pReq->name);
+      } else {
+        metaUpdateMetaRsp(pReq->uid, pReq->name, &pReq->ntb.schemaRow, aRsp[iReq].pMeta);
+      }
+    }
+
+    metaDebug("vgId:%d, table:%s uid %" PRId64 " is created, type:%" PRId8, TD_VID(pMeta->pVnode), pReq->name,
+              pReq->uid, pReq->type);
+  }
+
+_exit:
+  for (int32_t iReq = 0; iReq < nReq; iReq++) {
+    SVCreateTbReq *pReq = ppReq[iReq];
+    if (code && aRsp[iReq].code == TSDB_CODE_SUCCESS) {
+      aRsp[iReq].code = code;
+    }
+    if (aRsp[iReq].code && aRsp[iReq].code != TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
+      metaError("vgId:%d, failed to create table:%s type:%s since %s", TD_VID(pMeta->pVnode), pReq->name,
+                pReq->type == TSDB_CHILD_TABLE ? "child table" : "normal table", tstrerror(aRsp[iReq].code));
+    }
+  }
+  taosHashCleanup(pNames);
+  taosArrayDestroy(aEntryP);
+  taosMemoryFree(aEntry);
+  return code ? -1 : 0;
 }
 
 int metaDropTable(SMeta *pMeta, int64_t version, SVDropTbReq *pReq, SArray *tbUids, tb_uid_t *tbUid) {
@@ -1072,8 +1163,9 @@ static int metaDropTableByUid(SMeta *pMeta, tb_uid_t uid, int *type) {
     --pMeta->pVnode->config.vndStats.numOfCTables;
 
     metaUpdateStbStats(pMeta, e.ctbEntry.suid, -1);
-    metaUidCacheClear(pMeta, e.ctbEntry.suid);
+    metaUidCacheTableChanged(pMeta, e.ctbEntry.suid, uid, true);
     metaTbGroupCacheClear(pMeta, e.ctbEntry.suid);
+    metaTagColStoreTableChanged(pMeta, e.ctbEntry.suid, uid, NULL, NULL);
   } else if (e.type == TSDB_NORMAL_TABLE) {
     // drop schema.db (todo)
 
@@ -1086,6 +1178,7 @@ static int metaDropTableByUid(SMeta *pMeta, tb_uid_t uid, int *type) {
     metaStatsCacheDrop(pMeta, uid);
     metaUidCacheClear(pMeta, uid);
     metaTbGroupCacheClear(pMeta, uid);
+    metaTagColStoreClear(pMeta, uid);
     --pMeta->pVnode->config.vndStats.numOfSTables;
   }
 
@@ -1507,8 +1600,9 @@ static int metaUpdateTableTagVal(SMeta *pMeta, int64_t version, SVAlterTbReq *pA
   tdbTbUpsert(pMeta->pCtbIdx, &ctbIdxKey, sizeof(ctbIdxKey), ctbEntry.ctbEntry.pTags,
               ((STag *)(ctbEntry.ctbEntry.pTags))->len, pMeta->txn);
 
-  metaUidCacheClear(pMeta, ctbEntry.ctbEntry.suid);
+  metaUidCacheTableChanged(pMeta, ctbEntry.ctbEntry.suid, uid, false);
   metaTbGroupCacheClear(pMeta, ctbEntry.ctbEntry.suid);
+  metaTagColStoreTableChanged(pMeta, ctbEntry.ctbEntry.suid, uid, ctbEntry.name, (const STag *)ctbEntry.ctbEntry.pTags);
 
   metaUpdateChangeTime(pMeta, ctbEntry.uid, pAlterTbReq->ctimeMs);
 
@@ -2053,50 +2147,68 @@ static void metaDestroyTagIdxKey(STagIdxKey *pTagIdxKey) {
   if (pTagIdxKey) taosMemoryFree(pTagIdxKey);
 }
 
-static int metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry) {
-  void          *pData = NULL;
-  int            nData = 0;
-  STbDbKey       tbDbKey = {0};
-  SMetaEntry     stbEntry = {0};
-  STagIdxKey    *pTagIdxKey = NULL;
-  int32_t        nTagIdxKey;
-  const SSchema *pTagColumn;
-  const void    *pTagData = NULL;
-  int32_t        nTagData = 0;
-  SDecoder       dc = {0};
-  int32_t        ret = 0;
-  // get super table
-  if (tdbTbGet(pMeta->pUidIdx, &pCtbEntry->ctbEntry.suid, sizeof(tb_uid_t), &pData, &nData) != 0) {
+typedef struct {
+  STagIdxKey *pKey;
+  int32_t     nKey;
+} STagIdxKeyInfo;
+
+static int metaTagIdxKeyInfoCmpr(const void *p1, const void *p2) {
+  const STagIdxKeyInfo *pInfo1 = (const STagIdxKeyInfo *)p1;
+  const STagIdxKeyInfo *pInfo2 = (const STagIdxKeyInfo *)p2;
+
+  return tagIdxKeyCmpr(pInfo1->pKey, pInfo1->nKey, pInfo2->pKey, pInfo2->nKey);
+}
+
+static int metaGetSuperTableEntry(SMeta *pMeta, const SMetaEntry *pCtbEntry, void **ppData, SDecoder *pDc,
+                                  SMetaEntry *pStbEntry) {
+  STbDbKey tbDbKey = {0};
+  int      nData = 0;
+
+  if (tdbTbGet(pMeta->pUidIdx, &pCtbEntry->ctbEntry.suid, sizeof(tb_uid_t), ppData, &nData) != 0) {
     metaError("vgId:%d, failed to get stable suid for update. version:%" PRId64, TD_VID(pMeta->pVnode),
               pCtbEntry->version);
     terrno = TSDB_CODE_TDB_INVALID_TABLE_ID;
-    ret = -1;
-    goto end;
+    return -1;
   }
   tbDbKey.uid = pCtbEntry->ctbEntry.suid;
-  tbDbKey.version = ((SUidIdxVal *)pData)[0].version;
-  tdbTbGet(pMeta->pTbDb, &tbDbKey, sizeof(tbDbKey), &pData, &nData);
+  tbDbKey.version = ((SUidIdxVal *)*ppData)[0].version;
+  tdbTbGet(pMeta->pTbDb, &tbDbKey, sizeof(tbDbKey), ppData, &nData);
 
-  tDecoderInit(&dc, pData, nData);
-  ret = metaDecodeEntry(&dc, &stbEntry);
-  if (ret < 0) {
-    goto end;
-  }
+  tDecoderInit(pDc, *ppData, nData);
+  return metaDecodeEntry(pDc, pStbEntry);
+}
 
-  if (stbEntry.stbEntry.schemaTag.pSchema == NULL) {
-    goto end;
+// index the tags of child tables of one super table, the keys of all of them are inserted in the order of tag.idx
+static int metaSaveTagIdx(SMeta *pMeta, const SMetaEntry **ppCtbEntry, int32_t nCtbEntry,
+                          const SMetaEntry *pStbEntry) {
+  const SSchemaWrapper *pTagSchema = &pStbEntry->stbEntry.schemaTag;
+  const SSchema        *pTagColumn;
+  const void           *pTagData = NULL;
+  int32_t               nTagData = 0;
+  SArray               *aKeyInfo = NULL;
+  int32_t               ret = 0;
+
+  if (pTagSchema->pSchema == NULL) {
+    return 0;
   }
 
-  SSchemaWrapper *pTagSchema = &stbEntry.stbEntry.schemaTag;
   if (pTagSchema->nCols == 1 && pTagSchema->pSchema[0].type == TSDB_DATA_TYPE_JSON) {
-    pTagColumn = &stbEntry.stbEntry.schemaTag.pSchema[0];
-    STagVal tagVal = {.cid = pTagColumn->colId};
+    for (int32_t i = 0; i < nCtbEntry; i++) {
+      ret = metaSaveJsonVarToIdx(pMeta, ppCtbEntry[i], &pTagSchema->pSchema[0]);
+      if (ret < 0) return ret;
+    }
+    return 0;
+  }
+
+  aKeyInfo = taosArrayInit(nCtbEntry, sizeof(STagIdxKeyInfo));
+  if (aKeyInfo == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  for (int32_t iEntry = 0; iEntry < nCtbEntry; iEntry++) {
+    const SMetaEntry *pCtbEntry = ppCtbEntry[iEntry];
 
-    pTagData = pCtbEntry->ctbEntry.pTags;
-    nTagData = ((const STag *)pCtbEntry->ctbEntry.pTags)->len;
-    ret = metaSaveJsonVarToIdx(pMeta, pCtbEntry, pTagColumn);
-    goto end;
-  } else {
     for (int i = 0; i < pTagSchema->nCols; i++) {
       pTagColumn = &pTagSchema->pSchema[i];
       if (!IS_IDX_ON(pTagColumn)) continue;
@@ -2112,18 +2224,49 @@ static int metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry) {
       }
 
       if (pTagData != NULL) {
+        STagIdxKeyInfo keyInfo = {0};
         if (metaCreateTagIdxKey(pCtbEntry->ctbEntry.suid, pTagColumn->colId, pTagData, nTagData, pTagColumn->type,
-                                pCtbEntry->uid, &pTagIdxKey, &nTagIdxKey) < 0) {
+                                pCtbEntry->uid, &keyInfo.pKey, &keyInfo.nKey) < 0) {
           ret = -1;
-          goto end;
+          goto _exit;
         }
-        tdbTbUpsert(pMeta->pTagIdx, pTagIdxKey, nTagIdxKey, NULL, 0, pMeta->txn);
+        taosArrayPush(aKeyInfo, &keyInfo);
       }
-      metaDestroyTagIdxKey(pTagIdxKey);
     }
   }
+
+  if (taosArrayGetSize(aKeyInfo) > 1) {
+    taosArraySort(aKeyInfo, metaTagIdxKeyInfoCmpr);
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(aKeyInfo); i++) {
+    STagIdxKeyInfo *pKeyInfo = taosArrayGet(aKeyInfo, i);
+    tdbTbUpsert(pMeta->pTagIdx, pKeyInfo->pKey, pKeyInfo->nKey, NULL, 0, pMeta->txn);
+  }
+
+_exit:
+  for (int32_t i = 0; i < taosArrayGetSize(aKeyInfo); i++) {
+    metaDestroyTagIdxKey(((STagIdxKeyInfo *)taosArrayGet(aKeyInfo, i))->pKey);
+  }
+  taosArrayDestroy(aKeyInfo);
+  return ret;
+}
+
+static int metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry) {
+  void      *pData = NULL;
+  SMetaEntry stbEntry = {0};
+  SDecoder   dc = {0};
+  int32_t    ret = 0;
+
+  // get super table
+  ret = metaGetSuperTableEntry(pMeta, pCtbEntry, &pData, &dc, &stbEntry);
+  if (ret < 0) {
+    goto end;
+  }
+
+  ret = metaSaveTagIdx(pMeta, &pCtbEntry, 1, &stbEntry);
+
 end:
-  // metaDestroyTagIdxKey(pTagIdxKey);
   tDecoderClear(&dc);
   tdbFree(pData);
   return ret;
@@ -2243,6 +2386,133 @@ _err:
   return -1;
 }
 
+static int metaEntryUidCmpr(const void *p1, const void *p2) {
+  const SMetaEntry *pME1 = *(const SMetaEntry **)p1;
+  const SMetaEntry *pME2 = *(const SMetaEntry **)p2;
+
+  if (pME1->uid < pME2->uid) return -1;
+  if (pME1->uid > pME2->uid) return 1;
+  return 0;
+}
+
+static int metaEntryNameCmpr(const void *p1, const void *p2) {
+  const SMetaEntry *pME1 = *(const SMetaEntry **)p1;
+  const SMetaEntry *pME2 = *(const SMetaEntry **)p2;
+
+  return strcmp(pME1->name, pME2->name);
+}
+
+// child tables grouped by super table, after the normal tables
+static int metaEntrySuidCmpr(const void *p1, const void *p2) {
+  const SMetaEntry *pME1 = *(const SMetaEntry **)p1;
+  const SMetaEntry *pME2 = *(const SMetaEntry **)p2;
+  tb_uid_t          suid1 = pME1->type == TSDB_CHILD_TABLE ? pME1->ctbEntry.suid : 0;
+  tb_uid_t          suid2 = pME2->type == TSDB_CHILD_TABLE ? pME2->ctbEntry.suid : 0;
+
+  if (suid1 < suid2) return -1;
+  if (suid1 > suid2) return 1;
+  return metaEntryUidCmpr(p1, p2);
+}
+
+static int metaEntryBtimeCmpr(const void *p1, const void *p2) {
+  const SMetaEntry *pME1 = *(const SMetaEntry **)p1;
+  const SMetaEntry *pME2 = *(const SMetaEntry **)p2;
+  int64_t           btime1 = pME1->type == TSDB_CHILD_TABLE ? pME1->ctbEntry.btime : pME1->ntbEntry.btime;
+  int64_t           btime2 = pME2->type == TSDB_CHILD_TABLE ? pME2->ctbEntry.btime : pME2->ntbEntry.btime;
+
+  if (btime1 < btime2) return -1;
+  if (btime1 > btime2) return 1;
+  return metaEntryUidCmpr(p1, p2);
+}
+
+static int metaSaveCtbEntries(SMeta *pMeta, const SMetaEntry **ppCtbEntry, int32_t nCtbEntry) {
+  int32_t    code = 0;
+  void      *pData = NULL;
+  SMetaEntry stbEntry = {0};
+  SDecoder   dc = {0};
+
+  for (int32_t i = 0; i < nCtbEntry; i++) {
+    code = metaUpdateCtbIdx(pMeta, ppCtbEntry[i]);
+    if (code) return code;
+  }
+
+  // the super table is decoded once for all its child tables
+  code = metaGetSuperTableEntry(pMeta, ppCtbEntry[0], &pData, &dc, &stbEntry);
+  if (code == 0) {
+    code = metaSaveTagIdx(pMeta, ppCtbEntry, nCtbEntry, &stbEntry);
+  }
+
+  tDecoderClear(&dc);
+  tdbFree(pData);
+  return code;
+}
+
+// the child and normal tables of a batch, each index is updated in the order of its keys
+static int metaHandleEntries(SMeta *pMeta, SArray *aEntryP) {
+  int32_t            code = 0;
+  int32_t            line = 0;
+  int32_t            nEntry = taosArrayGetSize(aEntryP);
+  const SMetaEntry **ppEntry = (const SMetaEntry **)TARRAY_DATA(aEntryP);
+
+  metaWLock(pMeta);
+
+  // table.db and uid.idx
+  taosArraySort(aEntryP, metaEntryUidCmpr);
+  for (int32_t i = 0; i < nEntry; i++) {
+    code = metaSaveToTbDb(pMeta, ppEntry[i]);
+    VND_CHECK_CODE(code, line, _err);
+  }
+  for (int32_t i = 0; i < nEntry; i++) {
+    code = metaUpdateUidIdx(pMeta, ppEntry[i]);
+    VND_CHECK_CODE(code, line, _err);
+  }
+
+  // name.idx
+  taosArraySort(aEntryP, metaEntryNameCmpr);
+  for (int32_t i = 0; i < nEntry; i++) {
+    code = metaUpdateNameIdx(pMeta, ppEntry[i]);
+    VND_CHECK_CODE(code, line, _err);
+  }
+
+  // ctb.idx and tag.idx of each super table, schema.db and ncol.idx of normal tables
+  taosArraySort(aEntryP, metaEntrySuidCmpr);
+  for (int32_t i = 0, j; i < nEntry; i = j) {
+    if (ppEntry[i]->type == TSDB_CHILD_TABLE) {
+      for (j = i + 1; j < nEntry && ppEntry[j]->ctbEntry.suid == ppEntry[i]->ctbEntry.suid; j++) {
+      }
+      code = metaSaveCtbEntries(pMeta, ppEntry + i, j - i);
+      VND_CHECK_CODE(code, line, _err);
+    } else {
+      j = i + 1;
+      code = metaSaveToSkmDb(pMeta, ppEntry[i]);
+      VND_CHECK_CODE(code, line, _err);
+
+      code = metaUpdateNcolIdx(pMeta, ppEntry[i]);
+      VND_CHECK_CODE(code, line, _err);
+    }
+  }
+
+  // ctime.idx and ttl
+  taosArraySort(aEntryP, metaEntryBtimeCmpr);
+  for (int32_t i = 0; i < nEntry; i++) {
+    code = metaUpdateBtimeIdx(pMeta, ppEntry[i]);
+    VND_CHECK_CODE(code, line, _err);
+
+    code = metaUpdateTtl(pMeta, ppEntry[i]);
+    VND_CHECK_CODE(code, line, _err);
+  }
+
+  metaULock(pMeta);
+  metaDebug("vgId:%d, handle %d meta entries, ver:%" PRId64, TD_VID(pMeta->pVnode), nEntry, ppEntry[0]->version);
+  return 0;
+
+_err:
+  metaULock(pMeta);
+  metaError("vgId:%d, failed to handle %d meta entries since %s at line:%d, ver:%" PRId64, TD_VID(pMeta->pVnode),
+            nEntry, terrstr(), line, ppEntry[0]->version);
+  return -1;
+}
+
 // refactor later
 void *metaGetIdx(SMeta *pMeta) { return pMeta->pTagIdx; }
 void *metaGetIvtIdx(SMeta *pMeta) { return pMeta->pTagIvtIdx; }
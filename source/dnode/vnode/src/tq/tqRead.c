@@ -277,6 +277,7 @@ void tqReaderClose(STqReader* pReader) {
   if (pReader->pSchemaWrapper) {
     tDeleteSchemaWrapper(pReader->pSchemaWrapper);
   }
+  taosMemoryFreeClear(pReader->pTSchema);
 
   if (pReader->pColIdList) {
     taosArrayDestroy(pReader->pColIdList);
@@ -610,11 +611,53 @@ static int32_t buildResSDataBlock(SSDataBlock* pBlock, SSchemaWrapper* pSchema,
   return TSDB_CODE_SUCCESS;
 }
 
+// the schema is shared by all child tables of one super table, so it is only reloaded when the submit block
+// belongs to another super table/normal table or carries another schema version.
+static int32_t tqReaderUpdateSchema(STqReader* pReader, int64_t suid, int64_t uid, int32_t sversion) {
+  if (pReader->pSchemaWrapper != NULL && pReader->cachedSchemaVer == sversion &&
+      ((suid != 0 && pReader->cachedSchemaSuid == suid) || (suid == 0 && pReader->cachedSchemaUid == uid))) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  tDeleteSchemaWrapper(pReader->pSchemaWrapper);
+  taosMemoryFreeClear(pReader->pTSchema);
+
+  pReader->pSchemaWrapper = metaGetTableSchema(pReader->pVnodeMeta, uid, sversion, 1);
+  if (pReader->pSchemaWrapper == NULL) {
+    tqWarn("vgId:%d, cannot found schema wrapper for table: suid:%" PRId64 ", uid:%" PRId64
+           "version %d, possibly dropped table",
+           pReader->pWalReader->pWal->cfg.vgId, suid, uid, sversion);
+    pReader->cachedSchemaSuid = 0;
+    pReader->cachedSchemaUid = 0;
+    terrno = TSDB_CODE_TQ_TABLE_SCHEMA_NOT_FOUND;
+    return -1;
+  }
+
+  pReader->cachedSchemaUid = uid;
+  pReader->cachedSchemaSuid = suid;
+  pReader->cachedSchemaVer = sversion;
+
+  ASSERT(pReader->cachedSchemaVer == pReader->pSchemaWrapper->version);
+  return TSDB_CODE_SUCCESS;
+}
+
+static STSchema* tqReaderGetTSchema(STqReader* pReader) {
+  if (pReader->pTSchema == NULL) {
+    SSchemaWrapper* pWrapper = pReader->pSchemaWrapper;
+    pReader->pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
+    if (pReader->pTSchema == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  return pReader->pTSchema;
+}
+
 static int32_t doSetVal(SColumnInfoData* pColumnInfoData, int32_t rowIndex, SColVal* pColVal) {
   int32_t code = TSDB_CODE_SUCCESS;
 
   if (IS_STR_DATA_TYPE(pColVal->type)) {
-    char val[65535 + 2] = {0};
+    char val[65535 + 2];
     if (pColVal->value.pData != NULL) {
       memcpy(varDataVal(val), pColVal->value.pData, pColVal->value.nData);
       varDataSetLen(val, pColVal->value.nData);
@@ -629,6 +672,41 @@ static int32_t doSetVal(SColumnInfoData* pColumnInfoData, int32_t rowIndex, SCol
   return code;
 }
 
+// copy one column of the submit msg into the result block. Fixed length values are stored densely in the SColData,
+// a slot for each row, so they are copied at once and only the null rows are marked afterwards.
+static int32_t doSetColData(SColumnInfoData* pColumnInfoData, SColData* pCol) {
+  int32_t numOfRows = pCol->nVal;
+
+  if (!(pCol->flag & HAS_VALUE)) {
+    colDataSetNNULL(pColumnInfoData, 0, numOfRows);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (!IS_VAR_DATA_TYPE(pCol->type) && pColumnInfoData->info.type == pCol->type &&
+      pColumnInfoData->info.bytes == tDataTypes[pCol->type].bytes) {
+    memcpy(pColumnInfoData->pData, pCol->pData, (size_t)numOfRows * pColumnInfoData->info.bytes);
+    if (pCol->flag != HAS_VALUE) {
+      for (int32_t i = 0; i < numOfRows; i++) {
+        if (tColDataGetBitValue(pCol, i) != 2) {
+          colDataSetNULL(pColumnInfoData, i);
+        }
+      }
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColVal colVal;
+  for (int32_t i = 0; i < numOfRows; i++) {
+    tColDataGetValue(pCol, i, &colVal);
+    int32_t code = doSetVal(pColumnInfoData, i, &colVal);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char* id) {
   tqTrace("tq reader retrieve data block %p, index:%d", pReader->msg.msgStr, pReader->nextBlk);
   SSubmitTbData* pSubmitTbData = taosArrayGet(pReader->submit.aSubmitTbData, pReader->nextBlk++);
@@ -647,31 +725,15 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
   pBlock->info.id.uid = uid;
   pBlock->info.version = pReader->msg.ver;
 
-  if ((suid != 0 && pReader->cachedSchemaSuid != suid) || (suid == 0 && pReader->cachedSchemaUid != uid) ||
-      (pReader->cachedSchemaVer != sversion)) {
-    tDeleteSchemaWrapper(pReader->pSchemaWrapper);
-
-    pReader->pSchemaWrapper = metaGetTableSchema(pReader->pVnodeMeta, uid, sversion, 1);
-    if (pReader->pSchemaWrapper == NULL) {
-      tqWarn("vgId:%d, cannot found schema wrapper for table: suid:%" PRId64 ", uid:%" PRId64
-             "version %d, possibly dropped table",
-             vgId, suid, uid, pReader->cachedSchemaVer);
-      pReader->cachedSchemaSuid = 0;
-      terrno = TSDB_CODE_TQ_TABLE_SCHEMA_NOT_FOUND;
-      return -1;
-    }
-
-    pReader->cachedSchemaUid = uid;
-    pReader->cachedSchemaSuid = suid;
-    pReader->cachedSchemaVer = sversion;
+  if (tqReaderUpdateSchema(pReader, suid, uid, sversion) < 0) {
+    return -1;
+  }
 
-    ASSERT(pReader->cachedSchemaVer == pReader->pSchemaWrapper->version);
-    if (blockDataGetNumOfCols(pBlock) == 0) {
-      int32_t code = buildResSDataBlock(pReader->pResBlock, pReader->pSchemaWrapper, pReader->pColIdList);
-      if (code != TSDB_CODE_SUCCESS) {
-        tqError("vgId:%d failed to build data block, code:%s", vgId, tstrerror(code));
-        return code;
-      }
+  if (blockDataGetNumOfCols(pBlock) == 0) {
+    int32_t code = buildResSDataBlock(pReader->pResBlock, pReader->pSchemaWrapper, pReader->pColIdList);
+    if (code != TSDB_CODE_SUCCESS) {
+      tqError("vgId:%d failed to build data block, code:%s", vgId, tstrerror(code));
+      return code;
     }
   }
 
@@ -699,15 +761,16 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
     int32_t targetIdx = 0;
     int32_t sourceIdx = 0;
     while (targetIdx < colActual) {
+      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, targetIdx);
+
+      // a column added after the schema version of the submit block
       if (sourceIdx >= numOfCols) {
-        tqError("tqRetrieveDataBlock sourceIdx:%d >= numOfCols:%d", sourceIdx, numOfCols);
-        return -1;
+        colDataSetNNULL(pColData, 0, numOfRows);
+        targetIdx++;
+        continue;
       }
 
-      SColData*        pCol = taosArrayGet(pCols, sourceIdx);
-      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, targetIdx);
-      SColVal          colVal;
-
+      SColData* pCol = taosArrayGet(pCols, sourceIdx);
       if (pCol->nVal != numOfRows) {
         tqError("tqRetrieveDataBlock pCol->nVal:%d != numOfRows:%d", pCol->nVal, numOfRows);
         return -1;
@@ -716,12 +779,9 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
       if (pCol->cid < pColData->info.colId) {
         sourceIdx++;
       } else if (pCol->cid == pColData->info.colId) {
-        for (int32_t i = 0; i < pCol->nVal; i++) {
-          tColDataGetValue(pCol, i, &colVal);
-          int32_t code = doSetVal(pColData, i, &colVal);
-          if (code != TSDB_CODE_SUCCESS) {
-            return code;
-          }
+        int32_t code = doSetColData(pColData, pCol);
+        if (code != TSDB_CODE_SUCCESS) {
+          return code;
         }
         sourceIdx++;
         targetIdx++;
@@ -731,9 +791,11 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
       }
     }
   } else {
-    SArray*         pRows = pSubmitTbData->aRowP;
-    SSchemaWrapper* pWrapper = pReader->pSchemaWrapper;
-    STSchema*       pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
+    SArray*   pRows = pSubmitTbData->aRowP;
+    STSchema* pTSchema = tqReaderGetTSchema(pReader);
+    if (pTSchema == NULL) {
+      return -1;
+    }
 
     for (int32_t i = 0; i < numOfRows; i++) {
       SRow*   pRow = taosArrayGetP(pRows, i);
@@ -742,6 +804,11 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
       for (int32_t j = 0; j < colActual; j++) {
         SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, j);
         while (1) {
+          if (sourceIdx >= pTSchema->numOfCols) {
+            colDataSetNULL(pColData, i);
+            break;
+          }
+
           SColVal colVal;
           tRowGet(pRow, pTSchema, sourceIdx, &colVal);
           if (colVal.cid < pColData->info.colId) {
@@ -765,8 +832,6 @@ int32_t tqRetrieveDataBlock(STqReader* pReader, SSDataBlock** pRes, const char*
         }
       }
     }
-
-    taosMemoryFreeClear(pTSchema);
   }
 
   return 0;
@@ -788,13 +853,7 @@ int32_t tqRetrieveTaosxBlock(STqReader* pReader, SArray* blocks, SArray* schemas
   int64_t uid = pSubmitTbData->uid;
   pReader->lastBlkUid = uid;
 
-  tDeleteSchemaWrapper(pReader->pSchemaWrapper);
-  pReader->pSchemaWrapper = metaGetTableSchema(pReader->pVnodeMeta, uid, sversion, 1);
-  if (pReader->pSchemaWrapper == NULL) {
-    tqWarn("vgId:%d, cannot found schema wrapper for table: suid:%" PRId64 ", version %d, possibly dropped table",
-           pReader->pWalReader->pWal->cfg.vgId, uid, pReader->cachedSchemaVer);
-    pReader->cachedSchemaSuid = 0;
-    terrno = TSDB_CODE_TQ_TABLE_SCHEMA_NOT_FOUND;
+  if (tqReaderUpdateSchema(pReader, suid, uid, sversion) < 0) {
     return -1;
   }
 
@@ -914,9 +973,11 @@ int32_t tqRetrieveTaosxBlock(STqReader* pReader, SArray* blocks, SArray* schemas
       curRow++;
     }
   } else {
-    SSchemaWrapper* pWrapper = pReader->pSchemaWrapper;
-    STSchema*       pTSchema = tBuildTSchema(pWrapper->pSchema, pWrapper->nCols, pWrapper->version);
-    SArray*         pRows = pSubmitTbData->aRowP;
+    STSchema* pTSchema = tqReaderGetTSchema(pReader);
+    SArray*   pRows = pSubmitTbData->aRowP;
+    if (pTSchema == NULL) {
+      goto FAIL;
+    }
 
     for (int32_t i = 0; i < numOfRows; i++) {
       SRow* pRow = taosArrayGetP(pRows, i);
@@ -1009,8 +1070,6 @@ int32_t tqRetrieveTaosxBlock(STqReader* pReader, SArray* blocks, SArray* schemas
       }
       curRow++;
     }
-
-    taosMemoryFreeClear(pTSchema);
   }
 
   SSDataBlock* pLastBlock = taosArrayGetLast(blocks);
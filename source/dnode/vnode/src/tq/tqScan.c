@@ -64,9 +64,7 @@ static int32_t tqAddTbNameToRsp(const STQ* pTq, int64_t uid, STaosxRsp* pRsp, in
   return 0;
 }
 
-int32_t tqScanData(STQ* pTq, const STqHandle* pHandle, SMqDataRsp* pRsp, STqOffsetVal* pOffset) {
-  const int32_t MAX_ROWS_TO_RETURN = 4096;
-
+int32_t tqScanData(STQ* pTq, const STqHandle* pHandle, SMqDataRsp* pRsp, STqOffsetVal* pOffset, int32_t maxRows) {
   int32_t vgId = TD_VID(pTq->pVnode);
   int32_t code = 0;
   int32_t totalRows = 0;
@@ -106,7 +104,7 @@ int32_t tqScanData(STQ* pTq, const STqHandle* pHandle, SMqDataRsp* pRsp, STqOffs
 
     pRsp->blockNum++;
     totalRows += pDataBlock->info.rows;
-    if (totalRows >= MAX_ROWS_TO_RETURN) {
+    if (totalRows >= maxRows) {
       break;
     }
   }
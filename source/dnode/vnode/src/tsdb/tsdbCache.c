@@ -16,6 +16,7 @@
 #include "tsdbDataFileRW.h"
 #include "tsdbReadUtil.h"
 #include "vnd.h"
+#include "vndCos.h"
 
 #define ROCKS_BATCH_SIZE (4096)
 
@@ -51,6 +52,64 @@ static void tsdbCloseBICache(STsdb *pTsdb) {
   }
 }
 
+// data files migrated to S3 are read in blocks of tsS3BlockSize, each block is kept as a file under the primary dir
+// of the vnode until the blocks outgrow tsS3BlockCacheSize. No file is held open by a cached block, each read of a
+// page opens the file of its block.
+typedef struct {
+  char path[TSDB_FILENAME_LEN];
+} SS3Block;
+
+static void tsdbGetS3CachePath(STsdb *pTsdb, char *path) {
+  SVnode *pVnode = pTsdb->pVnode;
+  vnodeGetPrimaryDir(pTsdb->path, pVnode->diskPrimary, pVnode->pTfs, path, TSDB_FILENAME_LEN);
+
+  int32_t offset = strlen(path);
+  snprintf(path + offset, TSDB_FILENAME_LEN - offset - 1, "%ss3cache", TD_DIRSEP);
+}
+
+static int32_t tsdbOpenS3Cache(STsdb *pTsdb) {
+  int32_t code = 0;
+  char    path[TSDB_FILENAME_LEN];
+
+  if (!tsS3Enabled) goto _err;
+
+  // blocks left by the last run are unknown to the new cache
+  tsdbGetS3CachePath(pTsdb, path);
+  taosRemoveDir(path);
+  if (taosMulMkDir(path) != 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _err;
+  }
+
+  // the cache holds one block at least, otherwise each block would be removed once it is fetched
+  int64_t    capacity = TMAX((int64_t)tsS3BlockCacheSize * 1024 * 1024, (int64_t)tsS3BlockSize * 1024);
+  SLRUCache *pCache = taosLRUCacheInit(capacity, 0, .5);
+  if (pCache == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err;
+  }
+
+  taosLRUCacheSetStrictCapacity(pCache, false);
+
+  taosThreadMutexInit(&pTsdb->s3Mutex, NULL);
+  pTsdb->s3Cache = pCache;
+
+_err:
+  return code;
+}
+
+static void tsdbCloseS3Cache(STsdb *pTsdb) {
+  SLRUCache *pCache = pTsdb->s3Cache;
+  if (pCache) {
+    taosLRUCacheEraseUnrefEntries(pCache);
+
+    taosLRUCacheCleanup(pCache);
+
+    taosThreadMutexDestroy(&pTsdb->s3Mutex);
+    pTsdb->s3Cache = NULL;
+  }
+}
+
 #define ROCKS_KEY_LEN (sizeof(tb_uid_t) + sizeof(int16_t) + sizeof(int8_t))
 
 typedef struct {
@@ -1155,6 +1214,15 @@ int32_t tsdbOpenCache(STsdb *pTsdb) {
     goto _err;
   }
 
+  code = tsdbOpenS3Cache(pTsdb);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbCloseRocksCache(pTsdb);
+    tsdbCloseBICache(pTsdb);
+    taosLRUCacheCleanup(pCache);
+    pCache = NULL;
+    goto _err;
+  }
+
   taosLRUCacheSetStrictCapacity(pCache, false);
 
   taosThreadMutexInit(&pTsdb->lruMutex, NULL);
@@ -1178,6 +1246,7 @@ void tsdbCloseCache(STsdb *pTsdb) {
   }
 
   tsdbCloseBICache(pTsdb);
+  tsdbCloseS3Cache(pTsdb);
   tsdbCloseRocksCache(pTsdb);
 }
 
@@ -2987,3 +3056,190 @@ int32_t tsdbBICacheRelease(SLRUCache *pCache, LRUHandle *h) {
 
   return code;
 }
+
+static int64_t tsdbS3BlockPages(int32_t szPage) { return TMAX((int64_t)tsS3BlockSize * 1024 / szPage, 1); }
+
+static void getS3BlockKey(STsdbFD *pFD, int64_t blk, char *key, int *len) {
+  *len = snprintf(key, TSDB_FILENAME_LEN, "%s.%" PRId64, taosDirEntryBaseName(pFD->path), blk);
+}
+
+static void deleteS3Block(const void *key, size_t keyLen, void *value, void *ud) {
+  (void)ud;
+  SS3Block *pBlock = (SS3Block *)value;
+
+  taosRemoveFile(pBlock->path);
+  taosMemoryFree(pBlock);
+}
+
+static bool tsdbS3BlockCached(STsdbFD *pFD, int64_t blk) {
+  SLRUCache *pCache = pFD->pTsdb->s3Cache;
+  char       key[TSDB_FILENAME_LEN];
+  int        keyLen = 0;
+
+  getS3BlockKey(pFD, blk, key, &keyLen);
+  LRUHandle *h = taosLRUCacheLookup(pCache, key, keyLen);
+  if (h) {
+    taosLRUCacheRelease(pCache, h, false);
+  }
+
+  return h != NULL;
+}
+
+static int32_t tsdbS3CacheInsert(STsdbFD *pFD, int64_t blk, const uint8_t *pData, int64_t size) {
+  int32_t   code = 0;
+  STsdb    *pTsdb = pFD->pTsdb;
+  char      key[TSDB_FILENAME_LEN];
+  int       keyLen = 0;
+  SS3Block *pBlock = NULL;
+
+  pBlock = taosMemoryCalloc(1, sizeof(*pBlock));
+  if (pBlock == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err;
+  }
+
+  getS3BlockKey(pFD, blk, key, &keyLen);
+  tsdbGetS3CachePath(pTsdb, pBlock->path);
+  int32_t offset = strlen(pBlock->path);
+  snprintf(pBlock->path + offset, TSDB_FILENAME_LEN - offset - 1, "%s%s", TD_DIRSEP, key);
+
+  TdFilePtr pFile = taosOpenFile(pBlock->path, TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
+  if (pFile == NULL) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _err;
+  }
+
+  if (taosWriteFile(pFile, pData, size) != size) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    taosCloseFile(&pFile);
+    goto _err;
+  }
+  taosCloseFile(&pFile);
+
+  // a block over the capacity is freed by the cache at once
+  taosLRUCacheInsert(pTsdb->s3Cache, key, keyLen, pBlock, size, deleteS3Block, NULL, TAOS_LRU_PRIORITY_LOW, NULL);
+  return code;
+
+_err:
+  if (pBlock) {
+    deleteS3Block(NULL, 0, pBlock, NULL);
+  }
+  return code;
+}
+
+// fetch the blocks [fBlk, lBlk] of an object by one ranged read, with s3Mutex locked
+static int32_t tsdbS3CacheFetch(STsdbFD *pFD, int64_t fBlk, int64_t lBlk) {
+  int32_t  code = 0;
+  STsdb   *pTsdb = pFD->pTsdb;
+  int64_t  szBlock = tsdbS3BlockPages(pFD->szPage) * pFD->szPage;
+  int64_t  offset = fBlk * szBlock;
+  int64_t  size = TMIN((lBlk + 1) * szBlock, pFD->szFile * pFD->szPage) - offset;
+  uint8_t *pData = NULL;
+
+  code = s3GetObjectBlock(taosDirEntryBaseName(pFD->path), offset, size, &pData);
+  if (code) {
+    tsdbError("vgId:%d, failed to fetch blocks [%" PRId64 ", %" PRId64 "] of %s since %s", TD_VID(pTsdb->pVnode),
+              fBlk, lBlk, pFD->path, tstrerror(code));
+    return code;
+  }
+  atomic_add_fetch_64(&pTsdb->s3FetchBytes, size);
+
+  for (int64_t blk = fBlk; blk <= lBlk; blk++) {
+    int64_t bOffset = (blk - fBlk) * szBlock;
+    code = tsdbS3CacheInsert(pFD, blk, pData + bOffset, TMIN(szBlock, size - bOffset));
+    if (code) break;
+  }
+
+  taosMemoryFree(pData);
+  return code;
+}
+
+int32_t tsdbCacheLoadS3Pages(STsdbFD *pFD, int64_t fPgno, int64_t lPgno) {
+  int32_t code = 0;
+  STsdb  *pTsdb = pFD->pTsdb;
+  int64_t nPage = tsdbS3BlockPages(pFD->szPage);
+  int64_t fBlk = (fPgno - 1) / nPage;
+  int64_t lBlk = (TMIN(lPgno, pFD->szFile) - 1) / nPage;
+  int64_t eBlk = TMIN(lBlk + tsS3ReadAheadBlocks, (pFD->szFile - 1) / nPage);
+
+  for (int64_t blk = fBlk; blk <= lBlk; blk++) {
+    if (tsdbS3BlockCached(pFD, blk)) {
+      atomic_add_fetch_64(&pTsdb->s3CacheHits, 1);
+      continue;
+    }
+
+    taosThreadMutexLock(&pTsdb->s3Mutex);
+
+    if (tsdbS3BlockCached(pFD, blk)) {
+      atomic_add_fetch_64(&pTsdb->s3CacheHits, 1);
+    } else {
+      // a run of missing blocks and the blocks read ahead of the run are fetched together
+      int64_t end = blk;
+      while (end < eBlk && !tsdbS3BlockCached(pFD, end + 1)) {
+        end++;
+      }
+      atomic_add_fetch_64(&pTsdb->s3CacheMisses, TMIN(end, lBlk) - blk + 1);
+
+      code = tsdbS3CacheFetch(pFD, blk, end);
+      blk = end;
+    }
+
+    taosThreadMutexUnlock(&pTsdb->s3Mutex);
+    if (code) break;
+  }
+
+  return code;
+}
+
+int32_t tsdbCacheReadS3Page(STsdbFD *pFD, int64_t pgno, uint8_t *pBuf) {
+  int32_t    code = 0;
+  SLRUCache *pCache = pFD->pTsdb->s3Cache;
+  int64_t    nPage = tsdbS3BlockPages(pFD->szPage);
+  char       key[TSDB_FILENAME_LEN];
+  int        keyLen = 0;
+
+  getS3BlockKey(pFD, (pgno - 1) / nPage, key, &keyLen);
+  LRUHandle *h = taosLRUCacheLookup(pCache, key, keyLen);
+  if (h == NULL) {
+    code = tsdbCacheLoadS3Pages(pFD, pgno, pgno);
+    if (code) return code;
+
+    h = taosLRUCacheLookup(pCache, key, keyLen);
+  }
+
+  if (h == NULL) {
+    // the block did not fit into the cache, the page is read by itself
+    uint8_t *pPage = NULL;
+    code = s3GetObjectBlock(taosDirEntryBaseName(pFD->path), PAGE_OFFSET(pgno, pFD->szPage), pFD->szPage, &pPage);
+    if (code) return code;
+
+    atomic_add_fetch_64(&pFD->pTsdb->s3FetchBytes, pFD->szPage);
+    memcpy(pBuf, pPage, pFD->szPage);
+    taosMemoryFree(pPage);
+    return code;
+  }
+
+  // the handle keeps the file of the block until the page is read
+  SS3Block *pBlock = (SS3Block *)taosLRUCacheValue(pCache, h);
+  TdFilePtr pFile = taosOpenFile(pBlock->path, TD_FILE_READ);
+  if (pFile == NULL) {
+    code = TAOS_SYSTEM_ERROR(errno);
+  } else {
+    int64_t n = taosPReadFile(pFile, pBuf, pFD->szPage, ((pgno - 1) % nPage) * pFD->szPage);
+    if (n < 0) {
+      code = TAOS_SYSTEM_ERROR(errno);
+    } else if (n < pFD->szPage) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+    }
+    taosCloseFile(&pFile);
+  }
+  taosLRUCacheRelease(pCache, h, false);
+
+  return code;
+}
+
+void tsdbGetS3CacheStat(STsdb *pTsdb, int64_t *hits, int64_t *misses, int64_t *fetchBytes) {
+  *hits = atomic_load_64(&pTsdb->s3CacheHits);
+  *misses = atomic_load_64(&pTsdb->s3CacheMisses);
+  *fetchBytes = atomic_load_64(&pTsdb->s3FetchBytes);
+}
@@ -16,6 +16,12 @@
 #include "tsdbCommit2.h"
 
 // extern dependencies
+extern int vnodeScheduleTaskEx(int tpid, int (*execute)(void *), void *arg);
+
+#define TSDB_COMMIT_FSET_POOL 2
+
+typedef TARRAY2(int32_t) TFidArray;
+
 typedef struct {
   STsdb         *tsdb;
   TFileSetArray *fsetArr;
@@ -36,8 +42,6 @@ typedef struct {
   struct {
     int64_t    cid;
     int64_t    now;
-    TSKEY      nextKey;
-    TSKEY      maxDelKey;
     int32_t    fid;
     int32_t    expLevel;
     SDiskID    did;
@@ -59,6 +63,12 @@ typedef struct {
 
   // writer
   SFSetWriter *writer;
+
+  // file sets are committed in parallel, each by a committer forked for it
+  TFidArray         fidArr[1];
+  tsem_t           *done;
+  int32_t           code;
+  STsdbWriteProfile profile[1];
 } SCommitter2;
 
 static int32_t tsdbCommitOpenWriter(SCommitter2 *committer) {
@@ -116,6 +126,7 @@ static int32_t tsdbCommitTSData(SCommitter2 *committer) {
 
   committer->ctx->tbid->suid = 0;
   committer->ctx->tbid->uid = 0;
+  int64_t st = taosGetTimestampUs();
   for (SRowInfo *row; (row = tsdbIterMergerGetData(committer->dataIterMerger)) != NULL;) {
     if (row->uid != committer->ctx->tbid->uid) {
       committer->ctx->tbid->suid = row->suid;
@@ -130,7 +141,6 @@ static int32_t tsdbCommitTSData(SCommitter2 *committer) {
 
     int64_t ts = TSDBROW_TS(&row->row);
     if (ts > committer->ctx->maxKey) {
-      committer->ctx->nextKey = TMIN(committer->ctx->nextKey, ts);
       code = tsdbIterMergerSkipTableData(committer->dataIterMerger, committer->ctx->tbid);
       TSDB_CHECK_CODE(code, lino, _exit);
       continue;
@@ -139,12 +149,19 @@ static int32_t tsdbCommitTSData(SCommitter2 *committer) {
     committer->ctx->hasTSData = true;
     numOfRow++;
 
+    int64_t et = taosGetTimestampUs();
+    committer->profile->iterTime += et - st;
+
     code = tsdbFSetWriteRow(committer->writer, row);
     TSDB_CHECK_CODE(code, lino, _exit);
 
+    st = taosGetTimestampUs();
+    committer->profile->encodeTime += st - et;
+
     code = tsdbIterMergerNext(committer->dataIterMerger);
     TSDB_CHECK_CODE(code, lino, _exit);
   }
+  committer->profile->iterTime += taosGetTimestampUs() - st;
 
 _exit:
   if (code) {
@@ -162,11 +179,6 @@ static int32_t tsdbCommitTombData(SCommitter2 *committer) {
   SMetaInfo info;
 
   if (committer->ctx->fset == NULL && !committer->ctx->hasTSData) {
-    if (committer->ctx->maxKey < committer->ctx->maxDelKey) {
-      committer->ctx->nextKey = committer->ctx->maxKey + 1;
-    } else {
-      committer->ctx->nextKey = TSKEY_MAX;
-    }
     return 0;
   }
 
@@ -184,21 +196,17 @@ static int32_t tsdbCommitTombData(SCommitter2 *committer) {
       }
     }
 
-    if (record->ekey < committer->ctx->minKey) {
+    if (record->ekey < committer->ctx->minKey || record->skey > committer->ctx->maxKey) {
       // do nothing
-    } else if (record->skey > committer->ctx->maxKey) {
-      committer->ctx->nextKey = TMIN(record->skey, committer->ctx->nextKey);
     } else {
-      if (record->ekey > committer->ctx->maxKey) {
-        committer->ctx->nextKey = TMIN(committer->ctx->nextKey, committer->ctx->maxKey + 1);
-      }
-
       record->skey = TMAX(record->skey, committer->ctx->minKey);
       record->ekey = TMIN(record->ekey, committer->ctx->maxKey);
 
       numRecord++;
+      int64_t st = taosGetTimestampUs();
       code = tsdbFSetWriteTombRecord(committer->writer, record);
       TSDB_CHECK_CODE(code, lino, _exit);
+      committer->profile->encodeTime += taosGetTimestampUs() - st;
     }
 
     code = tsdbIterMergerNext(committer->tombIterMerger);
@@ -349,17 +357,19 @@ static int32_t tsdbCommitCloseIter(SCommitter2 *committer) {
   return 0;
 }
 
+// a failure is returned and fails the commit, it used to be logged only
 static int32_t tsdbCommitFileSetBegin(SCommitter2 *committer) {
   int32_t code = 0;
   int32_t lino = 0;
   STsdb  *tsdb = committer->tsdb;
 
-  committer->ctx->fid = tsdbKeyFid(committer->ctx->nextKey, committer->minutes, committer->precision);
   committer->ctx->expLevel = tsdbFidLevel(committer->ctx->fid, &tsdb->keepCfg, committer->ctx->now);
   tsdbFidKeyRange(committer->ctx->fid, committer->minutes, committer->precision, &committer->ctx->minKey,
                   &committer->ctx->maxKey);
-  code = tfsAllocDisk(committer->tsdb->pVnode->pTfs, committer->ctx->expLevel, &committer->ctx->did);
-  TSDB_CHECK_CODE(code, lino, _exit);
+  if (tfsAllocDisk(committer->tsdb->pVnode->pTfs, committer->ctx->expLevel, &committer->ctx->did) < 0) {
+    code = TSDB_CODE_FS_NO_VALID_DISK;
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
   tfsMkdirRecurAt(committer->tsdb->pVnode->pTfs, committer->tsdb->path, committer->ctx->did);
   STFileSet fset = {.fid = committer->ctx->fid};
   committer->ctx->fset = &fset;
@@ -381,9 +391,6 @@ static int32_t tsdbCommitFileSetBegin(SCommitter2 *committer) {
   code = tsdbCommitOpenWriter(committer);
   TSDB_CHECK_CODE(code, lino, _exit);
 
-  // reset nextKey
-  committer->ctx->nextKey = TSKEY_MAX;
-
 _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(tsdb->pVnode), lino, code);
@@ -391,15 +398,17 @@ _exit:
     tsdbDebug("vgId:%d %s done, fid:%d minKey:%" PRId64 " maxKey:%" PRId64 " expLevel:%d", TD_VID(tsdb->pVnode),
               __func__, committer->ctx->fid, committer->ctx->minKey, committer->ctx->maxKey, committer->ctx->expLevel);
   }
-  return 0;
+  return code;
 }
 
 static int32_t tsdbCommitFileSetEnd(SCommitter2 *committer) {
   int32_t code = 0;
   int32_t lino = 0;
 
+  int64_t st = taosGetTimestampUs();
   code = tsdbCommitCloseWriter(committer);
   TSDB_CHECK_CODE(code, lino, _exit);
+  committer->profile->encodeTime += taosGetTimestampUs() - st;
 
   code = tsdbCommitCloseIter(committer);
   TSDB_CHECK_CODE(code, lino, _exit);
@@ -437,6 +446,11 @@ static int32_t tsdbCommitFileSet(SCommitter2 *committer) {
 
 _exit:
   if (code) {
+    if (committer->writer) {
+      tsdbFSetWriterClose(&committer->writer, true, committer->fopArray);
+    }
+    tsdbCommitCloseIter(committer);
+    tsdbCommitCloseReader(committer);
     TSDB_ERROR_LOG(TD_VID(committer->tsdb->pVnode), lino, code);
   } else {
     tsdbDebug("vgId:%d %s done, fid:%d", TD_VID(committer->tsdb->pVnode), __func__, committer->ctx->fid);
@@ -444,6 +458,201 @@ _exit:
   return code;
 }
 
+static int32_t tsdbCommitFileSetTask(void *arg) {
+  SCommitter2       *committer = (SCommitter2 *)arg;
+  STsdbWriteProfile *profile = tsdbBindWriteProfile(committer->profile);
+
+  committer->code = tsdbCommitFileSet(committer);
+
+  // compressions, writes and fsyncs issued by the writer are reported apart from the encoding
+  committer->profile->encodeTime -=
+      committer->profile->cmprTime + committer->profile->writeTime + committer->profile->fsyncTime;
+  committer->profile->encodeTime = TMAX(committer->profile->encodeTime, 0);
+
+  tsdbBindWriteProfile(profile);
+  if (committer->done) {
+    tsem_post(committer->done);
+  }
+  return 0;
+}
+
+static void tsdbForkCommitter(SCommitter2 *committer, int32_t fid, tsem_t *done, SCommitter2 *fsetCommitter) {
+  memset(fsetCommitter, 0, sizeof(fsetCommitter[0]));
+
+  fsetCommitter->tsdb = committer->tsdb;
+  fsetCommitter->fsetArr = committer->fsetArr;
+  fsetCommitter->minutes = committer->minutes;
+  fsetCommitter->precision = committer->precision;
+  fsetCommitter->minRow = committer->minRow;
+  fsetCommitter->maxRow = committer->maxRow;
+  fsetCommitter->cmprAlg = committer->cmprAlg;
+  fsetCommitter->sttTrigger = committer->sttTrigger;
+  fsetCommitter->szPage = committer->szPage;
+  fsetCommitter->compactVersion = committer->compactVersion;
+  fsetCommitter->ctx->cid = committer->ctx->cid;
+  fsetCommitter->ctx->now = committer->ctx->now;
+  fsetCommitter->ctx->fid = fid;
+  fsetCommitter->done = done;
+}
+
+static void tsdbCloseForkedCommitter(SCommitter2 *fsetCommitter) {
+  ASSERT(fsetCommitter->writer == NULL);
+  ASSERT(fsetCommitter->dataIterMerger == NULL);
+  ASSERT(fsetCommitter->tombIterMerger == NULL);
+  TARRAY2_DESTROY(fsetCommitter->dataIterArray, NULL);
+  TARRAY2_DESTROY(fsetCommitter->tombIterArray, NULL);
+  TARRAY2_DESTROY(fsetCommitter->sttReaderArray, NULL);
+  TARRAY2_DESTROY(fsetCommitter->fopArray, NULL);
+}
+
+/*
+ * Each file set is committed by a committer of its own on the file set commit pool, the commit thread takes the
+ * last one. The file operations are collected in fid order once all are done, so the edit stays a single atomic one.
+ */
+static int32_t tsdbCommitFileSets(SCommitter2 *committer) {
+  int32_t      code = 0;
+  int32_t      lino = 0;
+  int32_t      nFSet = TARRAY2_SIZE(committer->fidArr);
+  int32_t      nScheduled = 0;
+  SCommitter2 *fsetCommitters = NULL;
+  tsem_t       done;
+
+  if (nFSet == 0) {
+    return 0;
+  }
+
+  fsetCommitters = taosMemoryCalloc(nFSet, sizeof(SCommitter2));
+  if (fsetCommitters == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  tsem_init(&done, 0, 0);
+  for (int32_t i = 0; i < nFSet; i++) {
+    SCommitter2 *fsetCommitter = &fsetCommitters[i];
+
+    tsdbForkCommitter(committer, TARRAY2_GET(committer->fidArr, i), &done, fsetCommitter);
+    if (i < nFSet - 1 && vnodeScheduleTaskEx(TSDB_COMMIT_FSET_POOL, tsdbCommitFileSetTask, fsetCommitter) == 0) {
+      nScheduled++;
+    } else {
+      fsetCommitter->done = NULL;
+      tsdbCommitFileSetTask(fsetCommitter);
+    }
+  }
+
+  for (int32_t i = 0; i < nScheduled; i++) {
+    tsem_wait(&done);
+  }
+  tsem_destroy(&done);
+
+  for (int32_t i = 0; i < nFSet; i++) {
+    SCommitter2 *fsetCommitter = &fsetCommitters[i];
+
+    committer->profile->iterTime += fsetCommitter->profile->iterTime;
+    committer->profile->encodeTime += fsetCommitter->profile->encodeTime;
+    committer->profile->cmprTime += fsetCommitter->profile->cmprTime;
+    committer->profile->writeTime += fsetCommitter->profile->writeTime;
+    committer->profile->fsyncTime += fsetCommitter->profile->fsyncTime;
+
+    if (code == 0) {
+      code = fsetCommitter->code;
+    }
+    if (code == 0 && TARRAY2_SIZE(fsetCommitter->fopArray) > 0) {
+      code = TARRAY2_APPEND_BATCH(committer->fopArray, TARRAY2_DATA(fsetCommitter->fopArray),
+                                  TARRAY2_SIZE(fsetCommitter->fopArray));
+    }
+  }
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (fsetCommitters) {
+    for (int32_t i = 0; i < nFSet; i++) {
+      tsdbCloseForkedCommitter(&fsetCommitters[i]);
+    }
+    taosMemoryFree(fsetCommitters);
+  }
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(committer->tsdb->pVnode), lino, code);
+  } else {
+    tsdbDebug("vgId:%d %s done, nFSet:%d scheduled:%d", TD_VID(committer->tsdb->pVnode), __func__, nFSet, nScheduled);
+  }
+  return code;
+}
+
+static int32_t tsdbFidCmprFn(const int32_t *fid1, const int32_t *fid2) {
+  if (*fid1 < *fid2) {
+    return -1;
+  } else if (*fid1 > *fid2) {
+    return 1;
+  }
+  return 0;
+}
+
+static int32_t tsdbCommitAddFid(SCommitter2 *committer, int32_t fid) {
+  if (TARRAY2_SEARCH(committer->fidArr, &fid, tsdbFidCmprFn, TD_EQ) != NULL) {
+    return 0;
+  }
+  return TARRAY2_SORT_INSERT(committer->fidArr, fid, tsdbFidCmprFn);
+}
+
+/*
+ * The file sets to commit are the ones the time-series data of the memtable falls in, plus the existing ones the
+ * tomb data of the memtable overlaps. Tables dropped already are skipped, as committing them writes nothing.
+ */
+static int32_t tsdbCommitPlanFileSets(SCommitter2 *committer) {
+  int32_t     code = 0;
+  int32_t     lino = 0;
+  STsdb      *tsdb = committer->tsdb;
+  SMetaInfo   info;
+  TSKEY       minKey;
+  TSKEY       maxKey;
+  STbDataIter tbIter[1];
+
+  SRBTreeIter iter[1] = {tRBTreeIterCreate(tsdb->imem->tbDataTree, 1)};
+  for (SRBTreeNode *node = tRBTreeIterNext(iter); node; node = tRBTreeIterNext(iter)) {
+    STbData *tbData = TCONTAINER_OF(node, STbData, rbtn);
+
+    if (metaGetInfo(tsdb->pVnode->pMeta, tbData->uid, &info, NULL) != 0) {
+      continue;
+    }
+
+    // hop over the rows of the table by seeking past the key range of each file set found
+    TSDBKEY from = {.version = VERSION_MIN, .ts = tbData->minKey};
+    for (;;) {
+      tsdbTbDataIterOpen(tbData, &from, 0, tbIter);
+      TSDBROW *row = tsdbTbDataIterGet(tbIter);
+      if (row == NULL) break;
+
+      int32_t fid = tsdbKeyFid(TSDBROW_TS(row), committer->minutes, committer->precision);
+      code = tsdbCommitAddFid(committer, fid);
+      TSDB_CHECK_CODE(code, lino, _exit);
+
+      tsdbFidKeyRange(fid, committer->minutes, committer->precision, &minKey, &maxKey);
+      if (maxKey >= tbData->maxKey) break;
+      from.ts = maxKey + 1;
+    }
+
+    for (SDelData *delData = tbData->pHead; delData; delData = delData->pNext) {
+      STFileSet *fset;
+      TARRAY2_FOREACH(committer->fsetArr, fset) {
+        tsdbFidKeyRange(fset->fid, committer->minutes, committer->precision, &minKey, &maxKey);
+        if (delData->sKey <= maxKey && delData->eKey >= minKey) {
+          code = tsdbCommitAddFid(committer, fset->fid);
+          TSDB_CHECK_CODE(code, lino, _exit);
+        }
+      }
+    }
+  }
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(tsdb->pVnode), lino, code);
+  } else {
+    tsdbDebug("vgId:%d %s done, nFSet:%d", TD_VID(tsdb->pVnode), __func__, TARRAY2_SIZE(committer->fidArr));
+  }
+  return code;
+}
+
 static int32_t tsdbOpenCommitter(STsdb *tsdb, SCommitInfo *info, SCommitter2 *committer) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -464,35 +673,8 @@ static int32_t tsdbOpenCommitter(STsdb *tsdb, SCommitInfo *info, SCommitter2 *co
   committer->ctx->cid = tsdbFSAllocEid(tsdb->pFS);
   committer->ctx->now = taosGetTimestampSec();
 
-  committer->ctx->nextKey = tsdb->imem->minKey;
-  if (tsdb->imem->nDel > 0) {
-    SRBTreeIter iter[1] = {tRBTreeIterCreate(tsdb->imem->tbDataTree, 1)};
-
-    for (SRBTreeNode *node = tRBTreeIterNext(iter); node; node = tRBTreeIterNext(iter)) {
-      STbData *tbData = TCONTAINER_OF(node, STbData, rbtn);
-
-      for (SDelData *delData = tbData->pHead; delData; delData = delData->pNext) {
-        if (delData->sKey < committer->ctx->nextKey) {
-          committer->ctx->nextKey = delData->sKey;
-        }
-      }
-    }
-  }
-
-  committer->ctx->maxDelKey = TSKEY_MIN;
-  TSKEY minKey = TSKEY_MAX;
-  TSKEY maxKey = TSKEY_MIN;
-  if (TARRAY2_SIZE(committer->fsetArr) > 0) {
-    STFileSet *fset = TARRAY2_LAST(committer->fsetArr);
-    tsdbFidKeyRange(fset->fid, committer->minutes, committer->precision, &minKey, &committer->ctx->maxDelKey);
-
-    fset = TARRAY2_FIRST(committer->fsetArr);
-    tsdbFidKeyRange(fset->fid, committer->minutes, committer->precision, &minKey, &maxKey);
-  }
-
-  if (committer->ctx->nextKey < TMIN(tsdb->imem->minKey, minKey)) {
-    committer->ctx->nextKey = TMIN(tsdb->imem->minKey, minKey);
-  }
+  code = tsdbCommitPlanFileSets(committer);
+  TSDB_CHECK_CODE(code, lino, _exit);
 
 _exit:
   if (code) {
@@ -522,7 +704,7 @@ static int32_t tsdbCloseCommitter(SCommitter2 *committer, int32_t eno) {
   TARRAY2_DESTROY(committer->tombIterArray, NULL);
   TARRAY2_DESTROY(committer->sttReaderArray, NULL);
   TARRAY2_DESTROY(committer->fopArray, NULL);
-  TARRAY2_DESTROY(committer->sttReaderArray, NULL);
+  TARRAY2_DESTROY(committer->fidArr, NULL);
   tsdbFSDestroyCopySnapshot(&committer->fsetArr);
 
 _exit:
@@ -550,9 +732,12 @@ int32_t tsdbCommitBegin(STsdb *tsdb, SCommitInfo *info) {
   int32_t code = 0;
   int32_t lino = 0;
 
-  SMemTable *imem = tsdb->imem;
-  int64_t    nRow = imem->nRow;
-  int64_t    nDel = imem->nDel;
+  SMemTable  *imem = tsdb->imem;
+  int64_t     nRow = imem->nRow;
+  int64_t     nDel = imem->nDel;
+  int32_t     nFSet = 0;
+  int64_t     st = taosGetTimestampUs();
+  SCommitter2 committer[1] = {0};
 
   if (nRow == 0 && nDel == 0) {
     taosThreadRwlockWrlock(&tsdb->rwLock);
@@ -560,15 +745,12 @@ int32_t tsdbCommitBegin(STsdb *tsdb, SCommitInfo *info) {
     taosThreadRwlockUnlock(&tsdb->rwLock);
     tsdbUnrefMemTable(imem, NULL, true);
   } else {
-    SCommitter2 committer[1];
-
     code = tsdbOpenCommitter(tsdb, info, committer);
     TSDB_CHECK_CODE(code, lino, _exit);
 
-    while (committer->ctx->nextKey != TSKEY_MAX) {
-      code = tsdbCommitFileSet(committer);
-      TSDB_CHECK_CODE(code, lino, _exit);
-    }
+    nFSet = TARRAY2_SIZE(committer->fidArr);
+    code = tsdbCommitFileSets(committer);
+    TSDB_CHECK_CODE(code, lino, _exit);
 
     code = tsdbCloseCommitter(committer, code);
     TSDB_CHECK_CODE(code, lino, _exit);
@@ -578,7 +760,13 @@ _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(tsdb->pVnode), lino, code);
   } else {
-    tsdbInfo("vgId:%d %s done, nRow:%" PRId64 " nDel:%" PRId64, TD_VID(tsdb->pVnode), __func__, nRow, nDel);
+    // the phase times are summed over the file sets committed in parallel
+    tsdbInfo("vgId:%d %s done, nRow:%" PRId64 " nDel:%" PRId64 " nFSet:%d elapsed:%.2fms, iterate:%.2fms encode:%.2fms"
+             " compress:%.2fms write:%.2fms fsync:%.2fms",
+             TD_VID(tsdb->pVnode), __func__, nRow, nDel, nFSet,
+             (taosGetTimestampUs() - st) / 1000.0, committer->profile->iterTime / 1000.0,
+             committer->profile->encodeTime / 1000.0, committer->profile->cmprTime / 1000.0,
+             committer->profile->writeTime / 1000.0, committer->profile->fsyncTime / 1000.0);
   }
   return code;
 }
@@ -23,7 +23,7 @@ extern int  vnodeScheduleTaskEx(int tpid, int (*execute)(void *), void *arg);
 extern void remove_file(const char *fname);
 
 #define TSDB_FS_EDIT_MIN TSDB_FEDIT_COMMIT
-#define TSDB_FS_EDIT_MAX (TSDB_FEDIT_MERGE + 1)
+#define TSDB_FS_EDIT_MAX (TSDB_FEDIT_RETENTION + 1)
 
 typedef struct STFileHashEntry {
   struct STFileHashEntry *next;
@@ -311,7 +311,7 @@ static int32_t commit_edit(STFileSystem *fs) {
   current_fname(fs->tsdb, current, TSDB_FCURRENT);
   if (fs->etype == TSDB_FEDIT_COMMIT) {
     current_fname(fs->tsdb, current_t, TSDB_FCURRENT_C);
-  } else if (fs->etype == TSDB_FEDIT_MERGE) {
+  } else if (fs->etype == TSDB_FEDIT_MERGE || fs->etype == TSDB_FEDIT_RETENTION) {
     current_fname(fs->tsdb, current_t, TSDB_FCURRENT_M);
   } else {
     ASSERT(0);
@@ -345,7 +345,7 @@ static int32_t abort_edit(STFileSystem *fs) {
 
   if (fs->etype == TSDB_FEDIT_COMMIT) {
     current_fname(fs->tsdb, fname, TSDB_FCURRENT_C);
-  } else if (fs->etype == TSDB_FEDIT_MERGE) {
+  } else if (fs->etype == TSDB_FEDIT_MERGE || fs->etype == TSDB_FEDIT_RETENTION) {
     current_fname(fs->tsdb, fname, TSDB_FCURRENT_M);
   } else {
     ASSERT(0);
@@ -792,6 +792,22 @@ int64_t tsdbFSAllocEid(STFileSystem *fs) {
   return cid;
 }
 
+static void tsdbFSEditAmpStat(STFileSystem *fs, const TFileOpArray *opArray) {
+  const STFileOp *op;
+
+  fs->editWriteBytes = 0;
+  fs->editReadBytes = 0;
+  TARRAY2_FOREACH_PTR(opArray, op) {
+    if (op->optype == TSDB_FOP_CREATE) {
+      fs->editWriteBytes += op->nf.size;
+    } else if (op->optype == TSDB_FOP_MODIFY) {
+      fs->editWriteBytes += TMAX(op->nf.size - op->of.size, 0);
+    } else if (op->optype == TSDB_FOP_REMOVE) {
+      fs->editReadBytes += op->of.size;
+    }
+  }
+}
+
 int32_t tsdbFSEditBegin(STFileSystem *fs, const TFileOpArray *opArray, EFEditT etype) {
   int32_t code = 0;
   int32_t lino;
@@ -802,6 +818,7 @@ int32_t tsdbFSEditBegin(STFileSystem *fs, const TFileOpArray *opArray, EFEditT e
       current_fname(fs->tsdb, current_t, TSDB_FCURRENT_C);
       break;
     case TSDB_FEDIT_MERGE:
+    case TSDB_FEDIT_RETENTION:
       current_fname(fs->tsdb, current_t, TSDB_FCURRENT_M);
       break;
     default:
@@ -810,6 +827,7 @@ int32_t tsdbFSEditBegin(STFileSystem *fs, const TFileOpArray *opArray, EFEditT e
 
   tsem_wait(&fs->canEdit);
   fs->etype = etype;
+  tsdbFSEditAmpStat(fs, opArray);
 
   // edit
   code = edit_fs(fs, opArray);
@@ -837,6 +855,14 @@ int32_t tsdbFSEditCommit(STFileSystem *fs) {
   code = commit_edit(fs);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  // retention only moves or removes files, its bytes are not compaction i/o and go to migrate_bytes instead
+  if (fs->etype == TSDB_FEDIT_COMMIT) {
+    atomic_add_fetch_64(&fs->ingestBytes, fs->editWriteBytes);
+  } else if (fs->etype == TSDB_FEDIT_MERGE) {
+    atomic_add_fetch_64(&fs->mergeWriteBytes, fs->editWriteBytes);
+    atomic_add_fetch_64(&fs->mergeReadBytes, fs->editReadBytes);
+  }
+
   // schedule merge
   if (fs->tsdb->pVnode->config.sttTrigger != 1) {
     STFileSet *fset;
@@ -869,6 +895,26 @@ int32_t tsdbFSEditAbort(STFileSystem *fs) {
   return code;
 }
 
+void tsdbGetAmpStat(STsdb *pTsdb, int64_t *ingestBytes, int64_t *mergeWriteBytes, int64_t *mergeReadBytes,
+                    int32_t *numOfFSets, int32_t *numOfSttFiles) {
+  STFileSystem *fs = pTsdb->pFS;
+
+  *ingestBytes = atomic_load_64(&fs->ingestBytes);
+  *mergeWriteBytes = atomic_load_64(&fs->mergeWriteBytes);
+  *mergeReadBytes = atomic_load_64(&fs->mergeReadBytes);
+  *numOfFSets = 0;
+  *numOfSttFiles = 0;
+
+  taosThreadRwlockRdlock(&pTsdb->rwLock);
+  STFileSet *fset;
+  TARRAY2_FOREACH(fs->fSetArr, fset) {
+    SSttLvl *lvl;
+    TARRAY2_FOREACH(fset->lvlArr, lvl) { *numOfSttFiles += TARRAY2_SIZE(lvl->fobjArr); }
+    (*numOfFSets)++;
+  }
+  taosThreadRwlockUnlock(&pTsdb->rwLock);
+}
+
 int32_t tsdbFSGetFSet(STFileSystem *fs, int32_t fid, STFileSet **fset) {
   STFileSet   tfset = {.fid = fid};
   STFileSet  *pset = &tfset;
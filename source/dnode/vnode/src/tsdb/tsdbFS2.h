@@ -29,7 +29,8 @@ typedef struct STFSBgTask   STFSBgTask;
 
 typedef enum {
   TSDB_FEDIT_COMMIT = 1,  //
-  TSDB_FEDIT_MERGE
+  TSDB_FEDIT_MERGE,
+  TSDB_FEDIT_RETENTION,
 } EFEditT;
 
 typedef enum {
@@ -96,6 +97,17 @@ struct STFileSystem {
   TFileSetArray fSetArr[1];
   TFileSetArray fSetArrTmp[1];
 
+  // bytes written and read by file edits since open, for write amplification
+  int64_t ingestBytes;
+  int64_t mergeWriteBytes;
+  int64_t mergeReadBytes;
+  int64_t editWriteBytes;  // of the edit in progress
+  int64_t editReadBytes;
+
+  // bytes copied to other tiers or s3 by retentions since open, and the files waiting to be copied
+  int64_t migrateBytes;
+  int32_t migrateQueue;
+
   // background task queue
   TdThreadMutex mutex[1];
   bool          stop;
@@ -27,14 +27,17 @@ typedef struct {
   int64_t compactVersion;
   int64_t cid;
 
+  const STsdbMergePolicy *policy;
+  SMergePolicyConfig      policyConfig;
+
   // context
   struct {
     bool       opened;
     int64_t    now;
     STFileSet *fset;
+    SMergePlan plan[1];
     bool       toData;
     int32_t    level;
-    SSttLvl   *lvl;
     TABLEID    tbid[1];
   } ctx[1];
 
@@ -104,30 +107,16 @@ static int32_t tsdbMergeFileSetBeginOpenReader(SMerger *merger) {
   int32_t code = 0;
   int32_t lino = 0;
 
-  merger->ctx->toData = true;
-  merger->ctx->level = 0;
-
-  // TODO: optimize merge strategy
-  for (int32_t i = 0;; ++i) {
-    if (i >= TARRAY2_SIZE(merger->ctx->fset->lvlArr)) {
-      merger->ctx->lvl = NULL;
-      break;
-    }
+  merger->ctx->toData = merger->ctx->plan->toData;
+  merger->ctx->level = merger->ctx->plan->toLevel;
 
-    merger->ctx->lvl = TARRAY2_GET(merger->ctx->fset->lvlArr, i);
-    if (merger->ctx->lvl->level != merger->ctx->level ||
-        TARRAY2_SIZE(merger->ctx->lvl->fobjArr) + 1 < merger->sttTrigger) {
-      merger->ctx->toData = false;
-      merger->ctx->lvl = NULL;
-      break;
-    }
-
-    merger->ctx->level++;
+  for (int32_t i = 0; i < merger->ctx->plan->nLevel; ++i) {
+    SSttLvl *lvl = TARRAY2_GET(merger->ctx->fset->lvlArr, i);
 
     STFileObj *fobj;
     int32_t    numFile = 0;
-    TARRAY2_FOREACH(merger->ctx->lvl->fobjArr, fobj) {
-      if (numFile == merger->sttTrigger) {
+    TARRAY2_FOREACH(lvl->fobjArr, fobj) {
+      if (numFile == merger->ctx->plan->nFile[i]) {
         break;
       }
 
@@ -384,11 +373,31 @@ _exit:
   if (code) {
     tsdbError("vgId:%d %s failed at line %d since %s", TD_VID(merger->tsdb->pVnode), __func__, lino, tstrerror(code));
   } else {
-    tsdbDebug("vgId:%d %s done, fid:%d", TD_VID(merger->tsdb->pVnode), __func__, fset->fid);
+    tsdbDebug("vgId:%d %s done, fid:%d policy:%s nLevel:%d toLevel:%d toData:%d", TD_VID(merger->tsdb->pVnode),
+              __func__, fset->fid, merger->policy->name, merger->ctx->plan->nLevel, merger->ctx->plan->toLevel,
+              merger->ctx->plan->toData);
   }
   return code;
 }
 
+static void tsdbMergePlanFileSet(SMerger *merger, STFileSet *fset, SMergePlan *plan) {
+  SMergeLevel levels[TSDB_MERGE_MAX_LEVEL];
+  int32_t     nLevel = TMIN(TARRAY2_SIZE(fset->lvlArr), TSDB_MERGE_MAX_LEVEL);
+
+  for (int32_t i = 0; i < nLevel; i++) {
+    SSttLvl *lvl = TARRAY2_GET(fset->lvlArr, i);
+
+    levels[i].level = lvl->level;
+    levels[i].nFile = TARRAY2_SIZE(lvl->fobjArr);
+    levels[i].size = 0;
+
+    STFileObj *fobj;
+    TARRAY2_FOREACH(lvl->fobjArr, fobj) { levels[i].size += fobj->f->size; }
+  }
+
+  merger->policy->pick(&merger->policyConfig, levels, nLevel, plan);
+}
+
 static int32_t tsdbDoMerge(SMerger *merger) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -401,6 +410,9 @@ static int32_t tsdbDoMerge(SMerger *merger) {
 
     if (lvl->level != 0 || TARRAY2_SIZE(lvl->fobjArr) < merger->sttTrigger) continue;
 
+    tsdbMergePlanFileSet(merger, fset, merger->ctx->plan);
+    if (merger->ctx->plan->nLevel == 0) continue;
+
     if (!merger->ctx->opened) {
       code = tsdbMergerOpen(merger);
       TSDB_CHECK_CODE(code, lino, _exit);
@@ -432,6 +444,12 @@ int32_t tsdbMerge(void *arg) {
   SMerger merger[1] = {{
       .tsdb = tsdb,
       .sttTrigger = tsdb->pVnode->config.sttTrigger,
+      .policy = tsdbGetMergePolicy(tsSttMergePolicy),
+      .policyConfig =
+          {
+              .sttTrigger = tsdb->pVnode->config.sttTrigger,
+              .levelBaseSize = (int64_t)tsSttLevelBaseSize * 1024 * 1024,
+          },
   }};
 
   ASSERT(merger->sttTrigger > 1);
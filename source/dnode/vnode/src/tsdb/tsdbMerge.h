@@ -17,6 +17,7 @@
 #include "tsdbFS2.h"
 #include "tsdbFSetRW.h"
 #include "tsdbIter.h"
+#include "tsdbMergePolicy.h"
 #include "tsdbSttFileRW.h"
 #include "tsdbUtil2.h"
 
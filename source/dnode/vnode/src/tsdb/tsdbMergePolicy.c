@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tsdbMergePolicy.h"
+
+/*
+ * Tiered: sttTrigger files of level 0 are merged into one file of level 1. A level that collects sttTrigger - 1 files
+ * is merged along with the one file it is about to get, and so on down the levels. When all the levels are merged,
+ * the data files take the result. Each row is rewritten about once per level.
+ */
+static void tsdbTieredMergePick(const SMergePolicyConfig *config, const SMergeLevel *levels, int32_t nLevel,
+                                SMergePlan *plan) {
+  plan->nLevel = 0;
+  plan->toData = true;
+
+  for (int32_t i = 0; i < nLevel; i++) {
+    if (i >= TSDB_MERGE_MAX_LEVEL || levels[i].level != i || levels[i].nFile + 1 < config->sttTrigger) {
+      plan->toData = false;
+      break;
+    }
+
+    plan->nFile[i] = TMIN(levels[i].nFile, config->sttTrigger);
+    plan->nLevel++;
+  }
+
+  plan->toLevel = plan->nLevel;
+}
+
+static int64_t tsdbLeveledTargetSize(const SMergePolicyConfig *config, int32_t level) {
+  int64_t size = config->levelBaseSize;
+  for (int32_t i = 1; i < level; i++) {
+    size *= config->sttTrigger;
+  }
+  return size;
+}
+
+/*
+ * Leveled: all files of level 0 are merged with all files of level 1 into level 1. While the result is over the
+ * target size of its level, the next level joins the merge. Past the last stt level the data files take the result.
+ * Levels stay at one file each, a read visits fewer files at the price of rewriting level 1 more often.
+ */
+static void tsdbLeveledMergePick(const SMergePolicyConfig *config, const SMergeLevel *levels, int32_t nLevel,
+                                 SMergePlan *plan) {
+  int64_t size = 0;
+
+  plan->nLevel = 0;
+  plan->toData = false;
+  if (nLevel == 0 || levels[0].level != 0) {
+    plan->toLevel = 0;
+    return;
+  }
+
+  size = levels[0].size;
+  plan->nFile[0] = levels[0].nFile;
+  plan->nLevel = 1;
+
+  for (int32_t level = 1;; level++) {
+    if (level < nLevel && level < TSDB_MERGE_MAX_LEVEL && levels[level].level == level) {
+      size += levels[level].size;
+      plan->nFile[level] = levels[level].nFile;
+      plan->nLevel = level + 1;
+    }
+
+    if (size <= tsdbLeveledTargetSize(config, level)) {
+      plan->toLevel = level;
+      break;
+    }
+
+    if (level >= TSDB_MERGE_LEVELED_MAX_LEVEL || plan->nLevel <= level) {
+      // no deeper stt level to carry the result
+      plan->toLevel = plan->nLevel;
+      plan->toData = true;
+      break;
+    }
+  }
+}
+
+static const STsdbMergePolicy tsdbMergePolicies[TSDB_MERGE_POLICY_MAX] = {
+    [TSDB_MERGE_POLICY_TIERED] = {.name = "tiered", .pick = tsdbTieredMergePick},
+    [TSDB_MERGE_POLICY_LEVELED] = {.name = "leveled", .pick = tsdbLeveledMergePick},
+};
+
+const STsdbMergePolicy *tsdbGetMergePolicy(int32_t policy) {
+  if (policy < 0 || policy >= TSDB_MERGE_POLICY_MAX) {
+    policy = TSDB_MERGE_POLICY_TIERED;
+  }
+  return &tsdbMergePolicies[policy];
+}
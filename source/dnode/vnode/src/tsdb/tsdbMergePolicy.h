@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "os.h"
+
+#ifndef _TSDB_MERGE_POLICY_H
+#define _TSDB_MERGE_POLICY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Exposed Handle */
+typedef struct SMergeLevel        SMergeLevel;
+typedef struct SMergePlan         SMergePlan;
+typedef struct SMergePolicyConfig SMergePolicyConfig;
+typedef struct STsdbMergePolicy   STsdbMergePolicy;
+
+typedef enum {
+  TSDB_MERGE_POLICY_TIERED = 0,
+  TSDB_MERGE_POLICY_LEVELED,
+  TSDB_MERGE_POLICY_MAX,
+} tsdb_merge_policy_t;
+
+#define TSDB_MERGE_MAX_LEVEL         32
+#define TSDB_MERGE_LEVELED_MAX_LEVEL 3  // stt levels kept by the leveled policy, the data files are the last level
+
+/* Exposed APIs */
+const STsdbMergePolicy *tsdbGetMergePolicy(int32_t policy);
+
+/* Exposed Structs */
+// a stt level of a file set, as a merge policy sees it
+struct SMergeLevel {
+  int32_t level;
+  int32_t nFile;
+  int64_t size;  // total size of the files of the level
+};
+
+struct SMergePolicyConfig {
+  int32_t sttTrigger;
+  int64_t levelBaseSize;  // target size of stt level 1 with the leveled policy, each level below is sttTrigger times it
+};
+
+// the first nFile[i] files of each of the first nLevel levels are merged into level toLevel, or into the data files
+struct SMergePlan {
+  int32_t nLevel;
+  int32_t nFile[TSDB_MERGE_MAX_LEVEL];
+  int32_t toLevel;
+  bool    toData;
+};
+
+struct STsdbMergePolicy {
+  const char *name;
+  void (*pick)(const SMergePolicyConfig *config, const SMergeLevel *levels, int32_t nLevel, SMergePlan *plan);
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TSDB_MERGE_POLICY_H*/
@@ -56,6 +56,7 @@ void getSttBlockLoadInfo(SSttBlockLoadInfo *pLoadInfo, SSttBlockLoadCostInfo* pL
     pLoadCost->blockElapsedTime += pLoadInfo[i].cost.blockElapsedTime;
     pLoadCost->loadBlocks += pLoadInfo[i].cost.loadBlocks;
     pLoadCost->loadStatisBlocks += pLoadInfo[i].cost.loadStatisBlocks;
+    pLoadCost->skipFiles += pLoadInfo[i].cost.skipFiles;
     pLoadCost->statisElapsedTime += pLoadInfo[i].cost.statisElapsedTime;
   }
 }
@@ -96,6 +97,7 @@ void *destroySttBlockReader(SArray *pLDataIterArray, SSttBlockLoadCostInfo* pLoa
       if (pLoadCost != NULL) {
         pLoadCost->loadBlocks += pIter->pBlockLoadInfo->cost.loadBlocks;
         pLoadCost->loadStatisBlocks += pIter->pBlockLoadInfo->cost.loadStatisBlocks;
+        pLoadCost->skipFiles += pIter->pBlockLoadInfo->cost.skipFiles;
         pLoadCost->blockElapsedTime += pIter->pBlockLoadInfo->cost.blockElapsedTime;
         pLoadCost->statisElapsedTime += pIter->pBlockLoadInfo->cost.statisElapsedTime;
       }
@@ -150,6 +152,11 @@ static SBlockData *loadLastBlock(SLDataIter *pIter, const char *idStr) {
   pInfo->cost.blockElapsedTime += el;
   pInfo->cost.loadBlocks += 1;
 
+  STableScanAnalyzeInfo *pProfile = tsdbGetReadProfile();
+  if (pProfile != NULL) {
+    pProfile->fileRows += pBlock->nRow;
+  }
+
   tsdbDebug("read last block, total load:%"PRId64", trigger by uid:%" PRIu64
             ", last file index:%d, last block index:%d, entry:%d, rows:%d, %p, elapsed time:%.2f ms, %s",
             pInfo->cost.loadBlocks, pIter->uid, pIter->iStt, pIter->iSttBlk, pInfo->currentLoadBlockIndex, pBlock->nRow,
@@ -455,6 +462,21 @@ int32_t tLDataIterOpen2(SLDataIter *pIter, SSttFileReader *pSttFileReader, int32
     }
   }
 
+  // the table has no row in this stt file if its bloom filter says so
+  const SBloomFilter *pFilter = NULL;
+  code = tsdbSttFileReadBloomFilter(pIter->pReader, &pFilter);
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbError("failed to load stt bloom filter, code:%s, %s", tstrerror(code), idStr);
+    return code;
+  }
+
+  if (pFilter != NULL && tBloomFilterNoContain(pFilter, &uid, sizeof(uid)) == TSDB_CODE_SUCCESS) {
+    pBlockLoadInfo->cost.skipFiles += 1;
+    pIter->iSttBlk = -1;
+    pIter->pSttBlk = NULL;
+    return TSDB_CODE_SUCCESS;
+  }
+
 //  bool exists = existsFromSttBlkStatis(pBlockLoadInfo, suid, uid, pIter->pReader);
 //  if (!exists) {
 //    pIter->iSttBlk = -1;
@@ -977,12 +977,26 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
         if (IS_MATHABLE_TYPE(pColData->info.type)) {
           copyNumericCols(pData, pDumpInfo, pColData, dumpedRows, asc);
         } else {  // varchar/nchar type
+          // a value equal to the one of the previous row shares its payload, so that filters and group keys on
+          // repetitive columns (dictionary encoded ones most of the time) can tell them apart by the offset
+          SValue prev = {0};
+          bool   hasPrev = false;
           for (int32_t j = pDumpInfo->rowIndex; rowIndex < dumpedRows; j += step) {
             tColDataGetValue(pData, j, &cv);
+            if (hasPrev && COL_VAL_IS_VALUE(&cv) && cv.value.nData == prev.nData &&
+                (prev.nData == 0 || memcmp(cv.value.pData, prev.pData, prev.nData) == 0)) {
+              colDataReassignVal(pColData, rowIndex, rowIndex - 1, NULL);
+              rowIndex++;
+              continue;
+            }
+
             code = doCopyColVal(pColData, rowIndex++, i, &cv, pSupInfo);
             if (code) {
               return code;
             }
+
+            hasPrev = COL_VAL_IS_VALUE(&cv);
+            prev = cv.value;
           }
         }
       }
@@ -1092,6 +1106,11 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   pReader->cost.blockLoadTime += elapsedTime;
   pDumpInfo->allDumped = false;
 
+  STableScanAnalyzeInfo* pProfile = tsdbGetReadProfile();
+  if (pProfile != NULL) {
+    pProfile->fileRows += pBlockData->nRow;
+  }
+
   return TSDB_CODE_SUCCESS;
 }
 
@@ -1366,6 +1385,11 @@ static int32_t buildDataBlockFromBuf(STsdbReader* pReader, STableBlockScanInfo*
             pBlockScanInfo->uid, pReader->idStr);
 
   pReader->cost.buildmemBlock += elapsedTime;
+
+  STableScanAnalyzeInfo* pProfile = tsdbGetReadProfile();
+  if (pProfile != NULL) {
+    pProfile->memRows += pBlock->info.rows;
+  }
   return code;
 }
 
@@ -4094,13 +4118,13 @@ void tsdbReaderClose2(STsdbReader* pReader) {
       " SMA-time:%.2f ms, fileBlocks:%" PRId64
       ", fileBlocks-load-time:%.2f ms, "
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
-      ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
+      ", stt-statis-Block-time:%.2f ms, stt-skip-files:%" PRId64 ", composed-blocks:%" PRId64
       ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
       "ms, initLastBlockReader:%.2fms, %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
-      pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
-      pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
+      pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->sttCost.skipFiles,
+      pCost->composedBlocks, pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
       pCost->createSkylineIterTime, pCost->initLastBlockReader, pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
@@ -4351,7 +4375,7 @@ static int32_t doTsdbNextDataBlock2(STsdbReader* pReader, bool* hasNext) {
   return code;
 }
 
-int32_t tsdbNextDataBlock2(STsdbReader* pReader, bool* hasNext) {
+static int32_t tsdbNextDataBlockImpl(STsdbReader* pReader, bool* hasNext) {
   int32_t code = TSDB_CODE_SUCCESS;
 
   *hasNext = false;
@@ -4454,6 +4478,15 @@ int32_t tsdbNextDataBlock2(STsdbReader* pReader, bool* hasNext) {
   return code;
 }
 
+// The file reads and decompressions done on behalf of the reader, including its inner readers, are charged to the
+// profile of the query.
+int32_t tsdbNextDataBlock2(STsdbReader* pReader, bool* hasNext) {
+  STableScanAnalyzeInfo* pPrev = tsdbBindReadProfile(pReader->pProfile);
+  int32_t                code = tsdbNextDataBlockImpl(pReader, hasNext);
+  tsdbBindReadProfile(pPrev);
+  return code;
+}
+
 static void doFillNullColSMA(SBlockLoadSuppInfo* pSup, int32_t numOfRows, int32_t numOfCols, SColumnDataAgg* pTsAgg) {
   // do fill all null column value SMA info
   int32_t i = 0, j = 0;
@@ -4501,7 +4534,8 @@ static void doFillNullColSMA(SBlockLoadSuppInfo* pSup, int32_t numOfRows, int32_
   }
 }
 
-int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock, bool* allHave, bool* hasNullSMA) {
+static int32_t tsdbRetrieveDatablockSMAImpl(STsdbReader* pReader, SSDataBlock* pDataBlock, bool* allHave,
+                                            bool* hasNullSMA) {
   SColumnDataAgg*** pBlockSMA = &pDataBlock->pBlockAgg;
 
   int32_t code = 0;
@@ -4589,6 +4623,13 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
   return code;
 }
 
+int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock, bool* allHave, bool* hasNullSMA) {
+  STableScanAnalyzeInfo* pPrev = tsdbBindReadProfile(pReader->pProfile);
+  int32_t                code = tsdbRetrieveDatablockSMAImpl(pReader, pDataBlock, allHave, hasNullSMA);
+  tsdbBindReadProfile(pPrev);
+  return code;
+}
+
 static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
   SReaderStatus*      pStatus = &pReader->status;
   int32_t             code = TSDB_CODE_SUCCESS;
@@ -4620,7 +4661,7 @@ static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
   return pReader->resBlockInfo.pResBlock;
 }
 
-SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
+static SSDataBlock* tsdbRetrieveDataBlockImpl(STsdbReader* pReader, SArray* pIdList) {
   STsdbReader* pTReader = pReader;
   if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
     if (pReader->step == EXTERNAL_ROWS_PREV) {
@@ -4643,6 +4684,13 @@ SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
   return ret;
 }
 
+SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
+  STableScanAnalyzeInfo* pPrev = tsdbBindReadProfile(pReader->pProfile);
+  SSDataBlock*           pBlock = tsdbRetrieveDataBlockImpl(pReader, pIdList);
+  tsdbBindReadProfile(pPrev);
+  return pBlock;
+}
+
 int32_t tsdbReaderReset2(STsdbReader* pReader, SQueryTableDataCond* pCond) {
   int32_t code = TSDB_CODE_SUCCESS;
 
@@ -4725,7 +4773,7 @@ static int32_t getBucketIndex(int32_t startRow, int32_t bucketRange, int32_t num
   return bucketIndex;
 }
 
-int32_t tsdbGetFileBlocksDistInfo2(STsdbReader* pReader, STableBlockDistInfo* pTableBlockInfo) {
+static int32_t tsdbGetFileBlocksDistInfoImpl(STsdbReader* pReader, STableBlockDistInfo* pTableBlockInfo) {
   int32_t code = TSDB_CODE_SUCCESS;
   pTableBlockInfo->totalSize = 0;
   pTableBlockInfo->totalRows = 0;
@@ -4807,6 +4855,14 @@ int32_t tsdbGetFileBlocksDistInfo2(STsdbReader* pReader, STableBlockDistInfo* pT
   return code;
 }
 
+// the block index pages read to count the blocks are charged to the profile of the query
+int32_t tsdbGetFileBlocksDistInfo2(STsdbReader* pReader, STableBlockDistInfo* pTableBlockInfo) {
+  STableScanAnalyzeInfo* pPrev = tsdbBindReadProfile(pReader->pProfile);
+  int32_t                code = tsdbGetFileBlocksDistInfoImpl(pReader, pTableBlockInfo);
+  tsdbBindReadProfile(pPrev);
+  return code;
+}
+
 int64_t tsdbGetNumOfRowsInMemTable2(STsdbReader* pReader) {
   int32_t code = TSDB_CODE_SUCCESS;
   int64_t rows = 0;
@@ -4991,4 +5047,6 @@ void tsdbReaderSetId2(STsdbReader* pReader, const char* idstr) {
   pReader->status.fileIter.pLastBlockReader->mergeTree.idStr = pReader->idStr;
 }
 
+void tsdbReaderSetProfile2(STsdbReader* pReader, STableScanAnalyzeInfo* pProfile) { pReader->pProfile = pProfile; }
+
 void tsdbReaderSetCloseFlag(STsdbReader* pReader) { /*pReader->code = TSDB_CODE_TSC_QUERY_CANCELLED;*/ }
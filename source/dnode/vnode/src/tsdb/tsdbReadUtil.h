@@ -217,6 +217,7 @@ struct STsdbReader {
   SBlockInfoBuf      blockInfoBuf;
   EContentData       step;
   STsdbReader*       innerReader[2];
+  STableScanAnalyzeInfo* pProfile;  // counters of the query, NULL if it is not profiled
 };
 
 typedef struct SBrinRecordIter {
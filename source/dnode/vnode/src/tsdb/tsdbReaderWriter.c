@@ -28,15 +28,20 @@ static int32_t tsdbOpenFileImpl(STsdbFD *pFD) {
     const char *object_name = taosDirEntryBaseName((char *)path);
     long        s3_size = tsS3Enabled ? s3Size(object_name) : 0;
     if (tsS3Enabled && !strncmp(path + strlen(path) - 5, ".data", 5) && s3_size > 0) {
-      s3EvictCache(path, s3_size);
-      s3Get(object_name, path);
-
-      pFD->pFD = taosOpenFile(path, flag);
-
-      if (pFD->pFD == NULL) {
-        code = TAOS_SYSTEM_ERROR(ENOENT);
-        // taosMemoryFree(pFD);
-        goto _exit;
+      if (flag != TD_FILE_READ || pFD->pTsdb == NULL || pFD->pTsdb->s3Cache == NULL) {
+        // a writer appends to the file, so it is downloaded back as a whole
+        s3EvictCache(path, s3_size);
+        s3Get(object_name, path);
+
+        pFD->pFD = taosOpenFile(path, flag);
+        if (pFD->pFD == NULL) {
+          code = TAOS_SYSTEM_ERROR(ENOENT);
+          goto _exit;
+        }
+      } else {
+        // pages are fetched by range into the block cache of the vnode, the object is never downloaded as a whole
+        pFD->s3File = true;
+        pFD->szFile = s3_size / szPage;
       }
     } else {
       code = TAOS_SYSTEM_ERROR(errsv);
@@ -72,7 +77,7 @@ _exit:
 }
 
 // =============== PAGE-WISE FILE ===============
-int32_t tsdbOpenFile(const char *path, int32_t szPage, int32_t flag, STsdbFD **ppFD) {
+int32_t tsdbOpenFile(const char *path, STsdb *pTsdb, int32_t szPage, int32_t flag, STsdbFD **ppFD) {
   int32_t  code = 0;
   STsdbFD *pFD = NULL;
 
@@ -86,6 +91,7 @@ int32_t tsdbOpenFile(const char *path, int32_t szPage, int32_t flag, STsdbFD **p
 
   pFD->path = (char *)&pFD[1];
   strcpy(pFD->path, path);
+  pFD->pTsdb = pTsdb;
   pFD->szPage = szPage;
   pFD->flag = flag;
   pFD->szPage = szPage;
@@ -107,6 +113,16 @@ void tsdbCloseFile(STsdbFD **ppFD) {
   }
 }
 
+static threadlocal STsdbWriteProfile *tsdbWriteProfile = NULL;
+
+STsdbWriteProfile *tsdbBindWriteProfile(STsdbWriteProfile *pProfile) {
+  STsdbWriteProfile *pPrev = tsdbWriteProfile;
+  tsdbWriteProfile = pProfile;
+  return pPrev;
+}
+
+STsdbWriteProfile *tsdbGetWriteProfile() { return tsdbWriteProfile; }
+
 static int32_t tsdbWriteFilePage(STsdbFD *pFD) {
   int32_t code = 0;
 
@@ -126,11 +142,15 @@ static int32_t tsdbWriteFilePage(STsdbFD *pFD) {
 
     taosCalcChecksumAppend(0, pFD->pBuf, pFD->szPage);
 
+    int64_t st = tsdbWriteProfile ? taosGetTimestampUs() : 0;
     n = taosWriteFile(pFD->pFD, pFD->pBuf, pFD->szPage);
     if (n < 0) {
       code = TAOS_SYSTEM_ERROR(errno);
       goto _exit;
     }
+    if (tsdbWriteProfile) {
+      tsdbWriteProfile->writeTime += taosGetTimestampUs() - st;
+    }
 
     if (pFD->szFile < pFD->pgno) {
       pFD->szFile = pFD->pgno;
@@ -142,33 +162,48 @@ _exit:
   return code;
 }
 
+static threadlocal STableScanAnalyzeInfo *tsdbReadProfile = NULL;
+
+STableScanAnalyzeInfo *tsdbBindReadProfile(STableScanAnalyzeInfo *pProfile) {
+  STableScanAnalyzeInfo *pPrev = tsdbReadProfile;
+  tsdbReadProfile = pProfile;
+  return pPrev;
+}
+
+STableScanAnalyzeInfo *tsdbGetReadProfile() { return tsdbReadProfile; }
+
 static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno) {
   int32_t code = 0;
 
   // ASSERT(pgno <= pFD->szFile);
-  if (!pFD->pFD) {
+  if (!pFD->pFD && !pFD->s3File) {
     code = tsdbOpenFileImpl(pFD);
     if (code) {
       goto _exit;
     }
   }
 
-  // seek
-  int64_t offset = PAGE_OFFSET(pgno, pFD->szPage);
-  int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
-  if (n < 0) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _exit;
-  }
+  if (pFD->s3File) {
+    code = tsdbCacheReadS3Page(pFD, pgno, pFD->pBuf);
+    if (code) goto _exit;
+  } else {
+    // seek
+    int64_t offset = PAGE_OFFSET(pgno, pFD->szPage);
+    int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
+    if (n < 0) {
+      code = TAOS_SYSTEM_ERROR(errno);
+      goto _exit;
+    }
 
-  // read
-  n = taosReadFile(pFD->pFD, pFD->pBuf, pFD->szPage);
-  if (n < 0) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    goto _exit;
-  } else if (n < pFD->szPage) {
-    code = TSDB_CODE_FILE_CORRUPTED;
-    goto _exit;
+    // read
+    n = taosReadFile(pFD->pFD, pFD->pBuf, pFD->szPage);
+    if (n < 0) {
+      code = TAOS_SYSTEM_ERROR(errno);
+      goto _exit;
+    } else if (n < pFD->szPage) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
   }
 
   // check
@@ -178,6 +213,9 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno) {
   }
 
   pFD->pgno = pgno;
+  if (tsdbReadProfile != NULL) {
+    tsdbReadProfile->diskReadBytes += pFD->szPage;
+  }
 
 _exit:
   return code;
@@ -226,10 +264,24 @@ int32_t tsdbReadFile(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t size)
   // ASSERT(pgno && pgno <= pFD->szFile);
   ASSERT(bOffset < szPgCont);
 
+  if (!pFD->pFD && !pFD->s3File) {
+    code = tsdbOpenFileImpl(pFD);
+    if (code) goto _exit;
+  }
+
+  if (pFD->s3File && size > 0) {
+    // the blocks of all pages wanted are fetched by as few ranged reads as possible before copying page by page
+    int64_t lPgno = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset + size - 1, pFD->szPage), pFD->szPage);
+    code = tsdbCacheLoadS3Pages(pFD, pgno, lPgno);
+    if (code) goto _exit;
+  }
+
   while (n < size) {
     if (pFD->pgno != pgno) {
       code = tsdbReadFilePage(pFD, pgno);
       if (code) goto _exit;
+    } else if (tsdbReadProfile != NULL) {
+      tsdbReadProfile->cacheReadBytes += TMIN(szPgCont - bOffset, size - n);
     }
 
     int64_t nRead = TMIN(szPgCont - bOffset, size - n);
@@ -250,10 +302,14 @@ int32_t tsdbFsyncFile(STsdbFD *pFD) {
   code = tsdbWriteFilePage(pFD);
   if (code) goto _exit;
 
+  int64_t st = tsdbWriteProfile ? taosGetTimestampUs() : 0;
   if (taosFsyncFile(pFD->pFD) < 0) {
     code = TAOS_SYSTEM_ERROR(errno);
     goto _exit;
   }
+  if (tsdbWriteProfile) {
+    tsdbWriteProfile->fsyncTime += taosGetTimestampUs() - st;
+  }
 
 _exit:
   return code;
@@ -293,7 +349,7 @@ int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pS
   // head
   flag = TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC;
   tsdbHeadFileName(pTsdb, pWriter->wSet.diskId, pWriter->wSet.fid, &pWriter->fHead, fname);
-  code = tsdbOpenFile(fname, szPage, flag, &pWriter->pHeadFD);
+  code = tsdbOpenFile(fname, pTsdb, szPage, flag, &pWriter->pHeadFD);
   if (code) goto _err;
 
   code = tsdbWriteFile(pWriter->pHeadFD, 0, hdr, TSDB_FHDR_SIZE);
@@ -307,7 +363,7 @@ int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pS
     flag = TD_FILE_READ | TD_FILE_WRITE;
   }
   tsdbDataFileName(pTsdb, pWriter->wSet.diskId, pWriter->wSet.fid, &pWriter->fData, fname);
-  code = tsdbOpenFile(fname, szPage, flag, &pWriter->pDataFD);
+  code = tsdbOpenFile(fname, pTsdb, szPage, flag, &pWriter->pDataFD);
   if (code) goto _err;
   if (pWriter->fData.size == 0) {
     code = tsdbWriteFile(pWriter->pDataFD, 0, hdr, TSDB_FHDR_SIZE);
@@ -322,7 +378,7 @@ int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pS
     flag = TD_FILE_READ | TD_FILE_WRITE;
   }
   tsdbSmaFileName(pTsdb, pWriter->wSet.diskId, pWriter->wSet.fid, &pWriter->fSma, fname);
-  code = tsdbOpenFile(fname, szPage, flag, &pWriter->pSmaFD);
+  code = tsdbOpenFile(fname, pTsdb, szPage, flag, &pWriter->pSmaFD);
   if (code) goto _err;
   if (pWriter->fSma.size == 0) {
     code = tsdbWriteFile(pWriter->pSmaFD, 0, hdr, TSDB_FHDR_SIZE);
@@ -335,7 +391,7 @@ int32_t tsdbDataFWriterOpen(SDataFWriter **ppWriter, STsdb *pTsdb, SDFileSet *pS
   ASSERT(pWriter->fStt[pSet->nSttF - 1].size == 0);
   flag = TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC;
   tsdbSttFileName(pTsdb, pWriter->wSet.diskId, pWriter->wSet.fid, &pWriter->fStt[pSet->nSttF - 1], fname);
-  code = tsdbOpenFile(fname, szPage, flag, &pWriter->pSttFD);
+  code = tsdbOpenFile(fname, pTsdb, szPage, flag, &pWriter->pSttFD);
   if (code) goto _err;
   code = tsdbWriteFile(pWriter->pSttFD, 0, hdr, TSDB_FHDR_SIZE);
   if (code) goto _err;
@@ -712,7 +768,7 @@ int32_t tsdbWriteDiskData(SDataFWriter *pWriter, const SDiskData *pDiskData, SBl
     n = 0;
     for (int32_t iDiskCol = 0; iDiskCol < taosArrayGetSize(pDiskData->aDiskCol); iDiskCol++) {
       SDiskCol *pDiskCol = (SDiskCol *)taosArrayGet(pDiskData->aDiskCol, iDiskCol);
-      n += tPutBlockCol(pWriter->aBuf[0] + n, pDiskCol);
+      n += tPutBlockCol(pWriter->aBuf[0] + n, pDiskCol, pDiskData->hdr.fmtVer);
     }
     ASSERT(n == pDiskData->hdr.szBlkCol);
 
@@ -907,23 +963,23 @@ int32_t tsdbDataFReaderOpen(SDataFReader **ppReader, STsdb *pTsdb, SDFileSet *pS
 
   // head
   tsdbHeadFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pHeadF, fname);
-  code = tsdbOpenFile(fname, szPage, TD_FILE_READ, &pReader->pHeadFD);
+  code = tsdbOpenFile(fname, pTsdb, szPage, TD_FILE_READ, &pReader->pHeadFD);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // data
   tsdbDataFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pDataF, fname);
-  code = tsdbOpenFile(fname, szPage, TD_FILE_READ, &pReader->pDataFD);
+  code = tsdbOpenFile(fname, pTsdb, szPage, TD_FILE_READ, &pReader->pDataFD);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // sma
   tsdbSmaFileName(pTsdb, pSet->diskId, pSet->fid, pSet->pSmaF, fname);
-  code = tsdbOpenFile(fname, szPage, TD_FILE_READ, &pReader->pSmaFD);
+  code = tsdbOpenFile(fname, pTsdb, szPage, TD_FILE_READ, &pReader->pSmaFD);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // stt
   for (int32_t iStt = 0; iStt < pSet->nSttF; iStt++) {
     tsdbSttFileName(pTsdb, pSet->diskId, pSet->fid, pSet->aSttF[iStt], fname);
-    code = tsdbOpenFile(fname, szPage, TD_FILE_READ, &pReader->aSttFD[iStt]);
+    code = tsdbOpenFile(fname, pTsdb, szPage, TD_FILE_READ, &pReader->aSttFD[iStt]);
     TSDB_CHECK_CODE(code, lino, _exit);
   }
 
@@ -1181,7 +1237,7 @@ static int32_t tsdbReadBlockDataImpl(SDataFReader *pReader, SBlockInfo *pBlkInfo
 
     while (pBlockCol && pBlockCol->cid < pColData->cid) {
       if (n < hdr.szBlkCol) {
-        n += tGetBlockCol(pReader->aBuf[0] + n, pBlockCol);
+        n += tGetBlockCol(pReader->aBuf[0] + n, pBlockCol, hdr.fmtVer);
       } else {
         ASSERT(n == hdr.szBlkCol);
         pBlockCol = NULL;
@@ -1323,7 +1379,7 @@ int32_t tsdbDelFWriterOpen(SDelFWriter **ppWriter, SDelFile *pFile, STsdb *pTsdb
   pDelFWriter->fDel = *pFile;
 
   tsdbDelFileName(pTsdb, pFile, fname);
-  code = tsdbOpenFile(fname, pTsdb->pVnode->config.tsdbPageSize, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE,
+  code = tsdbOpenFile(fname, pTsdb, pTsdb->pVnode->config.tsdbPageSize, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE,
                       &pDelFWriter->pWriteH);
   TSDB_CHECK_CODE(code, lino, _exit);
 
@@ -1498,7 +1554,7 @@ int32_t tsdbDelFReaderOpen(SDelFReader **ppReader, SDelFile *pFile, STsdb *pTsdb
   pDelFReader->fDel = *pFile;
 
   tsdbDelFileName(pTsdb, pFile, fname);
-  code = tsdbOpenFile(fname, pTsdb->pVnode->config.tsdbPageSize, TD_FILE_READ, &pDelFReader->pReadH);
+  code = tsdbOpenFile(fname, pTsdb, pTsdb->pVnode->config.tsdbPageSize, TD_FILE_READ, &pDelFReader->pReadH);
   if (code) {
     taosMemoryFree(pDelFReader);
     goto _exit;
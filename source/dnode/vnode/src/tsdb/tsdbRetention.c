@@ -17,7 +17,37 @@
 #include "tsdbFS2.h"
 #include "vndCos.h"
 
+// extern dependencies
+extern int vnodeScheduleTaskEx(int tpid, int (*execute)(void *), void *arg);
+
+#define TSDB_RETENTION_POOL       3
+#define TSDB_RETENTION_CHUNK_SIZE (4 << 20)  // bytes copied between two throttle checks
+
+typedef struct SRTNer SRTNer;
+
+// a file set to migrate, edited into the file system on its own once all its files are copied
 typedef struct {
+  int32_t      fid;
+  int32_t      nJob;  // copies not done yet
+  int32_t      code;
+  bool         inEdit;  // in the edit being committed
+  bool         committed;
+  TFileOpArray fopArr[1];
+} SRtnFSet;
+
+// a file to copy to another tier or to s3
+typedef struct {
+  SRTNer          *rtner;
+  SRtnFSet        *rfset;
+  const STFileObj *from;
+  STFile           to;
+  bool             s3;
+} SRtnJob;
+
+typedef TARRAY2(SRtnFSet *) TRtnFSetArray;
+typedef TARRAY2(SRtnJob) TRtnJobArray;
+
+struct SRTNer {
   STsdb  *tsdb;
   int32_t szPage;
   int64_t now;
@@ -25,12 +55,45 @@ typedef struct {
 
   TFileSetArray *fsetArr;
   TFileOpArray   fopArr[1];
+  TRtnFSetArray  rfsetArr[1];
+  TRtnJobArray   jobArr[1];
+  tsem_t         done;  // posted by each copy done on the retention pool
 
   struct {
     int32_t    fsetArrIdx;
     STFileSet *fset;
+    SRtnFSet  *rfset;
   } ctx[1];
-} SRTNer;
+};
+
+// the time in us from which each disk is free for more copies, shared by the retentions of all vnodes
+static int64_t tsdbRtnDiskFreeTime[TFS_MAX_TIERS][TFS_MAX_DISKS_PER_TIER];
+
+static int64_t tsdbRtnReserveDisk(const SDiskID *did, int64_t cost, int64_t now) {
+  int64_t *pFreeTime = &tsdbRtnDiskFreeTime[did->level][did->id];
+  int64_t  freeTime, start;
+
+  do {
+    freeTime = atomic_load_64(pFreeTime);
+    start = TMAX(freeTime, now);
+  } while (atomic_val_compare_exchange_64(pFreeTime, freeTime, start + cost) != freeTime);
+
+  return start;
+}
+
+// wait until nBytes can be read from one disk and written to the other within retentionSpeedLimitMB
+static void tsdbRtnThrottle(const SDiskID *from, const SDiskID *to, int64_t nBytes) {
+  int64_t limit = (int64_t)tsRetentionSpeedLimitMB << 20;
+  if (limit <= 0) return;
+
+  int64_t cost = nBytes * 1000000 / limit;
+  int64_t now = taosGetTimestampUs();
+  int64_t start = TMAX(tsdbRtnReserveDisk(from, cost, now), tsdbRtnReserveDisk(to, cost, now));
+  while (start > now) {
+    taosUsleep((int32_t)TMIN(start - now, 1000000));
+    now = taosGetTimestampUs();
+  }
+}
 
 static int32_t tsdbDoRemoveFileObject(SRTNer *rtner, const STFileObj *fobj) {
   STFileOp op = {
@@ -39,7 +102,7 @@ static int32_t tsdbDoRemoveFileObject(SRTNer *rtner, const STFileObj *fobj) {
       .of = fobj->f[0],
   };
 
-  return TARRAY2_APPEND(rtner->fopArr, op);
+  return TARRAY2_APPEND(rtner->ctx->rfset->fopArr, op);
 }
 
 static int32_t tsdbRemoveFileObjectS3(SRTNer *rtner, const STFileObj *fobj) {
@@ -51,7 +114,7 @@ static int32_t tsdbRemoveFileObjectS3(SRTNer *rtner, const STFileObj *fobj) {
       .of = fobj->f[0],
   };
 
-  code = TARRAY2_APPEND(rtner->fopArr, op);
+  code = TARRAY2_APPEND(rtner->ctx->rfset->fopArr, op);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   const char *object_name = taosDirEntryBaseName((char *)fobj->fname);
@@ -75,17 +138,29 @@ static int32_t tsdbDoCopyFile(SRTNer *rtner, const STFileObj *from, const STFile
   tsdbTFileName(rtner->tsdb, to, fname);
 
   fdFrom = taosOpenFile(from->fname, TD_FILE_READ);
-  if (fdFrom == NULL) code = terrno;
+  if (fdFrom == NULL) code = TAOS_SYSTEM_ERROR(errno);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   fdTo = taosOpenFile(fname, TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
-  if (fdTo == NULL) code = terrno;
+  if (fdTo == NULL) code = TAOS_SYSTEM_ERROR(errno);
   TSDB_CHECK_CODE(code, lino, _exit);
 
-  int64_t n = taosFSendFile(fdTo, fdFrom, 0, tsdbLogicToFileSize(from->f->size, rtner->szPage));
-  if (n < 0) {
-    code = TAOS_SYSTEM_ERROR(errno);
-    TSDB_CHECK_CODE(code, lino, _exit);
+  // copied by chunks, each one waits for its turn on both disks
+  int64_t size = tsdbLogicToFileSize(from->f->size, rtner->szPage);
+  for (int64_t offset = 0; offset < size;) {
+    int64_t nChunk = TMIN(size - offset, TSDB_RETENTION_CHUNK_SIZE);
+
+    tsdbRtnThrottle(&from->f->did, &to->did, nChunk);
+
+    int64_t n = taosFSendFile(fdTo, fdFrom, NULL, nChunk);
+    if (n < 0) {
+      code = TAOS_SYSTEM_ERROR(errno);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+    atomic_add_fetch_64(&rtner->tsdb->pFS->migrateBytes, n);
+
+    if (n < nChunk) break;
+    offset += n;
   }
   taosCloseFile(&fdFrom);
   taosCloseFile(&fdTo);
@@ -110,13 +185,18 @@ static int32_t tsdbCopyFileS3(SRTNer *rtner, const STFileObj *from, const STFile
   tsdbTFileName(rtner->tsdb, to, fname);
 
   fdFrom = taosOpenFile(from->fname, TD_FILE_READ);
-  if (fdFrom == NULL) code = terrno;
+  if (fdFrom == NULL) code = TAOS_SYSTEM_ERROR(errno);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  // the object is put in one request, so the whole file waits for its turn
+  int64_t size = tsdbLogicToFileSize(from->f->size, rtner->szPage);
+  tsdbRtnThrottle(&from->f->did, &to->did, size);
+
   char *object_name = taosDirEntryBaseName(fname);
   code = s3PutObjectFromFile(from->fname, object_name);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  atomic_add_fetch_64(&rtner->tsdb->pFS->migrateBytes, size);
   taosCloseFile(&fdFrom);
 
 _exit:
@@ -127,7 +207,7 @@ _exit:
   return code;
 }
 
-static int32_t tsdbDoMigrateFileObj(SRTNer *rtner, const STFileObj *fobj, const SDiskID *did) {
+static int32_t tsdbDoMigrateFileObj(SRTNer *rtner, const STFileObj *fobj, const SDiskID *did, bool s3) {
   int32_t  code = 0;
   int32_t  lino = 0;
   STFileOp op = {0};
@@ -139,7 +219,7 @@ static int32_t tsdbDoMigrateFileObj(SRTNer *rtner, const STFileObj *fobj, const
       .of = fobj->f[0],
   };
 
-  code = TARRAY2_APPEND(rtner->fopArr, op);
+  code = TARRAY2_APPEND(rtner->ctx->rfset->fopArr, op);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   // create new
@@ -160,59 +240,22 @@ static int32_t tsdbDoMigrateFileObj(SRTNer *rtner, const STFileObj *fobj, const
           },
   };
 
-  code = TARRAY2_APPEND(rtner->fopArr, op);
-  TSDB_CHECK_CODE(code, lino, _exit);
-
-  // do copy the file
-  code = tsdbDoCopyFile(rtner, fobj, &op.nf);
+  code = TARRAY2_APPEND(rtner->ctx->rfset->fopArr, op);
   TSDB_CHECK_CODE(code, lino, _exit);
 
-_exit:
-  if (code) {
-    TSDB_ERROR_LOG(TD_VID(rtner->tsdb->pVnode), lino, code);
-  }
-  return code;
-}
-
-static int32_t tsdbMigrateDataFileS3(SRTNer *rtner, const STFileObj *fobj, const SDiskID *did) {
-  int32_t  code = 0;
-  int32_t  lino = 0;
-  STFileOp op = {0};
-
-  // remove old
-  op = (STFileOp){
-      .optype = TSDB_FOP_REMOVE,
-      .fid = fobj->f->fid,
-      .of = fobj->f[0],
-  };
-
-  code = TARRAY2_APPEND(rtner->fopArr, op);
-  TSDB_CHECK_CODE(code, lino, _exit);
-
-  // create new
-  op = (STFileOp){
-      .optype = TSDB_FOP_CREATE,
-      .fid = fobj->f->fid,
-      .nf =
-          {
-              .type = fobj->f->type,
-              .did = did[0],
-              .fid = fobj->f->fid,
-              .cid = fobj->f->cid,
-              .size = fobj->f->size,
-              .stt[0] =
-                  {
-                      .level = fobj->f->stt[0].level,
-                  },
-          },
+  // the file is copied later on the retention pool
+  SRtnJob job = {
+      .rtner = rtner,
+      .rfset = rtner->ctx->rfset,
+      .from = fobj,
+      .to = op.nf,
+      .s3 = s3,
   };
 
-  code = TARRAY2_APPEND(rtner->fopArr, op);
+  code = TARRAY2_APPEND(rtner->jobArr, job);
   TSDB_CHECK_CODE(code, lino, _exit);
 
-  // do copy the file
-  code = tsdbCopyFileS3(rtner, fobj, &op.nf);
-  TSDB_CHECK_CODE(code, lino, _exit);
+  rtner->ctx->rfset->nJob++;
 
 _exit:
   if (code) {
@@ -237,6 +280,7 @@ static int32_t tsdbDoRetentionBegin(SRtnArg *arg, SRTNer *rtner) {
   rtner->szPage = tsdb->pVnode->config.tsdbPageSize;
   rtner->now = arg->now;
   rtner->cid = tsdbFSAllocEid(tsdb->pFS);
+  tsem_init(&rtner->done, 0, 0);
 
   code = tsdbFSCreateCopySnapshot(tsdb->pFS, &rtner->fsetArr);
   TSDB_CHECK_CODE(code, lino, _exit);
@@ -250,13 +294,62 @@ _exit:
   return code;
 }
 
+static void tsdbRtnFSetDestroy(SRtnFSet **rfset) {
+  TARRAY2_DESTROY(rfset[0]->fopArr, NULL);
+  taosMemoryFreeClear(rfset[0]);
+}
+
 static int32_t tsdbDoRetentionEnd(SRTNer *rtner) {
-  int32_t code = 0;
-  int32_t lino = 0;
+  // the copies of the file sets left out of the file system are not referenced by anything
+  SRtnFSet *rfset;
+  TARRAY2_FOREACH(rtner->rfsetArr, rfset) {
+    if (rfset->committed) continue;
+
+    const STFileOp *op;
+    TARRAY2_FOREACH_PTR(rfset->fopArr, op) {
+      if (op->optype != TSDB_FOP_CREATE) continue;
+
+      char fname[TSDB_FILENAME_LEN];
+      tsdbTFileName(rtner->tsdb, &op->nf, fname);
+      taosRemoveFile(fname);
+    }
+  }
+
+  TARRAY2_DESTROY(rtner->fopArr, NULL);
+  TARRAY2_DESTROY(rtner->rfsetArr, tsdbRtnFSetDestroy);
+  TARRAY2_DESTROY(rtner->jobArr, NULL);
+  tsem_destroy(&rtner->done);
+  tsdbFSDestroyCopySnapshot(&rtner->fsetArr);
+  return 0;
+}
+
+/*
+ * The file sets with all their files copied are edited into the file system together, so the progress of a
+ * migration survives a restart: the next retention finds them on their tier and goes on with the others.
+ */
+static int32_t tsdbRtnCommitDoneFSets(SRTNer *rtner) {
+  int32_t   code = 0;
+  int32_t   lino = 0;
+  int32_t   nFSet = 0;
+  SRtnFSet *rfset;
+
+  TARRAY2_CLEAR(rtner->fopArr, NULL);
+  TARRAY2_FOREACH(rtner->rfsetArr, rfset) {
+    rfset->inEdit = false;
+  }
+  TARRAY2_FOREACH(rtner->rfsetArr, rfset) {
+    if (rfset->committed || rfset->code || atomic_load_32(&rfset->nJob) > 0) continue;
+
+    rfset->inEdit = true;
+    nFSet++;
+
+    code = TARRAY2_APPEND_BATCH(rtner->fopArr, TARRAY2_DATA(rfset->fopArr), TARRAY2_SIZE(rfset->fopArr));
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
 
   if (TARRAY2_SIZE(rtner->fopArr) == 0) goto _exit;
 
-  code = tsdbFSEditBegin(rtner->tsdb->pFS, rtner->fopArr, TSDB_FEDIT_MERGE);
+  code = tsdbFSEditBegin(rtner->tsdb->pFS, rtner->fopArr, TSDB_FEDIT_RETENTION);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   taosThreadRwlockWrlock(&rtner->tsdb->rwLock);
@@ -269,18 +362,115 @@ static int32_t tsdbDoRetentionEnd(SRTNer *rtner) {
 
   taosThreadRwlockUnlock(&rtner->tsdb->rwLock);
 
-  TARRAY2_DESTROY(rtner->fopArr, NULL);
+  TARRAY2_FOREACH(rtner->rfsetArr, rfset) {
+    if (rfset->inEdit) rfset->committed = true;
+  }
 
 _exit:
   if (code) {
+    // the file sets of a failed edit are not tried again, their copies are removed by tsdbDoRetentionEnd()
+    TARRAY2_FOREACH(rtner->rfsetArr, rfset) {
+      if (rfset->inEdit) atomic_val_compare_exchange_32(&rfset->code, 0, code);
+    }
     TSDB_ERROR_LOG(TD_VID(rtner->tsdb->pVnode), lino, code);
+  } else if (nFSet > 0) {
+    tsdbInfo("vid:%d, cid:%" PRId64 ", %s done, nFSet:%d", TD_VID(rtner->tsdb->pVnode), rtner->cid, __func__, nFSet);
+  }
+  return code;
+}
+
+static int32_t tsdbRtnCopyTask(void *arg) {
+  SRtnJob *job = (SRtnJob *)arg;
+  SRTNer  *rtner = job->rtner;
+  int32_t  code;
+
+  if (job->s3) {
+    code = tsdbCopyFileS3(rtner, job->from, &job->to);
   } else {
-    tsdbInfo("vid:%d, cid:%" PRId64 ", %s done", TD_VID(rtner->tsdb->pVnode), rtner->cid, __func__);
+    code = tsdbDoCopyFile(rtner, job->from, &job->to);
+  }
+
+  if (code) {
+    atomic_val_compare_exchange_32(&job->rfset->code, 0, code);
+  }
+  atomic_sub_fetch_32(&job->rfset->nJob, 1);
+  atomic_sub_fetch_32(&rtner->tsdb->pFS->migrateQueue, 1);
+  tsem_post(&rtner->done);
+  return 0;
+}
+
+/*
+ * The copies run on the retention pool, at most retentionParallelism of them at a time. Each time one is done the
+ * file sets with nothing left to copy are committed. Once a copy fails no more are started, the ones running are
+ * waited for and the file sets already copied are still committed.
+ */
+static int32_t tsdbRtnDoCopyJobs(SRTNer *rtner) {
+  int32_t code = 0;
+  int32_t lino = 0;
+  int32_t nJob = TARRAY2_SIZE(rtner->jobArr);
+  int32_t parallelism = TMAX(tsRetentionParallelism, 1);
+  int32_t nRunning = 0;
+  int32_t iJob = 0;
+
+  atomic_add_fetch_32(&rtner->tsdb->pFS->migrateQueue, nJob);
+
+  for (; iJob < nJob || nRunning > 0;) {
+    if (iJob < nJob && nRunning < parallelism) {
+      SRtnJob *job = TARRAY2_GET_PTR(rtner->jobArr, iJob);
+
+      iJob++;
+      nRunning++;
+      if (vnodeScheduleTaskEx(TSDB_RETENTION_POOL, tsdbRtnCopyTask, job) != 0) {
+        tsdbRtnCopyTask(job);
+      }
+      continue;
+    }
+
+    tsem_wait(&rtner->done);
+    nRunning--;
+
+    SRtnFSet *rfset;
+    TARRAY2_FOREACH(rtner->rfsetArr, rfset) {
+      if (code == 0) code = atomic_load_32(&rfset->code);
+    }
+    if (code && iJob < nJob) {
+      atomic_sub_fetch_32(&rtner->tsdb->pFS->migrateQueue, nJob - iJob);
+      nJob = iJob;
+    }
+
+    int32_t ret = tsdbRtnCommitDoneFSets(rtner);
+    if (code == 0) code = ret;
+  }
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  // the file sets with nothing to copy
+  code = tsdbRtnCommitDoneFSets(rtner);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(rtner->tsdb->pVnode), lino, code);
   }
-  tsdbFSDestroyCopySnapshot(&rtner->fsetArr);
   return code;
 }
 
+static int32_t tsdbRtnFSetBegin(SRTNer *rtner) {
+  SRtnFSet *rfset = taosMemoryCalloc(1, sizeof(*rfset));
+  if (rfset == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+
+  rfset->fid = rtner->ctx->fset->fid;
+  TARRAY2_INIT(rfset->fopArr);
+
+  int32_t code = TARRAY2_APPEND(rtner->rfsetArr, rfset);
+  if (code) {
+    taosMemoryFree(rfset);
+    return code;
+  }
+
+  rtner->ctx->rfset = rfset;
+  return 0;
+}
+
 static int32_t tsdbDoRetention2(void *arg) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -295,6 +485,11 @@ static int32_t tsdbDoRetention2(void *arg) {
     STFileObj *fobj;
     int32_t    expLevel = tsdbFidLevel(rtner->ctx->fset->fid, &rtner->tsdb->keepCfg, rtner->now);
 
+    if (expLevel == 0) continue;
+
+    code = tsdbRtnFSetBegin(rtner);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
     if (expLevel < 0) {  // remove the file set
       for (int32_t ftype = 0; (ftype < TSDB_FTYPE_MAX) && (fobj = rtner->ctx->fset->farr[ftype], 1); ++ftype) {
         if (fobj == NULL) continue;
@@ -316,8 +511,6 @@ static int32_t tsdbDoRetention2(void *arg) {
           TSDB_CHECK_CODE(code, lino, _exit);
         }
       }
-    } else if (expLevel == 0) {
-      continue;
     } else {
       SDiskID did;
 
@@ -335,7 +528,7 @@ static int32_t tsdbDoRetention2(void *arg) {
 
         int32_t nlevel = tfsGetLevel(rtner->tsdb->pVnode->pTfs);
         if (tsS3Enabled && nlevel > 1 && TSDB_FTYPE_DATA == ftype && did.level == nlevel - 1) {
-          code = tsdbMigrateDataFileS3(rtner, fobj, &did);
+          code = tsdbDoMigrateFileObj(rtner, fobj, &did, true);
           TSDB_CHECK_CODE(code, lino, _exit);
         } else {
           if (tsS3Enabled) {
@@ -349,7 +542,7 @@ static int32_t tsdbDoRetention2(void *arg) {
             s3EvictCache(fobj->fname, fsize * 2);
           }
 
-          code = tsdbDoMigrateFileObj(rtner, fobj, &did);
+          code = tsdbDoMigrateFileObj(rtner, fobj, &did, false);
           TSDB_CHECK_CODE(code, lino, _exit);
         }
       }
@@ -360,23 +553,32 @@ static int32_t tsdbDoRetention2(void *arg) {
         TARRAY2_FOREACH(lvl->fobjArr, fobj) {
           if (fobj->f->did.level == did.level) continue;
 
-          code = tsdbDoMigrateFileObj(rtner, fobj, &did);
+          code = tsdbDoMigrateFileObj(rtner, fobj, &did, false);
           TSDB_CHECK_CODE(code, lino, _exit);
         }
       }
     }
   }
 
-  code = tsdbDoRetentionEnd(rtner);
+  code = tsdbRtnDoCopyJobs(rtner);
   TSDB_CHECK_CODE(code, lino, _exit);
 
 _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(rtner->tsdb->pVnode), lino, code);
+  } else {
+    tsdbInfo("vid:%d, cid:%" PRId64 ", %s done, nFSet:%d nFile:%d", TD_VID(rtner->tsdb->pVnode), rtner->cid, __func__,
+             TARRAY2_SIZE(rtner->rfsetArr), TARRAY2_SIZE(rtner->jobArr));
   }
+  tsdbDoRetentionEnd(rtner);
   return code;
 }
 
+void tsdbGetMigrateStat(STsdb *pTsdb, int64_t *migrateBytes, int32_t *migrateQueue) {
+  *migrateBytes = atomic_load_64(&pTsdb->pFS->migrateBytes);
+  *migrateQueue = atomic_load_32(&pTsdb->pFS->migrateQueue);
+}
+
 static void tsdbFreeRtnArg(void *arg) {
   SRtnArg *rArg = (SRtnArg *)arg;
   if (rArg->sync) {
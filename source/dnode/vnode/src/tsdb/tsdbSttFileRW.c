@@ -24,10 +24,12 @@ struct SSttFileReader {
     bool sttBlkLoaded;
     bool statisBlkLoaded;
     bool tombBlkLoaded;
+    bool bloomFilterLoaded;
   } ctx[1];
   TSttBlkArray    sttBlkArray[1];
   TStatisBlkArray statisBlkArray[1];
   TTombBlkArray   tombBlkArray[1];
+  SBloomFilter   *bloomFilter;
   uint8_t        *bufArr[5];
 };
 
@@ -46,12 +48,12 @@ int32_t tsdbSttFileReaderOpen(const char *fname, const SSttFileReaderConfig *con
 
   // open file
   if (fname) {
-    code = tsdbOpenFile(fname, config->szPage, TD_FILE_READ, &reader[0]->fd);
+    code = tsdbOpenFile(fname, config->tsdb, config->szPage, TD_FILE_READ, &reader[0]->fd);
     TSDB_CHECK_CODE(code, lino, _exit);
   } else {
     char fname1[TSDB_FILENAME_LEN];
     tsdbTFileName(config->tsdb, config->file, fname1);
-    code = tsdbOpenFile(fname1, config->szPage, TD_FILE_READ, &reader[0]->fd);
+    code = tsdbOpenFile(fname1, config->tsdb, config->szPage, TD_FILE_READ, &reader[0]->fd);
     TSDB_CHECK_CODE(code, lino, _exit);
   }
 
@@ -76,6 +78,7 @@ int32_t tsdbSttFileReaderClose(SSttFileReader **reader) {
       tFree(reader[0]->bufArr[i]);
     }
     tsdbCloseFile(&reader[0]->fd);
+    tBloomFilterDestroy(reader[0]->bloomFilter);
     TARRAY2_DESTROY(reader[0]->tombBlkArray, NULL);
     TARRAY2_DESTROY(reader[0]->statisBlkArray, NULL);
     TARRAY2_DESTROY(reader[0]->sttBlkArray, NULL);
@@ -169,6 +172,35 @@ int32_t tsdbSttFileReadSttBlk(SSttFileReader *reader, const TSttBlkArray **sttBl
   return 0;
 }
 
+int32_t tsdbSttFileReadBloomFilter(SSttFileReader *reader, const SBloomFilter **filter) {
+  if (!reader->ctx->bloomFilterLoaded) {
+    if (reader->footer->bloomFilterPtr->size > 0) {
+      void *data = taosMemoryMalloc(reader->footer->bloomFilterPtr->size);
+      if (!data) return TSDB_CODE_OUT_OF_MEMORY;
+
+      int32_t code = tsdbReadFile(reader->fd, reader->footer->bloomFilterPtr->offset, data,
+                                  reader->footer->bloomFilterPtr->size);
+      if (code) {
+        taosMemoryFree(data);
+        return code;
+      }
+
+      SDecoder decoder = {0};
+      tDecoderInit(&decoder, data, reader->footer->bloomFilterPtr->size);
+      reader->bloomFilter = tBloomFilterDecode(&decoder);
+      tDecoderClear(&decoder);
+      taosMemoryFree(data);
+
+      if (reader->bloomFilter == NULL) return TSDB_CODE_FILE_CORRUPTED;
+    }
+
+    reader->ctx->bloomFilterLoaded = true;
+  }
+
+  filter[0] = reader->bloomFilter;
+  return 0;
+}
+
 int32_t tsdbSttFileReadBlockData(SSttFileReader *reader, const SSttBlk *sttBlk, SBlockData *bData) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -189,6 +221,107 @@ _exit:
   return code;
 }
 
+static FORCE_INLINE int64_t tsdbBlockColEnd(const SBlockCol *blockCol) {
+  return blockCol->offset + blockCol->szBitmap + blockCol->szOffset + blockCol->szValue;
+}
+
+// Read the columns set up in bData from the column part of a block starting at offset. The column headers are parsed
+// only up to the last column wanted, and the wanted columns lying less than a page apart are fetched with one read.
+int32_t tsdbFileReadBlockColData(STsdbFD *fd, int64_t offset, const SDiskDataHdr *hdr, SBlockData *bData,
+                                 uint8_t **bufArr) {
+  if (bData->nColData == 0) return 0;
+
+  int32_t code = 0;
+  int32_t lino = 0;
+
+  if (hdr->szBlkCol > 0) {
+    code = tRealloc(&bufArr[0], hdr->szBlkCol);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    code = tsdbReadFile(fd, offset, bufArr[0], hdr->szBlkCol);
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  // match the wanted columns with the column headers, the ones with values go to bufArr[3] and their index to bufArr[4]
+  code = tRealloc(&bufArr[3], sizeof(SBlockCol) * bData->nColData);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  code = tRealloc(&bufArr[4], sizeof(int32_t) * bData->nColData);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  SBlockCol  bc[1] = {{.cid = 0}};
+  SBlockCol *blockCol = bc;
+  SBlockCol *blockColArr = (SBlockCol *)bufArr[3];
+  int32_t   *colIdxArr = (int32_t *)bufArr[4];
+  int32_t    nBlockCol = 0;
+  int32_t    size = 0;
+
+  for (int32_t i = 0; i < bData->nColData; i++) {
+    SColData *colData = tBlockDataGetColDataByIdx(bData, i);
+
+    while (blockCol && blockCol->cid < colData->cid) {
+      if (size < hdr->szBlkCol) {
+        size += tGetBlockCol(bufArr[0] + size, blockCol, hdr->fmtVer);
+      } else {
+        ASSERT(size == hdr->szBlkCol);
+        blockCol = NULL;
+      }
+    }
+
+    if (blockCol == NULL || blockCol->cid > colData->cid) {
+      for (int32_t iRow = 0; iRow < hdr->nRow; iRow++) {
+        code = tColDataAppendValue(colData, &COL_VAL_NONE(colData->cid, colData->type));
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
+    } else {
+      ASSERT(blockCol->type == colData->type);
+      ASSERT(blockCol->flag && blockCol->flag != HAS_NONE);
+
+      if (blockCol->flag == HAS_NULL) {
+        for (int32_t iRow = 0; iRow < hdr->nRow; iRow++) {
+          code = tColDataAppendValue(colData, &COL_VAL_NULL(blockCol->cid, blockCol->type));
+          TSDB_CHECK_CODE(code, lino, _exit);
+        }
+      } else {
+        blockColArr[nBlockCol] = blockCol[0];
+        colIdxArr[nBlockCol] = i;
+        nBlockCol++;
+      }
+    }
+  }
+
+  // the column values are laid out in cid order, read them in runs
+  for (int32_t iStart = 0, iEnd; iStart < nBlockCol; iStart = iEnd) {
+    int64_t runStart = blockColArr[iStart].offset;
+    int64_t runEnd = tsdbBlockColEnd(&blockColArr[iStart]);
+
+    for (iEnd = iStart + 1; iEnd < nBlockCol; iEnd++) {
+      if (blockColArr[iEnd].offset - runEnd >= fd->szPage) break;
+      runEnd = tsdbBlockColEnd(&blockColArr[iEnd]);
+    }
+
+    code = tRealloc(&bufArr[1], runEnd - runStart);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    code = tsdbReadFile(fd, offset + hdr->szBlkCol + runStart, bufArr[1], runEnd - runStart);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    for (int32_t i = iStart; i < iEnd; i++) {
+      SColData *colData = tBlockDataGetColDataByIdx(bData, colIdxArr[i]);
+
+      code = tsdbDecmprColData(bufArr[1] + (blockColArr[i].offset - runStart), &blockColArr[i], hdr->cmprAlg,
+                               hdr->nRow, colData, &bufArr[2]);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
+  }
+
+_exit:
+  if (code) {
+    tsdbError("%s failed at line %d since %s", __func__, lino, tstrerror(code));
+  }
+  return code;
+}
+
 int32_t tsdbSttFileReadBlockDataByColumn(SSttFileReader *reader, const SSttBlk *sttBlk, SBlockData *bData,
                                          STSchema *pTSchema, int16_t cids[], int32_t ncid) {
   int32_t code = 0;
@@ -248,63 +381,9 @@ int32_t tsdbSttFileReadBlockDataByColumn(SSttFileReader *reader, const SSttBlk *
   ASSERT(size == sttBlk->bInfo.szKey);
 
   // other columns
-  if (bData->nColData > 0) {
-    if (hdr->szBlkCol > 0) {
-      code = tRealloc(&reader->config->bufArr[0], hdr->szBlkCol);
-      TSDB_CHECK_CODE(code, lino, _exit);
-
-      code = tsdbReadFile(reader->fd, sttBlk->bInfo.offset + sttBlk->bInfo.szKey, reader->config->bufArr[0],
-                          hdr->szBlkCol);
-      TSDB_CHECK_CODE(code, lino, _exit);
-    }
-
-    SBlockCol  bc[1] = {{.cid = 0}};
-    SBlockCol *blockCol = bc;
-
-    size = 0;
-    for (int32_t i = 0; i < bData->nColData; i++) {
-      SColData *colData = tBlockDataGetColDataByIdx(bData, i);
-
-      while (blockCol && blockCol->cid < colData->cid) {
-        if (size < hdr->szBlkCol) {
-          size += tGetBlockCol(reader->config->bufArr[0] + size, blockCol);
-        } else {
-          ASSERT(size == hdr->szBlkCol);
-          blockCol = NULL;
-        }
-      }
-
-      if (blockCol == NULL || blockCol->cid > colData->cid) {
-        for (int32_t iRow = 0; iRow < hdr->nRow; iRow++) {
-          code = tColDataAppendValue(colData, &COL_VAL_NONE(colData->cid, colData->type));
-          TSDB_CHECK_CODE(code, lino, _exit);
-        }
-      } else {
-        ASSERT(blockCol->type == colData->type);
-        ASSERT(blockCol->flag && blockCol->flag != HAS_NONE);
-
-        if (blockCol->flag == HAS_NULL) {
-          for (int32_t iRow = 0; iRow < hdr->nRow; iRow++) {
-            code = tColDataAppendValue(colData, &COL_VAL_NULL(blockCol->cid, blockCol->type));
-            TSDB_CHECK_CODE(code, lino, _exit);
-          }
-        } else {
-          int32_t size1 = blockCol->szBitmap + blockCol->szOffset + blockCol->szValue;
-
-          code = tRealloc(&reader->config->bufArr[1], size1);
-          TSDB_CHECK_CODE(code, lino, _exit);
-
-          code = tsdbReadFile(reader->fd, sttBlk->bInfo.offset + sttBlk->bInfo.szKey + hdr->szBlkCol + blockCol->offset,
-                              reader->config->bufArr[1], size1);
-          TSDB_CHECK_CODE(code, lino, _exit);
-
-          code = tsdbDecmprColData(reader->config->bufArr[1], blockCol, hdr->cmprAlg, hdr->nRow, colData,
-                                   &reader->config->bufArr[2]);
-          TSDB_CHECK_CODE(code, lino, _exit);
-        }
-      }
-    }
-  }
+  code = tsdbFileReadBlockColData(reader->fd, sttBlk->bInfo.offset + sttBlk->bInfo.szKey, hdr, bData,
+                                  reader->config->bufArr);
+  TSDB_CHECK_CODE(code, lino, _exit);
 
 _exit:
   if (code) {
@@ -395,6 +474,7 @@ struct SSttFileWriter {
   STombBlock      tombBlock[1];
   STbStatisBlock  staticBlock[1];
   SBlockData      blockData[1];
+  TARRAY2(int64_t) uidArr[1];  // uids of the tables written, for the bloom filter
   // helper data
   SSkmInfo skmTb[1];
   SSkmInfo skmRow[1];
@@ -668,6 +748,49 @@ _exit:
   return code;
 }
 
+static int32_t tsdbSttFileDoWriteBloomFilter(SSttFileWriter *writer) {
+  if (!tsSttBloomFilter || TARRAY2_SIZE(writer->uidArr) == 0) return 0;
+
+  int32_t       code = 0;
+  int32_t       lino = 0;
+  int32_t       size = 0;
+  SBloomFilter *filter = tBloomFilterInit(TARRAY2_SIZE(writer->uidArr), TSDB_STT_BLOOM_FILTER_FPP);
+  if (filter == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  const int64_t *uid;
+  TARRAY2_FOREACH_PTR(writer->uidArr, uid) { tBloomFilterPut(filter, uid, sizeof(*uid)); }
+
+  tEncodeSize(tBloomFilterEncode, filter, size, code);
+  if (code) {
+    code = TSDB_CODE_INVALID_PARA;
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  code = tRealloc(&writer->config->bufArr[0], size);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+  SEncoder encoder = {0};
+  tEncoderInit(&encoder, writer->config->bufArr[0], size);
+  tBloomFilterEncode(filter, &encoder);
+  tEncoderClear(&encoder);
+
+  writer->footer->bloomFilterPtr->offset = writer->file->size;
+  writer->footer->bloomFilterPtr->size = size;
+  code = tsdbWriteFile(writer->fd, writer->file->size, writer->config->bufArr[0], size);
+  TSDB_CHECK_CODE(code, lino, _exit);
+  writer->file->size += size;
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(writer->config->tsdb->pVnode), lino, code);
+  }
+  tBloomFilterDestroy(filter);
+  return code;
+}
+
 int32_t tsdbFileWriteSttFooter(STsdbFD *fd, const SSttFooter *footer, int64_t *fileSize) {
   int32_t code = tsdbWriteFile(fd, *fileSize, (const uint8_t *)footer, sizeof(*footer));
   if (code) return code;
@@ -705,7 +828,7 @@ static int32_t tsdbSttFWriterDoOpen(SSttFileWriter *writer) {
   char    fname[TSDB_FILENAME_LEN];
 
   tsdbTFileName(writer->config->tsdb, writer->file, fname);
-  code = tsdbOpenFile(fname, writer->config->szPage, flag, &writer->fd);
+  code = tsdbOpenFile(fname, writer->config->tsdb, writer->config->szPage, flag, &writer->fd);
   TSDB_CHECK_CODE(code, lino, _exit);
 
   uint8_t hdr[TSDB_FHDR_SIZE] = {0};
@@ -733,6 +856,7 @@ static void tsdbSttFWriterDoClose(SSttFileWriter *writer) {
   tTombBlockDestroy(writer->tombBlock);
   tStatisBlockDestroy(writer->staticBlock);
   tBlockDataDestroy(writer->blockData);
+  TARRAY2_DESTROY(writer->uidArr, NULL);
   TARRAY2_DESTROY(writer->tombBlkArray, NULL);
   TARRAY2_DESTROY(writer->statisBlkArray, NULL);
   TARRAY2_DESTROY(writer->sttBlkArray, NULL);
@@ -765,6 +889,9 @@ static int32_t tsdbSttFWriterCloseCommit(SSttFileWriter *writer, TFileOpArray *o
   code = tsdbSttFileDoWriteTombBlk(writer);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  code = tsdbSttFileDoWriteBloomFilter(writer);
+  TSDB_CHECK_CODE(code, lino, _exit);
+
   code = tsdbSttFileDoWriteFooter(writer);
   TSDB_CHECK_CODE(code, lino, _exit);
 
@@ -882,6 +1009,9 @@ int32_t tsdbSttFileWriteRow(SSttFileWriter *writer, SRowInfo *row) {
     };
     code = tStatisBlockPut(writer->staticBlock, &record);
     TSDB_CHECK_CODE(code, lino, _exit);
+
+    code = TARRAY2_APPEND(writer->uidArr, row->uid);
+    TSDB_CHECK_CODE(code, lino, _exit);
   } else {
     ASSERT(key->ts >= TARRAY2_LAST(writer->staticBlock->lastKey));
 
@@ -13,6 +13,7 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "tbloomfilter.h"
 #include "tsdbFS2.h"
 #include "tsdbUtil2.h"
 
@@ -23,6 +24,8 @@
 extern "C" {
 #endif
 
+#define TSDB_STT_BLOOM_FILTER_FPP 0.01  // false positive probability of the table uid bloom filter
+
 typedef TARRAY2(SSttBlk) TSttBlkArray;
 typedef TARRAY2(SStatisBlk) TStatisBlkArray;
 
@@ -30,7 +33,8 @@ typedef struct {
   SFDataPtr sttBlkPtr[1];
   SFDataPtr statisBlkPtr[1];
   SFDataPtr tombBlkPtr[1];
-  SFDataPtr rsrvd[2];
+  SFDataPtr bloomFilterPtr[1];  // bloom filter of the table uids, size 0 if not written
+  SFDataPtr rsrvd[1];
 } SSttFooter;
 
 // SSttFileReader ==========================================
@@ -46,6 +50,7 @@ int32_t tsdbSttFileReaderClose(SSttFileReader **reader);
 int32_t tsdbSttFileReadSttBlk(SSttFileReader *reader, const TSttBlkArray **sttBlkArray);
 int32_t tsdbSttFileReadStatisBlk(SSttFileReader *reader, const TStatisBlkArray **statisBlkArray);
 int32_t tsdbSttFileReadTombBlk(SSttFileReader *reader, const TTombBlkArray **delBlkArray);
+int32_t tsdbSttFileReadBloomFilter(SSttFileReader *reader, const SBloomFilter **filter);  // NULL if the file has none
 
 int32_t tsdbSttFileReadBlockData(SSttFileReader *reader, const SSttBlk *sttBlk, SBlockData *bData);
 int32_t tsdbSttFileReadBlockDataByColumn(SSttFileReader *reader, const SSttBlk *sttBlk, SBlockData *bData,
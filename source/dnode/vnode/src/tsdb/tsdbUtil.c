@@ -370,7 +370,7 @@ int32_t tGetSttBlk(uint8_t *p, void *ph) {
 }
 
 // SBlockCol ======================================================
-int32_t tPutBlockCol(uint8_t *p, void *ph) {
+int32_t tPutBlockCol(uint8_t *p, void *ph, int32_t fmtVer) {
   int32_t    n = 0;
   SBlockCol *pBlockCol = (SBlockCol *)ph;
 
@@ -389,6 +389,11 @@ int32_t tPutBlockCol(uint8_t *p, void *ph) {
 
     if (IS_VAR_DATA_TYPE(pBlockCol->type)) {
       n += tPutI32v(p ? p + n : p, pBlockCol->szOffset);
+      if (fmtVer > 0) {
+        n += tPutI8(p ? p + n : p, pBlockCol->encoding);
+      } else {
+        ASSERT(pBlockCol->encoding == TSDB_COL_ENCODING_PLAIN);
+      }
     }
 
     if (pBlockCol->flag != (HAS_NULL | HAS_NONE)) {
@@ -402,7 +407,7 @@ _exit:
   return n;
 }
 
-int32_t tGetBlockCol(uint8_t *p, void *ph) {
+int32_t tGetBlockCol(uint8_t *p, void *ph, int32_t fmtVer) {
   int32_t    n = 0;
   SBlockCol *pBlockCol = (SBlockCol *)ph;
 
@@ -418,6 +423,7 @@ int32_t tGetBlockCol(uint8_t *p, void *ph) {
   pBlockCol->szOffset = 0;
   pBlockCol->szValue = 0;
   pBlockCol->offset = 0;
+  pBlockCol->encoding = TSDB_COL_ENCODING_PLAIN;
 
   if (pBlockCol->flag != HAS_NULL) {
     if (pBlockCol->flag != HAS_VALUE) {
@@ -426,6 +432,9 @@ int32_t tGetBlockCol(uint8_t *p, void *ph) {
 
     if (IS_VAR_DATA_TYPE(pBlockCol->type)) {
       n += tGetI32v(p + n, &pBlockCol->szOffset);
+      if (fmtVer > 0) {
+        n += tGetI8(p + n, &pBlockCol->encoding);
+      }
     }
 
     if (pBlockCol->flag != (HAS_NULL | HAS_NONE)) {
@@ -1311,8 +1320,9 @@ int32_t tCmprBlockData(SBlockData *pBlockData, int8_t cmprAlg, uint8_t **ppOut,
                        int32_t aBufN[]) {
   int32_t code = 0;
 
+  // uncompressed blocks are never dictionary encoded and keep the old format, snapshots are sent that way
   SDiskDataHdr hdr = {.delimiter = TSDB_FILE_DLMT,
-                      .fmtVer = 0,
+                      .fmtVer = (cmprAlg == NO_COMPRESSION) ? 0 : TSDB_DISK_DATA_FMT_VER,
                       .suid = pBlockData->suid,
                       .uid = pBlockData->uid,
                       .nRow = pBlockData->nRow,
@@ -1342,9 +1352,9 @@ int32_t tCmprBlockData(SBlockData *pBlockData, int8_t cmprAlg, uint8_t **ppOut,
       aBufN[0] = aBufN[0] + blockCol.szBitmap + blockCol.szOffset + blockCol.szValue;
     }
 
-    code = tRealloc(&aBuf[1], hdr.szBlkCol + tPutBlockCol(NULL, &blockCol));
+    code = tRealloc(&aBuf[1], hdr.szBlkCol + tPutBlockCol(NULL, &blockCol, hdr.fmtVer));
     if (code) goto _exit;
-    hdr.szBlkCol += tPutBlockCol(aBuf[1] + hdr.szBlkCol, &blockCol);
+    hdr.szBlkCol += tPutBlockCol(aBuf[1] + hdr.szBlkCol, &blockCol, hdr.fmtVer);
   }
 
   // SBlockCol
@@ -1441,7 +1451,7 @@ int32_t tDecmprBlockData(uint8_t *pIn, int32_t szIn, SBlockData *pBlockData, uin
   int32_t nt = 0;
   while (nt < hdr.szBlkCol) {
     SBlockCol blockCol = {0};
-    nt += tGetBlockCol(pIn + n + nt, &blockCol);
+    nt += tGetBlockCol(pIn + n + nt, &blockCol, hdr.fmtVer);
     ++nColData;
   }
   ASSERT(nt == hdr.szBlkCol);
@@ -1453,7 +1463,7 @@ int32_t tDecmprBlockData(uint8_t *pIn, int32_t szIn, SBlockData *pBlockData, uin
   int32_t iColData = 0;
   while (nt < hdr.szBlkCol) {
     SBlockCol blockCol = {0};
-    nt += tGetBlockCol(pIn + n + nt, &blockCol);
+    nt += tGetBlockCol(pIn + n + nt, &blockCol, hdr.fmtVer);
 
     SColData *pColData = &pBlockData->aColData[iColData++];
 
@@ -1535,8 +1545,8 @@ int32_t tGetColumnDataAgg(uint8_t *p, SColumnDataAgg *pColAgg) {
   return n;
 }
 
-int32_t tsdbCmprData(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut, int32_t nOut,
-                     int32_t *szOut, uint8_t **ppBuf) {
+static int32_t tsdbCmprDataImpl(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut,
+                                int32_t nOut, int32_t *szOut, uint8_t **ppBuf) {
   int32_t code = 0;
 
   ASSERT(szIn > 0 && ppOut);
@@ -1571,8 +1581,21 @@ _exit:
   return code;
 }
 
-int32_t tsdbDecmprData(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut, int32_t szOut,
-                       uint8_t **ppBuf) {
+int32_t tsdbCmprData(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut, int32_t nOut,
+                     int32_t *szOut, uint8_t **ppBuf) {
+  STsdbWriteProfile *pProfile = tsdbGetWriteProfile();
+  if (pProfile == NULL) {
+    return tsdbCmprDataImpl(pIn, szIn, type, cmprAlg, ppOut, nOut, szOut, ppBuf);
+  }
+
+  int64_t st = taosGetTimestampUs();
+  int32_t code = tsdbCmprDataImpl(pIn, szIn, type, cmprAlg, ppOut, nOut, szOut, ppBuf);
+  pProfile->cmprTime += taosGetTimestampUs() - st;
+  return code;
+}
+
+static int32_t tsdbDecmprDataImpl(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut,
+                                  int32_t szOut, uint8_t **ppBuf) {
   int32_t code = 0;
 
   code = tRealloc(ppOut, szOut);
@@ -1601,6 +1624,170 @@ _exit:
   return code;
 }
 
+int32_t tsdbDecmprData(uint8_t *pIn, int32_t szIn, int8_t type, int8_t cmprAlg, uint8_t **ppOut, int32_t szOut,
+                       uint8_t **ppBuf) {
+  STableScanAnalyzeInfo *pProfile = tsdbGetReadProfile();
+  if (pProfile == NULL) {
+    return tsdbDecmprDataImpl(pIn, szIn, type, cmprAlg, ppOut, szOut, ppBuf);
+  }
+
+  int64_t st = taosGetTimestampUs();
+  int32_t code = tsdbDecmprDataImpl(pIn, szIn, type, cmprAlg, ppOut, szOut, ppBuf);
+  pProfile->decompressTime[type] += (taosGetTimestampUs() - st) / 1000.0;
+  return code;
+}
+
+// Dictionary encoding of a variant data type column: the offset part keeps a code for each value (the empty values of
+// NULL and NONE included), the value part keeps the size of the dictionary followed by the compressed dictionary,
+// which is the number of distinct values and each of them as a binary.
+static int32_t tsdbBuildColDict(SColData *pColData, int32_t *aCode, int32_t *aDictIdx, int32_t *nDict) {
+  int32_t aSlot[TSDB_COL_DICT_MAX_SIZE * 2];
+  int32_t nSlot = TSDB_COL_DICT_MAX_SIZE * 2;
+
+  memset(aSlot, 0xFF, sizeof(aSlot));
+  *nDict = 0;
+
+  for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
+    int32_t  nData = ((iVal + 1 < pColData->nVal) ? pColData->aOffset[iVal + 1] : pColData->nData) -
+                    pColData->aOffset[iVal];
+    uint8_t *pData = pColData->pData + pColData->aOffset[iVal];
+    int32_t  iSlot = MurmurHash3_32((const char *)pData, nData) & (nSlot - 1);
+
+    for (;;) {
+      int32_t iDict = aSlot[iSlot];
+      if (iDict < 0) {
+        if (*nDict >= TSDB_COL_DICT_MAX_SIZE) return -1;
+
+        aDictIdx[*nDict] = iVal;
+        aSlot[iSlot] = iDict = (*nDict)++;
+      } else {
+        int32_t iFirst = aDictIdx[iDict];
+        int32_t nFirst = ((iFirst + 1 < pColData->nVal) ? pColData->aOffset[iFirst + 1] : pColData->nData) -
+                         pColData->aOffset[iFirst];
+        if (nFirst != nData || memcmp(pColData->pData + pColData->aOffset[iFirst], pData, nData) != 0) {
+          iSlot = (iSlot + 1) & (nSlot - 1);
+          continue;
+        }
+      }
+
+      aCode[iVal] = iDict;
+      break;
+    }
+  }
+
+  return 0;
+}
+
+static int32_t tsdbCmprColDict(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol, uint8_t **ppOut, int32_t nOut,
+                               uint8_t **ppBuf, bool *encoded) {
+  int32_t  code = 0;
+  int32_t  aDictIdx[TSDB_COL_DICT_MAX_SIZE];
+  int32_t  nDict = 0;
+  uint8_t *pBuf = NULL;
+
+  *encoded = false;
+
+  // the dictionary only pays off when values repeat a lot
+  if (pColData->nVal < TSDB_COL_DICT_MIN_ROWS) goto _exit;
+
+  code = tRealloc(&pBuf, sizeof(int32_t) * pColData->nVal);
+  if (code) goto _exit;
+
+  if (tsdbBuildColDict(pColData, (int32_t *)pBuf, aDictIdx, &nDict) < 0 || nDict * 4 > pColData->nVal) goto _exit;
+
+  // codes
+  code = tsdbCmprData(pBuf, sizeof(int32_t) * pColData->nVal, TSDB_DATA_TYPE_INT, cmprAlg, ppOut, nOut,
+                      &pBlockCol->szOffset, ppBuf);
+  if (code) goto _exit;
+  nOut += pBlockCol->szOffset;
+
+  // dictionary
+  int32_t szDict = tPutI32v(NULL, nDict);
+  for (int32_t iDict = 0; iDict < nDict; iDict++) {
+    int32_t iVal = aDictIdx[iDict];
+    szDict += tPutBinary(NULL, NULL,
+                         ((iVal + 1 < pColData->nVal) ? pColData->aOffset[iVal + 1] : pColData->nData) -
+                             pColData->aOffset[iVal]);
+  }
+
+  code = tRealloc(&pBuf, szDict);
+  if (code) goto _exit;
+
+  int32_t n = tPutI32v(pBuf, nDict);
+  for (int32_t iDict = 0; iDict < nDict; iDict++) {
+    int32_t iVal = aDictIdx[iDict];
+    n += tPutBinary(pBuf + n, pColData->pData + pColData->aOffset[iVal],
+                    ((iVal + 1 < pColData->nVal) ? pColData->aOffset[iVal + 1] : pColData->nData) -
+                        pColData->aOffset[iVal]);
+  }
+  ASSERT(n == szDict);
+
+  code = tRealloc(ppOut, nOut + tPutI32v(NULL, szDict));
+  if (code) goto _exit;
+  n = tPutI32v(*ppOut + nOut, szDict);
+
+  code = tsdbCmprData(pBuf, szDict, TSDB_DATA_TYPE_BINARY, cmprAlg, ppOut, nOut + n, &pBlockCol->szValue, ppBuf);
+  if (code) goto _exit;
+  pBlockCol->szValue += n;
+
+  pBlockCol->encoding = TSDB_COL_ENCODING_DICT;
+  *encoded = true;
+
+_exit:
+  tFree(pBuf);
+  return code;
+}
+
+static int32_t tsdbDecmprColDict(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, SColData *pColData,
+                                 uint8_t **ppBuf) {
+  int32_t  code = 0;
+  uint8_t *pDict = NULL;
+  uint8_t *aDictData[TSDB_COL_DICT_MAX_SIZE];
+  uint32_t aDictLen[TSDB_COL_DICT_MAX_SIZE];
+  int32_t  nDict = 0;
+  int32_t  szDict = 0;
+
+  int32_t n = tGetI32v(pIn, &szDict);
+  code = tsdbDecmprDataImpl(pIn + n, pBlockCol->szValue - n, TSDB_DATA_TYPE_BINARY, cmprAlg, &pDict, szDict, ppBuf);
+  if (code) goto _exit;
+
+  n = tGetI32v(pDict, &nDict);
+  if (nDict <= 0 || nDict > TSDB_COL_DICT_MAX_SIZE) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+  for (int32_t iDict = 0; iDict < nDict; iDict++) {
+    n += tGetBinary(pDict + n, &aDictData[iDict], &aDictLen[iDict]);
+  }
+
+  // the codes were decompressed into aOffset, turn them into offsets while the values are laid out
+  code = tRealloc(&pColData->pData, pColData->nData);
+  if (code) goto _exit;
+
+  int32_t offset = 0;
+  for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
+    int32_t iDict = pColData->aOffset[iVal];
+    if (iDict < 0 || iDict >= nDict || offset + aDictLen[iDict] > pColData->nData) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+
+    pColData->aOffset[iVal] = offset;
+    if (aDictLen[iDict]) {
+      memcpy(pColData->pData + offset, aDictData[iDict], aDictLen[iDict]);
+      offset += aDictLen[iDict];
+    }
+  }
+
+  if (offset != pColData->nData) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+  }
+
+_exit:
+  tFree(pDict);
+  return code;
+}
+
 int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol, uint8_t **ppOut, int32_t nOut,
                         uint8_t **ppBuf) {
   int32_t code = 0;
@@ -1627,6 +1814,15 @@ int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol
   }
   size += pBlockCol->szBitmap;
 
+  // dictionary, only for compressed blocks as the others are written in the old format
+  if (IS_VAR_DATA_TYPE(pColData->type) && pColData->flag != (HAS_NULL | HAS_NONE) && pColData->nData &&
+      cmprAlg != NO_COMPRESSION) {
+    bool encoded = false;
+
+    code = tsdbCmprColDict(pColData, cmprAlg, pBlockCol, ppOut, nOut + size, ppBuf, &encoded);
+    if (code || encoded) goto _exit;
+  }
+
   // offset
   if (IS_VAR_DATA_TYPE(pColData->type) && pColData->flag != (HAS_NULL | HAS_NONE)) {
     code = tsdbCmprData((uint8_t *)pColData->aOffset, sizeof(int32_t) * pColData->nVal, TSDB_DATA_TYPE_INT, cmprAlg,
@@ -1647,8 +1843,8 @@ _exit:
   return code;
 }
 
-int32_t tsdbDecmprColData(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, int32_t nVal, SColData *pColData,
-                          uint8_t **ppBuf) {
+static int32_t tsdbDecmprColDataImpl(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, int32_t nVal,
+                                     SColData *pColData, uint8_t **ppBuf) {
   int32_t code = 0;
 
   ASSERT(pColData->cid == pBlockCol->cid);
@@ -1668,22 +1864,25 @@ int32_t tsdbDecmprColData(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, in
       szBitMap = BIT1_SIZE(pColData->nVal);
     }
 
-    code = tsdbDecmprData(p, pBlockCol->szBitmap, TSDB_DATA_TYPE_TINYINT, cmprAlg, &pColData->pBitMap, szBitMap, ppBuf);
+    code = tsdbDecmprDataImpl(p, pBlockCol->szBitmap, TSDB_DATA_TYPE_TINYINT, cmprAlg, &pColData->pBitMap, szBitMap, ppBuf);
     if (code) goto _exit;
   }
   p += pBlockCol->szBitmap;
 
   // offset
   if (pBlockCol->szOffset) {
-    code = tsdbDecmprData(p, pBlockCol->szOffset, TSDB_DATA_TYPE_INT, cmprAlg, (uint8_t **)&pColData->aOffset,
+    code = tsdbDecmprDataImpl(p, pBlockCol->szOffset, TSDB_DATA_TYPE_INT, cmprAlg, (uint8_t **)&pColData->aOffset,
                           sizeof(int32_t) * pColData->nVal, ppBuf);
     if (code) goto _exit;
   }
   p += pBlockCol->szOffset;
 
   // value
-  if (pBlockCol->szValue) {
-    code = tsdbDecmprData(p, pBlockCol->szValue, pColData->type, cmprAlg, &pColData->pData, pColData->nData, ppBuf);
+  if (pBlockCol->encoding == TSDB_COL_ENCODING_DICT) {
+    code = tsdbDecmprColDict(p, pBlockCol, cmprAlg, pColData, ppBuf);
+    if (code) goto _exit;
+  } else if (pBlockCol->szValue) {
+    code = tsdbDecmprDataImpl(p, pBlockCol->szValue, pColData->type, cmprAlg, &pColData->pData, pColData->nData, ppBuf);
     if (code) goto _exit;
   }
   p += pBlockCol->szValue;
@@ -1691,3 +1890,17 @@ int32_t tsdbDecmprColData(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, in
 _exit:
   return code;
 }
+
+int32_t tsdbDecmprColData(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, int32_t nVal, SColData *pColData,
+                          uint8_t **ppBuf) {
+  STableScanAnalyzeInfo *pProfile = tsdbGetReadProfile();
+  if (pProfile == NULL) {
+    return tsdbDecmprColDataImpl(pIn, pBlockCol, cmprAlg, nVal, pColData, ppBuf);
+  }
+
+  // the bitmap and offsets are charged to the column type as well
+  int64_t st = taosGetTimestampUs();
+  int32_t code = tsdbDecmprColDataImpl(pIn, pBlockCol, cmprAlg, nVal, pColData, ppBuf);
+  pProfile->decompressTime[pColData->type] += (taosGetTimestampUs() - st) / 1000.0;
+  return code;
+}
@@ -217,6 +217,69 @@ bool s3Get(const char *object_name, const char *path) {
   return ret;
 }
 
+int32_t s3GetObjectBlock(const char *object_name, int64_t offset, int64_t size, uint8_t **ppBlock) {
+  int32_t                code = 0;
+  cos_pool_t            *p = NULL;
+  int                    is_cname = 0;
+  cos_status_t          *s = NULL;
+  cos_request_options_t *options = NULL;
+  cos_string_t           bucket;
+  cos_string_t           object;
+  cos_table_t           *resp_headers = NULL;
+  cos_table_t           *headers = NULL;
+  cos_buf_t             *content = NULL;
+  cos_list_t             download_buffer;
+  uint8_t               *pBlock = NULL;
+  int64_t                len = 0;
+
+  *ppBlock = NULL;
+
+  cos_pool_create(&p, NULL);
+  options = cos_request_options_create(p);
+  s3InitRequestOptions(options, is_cname);
+  cos_str_set(&bucket, tsS3BucketName);
+  cos_str_set(&object, object_name);
+
+  // only the bytes [offset, offset + size) of the object are downloaded
+  headers = cos_table_make(p, 1);
+  cos_table_add(headers, "Range",
+                apr_psprintf(p, "bytes=%" APR_INT64_T_FMT "-%" APR_INT64_T_FMT, offset, offset + size - 1));
+
+  cos_list_init(&download_buffer);
+  s = cos_get_object_to_buffer(options, &bucket, &object, headers, NULL, &download_buffer, &resp_headers);
+  if (!cos_status_is_ok(s)) {
+    log_status(s);
+    vError("failed to get object:%s range:[%" PRId64 ", %" PRId64 ")", object_name, offset, offset + size);
+    code = TSDB_CODE_FAILED;
+    goto _exit;
+  }
+
+  cos_list_for_each_entry(cos_buf_t, content, &download_buffer, node) { len += cos_buf_size(content); }
+  if (len != size) {
+    vError("object:%s range:[%" PRId64 ", %" PRId64 ") got %" PRId64 " bytes", object_name, offset, offset + size,
+           len);
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  pBlock = taosMemoryMalloc(size);
+  if (pBlock == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  len = 0;
+  cos_list_for_each_entry(cos_buf_t, content, &download_buffer, node) {
+    memcpy(pBlock + len, content->pos, cos_buf_size(content));
+    len += cos_buf_size(content);
+  }
+  *ppBlock = pBlock;
+
+_exit:
+  cos_pool_destroy(p);
+  return code;
+}
+
 typedef struct {
   int64_t size;
   int32_t atime;
@@ -337,6 +400,10 @@ void    s3DeleteObjectsByPrefix(const char *prefix) {}
 void    s3DeleteObjects(const char *object_name[], int nobject) {}
 bool    s3Exists(const char *object_name) { return false; }
 bool    s3Get(const char *object_name, const char *path) { return false; }
+int32_t s3GetObjectBlock(const char *object_name, int64_t offset, int64_t size, uint8_t **ppBlock) {
+  *ppBlock = NULL;
+  return TSDB_CODE_OPS_NOT_SUPPORT;
+}
 void    s3EvictCache(const char *path, long object_size) {}
 long    s3Size(const char *object_name) { return 0; }
 
@@ -60,6 +60,7 @@ void initTsdbReaderAPI(TsdReader* pReader) {
 
   pReader->tsdSetQueryTableList = tsdbSetTableList2;
   pReader->tsdSetReaderTaskId = (void (*)(void*, const char*))tsdbReaderSetId2;
+  pReader->tsdSetReaderProfile = (void (*)(void*, STableScanAnalyzeInfo*))tsdbReaderSetProfile2;
 }
 
 void initMetadataAPI(SStoreMeta* pMeta) {
@@ -83,6 +84,7 @@ void initMetadataAPI(SStoreMeta* pMeta) {
   pMeta->extractTagVal = (const void* (*)(const void*, int16_t, STagVal*))metaGetTableTagVal;
   pMeta->getTableTags = metaGetTableTags;
   pMeta->getTableTagsByUid = metaGetTableTagsByUids;
+  pMeta->getTableTagCols = metaGetTableTagCols;
 
   pMeta->getTableUidByName = metaGetTableUidByName;
   pMeta->getTableTypeByName = metaGetTableTypeByName;
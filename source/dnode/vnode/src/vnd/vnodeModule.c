@@ -35,7 +35,7 @@ typedef struct {
 struct SVnodeGlobal {
   int8_t           init;
   int8_t           stop;
-  SVnodeThreadPool tp[2];
+  SVnodeThreadPool tp[4];  // commit, merge, file set commit and retention
 };
 
 struct SVnodeGlobal vnodeGlobal;
@@ -63,15 +63,16 @@ int vnodeInit(int nthreads) {
 
     taosThreadMutexUnlock(&(vnodeGlobal.tp[i].mutex));
 
-    vnodeGlobal.tp[i].nthreads = nthreads;
-    vnodeGlobal.tp[i].threads = taosMemoryCalloc(nthreads, sizeof(TdThread));
+    // the retention pool bounds the file copies of tiered storage run at the same time on the dnode
+    vnodeGlobal.tp[i].nthreads = (i == 3) ? TMAX(tsRetentionParallelism, 1) : nthreads;
+    vnodeGlobal.tp[i].threads = taosMemoryCalloc(vnodeGlobal.tp[i].nthreads, sizeof(TdThread));
     if (vnodeGlobal.tp[i].threads == NULL) {
       terrno = TSDB_CODE_OUT_OF_MEMORY;
       vError("failed to init vnode module since:%s", tstrerror(terrno));
       return -1;
     }
 
-    for (int j = 0; j < nthreads; j++) {
+    for (int j = 0; j < vnodeGlobal.tp[i].nthreads; j++) {
       taosThreadCreate(&(vnodeGlobal.tp[i].threads[j]), NULL, loop, &vnodeGlobal.tp[i]);
     }
   }
@@ -156,6 +157,10 @@ static void* loop(void* arg) {
     setThreadName("vnode-commit");
   } else if (tp == &vnodeGlobal.tp[1]) {
     setThreadName("vnode-merge");
+  } else if (tp == &vnodeGlobal.tp[2]) {
+    setThreadName("vnode-fcommit");
+  } else if (tp == &vnodeGlobal.tp[3]) {
+    setThreadName("vnode-retention");
   }
 
   for (;;) {
@@ -387,6 +387,12 @@ int32_t vnodeGetLoad(SVnode *pVnode, SVnodeLoad *pLoad) {
   pLoad->learnerProgress = state.progress;
   pLoad->cacheUsage = tsdbCacheGetUsage(pVnode);
   pLoad->numOfCachedTables = tsdbCacheGetElems(pVnode);
+  metaGetUidCacheStats(pVnode->pMeta, &pLoad->numOfTagFilterCacheHits, &pLoad->numOfTagFilterCachePatches,
+                       &pLoad->numOfTagFilterCacheRebuilds);
+  tsdbGetAmpStat(pVnode->pTsdb, &pLoad->ingestBytes, &pLoad->mergeWriteBytes, &pLoad->mergeReadBytes,
+                 &pLoad->numOfFSets, &pLoad->numOfSttFiles);
+  tsdbGetMigrateStat(pVnode->pTsdb, &pLoad->migrateBytes, &pLoad->migrateQueue);
+  tsdbGetS3CacheStat(pVnode->pTsdb, &pLoad->s3CacheHits, &pLoad->s3CacheMisses, &pLoad->s3FetchBytes);
   pLoad->numOfTables = metaGetTbNum(pVnode->pMeta);
   pLoad->numOfTimeSeries = metaGetTimeSeriesNum(pVnode->pMeta);
   pLoad->totalStorage = (int64_t)3 * 1073741824;
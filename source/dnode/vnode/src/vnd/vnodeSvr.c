@@ -881,6 +881,9 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
   char               tbName[TSDB_TABLE_FNAME_LEN];
   STbUidStore       *pStore = NULL;
   SArray            *tbUids = NULL;
+  SVCreateTbReq    **aCreateReqP = NULL;
+  SVCreateTbRsp     *aCreateRsp = NULL;
+  int32_t            nCreate = 0;
 
   pRsp->msgType = TDMT_VND_CREATE_TABLE_RSP;
   pRsp->code = TSDB_CODE_SUCCESS;
@@ -903,10 +906,17 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
     goto _exit;
   }
 
-  // loop to create table
+  aCreateReqP = taosMemoryCalloc(req.nReqs, sizeof(SVCreateTbReq *));
+  aCreateRsp = taosMemoryCalloc(req.nReqs, sizeof(SVCreateTbRsp));
+  if (aCreateReqP == NULL || aCreateRsp == NULL) {
+    rcode = -1;
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  // check requests
   for (int32_t iReq = 0; iReq < req.nReqs; iReq++) {
     pCreateReq = req.pReqs + iReq;
-    memset(&cRsp, 0, sizeof(cRsp));
 
     if ((terrno = grantCheck(TSDB_GRANT_TIMESERIES)) < 0) {
       rcode = -1;
@@ -921,20 +931,33 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
     // validate hash
     sprintf(tbName, "%s.%s", pVnode->config.dbname, pCreateReq->name);
     if (vnodeValidateTableHash(pVnode, tbName) < 0) {
+      continue;
+    }
+
+    aCreateReqP[nCreate++] = pCreateReq;
+  }
+
+  // create tables of the batch together
+  if (nCreate > 0) {
+    metaCreateTables(pVnode->pMeta, ver, aCreateReqP, nCreate, aCreateRsp);
+  }
+
+  for (int32_t iReq = 0, iCreate = 0; iReq < req.nReqs; iReq++) {
+    pCreateReq = req.pReqs + iReq;
+    memset(&cRsp, 0, sizeof(cRsp));
+
+    if (iCreate >= nCreate || aCreateReqP[iCreate] != pCreateReq) {
       cRsp.code = TSDB_CODE_VND_HASH_MISMATCH;
       taosArrayPush(rsp.pArray, &cRsp);
       continue;
     }
 
-    // do create table
-    if (metaCreateTable(pVnode->pMeta, ver, pCreateReq, &cRsp.pMeta) < 0) {
-      if (pCreateReq->flags & TD_CREATE_IF_NOT_EXISTS && terrno == TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
+    cRsp = aCreateRsp[iCreate++];
+    if (cRsp.code) {
+      if (pCreateReq->flags & TD_CREATE_IF_NOT_EXISTS && cRsp.code == TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
         cRsp.code = TSDB_CODE_SUCCESS;
-      } else {
-        cRsp.code = terrno;
       }
     } else {
-      cRsp.code = TSDB_CODE_SUCCESS;
       tdFetchTbUidList(pVnode->pSma, &pStore, pCreateReq->ctb.suid, pCreateReq->uid);
       taosArrayPush(tbUids, &pCreateReq->uid);
       vnodeUpdateMetaRsp(pVnode, cRsp.pMeta);
@@ -980,6 +1003,8 @@ _exit:
   }
   taosArrayDestroyEx(rsp.pArray, tFreeSVCreateTbRsp);
   taosArrayDestroy(tbUids);
+  taosMemoryFree(aCreateReqP);
+  taosMemoryFree(aCreateRsp);
   tDecoderClear(&decoder);
   tEncoderClear(&encoder);
   return rcode;
@@ -1391,6 +1416,7 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
   SSubmitReq2 *pSubmitReq = &(SSubmitReq2){0};
   SSubmitRsp2 *pSubmitRsp = &(SSubmitRsp2){0};
   SArray      *newTbUids = NULL;
+  SArray      *aCreateTbReqP = NULL;
   int32_t      ret;
   SEncoder     ec = {0};
 
@@ -1522,55 +1548,64 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
 
   vDebug("vgId:%d, submit block size %d", TD_VID(pVnode), (int32_t)taosArrayGetSize(pSubmitReq->aSubmitTbData));
 
-  // loop to handle
+  // create tables
   for (int32_t i = 0; i < TARRAY_SIZE(pSubmitReq->aSubmitTbData); ++i) {
     SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, i);
+    if (pSubmitTbData->pCreateTbReq == NULL) continue;
 
-    // create table
-    if (pSubmitTbData->pCreateTbReq) {
-      // check (TODO: move check to create table)
-      code = grantCheck(TSDB_GRANT_TIMESERIES);
-      if (code) goto _exit;
-
-      code = grantCheck(TSDB_GRANT_TABLE);
-      if (code) goto _exit;
-
-      // alloc if need
-      if (pSubmitRsp->aCreateTbRsp == NULL &&
-          (pSubmitRsp->aCreateTbRsp = taosArrayInit(TARRAY_SIZE(pSubmitReq->aSubmitTbData), sizeof(SVCreateTbRsp))) ==
-              NULL) {
-        code = TSDB_CODE_OUT_OF_MEMORY;
-        goto _exit;
-      }
+    // check (TODO: move check to create table)
+    code = grantCheck(TSDB_GRANT_TIMESERIES);
+    if (code) goto _exit;
 
-      SVCreateTbRsp *pCreateTbRsp = taosArrayReserve(pSubmitRsp->aCreateTbRsp, 1);
+    code = grantCheck(TSDB_GRANT_TABLE);
+    if (code) goto _exit;
 
-      // create table
-      if (metaCreateTable(pVnode->pMeta, ver, pSubmitTbData->pCreateTbReq, &pCreateTbRsp->pMeta) == 0) {
-        // create table success
+    if (aCreateTbReqP == NULL &&
+        (aCreateTbReqP = taosArrayInit(TARRAY_SIZE(pSubmitReq->aSubmitTbData), POINTER_BYTES)) == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+    taosArrayPush(aCreateTbReqP, &pSubmitTbData->pCreateTbReq);
+  }
 
-        if (newTbUids == NULL &&
-            (newTbUids = taosArrayInit(TARRAY_SIZE(pSubmitReq->aSubmitTbData), sizeof(int64_t))) == NULL) {
-          code = TSDB_CODE_OUT_OF_MEMORY;
-          goto _exit;
-        }
+  if (taosArrayGetSize(aCreateTbReqP) > 0) {
+    int32_t nCreate = TARRAY_SIZE(aCreateTbReqP);
+
+    if ((pSubmitRsp->aCreateTbRsp = taosArrayInit(nCreate, sizeof(SVCreateTbRsp))) == NULL ||
+        (newTbUids = taosArrayInit(nCreate, sizeof(int64_t))) == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
 
+    // all tables of the submit are created together, and their responses are kept in order
+    SVCreateTbRsp *aCreateTbRsp = taosArrayReserve(pSubmitRsp->aCreateTbRsp, nCreate);
+    metaCreateTables(pVnode->pMeta, ver, (SVCreateTbReq **)TARRAY_DATA(aCreateTbReqP), nCreate, aCreateTbRsp);
+
+    for (int32_t i = 0, iCreate = 0; i < TARRAY_SIZE(pSubmitReq->aSubmitTbData); ++i) {
+      SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, i);
+      if (pSubmitTbData->pCreateTbReq == NULL) continue;
+
+      SVCreateTbRsp *pCreateTbRsp = &aCreateTbRsp[iCreate++];
+      if (pCreateTbRsp->code == TSDB_CODE_SUCCESS) {
         taosArrayPush(newTbUids, &pSubmitTbData->uid);
 
         if (pCreateTbRsp->pMeta) {
           vnodeUpdateMetaRsp(pVnode, pCreateTbRsp->pMeta);
         }
-      } else {  // create table failed
-        if (terrno != TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
-          code = terrno;
-          vError("vgId:%d failed to create table:%s, code:%s", TD_VID(pVnode), pSubmitTbData->pCreateTbReq->name,
-              tstrerror(terrno));
-          goto _exit;
-        }
-        terrno = 0;
+      } else if (pCreateTbRsp->code == TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
         pSubmitTbData->uid = pSubmitTbData->pCreateTbReq->uid;  // update uid if table exist for using below
+      } else {
+        code = pCreateTbRsp->code;
+        vError("vgId:%d failed to create table:%s, code:%s", TD_VID(pVnode), pSubmitTbData->pCreateTbReq->name,
+               tstrerror(code));
+        goto _exit;
       }
     }
+  }
+
+  // loop to handle
+  for (int32_t i = 0; i < TARRAY_SIZE(pSubmitReq->aSubmitTbData); ++i) {
+    SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, i);
 
     // insert data
     int32_t affectedRows;
@@ -1610,6 +1645,7 @@ _exit:
 
   // clear
   taosArrayDestroy(newTbUids);
+  taosArrayDestroy(aCreateTbReqP);
   tDestroySubmitReq(pSubmitReq, 0 == pMsg->version ? TSDB_MSG_FLG_CMPT : TSDB_MSG_FLG_DECODE);
   tDestroySSubmitRsp2(pSubmitRsp, TSDB_MSG_FLG_ENCODE);
 
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "metaTestUtil.h"
+
+namespace {
+
+const tb_uid_t kSuid = 1000;
+const int32_t  kNumOfTags = 4;
+const int64_t  kBtime = 1700000000000;
+
+// a meta store of its own with the super table of kNumOfTags bigint tags, the first of which is indexed
+struct SMetaBench : public SMetaTestEnv {
+  explicit SMetaBench(const char *name) : SMetaTestEnv(name, 4096) {
+    std::vector<SSchema> tags(kNumOfTags);
+    for (int32_t i = 0; i < kNumOfTags; i++) {
+      tags[i] = {TSDB_DATA_TYPE_BIGINT, 0, (col_id_t)(3 + i), 8};
+      snprintf(tags[i].name, sizeof(tags[i].name), "t%d", i);
+    }
+    tags[0].flags = COL_IDX_ON;
+    createSTable(kSuid, "stb", tags);
+  }
+};
+
+// child tables of the super table, with tags that do not follow the uid order, and a ttl of a day for every 4th table
+struct SCreateReqs {
+  std::vector<std::string>     names;
+  std::vector<SVCreateTbReq>   reqs;
+  std::vector<SVCreateTbReq *> reqPs;
+
+  explicit SCreateReqs(int32_t nTable) : names(nTable), reqs(nTable), reqPs(nTable) {
+    SArray *pTagVals = taosArrayInit(kNumOfTags, sizeof(STagVal));
+    for (int32_t i = 0; i < nTable; i++) {
+      names[i] = "ctb_" + std::to_string(i);
+
+      taosArrayClear(pTagVals);
+      for (int32_t j = 0; j < kNumOfTags; j++) {
+        STagVal tagVal = {.cid = (int16_t)(3 + j), .type = TSDB_DATA_TYPE_BIGINT};
+        tagVal.i64 = (int64_t)i * 7919 % nTable + j;
+        taosArrayPush(pTagVals, &tagVal);
+      }
+      STag *pTag = NULL;
+      tTagNew(pTagVals, 1, false, &pTag);
+
+      SVCreateTbReq *pReq = &reqs[i];
+      memset(pReq, 0, sizeof(*pReq));
+      pReq->name = (char *)names[i].c_str();
+      pReq->uid = kSuid + 1 + i;
+      pReq->btime = kBtime + i;
+      pReq->ttl = (i % 4 == 0) ? 1 : 0;
+      pReq->type = TSDB_CHILD_TABLE;
+      pReq->ctb.stbName = (char *)"stb";
+      pReq->ctb.tagNum = kNumOfTags;
+      pReq->ctb.suid = kSuid;
+      pReq->ctb.pTag = (uint8_t *)pTag;
+      reqPs[i] = pReq;
+    }
+    taosArrayDestroy(pTagVals);
+  }
+
+  ~SCreateReqs() {
+    for (auto &req : reqs) taosMemoryFree(req.ctb.pTag);
+  }
+};
+
+void checkTables(SMetaBench &bench, int32_t nTable) {
+  int64_t numOfTables = 0;
+  ASSERT_EQ(metaGetStbStats(bench.pVnode, kSuid, &numOfTables), 0);
+  EXPECT_EQ(numOfTables, nTable);
+
+  SMetaReader mr = {0};
+  metaReaderDoInit(&mr, bench.pMeta, 0);
+  for (int32_t i = 0; i < nTable; i += nTable / 16) {
+    std::string name = "ctb_" + std::to_string(i);
+    ASSERT_EQ(metaGetTableEntryByName(&mr, name.c_str()), 0);
+    EXPECT_EQ(mr.me.uid, kSuid + 1 + i);
+    EXPECT_EQ(mr.me.ctbEntry.suid, kSuid);
+  }
+  metaReaderClear(&mr);
+}
+
+int filterInt64Equal(void *a, void *b, int16_t type) { return *(int64_t *)a == *(int64_t *)b ? 0 : 1; }
+
+int filterInt64GreaterEqual(void *a, void *b, int16_t type) { return *(int64_t *)a >= *(int64_t *)b ? 0 : 1; }
+
+// the tag index, the btime index and the ttl index are filled as each table is created on its own
+void checkIndexes(SMetaBench &bench, int32_t nTable) {
+  // each value of the indexed tag belongs to one table
+  for (int64_t val : {(int64_t)0, (int64_t)5, (int64_t)nTable - 1}) {
+    SArray       *pUids = taosArrayInit(1, sizeof(tb_uid_t));
+    SMetaFltParam param = {.suid = kSuid, .cid = 3, .type = TSDB_DATA_TYPE_BIGINT, .val = &val};
+    param.equal = true;
+    param.filterFunc = filterInt64Equal;
+    ASSERT_EQ(metaFilterTableIds(bench.pVnode, &param, pUids), 0);
+
+    int32_t i = 0;
+    while ((int64_t)i * 7919 % nTable != val) i++;
+    ASSERT_EQ(taosArrayGetSize(pUids), 1) << "t0 = " << val;
+    EXPECT_EQ(*(tb_uid_t *)taosArrayGet(pUids, 0), kSuid + 1 + i) << "t0 = " << val;
+    taosArrayDestroy(pUids);
+  }
+
+  // the tables created at or after a time, in the order of their btime
+  SArray       *pUids = taosArrayInit(32, sizeof(tb_uid_t));
+  int64_t       btime = kBtime + nTable - 24;
+  SMetaFltParam param = {.suid = kSuid, .type = TSDB_DATA_TYPE_TIMESTAMP, .val = &btime};
+  param.filterFunc = filterInt64GreaterEqual;
+  ASSERT_EQ(metaFilterCreateTime(bench.pVnode, &param, pUids), 0);
+  ASSERT_EQ(taosArrayGetSize(pUids), 24);
+  for (int32_t k = 0; k < 24; k++) {
+    EXPECT_EQ(*(tb_uid_t *)taosArrayGet(pUids, k), kSuid + 1 + nTable - 24 + k);
+  }
+
+  // the tables with a ttl whose day is over, once the ttl changes are flushed
+  taosArrayClear(pUids);
+  ASSERT_EQ(ttlMgrFlush(bench.pMeta->pTtlMgr, bench.pMeta->txn), 0);
+  int64_t halfway = kBtime + tsTtlUnit * 1000LL + nTable / 2;
+  ASSERT_EQ(metaTtlFindExpired(bench.pMeta, halfway, pUids, INT32_MAX), 0);
+  ASSERT_EQ(taosArrayGetSize(pUids), nTable / 8 + 1);
+  for (int32_t k = 0; k < (int32_t)taosArrayGetSize(pUids); k++) {
+    EXPECT_EQ(*(tb_uid_t *)taosArrayGet(pUids, k), kSuid + 1 + 4 * k);
+  }
+  taosArrayDestroy(pUids);
+}
+
+}  // namespace
+
+TEST(metaCreateTbBench, batch) {
+  SMetaBench  bench("metaCreateTbBatch");
+  SCreateReqs creates(1024);
+
+  // a name repeated in the batch is created once, the other request reports the existing table
+  std::vector<SVCreateTbReq *> reqPs(creates.reqPs);
+  SVCreateTbReq                dup = *reqPs[5];
+  dup.uid = kSuid + 100000;
+  reqPs.push_back(&dup);
+
+  std::vector<SVCreateTbRsp> rsps(reqPs.size());
+  EXPECT_EQ(metaCreateTables(bench.pMeta, ++bench.ver, reqPs.data(), reqPs.size(), rsps.data()), 0);
+  for (int32_t i = 0; i < (int32_t)creates.reqs.size(); i++) {
+    EXPECT_EQ(rsps[i].code, 0);
+    EXPECT_NE(rsps[i].pMeta, nullptr);
+  }
+  EXPECT_EQ(rsps.back().code, TSDB_CODE_TDB_TABLE_ALREADY_EXIST);
+  EXPECT_EQ(dup.uid, kSuid + 1 + 5);
+  for (auto &rsp : rsps) tFreeSVCreateTbRsp(&rsp);
+
+  checkTables(bench, creates.reqs.size());
+  checkIndexes(bench, creates.reqs.size());
+
+  // a second batch finds all of them
+  rsps.assign(creates.reqs.size(), SVCreateTbRsp{});
+  metaCreateTables(bench.pMeta, ++bench.ver, creates.reqPs.data(), creates.reqPs.size(), rsps.data());
+  for (auto &rsp : rsps) EXPECT_EQ(rsp.code, TSDB_CODE_TDB_TABLE_ALREADY_EXIST);
+}
+
+// child tables created per request and in batches of the size of a create table message, it is left out of the test
+// runs and run by hand with --gtest_also_run_disabled_tests
+TEST(metaCreateTbBench, DISABLED_tablesPerSecond) {
+  const int32_t nTable = 100000;
+  const int32_t nBatch = 1000;
+  SCreateReqs   creates(nTable);
+
+  for (int32_t batch = 0; batch < 2; batch++) {
+    SMetaBench bench(batch ? "metaCreateTbBatched" : "metaCreateTbSingle");
+
+    int64_t st = taosGetTimestampUs();
+    if (batch) {
+      std::vector<SVCreateTbRsp> rsps(nBatch);
+      for (int32_t i = 0; i < nTable; i += nBatch) {
+        ASSERT_EQ(metaCreateTables(bench.pMeta, ++bench.ver, &creates.reqPs[i], nBatch, rsps.data()), 0);
+        for (auto &rsp : rsps) tFreeSVCreateTbRsp(&rsp);
+        rsps.assign(nBatch, SVCreateTbRsp{});
+      }
+    } else {
+      for (int32_t i = 0; i < nTable; i++) {
+        ASSERT_EQ(metaCreateTable(bench.pMeta, ++bench.ver, creates.reqPs[i], NULL), 0);
+      }
+    }
+    int64_t et = taosGetTimestampUs();
+
+    checkTables(bench, nTable);
+    printf("%s: %d tables, %.0f tables/s\n", batch ? "batched" : "single", nTable, nTable * 1000000.0 / (et - st));
+  }
+}
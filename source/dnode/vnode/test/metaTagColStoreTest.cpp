@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "metaTestUtil.h"
+
+namespace {
+
+const tb_uid_t kSuid = 1000;
+
+struct STestTags {
+  int32_t     gid;
+  bool        hasLocation;
+  std::string location;
+};
+
+// a super table with an int tag and a varchar tag, its child table i is created with the tags (i % 10, "loc<i % 7>"),
+// and no varchar tag for every 5th table
+struct STagColStoreEnv : public SMetaTestEnv {
+  std::map<int32_t, STestTags> tags;  // the tags each child table has now
+
+  STagColStoreEnv() : SMetaTestEnv("metaTagColStoreTest", 256) {
+    SSchema gid = {TSDB_DATA_TYPE_INT, 0, 3, 4};
+    SSchema location = {TSDB_DATA_TYPE_VARCHAR, 0, 4, 16 + VARSTR_HEADER_SIZE};
+    strcpy(gid.name, "gid");
+    strcpy(location.name, "location");
+    createSTable(kSuid, "stb", {gid, location});
+  }
+
+  ~STagColStoreEnv() { tsTagColumnStore = false; }
+
+  void createTables(int32_t from, int32_t to) {
+    SArray *pTagVals = taosArrayInit(2, sizeof(STagVal));
+    for (int32_t i = from; i < to; i++) {
+      std::string name = "d" + std::to_string(i);
+      STestTags   t = {i % 10, i % 5 != 0, "loc" + std::to_string(i % 7)};
+
+      taosArrayClear(pTagVals);
+      STagVal gid = {.cid = 3, .type = TSDB_DATA_TYPE_INT};
+      gid.i64 = t.gid;
+      taosArrayPush(pTagVals, &gid);
+      if (t.hasLocation) {
+        STagVal loc = {.cid = 4, .type = TSDB_DATA_TYPE_VARCHAR};
+        loc.pData = (uint8_t *)t.location.c_str();
+        loc.nData = t.location.size();
+        taosArrayPush(pTagVals, &loc);
+      }
+      STag *pTag = NULL;
+      ASSERT_EQ(tTagNew(pTagVals, 1, false, &pTag), 0);
+
+      SVCreateTbReq req = {0};
+      req.name = (char *)name.c_str();
+      req.uid = kSuid + 1 + i;
+      req.type = TSDB_CHILD_TABLE;
+      req.ctb.suid = kSuid;
+      req.ctb.pTag = (uint8_t *)pTag;
+      EXPECT_EQ(metaCreateTable(pMeta, ++ver, &req, NULL), 0);
+      taosMemoryFree(pTag);
+      tags[i] = t;
+    }
+    taosArrayDestroy(pTagVals);
+  }
+
+  // alter table d<i> set tag location = ..., a NULL location sets it to null
+  void setLocation(int32_t i, const char *location) {
+    std::string   name = "d" + std::to_string(i);
+    SVAlterTbReq req = {0};
+    req.tbName = (char *)name.c_str();
+    req.action = TSDB_ALTER_TABLE_UPDATE_TAG_VAL;
+    req.tagName = (char *)"location";
+    req.tagType = TSDB_DATA_TYPE_VARCHAR;
+    req.isNull = (location == NULL);
+    if (location != NULL) {
+      req.pTagVal = (uint8_t *)location;
+      req.nTagVal = strlen(location);
+    }
+    ASSERT_EQ(metaAlterTable(pMeta, ++ver, &req, NULL), 0);
+
+    tags[i].hasLocation = (location != NULL);
+    tags[i].location = (location != NULL) ? location : "";
+  }
+
+  void dropTable(int32_t i) {
+    SMetaTestEnv::dropTable(("d" + std::to_string(i)).c_str());
+    tags.erase(i);
+  }
+
+  int64_t loads() {
+    int64_t n = 0;
+    metaGetTagColStoreStats(pMeta, &n);
+    return n;
+  }
+
+  void checkTags(SArray *pUidTagList, SSDataBlock *pBlock) {
+    ASSERT_EQ(pBlock->info.rows, taosArrayGetSize(pUidTagList));
+    for (int32_t row = 0; row < pBlock->info.rows; row++) {
+      int32_t i = ((STUidTagInfo *)taosArrayGet(pUidTagList, row))->uid - kSuid - 1;
+      ASSERT_EQ(tags.count(i), 1) << "table d" << i;
+      const STestTags &t = tags[i];
+
+      SColumnInfoData *pLoc = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0);
+      if (!t.hasLocation) {
+        EXPECT_TRUE(colDataIsNull_s(pLoc, row)) << "table d" << i;
+      } else {
+        char *data = colDataGetData(pLoc, row);
+        EXPECT_FALSE(colDataIsNull_s(pLoc, row)) << "table d" << i;
+        EXPECT_EQ(std::string(varDataVal(data), varDataLen(data)), t.location) << "table d" << i;
+      }
+
+      SColumnInfoData *pGid = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 1);
+      EXPECT_EQ(*(int32_t *)colDataGetData(pGid, row), t.gid) << "table d" << i;
+
+      if (taosArrayGetSize(pBlock->pDataBlock) > 2) {
+        SColumnInfoData *pName = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 2);
+        char            *data = colDataGetData(pName, row);
+        EXPECT_EQ(std::string(varDataVal(data), varDataLen(data)), "d" + std::to_string(i));
+      }
+    }
+  }
+
+  // the tags of all child tables served by the store
+  void checkAllTags() {
+    SArray      *pUidTagList = taosArrayInit(0, sizeof(STUidTagInfo));
+    SSDataBlock *pBlock = createTagBlock(true);
+    EXPECT_EQ(metaGetTableTagCols(pVnode, kSuid, pUidTagList, pBlock), 0);
+    EXPECT_EQ(taosArrayGetSize(pUidTagList), tags.size());
+    checkTags(pUidTagList, pBlock);
+    blockDataDestroy(pBlock);
+    taosArrayDestroy(pUidTagList);
+  }
+
+  static SSDataBlock *createTagBlock(bool withName) {
+    SSDataBlock    *pBlock = createDataBlock();
+    SColumnInfoData gid = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 3);
+    SColumnInfoData loc = createColumnInfoData(TSDB_DATA_TYPE_VARCHAR, 16 + VARSTR_HEADER_SIZE, 4);
+    blockDataAppendColInfo(pBlock, &loc);
+    blockDataAppendColInfo(pBlock, &gid);
+    if (withName) {
+      SColumnInfoData name =
+          createColumnInfoData(TSDB_DATA_TYPE_VARCHAR, TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE, -1);
+      blockDataAppendColInfo(pBlock, &name);
+    }
+    return pBlock;
+  }
+};
+
+}  // namespace
+
+TEST(metaTagColStoreTest, getTags) {
+  STagColStoreEnv env;
+  env.createTables(0, 1000);
+
+  // the store is off by default
+  SArray      *pUidTagList = taosArrayInit(0, sizeof(STUidTagInfo));
+  SSDataBlock *pBlock = env.createTagBlock(false);
+  EXPECT_EQ(metaGetTableTagCols(env.pVnode, kSuid, pUidTagList, pBlock), TSDB_CODE_OPS_NOT_SUPPORT);
+  blockDataDestroy(pBlock);
+
+  tsTagColumnStore = true;
+
+  // all child tables
+  pBlock = env.createTagBlock(false);
+  ASSERT_EQ(metaGetTableTagCols(env.pVnode, kSuid, pUidTagList, pBlock), 0);
+  EXPECT_EQ(taosArrayGetSize(pUidTagList), 1000);
+  env.checkTags(pUidTagList, pBlock);
+  blockDataDestroy(pBlock);
+
+  // tables created later are appended, the names are loaded once they are wanted
+  env.createTables(1000, 1100);
+  taosArrayClear(pUidTagList);
+  for (int32_t i = 1099; i >= 0; i -= 3) {
+    STUidTagInfo info = {.uid = (uint64_t)(kSuid + 1 + i)};
+    taosArrayPush(pUidTagList, &info);
+  }
+  pBlock = env.createTagBlock(true);
+  ASSERT_EQ(metaGetTableTagCols(env.pVnode, kSuid, pUidTagList, pBlock), 0);
+  env.checkTags(pUidTagList, pBlock);
+  blockDataDestroy(pBlock);
+
+  // a dropped table is taken out of the store, and a table it does not hold is not served
+  env.dropTable(7);
+  pBlock = env.createTagBlock(true);
+  EXPECT_EQ(metaGetTableTagCols(env.pVnode, kSuid, pUidTagList, pBlock), TSDB_CODE_OPS_NOT_SUPPORT);
+  blockDataDestroy(pBlock);
+
+  env.checkAllTags();
+  EXPECT_EQ(env.tags.size(), 1099);
+
+  // a table that is not a super table has no store
+  taosArrayClear(pUidTagList);
+  pBlock = env.createTagBlock(false);
+  EXPECT_NE(metaGetTableTagCols(env.pVnode, kSuid + 1, pUidTagList, pBlock), 0);
+  EXPECT_EQ(taosArrayGetSize(pUidTagList), 0);
+  blockDataDestroy(pBlock);
+
+  taosArrayDestroy(pUidTagList);
+}
+
+TEST(metaTagColStoreTest, retagTables) {
+  STagColStoreEnv env;
+  env.createTables(0, 100);
+  tsTagColumnStore = true;
+
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 1);
+
+  // the rows of the retagged tables are rewritten in place: a value changed, a null tag given a value and a value
+  // set to null, also for a table dropped and a table created meanwhile
+  env.setLocation(3, "moved");
+  env.setLocation(5, "was_null");
+  env.setLocation(6, NULL);
+  env.dropTable(1);
+  env.createTables(100, 101);
+  env.setLocation(99, "last");
+  env.setLocation(100, "new");
+  env.checkAllTags();
+
+  SArray *pUidTagList = taosArrayInit(0, sizeof(STUidTagInfo));
+  for (int32_t i : {100, 99, 6, 5, 3}) {
+    STUidTagInfo info = {.uid = (uint64_t)(kSuid + 1 + i)};
+    taosArrayPush(pUidTagList, &info);
+  }
+  SSDataBlock *pBlock = env.createTagBlock(false);
+  ASSERT_EQ(metaGetTableTagCols(env.pVnode, kSuid, pUidTagList, pBlock), 0);
+  env.checkTags(pUidTagList, pBlock);
+  blockDataDestroy(pBlock);
+  taosArrayDestroy(pUidTagList);
+
+  EXPECT_EQ(env.loads(), 1);
+}
+
+TEST(metaTagColStoreTest, reloadStaleStore) {
+  STagColStoreEnv env;
+  env.createTables(0, 100);
+  tsTagColumnStore = true;
+
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 1);
+
+  // each retag leaves the var data of the old row behind, up to 1024 of them the store is kept
+  for (int32_t n = 0; n < 1024; n++) {
+    env.setLocation(n % 100, ("r" + std::to_string(n)).c_str());
+  }
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 1);
+
+  // one more and it is dropped, the next use loads it again
+  env.setLocation(7, NULL);
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 2);
+
+  // the reloaded store is patched again
+  env.setLocation(7, "back");
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 2);
+}
+
+TEST(metaTagColStoreTest, largeStore) {
+  STagColStoreEnv env;
+  env.createTables(0, 30000);
+  tsTagColumnStore = true;
+
+  // the tags and names of this many tables take more than a megabyte, the store is still kept whole in the cache
+  SArray      *pUidTagList = taosArrayInit(0, sizeof(STUidTagInfo));
+  SSDataBlock *pBlock = env.createTagBlock(true);
+  ASSERT_EQ(metaGetTableTagCols(env.pVnode, kSuid, pUidTagList, pBlock), 0);
+  EXPECT_GT(blockDataGetSize(pBlock), 1024 * 1024);
+  env.checkTags(pUidTagList, pBlock);
+  blockDataDestroy(pBlock);
+  taosArrayDestroy(pUidTagList);
+
+  env.setLocation(29999, "last");
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 1);
+}
+
+TEST(metaTagColStoreTest, storeOverCapacity) {
+  // a store larger than the cache serves the call it is loaded for, and is loaded again for the next one
+  tsTagColumnStoreCacheSize = 1;
+  STagColStoreEnv env;
+  tsTagColumnStoreCacheSize = 64;
+  env.createTables(0, 30000);
+  tsTagColumnStore = true;
+
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 1);
+
+  env.setLocation(3, "moved");
+  env.dropTable(5);
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 2);
+
+  // a smaller super table still fits and is kept
+  for (int32_t i = 100; i < 30000; i++) env.dropTable(i);
+  env.checkAllTags();
+  env.checkAllTags();
+  EXPECT_EQ(env.loads(), 3);
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "metaTestUtil.h"
+
+SMetaTestEnv::SMetaTestEnv(const char *name, int32_t szCache) : path(std::string(TD_TMP_DIR_PATH) + name) {
+  pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+  pVnode->path = (char *)path.c_str();
+  pVnode->config.vgId = 2;
+  pVnode->config.szPage = 4096;
+  pVnode->config.szCache = szCache;
+  taosRemoveDir(pVnode->path);
+  taosMulMkDir(pVnode->path);
+
+  EXPECT_EQ(metaOpen(pVnode, &pMeta, 0), 0);
+  pVnode->pMeta = pMeta;
+  EXPECT_EQ(metaBegin(pMeta, META_BEGIN_HEAP_OS), 0);
+}
+
+SMetaTestEnv::~SMetaTestEnv() {
+  metaCommit(pMeta, pMeta->txn);
+  metaFinishCommit(pMeta, pMeta->txn);
+  metaClose(&pMeta);
+  taosRemoveDir(pVnode->path);
+  taosMemoryFree(pVnode);
+}
+
+void SMetaTestEnv::createSTable(tb_uid_t suid, const char *name, std::vector<SSchema> tags) {
+  SSchema cols[2] = {{TSDB_DATA_TYPE_TIMESTAMP, 0, 1, 8}, {TSDB_DATA_TYPE_DOUBLE, 0, 2, 8}};
+  strcpy(cols[0].name, "ts");
+  strcpy(cols[1].name, "v");
+
+  SVCreateStbReq req = {0};
+  req.name = (char *)name;
+  req.suid = suid;
+  req.schemaRow = {2, 1, cols};
+  req.schemaTag = {(int32_t)tags.size(), 1, tags.data()};
+  ASSERT_EQ(metaCreateSTable(pMeta, ++ver, &req), 0);
+}
+
+void SMetaTestEnv::dropTable(const char *name) {
+  SVDropTbReq req = {0};
+  req.name = (char *)name;
+  ASSERT_EQ(metaDropTable(pMeta, ++ver, &req, NULL, NULL), 0);
+}
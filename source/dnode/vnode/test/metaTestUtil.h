@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef META_TEST_UTIL_H
+#define META_TEST_UTIL_H
+
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "vnodeInt.h"
+
+// a meta store of its own, opened in a vnode that has nothing but the meta
+struct SMetaTestEnv {
+  std::string path;
+  SVnode     *pVnode = NULL;
+  SMeta      *pMeta = NULL;
+  int64_t     ver = 0;
+
+  SMetaTestEnv(const char *name, int32_t szCache);
+  ~SMetaTestEnv();
+
+  // a super table of a timestamp and a double column, with the tags given
+  void createSTable(tb_uid_t suid, const char *name, std::vector<SSchema> tags);
+
+  // drop the table as a drop table request does
+  void dropTable(const char *name);
+};
+
+#endif  // META_TEST_UTIL_H
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "metaTestUtil.h"
+
+namespace {
+
+const tb_uid_t kSuid = 1000;
+const int32_t  kChangeMax = 4096;  // TAG_FILTER_CHANGE_MAX
+
+// the uid lists cached for a tag condition of the super tables, the changes of child tables are recorded directly
+struct SUidCacheEnv : public SMetaTestEnv {
+  uint8_t digest[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+  SUidCacheEnv() : SMetaTestEnv("metaUidCacheTest", 256) {}
+
+  struct SCached {
+    bool                  acquired = false;
+    std::vector<uint64_t> uids;
+    std::vector<uint64_t> changed;
+    int64_t               ver = 0;
+    int64_t               cachedVer = 0;
+  };
+
+  SCached get(uint64_t suid) {
+    SCached res;
+    SArray *pList = taosArrayInit(8, sizeof(uint64_t));
+    SArray *pChanged = taosArrayInit(8, sizeof(uint64_t));
+    EXPECT_EQ(metaGetCachedTableUidList(pVnode, suid, digest, sizeof(digest), pList, &res.acquired, pChanged, &res.ver,
+                                        &res.cachedVer),
+              0);
+    for (int32_t i = 0; i < taosArrayGetSize(pList); i++) res.uids.push_back(*(uint64_t *)taosArrayGet(pList, i));
+    for (int32_t i = 0; i < taosArrayGetSize(pChanged); i++) {
+      res.changed.push_back(*(uint64_t *)taosArrayGet(pChanged, i));
+    }
+    taosArrayDestroy(pList);
+    taosArrayDestroy(pChanged);
+    return res;
+  }
+
+  void put(uint64_t suid, const std::vector<uint64_t> &uids, int64_t ver) {
+    int32_t size = sizeof(int32_t) + uids.size() * sizeof(uint64_t);
+    char   *pPayload = (char *)taosMemoryMalloc(size);
+    *(int32_t *)pPayload = uids.size();
+    if (!uids.empty()) memcpy(pPayload + sizeof(int32_t), uids.data(), uids.size() * sizeof(uint64_t));
+    EXPECT_EQ(metaUidFilterCachePut(pVnode, suid, digest, sizeof(digest), pPayload, size, 1, ver), 0);
+  }
+
+  // a query with no tag condition, all changed tables qualify, the patched list is put back as the executor does
+  SCached query(uint64_t suid) {
+    SCached res = get(suid);
+    if (res.acquired && res.cachedVer != res.ver) {
+      res.uids.insert(res.uids.end(), res.changed.begin(), res.changed.end());
+      put(suid, res.uids, res.ver);
+    }
+    return res;
+  }
+
+  void change(uint64_t suid, tb_uid_t uid, bool drop) {
+    EXPECT_EQ(metaUidCacheTableChanged(pMeta, suid, uid, drop), 0);
+  }
+
+  int64_t rebuilds() {
+    int64_t hits = 0, patches = 0, n = 0;
+    metaGetUidCacheStats(pMeta, &hits, &patches, &n);
+    return n;
+  }
+};
+
+}  // namespace
+
+TEST(metaUidCacheTest, patchList) {
+  SUidCacheEnv env;
+
+  SUidCacheEnv::SCached res = env.get(kSuid);
+  EXPECT_FALSE(res.acquired);
+  env.put(kSuid, {1, 2, 3, 4}, res.ver);
+
+  res = env.get(kSuid);
+  ASSERT_TRUE(res.acquired);
+  EXPECT_EQ(res.cachedVer, res.ver);
+  EXPECT_EQ(res.uids, std::vector<uint64_t>({1, 2, 3, 4}));
+  EXPECT_TRUE(res.changed.empty());
+
+  // a table created, one dropped, one retagged and one created then dropped
+  env.change(kSuid, 5, false);
+  env.change(kSuid, 2, true);
+  env.change(kSuid, 3, false);
+  env.change(kSuid, 6, false);
+  env.change(kSuid, 6, true);
+
+  int64_t cachedVer = res.ver;
+  res = env.get(kSuid);
+  ASSERT_TRUE(res.acquired);
+  EXPECT_EQ(res.cachedVer, cachedVer);
+  EXPECT_EQ(res.ver, cachedVer + 5);
+  EXPECT_EQ(res.uids, std::vector<uint64_t>({1, 4}));
+  EXPECT_EQ(res.changed, std::vector<uint64_t>({5, 3}));
+
+  // the list put back at the version observed is served as is
+  env.put(kSuid, {1, 4, 5, 3}, res.ver);
+  res = env.get(kSuid);
+  ASSERT_TRUE(res.acquired);
+  EXPECT_EQ(res.cachedVer, res.ver);
+  EXPECT_EQ(res.uids, std::vector<uint64_t>({1, 4, 5, 3}));
+
+  // a drop leaves nothing to evaluate, the list is still older than the changes
+  env.change(kSuid, 4, true);
+  res = env.get(kSuid);
+  ASSERT_TRUE(res.acquired);
+  EXPECT_EQ(res.cachedVer + 1, res.ver);
+  EXPECT_EQ(res.uids, std::vector<uint64_t>({1, 5, 3}));
+  EXPECT_TRUE(res.changed.empty());
+}
+
+TEST(metaUidCacheTest, trimChanges) {
+  SUidCacheEnv env;
+  const tb_uid_t kOtherSuid = kSuid + 1;
+
+  std::vector<uint64_t> uids;
+  for (uint64_t uid = 1; uid <= 100; uid++) uids.push_back(uid);
+  env.put(kSuid, uids, env.get(kSuid).ver);
+  env.put(kOtherSuid, uids, env.get(kOtherSuid).ver);
+  int64_t rebuilds = env.rebuilds();
+
+  // the tables dropped only leave the list to be put back as it is patched, the changes older than it are discarded
+  // instead of the list being cleared once there are too many of them
+  for (int32_t n = 0; n < 2 * kChangeMax; n++) {
+    env.change(kSuid, 1000 + n, true);
+    if (n % 1000 == 999) {
+      EXPECT_TRUE(env.query(kSuid).acquired) << "change " << n;
+    }
+  }
+  SUidCacheEnv::SCached res = env.query(kSuid);
+  ASSERT_TRUE(res.acquired);
+  EXPECT_EQ(res.uids, uids);
+  EXPECT_EQ(env.rebuilds(), rebuilds);
+
+  // a list not queried meanwhile is cleared, and evaluated again by the next query
+  for (int32_t n = 0; n <= kChangeMax; n++) env.change(kOtherSuid, 1000 + n, true);
+  EXPECT_FALSE(env.query(kOtherSuid).acquired);
+  EXPECT_EQ(env.rebuilds(), rebuilds + 1);
+}
@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "metaTestUtil.h"
+#include "tdatablock.h"
+
+namespace {
+
+const tb_uid_t kSuid = 1000;
+const tb_uid_t kNtbUid = 2000;
+const int64_t  kTs = 1700000000000;
+
+// the columns of a submit block of n rows: ts, v, null where i % vNullEvery == vNullEvery / 2, and w, which comes
+// with version 2 of the super table, null every 4th row
+struct SRows {
+  int32_t n;
+  int32_t vNullEvery;
+  bool    hasW;
+};
+
+bool vIsNull(const SRows &rows, int32_t i) { return rows.vNullEvery > 0 && i % rows.vNullEvery == rows.vNullEvery / 2; }
+bool wIsNull(const SRows &rows, int32_t i) { return !rows.hasW || i % 4 == 2; }
+
+// a super table (ts, v) with the child tables d0 and d1, altered to (ts, v, w) by alterSTable, and a normal table
+// (ts, v, w). The tq reader decodes into a result block of ts, v and w, as the stream scan sets it up
+struct STqReadEnv : public SMetaTestEnv {
+  SSchema    tags[1] = {{TSDB_DATA_TYPE_INT, 0, 4, 4}};
+  SWal      *pWal = NULL;
+  SWalReader walReader = {};
+  STqReader *pReader = NULL;
+
+  STqReadEnv() : SMetaTestEnv("tqReadTest", 256) {
+    strcpy(tags[0].name, "gid");
+    createSTable(kSuid, "stb", {tags[0]});
+    createChildTable(kSuid + 1, "d0");
+    createChildTable(kSuid + 2, "d1");
+
+    SSchema cols[3];
+    schemaOf(3, cols);
+    SVCreateTbReq req = {0};
+    req.name = (char *)"ntb";
+    req.uid = kNtbUid;
+    req.type = TSDB_NORMAL_TABLE;
+    req.ntb.schemaRow = {3, 1, cols};
+    EXPECT_EQ(metaCreateTable(pMeta, ++ver, &req, NULL), 0);
+
+    pWal = (SWal *)taosMemoryCalloc(1, sizeof(SWal));
+    pWal->cfg.vgId = 2;
+    walReader.pWal = pWal;
+    pReader = (STqReader *)taosMemoryCalloc(1, sizeof(STqReader));
+    pReader->pWalReader = &walReader;
+    pReader->pVnodeMeta = pMeta;
+    pReader->pResBlock = createDataBlock();
+    for (int32_t i = 0; i < 3; i++) {
+      SColumnInfoData col = createColumnInfoData(cols[i].type, cols[i].bytes, cols[i].colId);
+      EXPECT_EQ(blockDataAppendColInfo(pReader->pResBlock, &col), 0);
+    }
+  }
+
+  ~STqReadEnv() {
+    tDestroySubmitReq(&pReader->submit, TSDB_MSG_FLG_ENCODE);
+    pReader->pWalReader = NULL;
+    tqReaderClose(pReader);
+    taosMemoryFree(pWal);
+  }
+
+  // ts, v and w of the super table or the normal table, the first nCols of them
+  static void schemaOf(int32_t nCols, SSchema *cols) {
+    SSchema all[3] = {{TSDB_DATA_TYPE_TIMESTAMP, 0, 1, 8},
+                      {TSDB_DATA_TYPE_DOUBLE, 0, 2, 8},
+                      {TSDB_DATA_TYPE_VARCHAR, 0, 3, 16 + VARSTR_HEADER_SIZE}};
+    strcpy(all[0].name, "ts");
+    strcpy(all[1].name, "v");
+    strcpy(all[2].name, "w");
+    for (int32_t i = 0; i < nCols; i++) cols[i] = all[i];
+  }
+
+  void createChildTable(tb_uid_t uid, const char *name) {
+    SArray *pTagVals = taosArrayInit(1, sizeof(STagVal));
+    STagVal gid = {.cid = 4, .type = TSDB_DATA_TYPE_INT};
+    gid.i64 = uid;
+    taosArrayPush(pTagVals, &gid);
+    STag *pTag = NULL;
+    ASSERT_EQ(tTagNew(pTagVals, 1, false, &pTag), 0);
+
+    SVCreateTbReq req = {0};
+    req.name = (char *)name;
+    req.uid = uid;
+    req.type = TSDB_CHILD_TABLE;
+    req.ctb.suid = kSuid;
+    req.ctb.pTag = (uint8_t *)pTag;
+    EXPECT_EQ(metaCreateTable(pMeta, ++ver, &req, NULL), 0);
+    taosMemoryFree(pTag);
+    taosArrayDestroy(pTagVals);
+  }
+
+  // alter table stb add column w
+  void alterSTable() {
+    SSchema cols[3];
+    schemaOf(3, cols);
+    SVCreateStbReq req = {0};
+    req.name = (char *)"stb";
+    req.suid = kSuid;
+    req.schemaRow = {3, 2, cols};
+    req.schemaTag = {1, 1, tags};
+    ASSERT_EQ(metaAlterSTable(pMeta, ++ver, &req), 0);
+  }
+
+  // the submit msg of one table is the rows given, in the column format or in the row format
+  void submit(tb_uid_t suid, tb_uid_t uid, int32_t sver, bool colFmt, const SRows &rows) {
+    int32_t nCols = rows.hasW ? 3 : 2;
+    SSchema cols[3];
+    schemaOf(nCols, cols);
+
+    std::vector<std::string> ws(rows.n);
+    std::vector<SColVal>     vals(rows.n * nCols);
+    for (int32_t i = 0; i < rows.n; i++) {
+      SColVal *pVal = &vals[i * nCols];
+      pVal[0] = {.cid = 1, .type = TSDB_DATA_TYPE_TIMESTAMP, .flag = CV_FLAG_VALUE};
+      pVal[0].value.val = kTs + i;
+      pVal[1] = {.cid = 2, .type = TSDB_DATA_TYPE_DOUBLE, .flag = vIsNull(rows, i) ? CV_FLAG_NULL : CV_FLAG_VALUE};
+      double v = i * 1.5;
+      memcpy(&pVal[1].value.val, &v, sizeof(v));
+      if (nCols == 3) {
+        ws[i] = "w" + std::to_string(i);
+        pVal[2] = {.cid = 3, .type = TSDB_DATA_TYPE_VARCHAR, .flag = wIsNull(rows, i) ? CV_FLAG_NULL : CV_FLAG_VALUE};
+        if (!wIsNull(rows, i)) {
+          pVal[2].value.pData = (uint8_t *)ws[i].data();
+          pVal[2].value.nData = ws[i].size();
+        }
+      }
+    }
+
+    SSubmitTbData tbData = {0};
+    tbData.suid = suid;
+    tbData.uid = uid;
+    tbData.sver = sver;
+    if (colFmt) {
+      tbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+      tbData.aCol = taosArrayInit(nCols, sizeof(SColData));
+      for (int32_t c = 0; c < nCols; c++) {
+        SColData colData = {0};
+        tColDataInit(&colData, cols[c].colId, cols[c].type, 0);
+        for (int32_t i = 0; i < rows.n; i++) ASSERT_EQ(tColDataAppendValue(&colData, &vals[i * nCols + c]), 0);
+        taosArrayPush(tbData.aCol, &colData);
+      }
+    } else {
+      STSchema *pTSchema = tBuildTSchema(cols, nCols, sver);
+      SArray   *aColVal = taosArrayInit(nCols, sizeof(SColVal));
+      tbData.aRowP = taosArrayInit(rows.n, sizeof(SRow *));
+      for (int32_t i = 0; i < rows.n; i++) {
+        taosArrayClear(aColVal);
+        for (int32_t c = 0; c < nCols; c++) taosArrayPush(aColVal, &vals[i * nCols + c]);
+        SRow *pRow = NULL;
+        ASSERT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+        taosArrayPush(tbData.aRowP, &pRow);
+      }
+      taosArrayDestroy(aColVal);
+      tDestroyTSchema(pTSchema);
+    }
+
+    tDestroySubmitReq(&pReader->submit, TSDB_MSG_FLG_ENCODE);
+    pReader->submit.aSubmitTbData = taosArrayInit(1, sizeof(SSubmitTbData));
+    taosArrayPush(pReader->submit.aSubmitTbData, &tbData);
+    pReader->nextBlk = 0;
+    pReader->msg.ver = ++ver;
+  }
+
+  // retrieve the block submitted and check every value decoded
+  void retrieveAndCheck(const SRows &rows) {
+    SSDataBlock *pBlock = NULL;
+    ASSERT_EQ(tqRetrieveDataBlock(pReader, &pBlock, "tqReadTest"), 0);
+    ASSERT_EQ(pBlock->info.rows, rows.n);
+
+    SColumnInfoData *pTs = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData *pV = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 1);
+    SColumnInfoData *pW = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 2);
+    for (int32_t i = 0; i < rows.n; i++) {
+      ASSERT_FALSE(colDataIsNull_s(pTs, i));
+      EXPECT_EQ(*(int64_t *)colDataGetData(pTs, i), kTs + i) << "row " << i;
+
+      ASSERT_EQ(colDataIsNull_s(pV, i), vIsNull(rows, i)) << "row " << i;
+      if (!vIsNull(rows, i)) EXPECT_EQ(*(double *)colDataGetData(pV, i), i * 1.5) << "row " << i;
+
+      ASSERT_EQ(colDataIsNull_s(pW, i), wIsNull(rows, i)) << "row " << i;
+      if (!wIsNull(rows, i)) {
+        char *p = colDataGetData(pW, i);
+        EXPECT_EQ(std::string(varDataVal(p), varDataLen(p)), "w" + std::to_string(i)) << "row " << i;
+      }
+    }
+  }
+};
+
+}  // namespace
+
+TEST(tqReadTest, schemaCache) {
+  STqReadEnv env;
+  SRows      rows = {10, 3, false};
+
+  // the schema of the super table is loaded once for its child tables, the STSchema once the rows are decoded
+  env.submit(kSuid, kSuid + 1, 1, true, rows);
+  env.retrieveAndCheck(rows);
+  SSchemaWrapper *pWrapper = env.pReader->pSchemaWrapper;
+  ASSERT_NE(pWrapper, nullptr);
+  EXPECT_EQ(pWrapper->version, 1);
+  EXPECT_EQ(pWrapper->nCols, 2);
+  EXPECT_EQ(env.pReader->pTSchema, nullptr);
+
+  env.submit(kSuid, kSuid + 2, 1, false, rows);
+  env.retrieveAndCheck(rows);
+  EXPECT_EQ(env.pReader->pSchemaWrapper, pWrapper);
+  STSchema *pTSchema = env.pReader->pTSchema;
+  ASSERT_NE(pTSchema, nullptr);
+  EXPECT_EQ(pTSchema->version, 1);
+
+  env.submit(kSuid, kSuid + 1, 1, false, rows);
+  env.retrieveAndCheck(rows);
+  EXPECT_EQ(env.pReader->pSchemaWrapper, pWrapper);
+  EXPECT_EQ(env.pReader->pTSchema, pTSchema);
+
+  // another schema version swaps both of them
+  env.alterSTable();
+  rows.hasW = true;
+  env.submit(kSuid, kSuid + 2, 2, true, rows);
+  env.retrieveAndCheck(rows);
+  ASSERT_NE(env.pReader->pSchemaWrapper, nullptr);
+  EXPECT_EQ(env.pReader->cachedSchemaVer, 2);
+  EXPECT_EQ(env.pReader->pSchemaWrapper->version, 2);
+  EXPECT_EQ(env.pReader->pSchemaWrapper->nCols, 3);
+  EXPECT_EQ(env.pReader->pTSchema, nullptr);
+
+  env.submit(kSuid, kSuid + 1, 2, false, rows);
+  env.retrieveAndCheck(rows);
+  ASSERT_NE(env.pReader->pTSchema, nullptr);
+  EXPECT_EQ(env.pReader->pTSchema->version, 2);
+  EXPECT_EQ(env.pReader->pTSchema->numOfCols, 3);
+}
+
+TEST(tqReadTest, tableSwitch) {
+  STqReadEnv env;
+  SRows      stbRows = {10, 3, false};
+  SRows      ntbRows = {10, 3, true};
+
+  // the schema is kept by suid for child tables and by uid for a normal table
+  env.submit(kSuid, kSuid + 1, 1, false, stbRows);
+  env.retrieveAndCheck(stbRows);
+  EXPECT_EQ(env.pReader->cachedSchemaSuid, kSuid);
+  EXPECT_EQ(env.pReader->pSchemaWrapper->nCols, 2);
+
+  env.submit(0, kNtbUid, 1, false, ntbRows);
+  env.retrieveAndCheck(ntbRows);
+  EXPECT_EQ(env.pReader->cachedSchemaSuid, 0);
+  EXPECT_EQ(env.pReader->cachedSchemaUid, kNtbUid);
+  EXPECT_EQ(env.pReader->pSchemaWrapper->nCols, 3);
+  EXPECT_EQ(env.pReader->pTSchema->numOfCols, 3);
+
+  env.submit(kSuid, kSuid + 2, 1, false, stbRows);
+  env.retrieveAndCheck(stbRows);
+  EXPECT_EQ(env.pReader->cachedSchemaSuid, kSuid);
+  EXPECT_EQ(env.pReader->pSchemaWrapper->nCols, 2);
+  EXPECT_EQ(env.pReader->pTSchema->numOfCols, 2);
+
+  // a table the meta does not have leaves nothing cached
+  env.submit(0, kNtbUid + 1, 1, true, ntbRows);
+  SSDataBlock *pBlock = NULL;
+  EXPECT_LT(tqRetrieveDataBlock(env.pReader, &pBlock, "tqReadTest"), 0);
+  EXPECT_EQ(terrno, TSDB_CODE_TQ_TABLE_SCHEMA_NOT_FOUND);
+  EXPECT_EQ(env.pReader->pSchemaWrapper, nullptr);
+
+  env.submit(0, kNtbUid, 1, true, ntbRows);
+  env.retrieveAndCheck(ntbRows);
+  EXPECT_EQ(env.pReader->cachedSchemaUid, kNtbUid);
+}
+
+TEST(tqReadTest, bulkAndRowPaths) {
+  STqReadEnv env;
+
+  // v has no null, some nulls or only nulls, it is copied at once from the column format and value by value from the
+  // row format, w is a varchar copied value by value in both
+  for (int32_t vNullEvery : {0, 3, 1}) {
+    for (bool colFmt : {true, false}) {
+      SRows rows = {1000, vNullEvery, true};
+      env.submit(0, kNtbUid, 1, colFmt, rows);
+      env.retrieveAndCheck(rows);
+    }
+  }
+}
+
+TEST(tqReadTest, schemaVersionChange) {
+  STqReadEnv env;
+  SRows      v1 = {100, 3, false};
+  SRows      v2 = {100, 3, true};
+
+  // the rows of version 1 left in the wal are decoded with w null, the rows of version 2 with w, in any order
+  env.submit(kSuid, kSuid + 1, 1, true, v1);
+  env.retrieveAndCheck(v1);
+  env.alterSTable();
+  for (bool colFmt : {true, false}) {
+    env.submit(kSuid, kSuid + 1, 2, colFmt, v2);
+    env.retrieveAndCheck(v2);
+    env.submit(kSuid, kSuid + 2, 1, colFmt, v1);
+    env.retrieveAndCheck(v1);
+    env.submit(kSuid, kSuid + 2, 2, colFmt, v2);
+    env.retrieveAndCheck(v2);
+  }
+}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "tsdbTestUtil.h"
+
+extern "C" int32_t tsdbFileReadBlockColData(STsdbFD *fd, int64_t offset, const SDiskDataHdr *hdr, SBlockData *bData,
+                                            uint8_t **bufArr);
+
+namespace {
+
+const int32_t kSzPage = 4096;
+const int64_t kUid = 1001;
+const int64_t kBlockOffset = 100;
+
+// an uncompressed block keeps every column at its original size: a varchar of one byte a row takes 5 bytes a row, so
+// with 819 rows the filler in front of c4 is a page less one byte and the filler in front of c6, where the first row
+// has two more bytes, is a page and one byte
+const int32_t kNumOfRows = 819;
+enum { kCidTs = 1, kCidC2, kCidGapUnder, kCidC4, kCidGapOver, kCidC6, kCidNull, kCidNone };
+
+struct SBlockColReadEnv : public STsdbTestEnv {
+  std::string          dataPath = root + TD_DIRSEP + "v2f1ver1.data";
+  STSchema            *pTSchema = NULL;
+  SBlockData           bData;
+  SDiskDataHdr         hdr = {0};
+  int64_t              colOffset = 0;  // where the column headers of the block start in the file
+  std::vector<int32_t> colSizes;       // the size of the values of each column put, in cid order
+  STsdbFD             *pFD = NULL;
+  uint8_t             *bufArr[5] = {0};
+
+  SBlockColReadEnv() : STsdbTestEnv("tsdbBlockColReadTest") {
+    SSchema schema[8] = {{TSDB_DATA_TYPE_TIMESTAMP, 0, kCidTs, 8},
+                         {TSDB_DATA_TYPE_BIGINT, 0, kCidC2, 8},
+                         {TSDB_DATA_TYPE_VARCHAR, 0, kCidGapUnder, 8 + VARSTR_HEADER_SIZE},
+                         {TSDB_DATA_TYPE_BIGINT, 0, kCidC4, 8},
+                         {TSDB_DATA_TYPE_VARCHAR, 0, kCidGapOver, 8 + VARSTR_HEADER_SIZE},
+                         {TSDB_DATA_TYPE_BIGINT, 0, kCidC6, 8},
+                         {TSDB_DATA_TYPE_INT, 0, kCidNull, 4},
+                         {TSDB_DATA_TYPE_INT, 0, kCidNone, 4}};
+    pTSchema = tBuildTSchema(schema, 8, 1);
+    EXPECT_NE(pTSchema, nullptr);
+
+    EXPECT_EQ(tBlockDataCreate(&bData), 0);
+    TABLEID id = {.suid = 0, .uid = kUid};
+    EXPECT_EQ(tBlockDataInit(&bData, &id, pTSchema, NULL, 0), 0);
+
+    SArray *aColVal = taosArrayInit(8, sizeof(SColVal));
+    for (int32_t iRow = 0; iRow < kNumOfRows; iRow++) {
+      std::string gapOver = (iRow == 0) ? "xxx" : "x";
+
+      taosArrayClear(aColVal);
+      for (int16_t cid = kCidTs; cid <= kCidNone; cid++) {
+        SColVal cv = {.cid = cid, .type = pTSchema->columns[cid - 1].type, .flag = CV_FLAG_VALUE};
+        if (cid == kCidTs) {
+          cv.value.val = 1700000000000 + iRow;
+        } else if (cid == kCidGapUnder || cid == kCidGapOver) {
+          cv.value.pData = (uint8_t *)((cid == kCidGapUnder) ? "x" : gapOver.c_str());
+          cv.value.nData = (cid == kCidGapUnder) ? 1 : gapOver.size();
+        } else if (cid == kCidNull) {
+          cv.flag = CV_FLAG_NULL;
+        } else if (cid == kCidNone) {
+          cv.flag = CV_FLAG_NONE;
+        } else {
+          cv.value.val = (int64_t)iRow * cid * 7919;
+        }
+        taosArrayPush(aColVal, &cv);
+      }
+      tsdbTestAppendRow(&bData, pTSchema, aColVal, kUid, iRow);
+    }
+    taosArrayDestroy(aColVal);
+
+    // the block goes to the file behind a few bytes, so the columns do not start on a page
+    uint8_t *pOut = NULL;
+    uint8_t *aBuf[4] = {0};
+    int32_t  aBufN[4] = {0};
+    int32_t  szOut = 0;
+    EXPECT_EQ(tCmprBlockData(&bData, NO_COMPRESSION, &pOut, &szOut, aBuf, aBufN), 0);
+
+    int32_t n = tGetDiskDataHdr(pOut, &hdr);
+    colOffset = kBlockOffset + n + hdr.szUid + hdr.szVer + hdr.szKey;
+    for (int32_t nt = 0; nt < hdr.szBlkCol;) {
+      SBlockCol blockCol = {0};
+      nt += tGetBlockCol(pOut + (colOffset - kBlockOffset) + nt, &blockCol, hdr.fmtVer);
+      colSizes.push_back(blockCol.szBitmap + blockCol.szOffset + blockCol.szValue);
+    }
+
+    std::vector<uint8_t> content(kBlockOffset, 0);
+    content.insert(content.end(), pOut, pOut + szOut);
+    tsdbTestWriteDataFile(dataPath, content.data(), content.size(), kSzPage);
+    EXPECT_EQ(tsdbOpenFile(dataPath.c_str(), NULL, kSzPage, TD_FILE_READ, &pFD), 0);
+
+    tFree(pOut);
+    for (int32_t i = 0; i < 4; i++) tFree(aBuf[i]);
+  }
+
+  ~SBlockColReadEnv() {
+    for (int32_t i = 0; i < 5; i++) tFree(bufArr[i]);
+    tsdbCloseFile(&pFD);
+    tBlockDataDestroy(&bData);
+    tDestroyTSchema(pTSchema);
+  }
+
+  // read the columns given and check every value against the block written
+  void readAndCheck(std::vector<int16_t> cids) {
+    SBlockData bRead;
+    ASSERT_EQ(tBlockDataCreate(&bRead), 0);
+    TABLEID id = {.suid = 0, .uid = kUid};
+    ASSERT_EQ(tBlockDataInit(&bRead, &id, pTSchema, cids.data(), cids.size()), 0);
+    ASSERT_EQ(bRead.nColData, (int32_t)cids.size());
+
+    ASSERT_EQ(tsdbFileReadBlockColData(pFD, colOffset, &hdr, &bRead, bufArr), 0);
+
+    for (int32_t i = 0; i < bRead.nColData; i++) {
+      SColData *pActualCol = tBlockDataGetColDataByIdx(&bRead, i);
+      SColData *pExpectCol = tBlockDataGetColDataByIdx(&bData, pActualCol->cid - kCidC2);
+      ASSERT_EQ(pActualCol->cid, pExpectCol->cid);
+      ASSERT_EQ(pActualCol->flag, pExpectCol->flag) << "cid " << pActualCol->cid;
+      ASSERT_EQ(pActualCol->nVal, kNumOfRows) << "cid " << pActualCol->cid;
+
+      for (int32_t iRow = 0; iRow < kNumOfRows; iRow++) {
+        SColVal expect, actual;
+        tColDataGetValue(pExpectCol, iRow, &expect);
+        tColDataGetValue(pActualCol, iRow, &actual);
+        ASSERT_EQ(actual.flag, expect.flag) << "cid " << pActualCol->cid << " row " << iRow;
+        if (!COL_VAL_IS_VALUE(&expect)) continue;
+        if (IS_VAR_DATA_TYPE(expect.type)) {
+          ASSERT_EQ(std::string((char *)actual.value.pData, actual.value.nData),
+                    std::string((char *)expect.value.pData, expect.value.nData))
+              << "cid " << pActualCol->cid << " row " << iRow;
+        } else {
+          ASSERT_EQ(actual.value.val, expect.value.val) << "cid " << pActualCol->cid << " row " << iRow;
+        }
+      }
+    }
+
+    tBlockDataDestroy(&bRead);
+  }
+};
+
+}  // namespace
+
+TEST(tsdbBlockColReadTest, gapsAroundPage) {
+  SBlockColReadEnv env;
+
+  // the column headers are c2, the two fillers, c4, c6 and the null column, the column of none is not put
+  ASSERT_EQ(env.hdr.fmtVer, 0);
+  ASSERT_EQ(env.colSizes.size(), 6);
+  EXPECT_EQ(env.colSizes[1], kSzPage - 1);
+  EXPECT_EQ(env.colSizes[3], kSzPage + 1);
+  EXPECT_EQ(env.colSizes[5], 0);
+
+  // c2 and c4 are read together across the gap just under a page, c6 on its own after the gap just over a page
+  env.readAndCheck({kCidC2, kCidC4});
+  env.readAndCheck({kCidC4, kCidC6});
+  env.readAndCheck({kCidC2, kCidC4, kCidC6});
+  env.readAndCheck({kCidC2, kCidC6});
+
+  // the fillers read alone, and with the columns next to them in one run
+  env.readAndCheck({kCidGapUnder});
+  env.readAndCheck({kCidC2, kCidGapUnder, kCidC4, kCidGapOver, kCidC6});
+
+  // the null column and the column of none are filled without a read
+  env.readAndCheck({kCidNull, kCidNone});
+  env.readAndCheck({kCidC6, kCidNull, kCidNone});
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "tsdbTestUtil.h"
+
+namespace {
+
+const int32_t kNumOfRows = 2048;
+const int64_t kSuid = 1000;
+const int64_t kUid = 1001;
+
+// ts, v, a varchar of 5 values with NULL and NONE between them, a varchar of as many values as a dictionary can hold
+// and one of a value more
+enum { kCidTs = 1, kCidV, kCidCity, kCidDict256, kCidDict257 };
+
+std::string varcharOf(int16_t cid, int32_t iRow) {
+  switch (cid) {
+    case kCidCity:
+      return "city" + std::to_string(iRow % 5);
+    case kCidDict256:
+      return "d" + std::to_string(iRow % TSDB_COL_DICT_MAX_SIZE);
+    default:
+      return "e" + std::to_string(iRow % (TSDB_COL_DICT_MAX_SIZE + 1));
+  }
+}
+
+struct SBlockDataEnv {
+  STSchema  *pTSchema = NULL;
+  SBlockData bData;
+
+  SBlockDataEnv(int16_t *aCid = NULL, int32_t nCid = 0) {
+    SSchema schema[5] = {{TSDB_DATA_TYPE_TIMESTAMP, 0, kCidTs, 8},
+                         {TSDB_DATA_TYPE_INT, 0, kCidV, 4},
+                         {TSDB_DATA_TYPE_VARCHAR, 0, kCidCity, 16 + VARSTR_HEADER_SIZE},
+                         {TSDB_DATA_TYPE_VARCHAR, 0, kCidDict256, 16 + VARSTR_HEADER_SIZE},
+                         {TSDB_DATA_TYPE_VARCHAR, 0, kCidDict257, 16 + VARSTR_HEADER_SIZE}};
+    pTSchema = tBuildTSchema(schema, 5, 1);
+    EXPECT_NE(pTSchema, nullptr);
+
+    EXPECT_EQ(tBlockDataCreate(&bData), 0);
+    TABLEID id = {.suid = kSuid, .uid = kUid};
+    EXPECT_EQ(tBlockDataInit(&bData, &id, pTSchema, aCid, nCid), 0);
+
+    std::vector<std::string> values(3);
+    SArray                  *aColVal = taosArrayInit(5, sizeof(SColVal));
+    for (int32_t iRow = 0; iRow < kNumOfRows; iRow++) {
+      taosArrayClear(aColVal);
+      for (int16_t cid = kCidTs; cid <= kCidDict257; cid++) {
+        SColVal cv = {.cid = cid, .type = pTSchema->columns[cid - 1].type, .flag = CV_FLAG_VALUE};
+        if (cid == kCidTs) {
+          cv.value.val = 1700000000000 + iRow;
+        } else if (cid == kCidV) {
+          cv.value.val = iRow * 3;
+        } else if (cid == kCidCity && iRow % 10 == 3) {
+          cv.flag = CV_FLAG_NULL;
+        } else if (cid == kCidCity && iRow % 10 == 7) {
+          cv.flag = CV_FLAG_NONE;
+        } else {
+          std::string &value = values[cid - kCidCity];
+          value = varcharOf(cid, iRow);
+          cv.value.pData = (uint8_t *)value.data();
+          cv.value.nData = value.size();
+        }
+        taosArrayPush(aColVal, &cv);
+      }
+      tsdbTestAppendRow(&bData, pTSchema, aColVal, kUid, iRow);
+    }
+    taosArrayDestroy(aColVal);
+  }
+
+  ~SBlockDataEnv() {
+    tBlockDataDestroy(&bData);
+    tDestroyTSchema(pTSchema);
+  }
+};
+
+// the header and the column headers of a compressed block, the column headers keep the offset they are put at
+struct SCmprBlock {
+  SDiskDataHdr           hdr = {0};
+  int32_t                szKeys = 0;
+  int32_t                nBlkCol = 0;
+  std::vector<SBlockCol> blockCols;
+};
+
+SCmprBlock parseCmprBlock(uint8_t *pIn) {
+  SCmprBlock block;
+  int32_t    n = tGetDiskDataHdr(pIn, &block.hdr);
+  block.szKeys = n + block.hdr.szUid + block.hdr.szVer + block.hdr.szKey;
+  for (int32_t nt = 0; nt < block.hdr.szBlkCol;) {
+    SBlockCol blockCol = {0};
+    nt += tGetBlockCol(pIn + block.szKeys + nt, &blockCol, block.hdr.fmtVer);
+    block.blockCols.push_back(blockCol);
+  }
+  return block;
+}
+
+const SBlockCol *findBlockCol(const SCmprBlock &block, int16_t cid) {
+  for (const SBlockCol &blockCol : block.blockCols) {
+    if (blockCol.cid == cid) return &blockCol;
+  }
+  return NULL;
+}
+
+// every value of every column comes back, NULL and NONE included
+void checkBlockData(SBlockData *pExpect, SBlockData *pActual) {
+  ASSERT_EQ(pActual->suid, pExpect->suid);
+  ASSERT_EQ(pActual->uid, pExpect->uid);
+  ASSERT_EQ(pActual->nRow, pExpect->nRow);
+  ASSERT_EQ(pActual->nColData, pExpect->nColData);
+  EXPECT_EQ(memcmp(pActual->aTSKEY, pExpect->aTSKEY, sizeof(TSKEY) * pExpect->nRow), 0);
+  EXPECT_EQ(memcmp(pActual->aVersion, pExpect->aVersion, sizeof(int64_t) * pExpect->nRow), 0);
+
+  for (int32_t iColData = 0; iColData < pExpect->nColData; iColData++) {
+    SColData *pExpectCol = &pExpect->aColData[iColData];
+    SColData *pActualCol = &pActual->aColData[iColData];
+    ASSERT_EQ(pActualCol->cid, pExpectCol->cid);
+    ASSERT_EQ(pActualCol->flag, pExpectCol->flag);
+
+    for (int32_t iRow = 0; iRow < pExpect->nRow; iRow++) {
+      SColVal expect, actual;
+      tColDataGetValue(pExpectCol, iRow, &expect);
+      tColDataGetValue(pActualCol, iRow, &actual);
+      ASSERT_EQ(actual.flag, expect.flag) << "cid " << pExpectCol->cid << " row " << iRow;
+      if (!COL_VAL_IS_VALUE(&expect)) continue;
+      if (IS_VAR_DATA_TYPE(expect.type)) {
+        ASSERT_EQ(std::string((char *)actual.value.pData, actual.value.nData),
+                  std::string((char *)expect.value.pData, expect.value.nData))
+            << "cid " << pExpectCol->cid << " row " << iRow;
+      } else {
+        ASSERT_EQ(actual.value.val, expect.value.val) << "cid " << pExpectCol->cid << " row " << iRow;
+      }
+    }
+  }
+}
+
+struct SBufs {
+  uint8_t *pOut = NULL;
+  uint8_t *aBuf[4] = {0};
+  int32_t  aBufN[4] = {0};
+
+  ~SBufs() {
+    tFree(pOut);
+    for (int32_t i = 0; i < 4; i++) tFree(aBuf[i]);
+  }
+};
+
+}  // namespace
+
+TEST(tsdbBlockDataTest, dictRoundTrip) {
+  SBlockDataEnv env;
+  SBufs         bufs;
+  int32_t       szOut = 0;
+  ASSERT_EQ(tCmprBlockData(&env.bData, TWO_STAGE_COMP, &bufs.pOut, &szOut, bufs.aBuf, bufs.aBufN), 0);
+
+  SCmprBlock block = parseCmprBlock(bufs.pOut);
+  EXPECT_EQ(block.hdr.fmtVer, TSDB_DISK_DATA_FMT_VER);
+
+  // a column is dictionary encoded as long as its distinct values fit in the dictionary
+  const SBlockCol *pCity = findBlockCol(block, kCidCity);
+  ASSERT_NE(pCity, nullptr);
+  EXPECT_EQ(pCity->flag, HAS_NONE | HAS_NULL | HAS_VALUE);
+  EXPECT_EQ(pCity->encoding, TSDB_COL_ENCODING_DICT);
+  ASSERT_NE(findBlockCol(block, kCidDict256), nullptr);
+  EXPECT_EQ(findBlockCol(block, kCidDict256)->encoding, TSDB_COL_ENCODING_DICT);
+  ASSERT_NE(findBlockCol(block, kCidDict257), nullptr);
+  EXPECT_EQ(findBlockCol(block, kCidDict257)->encoding, TSDB_COL_ENCODING_PLAIN);
+
+  SBlockData bData;
+  ASSERT_EQ(tBlockDataCreate(&bData), 0);
+  ASSERT_EQ(tDecmprBlockData(bufs.pOut, szOut, &bData, bufs.aBuf), 0);
+  checkBlockData(&env.bData, &bData);
+  tBlockDataDestroy(&bData);
+}
+
+TEST(tsdbBlockDataTest, fmtVer0) {
+  // an uncompressed block keeps the format of version 0
+  {
+    SBlockDataEnv env;
+    SBufs         bufs;
+    int32_t       szOut = 0;
+    ASSERT_EQ(tCmprBlockData(&env.bData, NO_COMPRESSION, &bufs.pOut, &szOut, bufs.aBuf, bufs.aBufN), 0);
+
+    SCmprBlock block = parseCmprBlock(bufs.pOut);
+    EXPECT_EQ(block.hdr.fmtVer, 0);
+    for (const SBlockCol &blockCol : block.blockCols) EXPECT_EQ(blockCol.encoding, TSDB_COL_ENCODING_PLAIN);
+
+    SBlockData bData;
+    ASSERT_EQ(tBlockDataCreate(&bData), 0);
+    ASSERT_EQ(tDecmprBlockData(bufs.pOut, szOut, &bData, bufs.aBuf), 0);
+    checkBlockData(&env.bData, &bData);
+    tBlockDataDestroy(&bData);
+  }
+
+  // a compressed block written before dictionaries were there, it is rebuilt from a block with no dictionary column
+  // by putting its column headers without their encoding under a header of version 0
+  int16_t       aCid[] = {kCidV, kCidDict257};
+  SBlockDataEnv env(aCid, sizeof(aCid) / sizeof(aCid[0]));
+  SBufs         bufs;
+  int32_t       szOut = 0;
+  ASSERT_EQ(tCmprBlockData(&env.bData, TWO_STAGE_COMP, &bufs.pOut, &szOut, bufs.aBuf, bufs.aBufN), 0);
+
+  SCmprBlock block = parseCmprBlock(bufs.pOut);
+  ASSERT_EQ(block.hdr.fmtVer, TSDB_DISK_DATA_FMT_VER);
+  ASSERT_EQ(block.blockCols.size(), 2);
+
+  SDiskDataHdr hdr = block.hdr;
+  hdr.fmtVer = 0;
+  hdr.szBlkCol = 0;
+  for (SBlockCol &blockCol : block.blockCols) hdr.szBlkCol += tPutBlockCol(NULL, &blockCol, 0);
+  int32_t szHdr = tPutDiskDataHdr(NULL, &hdr);
+  int32_t szKeys = hdr.szUid + hdr.szVer + hdr.szKey;
+  int32_t szColData = szOut - block.szKeys - block.hdr.szBlkCol;
+
+  std::vector<uint8_t> v0(szHdr + szKeys + hdr.szBlkCol + szColData);
+  int32_t              n = tPutDiskDataHdr(v0.data(), &hdr);
+  memcpy(v0.data() + n, bufs.pOut + block.szKeys - szKeys, szKeys);
+  n += szKeys;
+  for (SBlockCol &blockCol : block.blockCols) n += tPutBlockCol(v0.data() + n, &blockCol, 0);
+  memcpy(v0.data() + n, bufs.pOut + block.szKeys + block.hdr.szBlkCol, szColData);
+  ASSERT_EQ(n + szColData, (int32_t)v0.size());
+
+  SBlockData bData;
+  ASSERT_EQ(tBlockDataCreate(&bData), 0);
+  ASSERT_EQ(tDecmprBlockData(v0.data(), v0.size(), &bData, bufs.aBuf), 0);
+  checkBlockData(&env.bData, &bData);
+  tBlockDataDestroy(&bData);
+}
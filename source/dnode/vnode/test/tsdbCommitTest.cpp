@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "meta.h"
+#include "tsdbFS2.h"
+#include "tsdbFSet2.h"
+#include "tsdbSttFileRW.h"
+#include "tsdbTestUtil.h"
+#include "vnd.h"
+
+extern "C" int32_t tsdbPreCommit(STsdb *tsdb);
+extern "C" int32_t tsdbCommitBegin(STsdb *tsdb, SCommitInfo *info);
+extern "C" int32_t tsdbCommitCommit(STsdb *tsdb);
+
+namespace {
+
+const int32_t  kSzPage = 4096;
+const int32_t  kDay = 1440;  // in minutes
+const tb_uid_t kSuid = 1000;
+const int32_t  kNumOfTables = 4;  // child tables kSuid + 1, ..., a uid past them is a table dropped from the meta
+
+// a vnode with its meta, its tsdb and a buffer pool for the memtables, the commits write stt files only
+struct SCommitEnv : public STsdbTestEnv {
+  SMeta    *pMeta = NULL;
+  STSchema *pTSchema = NULL;
+  int64_t   ver = 0;
+  int32_t   firstFid = 0;  // the file set of 20 days ago
+
+  SCommitEnv() : STsdbTestEnv("tsdbCommitTest") {
+    pVnode->config.szPage = kSzPage;
+    pVnode->config.szCache = 256;
+    pVnode->config.szBuf = 16 << 20;
+    pVnode->config.tsdbPageSize = kSzPage;
+    pVnode->config.sttTrigger = 8;
+    pVnode->config.tsdbCfg.minRows = 10;
+    pVnode->config.tsdbCfg.maxRows = 4096;
+    pVnode->config.tsdbCfg.compression = TWO_STAGE_COMP;
+    taosThreadMutexInit(&pVnode->mutex, NULL);
+    taosThreadCondInit(&pVnode->poolNotEmpty, NULL);
+    openTfs(1);
+
+    EXPECT_EQ(metaOpen(pVnode, &pMeta, 0), 0);
+    pVnode->pMeta = pMeta;
+    EXPECT_EQ(metaBegin(pMeta, META_BEGIN_HEAP_OS), 0);
+    createTables();
+
+    STsdbKeepCfg keepCfg = {0};
+    keepCfg.precision = TSDB_TIME_PRECISION_MILLI;
+    keepCfg.days = kDay;
+    keepCfg.keep0 = keepCfg.keep1 = keepCfg.keep2 = 3650 * kDay;
+    openTsdb(&keepCfg);
+
+    // the buffer pool in use, as the vnode takes it from the free list
+    EXPECT_EQ(vnodeOpenBufPool(pVnode), 0);
+    pVnode->inUse = pVnode->freeList;
+    pVnode->inUse->nRef = 1;
+    pVnode->freeList = pVnode->inUse->freeNext;
+    pVnode->inUse->freeNext = NULL;
+    EXPECT_EQ(tsdbMemTableCreate(pTsdb, &pTsdb->mem), 0);
+
+    firstFid = tsdbKeyFid((taosGetTimestampSec() - 20 * 86400LL) * 1000, kDay, TSDB_TIME_PRECISION_MILLI);
+  }
+
+  ~SCommitEnv() {
+    closeTsdb();
+    metaCommit(pMeta, pMeta->txn);
+    metaFinishCommit(pMeta, pMeta->txn);
+    metaClose(&pMeta);
+    vnodeCloseBufPool(pVnode);
+    taosThreadCondDestroy(&pVnode->poolNotEmpty);
+    taosThreadMutexDestroy(&pVnode->mutex);
+    tDestroyTSchema(pTSchema);
+  }
+
+  void createTables() {
+    SSchema cols[2] = {{TSDB_DATA_TYPE_TIMESTAMP, 0, 1, 8}, {TSDB_DATA_TYPE_INT, 0, 2, 4}};
+    SSchema tags[1] = {{TSDB_DATA_TYPE_INT, 0, 3, 4}};
+    strcpy(cols[0].name, "ts");
+    strcpy(cols[1].name, "v");
+    strcpy(tags[0].name, "gid");
+    pTSchema = tBuildTSchema(cols, 2, 1);
+
+    SVCreateStbReq stbReq = {0};
+    stbReq.name = (char *)"stb";
+    stbReq.suid = kSuid;
+    stbReq.schemaRow = {2, 1, cols};
+    stbReq.schemaTag = {1, 1, tags};
+    ASSERT_EQ(metaCreateSTable(pMeta, ++ver, &stbReq), 0);
+
+    SArray *pTagVals = taosArrayInit(1, sizeof(STagVal));
+    for (int32_t i = 0; i < kNumOfTables; i++) {
+      std::string name = "d" + std::to_string(i);
+
+      taosArrayClear(pTagVals);
+      STagVal gid = {.cid = 3, .type = TSDB_DATA_TYPE_INT};
+      gid.i64 = i;
+      taosArrayPush(pTagVals, &gid);
+      STag *pTag = NULL;
+      ASSERT_EQ(tTagNew(pTagVals, 1, false, &pTag), 0);
+
+      SVCreateTbReq req = {0};
+      req.name = (char *)name.c_str();
+      req.uid = kSuid + 1 + i;
+      req.type = TSDB_CHILD_TABLE;
+      req.ctb.suid = kSuid;
+      req.ctb.pTag = (uint8_t *)pTag;
+      EXPECT_EQ(metaCreateTable(pMeta, ++ver, &req, NULL), 0);
+      taosMemoryFree(pTag);
+    }
+    taosArrayDestroy(pTagVals);
+  }
+
+  TSKEY fidMinKey(int32_t fid) {
+    TSKEY minKey, maxKey;
+    tsdbFidKeyRange(fid, kDay, TSDB_TIME_PRECISION_MILLI, &minKey, &maxKey);
+    return minKey;
+  }
+
+  // nRow rows of the table, one a minute from the start of the file set
+  void insert(tb_uid_t uid, int32_t fid, int32_t nRow) {
+    SArray *aColVal = taosArrayInit(2, sizeof(SColVal));
+    SArray *aRowP = taosArrayInit(nRow, sizeof(SRow *));
+    for (int32_t iRow = 0; iRow < nRow; iRow++) {
+      taosArrayClear(aColVal);
+      SColVal ts = {.cid = 1, .type = TSDB_DATA_TYPE_TIMESTAMP, .flag = CV_FLAG_VALUE};
+      ts.value.val = fidMinKey(fid) + iRow * 60000LL;
+      SColVal v = {.cid = 2, .type = TSDB_DATA_TYPE_INT, .flag = CV_FLAG_VALUE};
+      v.value.val = iRow;
+      taosArrayPush(aColVal, &ts);
+      taosArrayPush(aColVal, &v);
+
+      SRow *pRow = NULL;
+      ASSERT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+      taosArrayPush(aRowP, &pRow);
+    }
+
+    SSubmitTbData data = {0};
+    data.suid = kSuid;
+    data.uid = uid;
+    data.sver = 1;
+    data.aRowP = aRowP;
+    int32_t affectedRows = 0;
+    EXPECT_EQ(tsdbInsertTableData(pTsdb, ++ver, &data, &affectedRows), 0);
+    EXPECT_EQ(affectedRows, nRow);
+
+    for (int32_t iRow = 0; iRow < nRow; iRow++) tRowDestroy(*(SRow **)taosArrayGet(aRowP, iRow));
+    taosArrayDestroy(aRowP);
+    taosArrayDestroy(aColVal);
+  }
+
+  void del(tb_uid_t uid, int32_t fromFid, int32_t toFid) {
+    TSKEY minKey, maxKey;
+    tsdbFidKeyRange(toFid, kDay, TSDB_TIME_PRECISION_MILLI, &minKey, &maxKey);
+    EXPECT_EQ(tsdbDeleteTableData(pTsdb, ++ver, kSuid, uid, fidMinKey(fromFid), maxKey), 0);
+  }
+
+  void commit() {
+    SCommitInfo info = {0};
+    info.info.config = pVnode->config;
+    info.pVnode = pVnode;
+
+    ASSERT_EQ(tsdbPreCommit(pTsdb), 0);
+    ASSERT_EQ(tsdbCommitBegin(pTsdb, &info), 0);
+    ASSERT_EQ(tsdbCommitCommit(pTsdb), 0);
+    ASSERT_EQ(tsdbMemTableCreate(pTsdb, &pTsdb->mem), 0);
+  }
+
+  // the fids of the file sets in the file system
+  std::vector<int32_t> fids() {
+    std::vector<int32_t> res;
+    STFileSet           *fset;
+    TARRAY2_FOREACH(pTsdb->pFS->fSetArr, fset) { res.push_back(fset->fid); }
+    return res;
+  }
+
+  struct SSttStat {
+    int32_t nFile = 0;
+    int64_t nRow = 0;
+    int32_t nTomb = 0;
+    int64_t cid = 0;  // of the last file
+    TSKEY   minKey = TSKEY_MAX;
+    TSKEY   maxKey = TSKEY_MIN;
+  };
+
+  // the rows and tomb records in the stt files of the file set
+  SSttStat sttStat(int32_t fid) {
+    SSttStat   stat;
+    STFileSet *fset = NULL;
+    EXPECT_EQ(tsdbFSGetFSet(pTsdb->pFS, fid, &fset), 0);
+    if (fset == NULL) return stat;
+
+    SSttLvl *lvl = tsdbTFileSetGetSttLvl(fset, 0);
+    if (lvl == NULL) return stat;
+
+    STFileObj *fobj;
+    TARRAY2_FOREACH(lvl->fobjArr, fobj) {
+      SSttFileReaderConfig config = {0};
+      config.tsdb = pTsdb;
+      config.szPage = kSzPage;
+      config.file[0] = fobj->f[0];
+
+      SSttFileReader *reader = NULL;
+      EXPECT_EQ(tsdbSttFileReaderOpen(NULL, &config, &reader), 0);
+      if (reader == NULL) continue;
+
+      const TSttBlkArray *sttBlkArray = NULL;
+      EXPECT_EQ(tsdbSttFileReadSttBlk(reader, &sttBlkArray), 0);
+      const SSttBlk *sttBlk;
+      TARRAY2_FOREACH_PTR(sttBlkArray, sttBlk) {
+        stat.nRow += sttBlk->nRow;
+        stat.minKey = TMIN(stat.minKey, sttBlk->minKey);
+        stat.maxKey = TMAX(stat.maxKey, sttBlk->maxKey);
+      }
+
+      const TTombBlkArray *tombBlkArray = NULL;
+      EXPECT_EQ(tsdbSttFileReadTombBlk(reader, &tombBlkArray), 0);
+      const STombBlk *tombBlk;
+      TARRAY2_FOREACH_PTR(tombBlkArray, tombBlk) { stat.nTomb += tombBlk->numRec; }
+
+      tsdbSttFileReaderClose(&reader);
+      stat.nFile++;
+      stat.cid = fobj->f->cid;
+    }
+    return stat;
+  }
+};
+
+}  // namespace
+
+TEST(tsdbCommitTest, planFileSets) {
+  SCommitEnv env;
+  int32_t    fid = env.firstFid;
+
+  // the file sets the rows of each table fall in, not those in between, nor those of a table no longer in the meta
+  env.insert(kSuid + 1, fid, 100);
+  env.insert(kSuid + 1, fid + 3, 50);
+  env.insert(kSuid + 2, fid + 1, 30);
+  env.insert(kSuid + 2, fid + 3, 20);
+  env.insert(kSuid + 1 + kNumOfTables, fid + 5, 10);
+  env.commit();
+
+  EXPECT_EQ(env.fids(), std::vector<int32_t>({fid, fid + 1, fid + 3}));
+  for (int32_t f : {fid, fid + 1, fid + 3}) {
+    SCommitEnv::SSttStat stat = env.sttStat(f);
+    EXPECT_EQ(stat.nFile, 1) << "fid " << f;
+    EXPECT_EQ(stat.nTomb, 0) << "fid " << f;
+    EXPECT_GE(stat.minKey, env.fidMinKey(f)) << "fid " << f;
+    EXPECT_LT(stat.maxKey, env.fidMinKey(f + 1)) << "fid " << f;
+  }
+  EXPECT_EQ(env.sttStat(fid).nRow, 100);
+  EXPECT_EQ(env.sttStat(fid + 1).nRow, 30);
+  EXPECT_EQ(env.sttStat(fid + 3).nRow, 70);
+
+  // tomb data goes to the existing file sets it overlaps, it creates none
+  env.del(kSuid + 3, fid + 1, fid + 2);
+  env.del(kSuid + 4, fid + 7, fid + 7);
+  env.commit();
+
+  EXPECT_EQ(env.fids(), std::vector<int32_t>({fid, fid + 1, fid + 3}));
+  SCommitEnv::SSttStat stat = env.sttStat(fid + 1);
+  EXPECT_EQ(stat.nFile, 2);
+  EXPECT_EQ(stat.nRow, 30);
+  EXPECT_EQ(stat.nTomb, 1);
+  EXPECT_EQ(env.sttStat(fid).nFile, 1);
+  EXPECT_EQ(env.sttStat(fid + 3).nFile, 1);
+}
+
+TEST(tsdbCommitTest, commitFileSetsInParallel) {
+  SCommitEnv    env;
+  const int32_t nFSet = 16;
+
+  // each table has rows in every other file set and tomb data over all of them
+  std::map<int32_t, int64_t> rows;
+  for (int32_t i = 0; i < kNumOfTables; i++) {
+    for (int32_t f = i % 2; f < nFSet; f += 2) {
+      env.insert(kSuid + 1 + i, env.firstFid + f, 200 + f * 10 + i);
+      rows[env.firstFid + f] += 200 + f * 10 + i;
+    }
+  }
+  env.commit();
+
+  std::vector<int32_t> fids = env.fids();
+  ASSERT_EQ((int32_t)fids.size(), nFSet);
+  int64_t cid = env.sttStat(fids[0]).cid;
+  for (int32_t f = 0; f < nFSet; f++) {
+    SCommitEnv::SSttStat stat = env.sttStat(fids[f]);
+    EXPECT_EQ(fids[f], env.firstFid + f);
+    EXPECT_EQ(stat.nFile, 1) << "fid " << fids[f];
+    EXPECT_EQ(stat.nRow, rows[fids[f]]) << "fid " << fids[f];
+
+    // the file sets are committed as one edit
+    EXPECT_EQ(stat.cid, cid) << "fid " << fids[f];
+  }
+
+  // a delete over all file sets reaches each of them
+  env.del(kSuid + 1, env.firstFid, env.firstFid + nFSet - 1);
+  env.commit();
+  ASSERT_EQ((int32_t)env.fids().size(), nFSet);
+  for (int32_t f = 0; f < nFSet; f++) {
+    SCommitEnv::SSttStat stat = env.sttStat(env.firstFid + f);
+    EXPECT_EQ(stat.nFile, 2) << "fid " << env.firstFid + f;
+    EXPECT_EQ(stat.nTomb, 1) << "fid " << env.firstFid + f;
+    EXPECT_EQ(stat.nRow, rows[env.firstFid + f]) << "fid " << env.firstFid + f;
+  }
+}
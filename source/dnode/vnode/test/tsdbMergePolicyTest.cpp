@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "tsdbMergePolicy.h"
+
+namespace {
+
+// one file set, committed to with files of a fixed size and merged the way tsdbMerge() applies a plan, no row is
+// ever deduplicated so the sizes only move between levels
+struct SMergeSim {
+  const STsdbMergePolicy           *policy;
+  SMergePolicyConfig                config;
+  std::vector<std::vector<int64_t>> levels;  // stt files of level 0, 1, ...
+  int64_t                           dataSize = 0;
+  int64_t                           ingestBytes = 0;
+  int64_t                           mergeWriteBytes = 0;
+  int64_t                           mergeReadBytes = 0;
+  int32_t                           numOfMerge = 0;
+  int32_t                           numOfDataMerge = 0;  // merges that rewrite the data files
+
+  SMergeSim(int32_t policy, int32_t sttTrigger, int64_t levelBaseSize) : policy(tsdbGetMergePolicy(policy)) {
+    config.sttTrigger = sttTrigger;
+    config.levelBaseSize = levelBaseSize;
+  }
+
+  void commit(int64_t size) {
+    if (levels.empty()) levels.resize(1);
+    levels[0].push_back(size);
+    ingestBytes += size;
+
+    if ((int32_t)levels[0].size() >= config.sttTrigger) merge();
+  }
+
+  void merge() {
+    SMergeLevel mlevels[TSDB_MERGE_MAX_LEVEL];
+    int32_t     nLevel = 0;
+    for (int32_t i = 0; i < (int32_t)levels.size() && levels[i].size() > 0; i++) {
+      mlevels[nLevel].level = i;
+      mlevels[nLevel].nFile = levels[i].size();
+      mlevels[nLevel].size = 0;
+      for (int64_t size : levels[i]) mlevels[nLevel].size += size;
+      nLevel++;
+    }
+
+    SMergePlan plan = {0};
+    policy->pick(&config, mlevels, nLevel, &plan);
+    if (plan.nLevel == 0) return;
+
+    int64_t size = 0;
+    for (int32_t i = 0; i < plan.nLevel; i++) {
+      for (int32_t j = 0; j < plan.nFile[i]; j++) size += levels[i][j];
+      levels[i].erase(levels[i].begin(), levels[i].begin() + plan.nFile[i]);
+    }
+
+    if (plan.toData) {
+      dataSize += size;
+      numOfDataMerge++;
+    } else {
+      if ((int32_t)levels.size() <= plan.toLevel) levels.resize(plan.toLevel + 1);
+      levels[plan.toLevel].push_back(size);
+    }
+    mergeReadBytes += size;
+    mergeWriteBytes += size;
+    numOfMerge++;
+  }
+
+  double writeAmp() const { return (double)(ingestBytes + mergeWriteBytes) / ingestBytes; }
+
+  int32_t numOfSttFiles() const {
+    int32_t n = 0;
+    for (auto &lvl : levels) n += lvl.size();
+    return n;
+  }
+};
+
+}  // namespace
+
+TEST(tsdbMergePolicyTest, getPolicy) {
+  EXPECT_STREQ(tsdbGetMergePolicy(TSDB_MERGE_POLICY_TIERED)->name, "tiered");
+  EXPECT_STREQ(tsdbGetMergePolicy(TSDB_MERGE_POLICY_LEVELED)->name, "leveled");
+  EXPECT_STREQ(tsdbGetMergePolicy(-1)->name, "tiered");
+  EXPECT_STREQ(tsdbGetMergePolicy(TSDB_MERGE_POLICY_MAX)->name, "tiered");
+}
+
+TEST(tsdbMergePolicyTest, tiered) {
+  const STsdbMergePolicy  *policy = tsdbGetMergePolicy(TSDB_MERGE_POLICY_TIERED);
+  const SMergePolicyConfig config = {.sttTrigger = 4, .levelBaseSize = 64};
+  SMergePlan               plan;
+
+  // a level with sttTrigger - 1 files is merged along with level 0, the next level takes the result
+  SMergeLevel levels[] = {{0, 4, 4}, {1, 3, 12}, {2, 2, 32}};
+  policy->pick(&config, levels, 3, &plan);
+  EXPECT_EQ(plan.nLevel, 2);
+  EXPECT_EQ(plan.nFile[0], 4);
+  EXPECT_EQ(plan.nFile[1], 3);
+  EXPECT_EQ(plan.toLevel, 2);
+  EXPECT_FALSE(plan.toData);
+
+  // with all levels merged, the data files take the result
+  levels[2].nFile = 3;
+  policy->pick(&config, levels, 3, &plan);
+  EXPECT_EQ(plan.nLevel, 3);
+  EXPECT_TRUE(plan.toData);
+
+  // a level out of sequence stops the merge
+  levels[1].level = 2;
+  policy->pick(&config, levels, 3, &plan);
+  EXPECT_EQ(plan.nLevel, 1);
+  EXPECT_EQ(plan.toLevel, 1);
+  EXPECT_FALSE(plan.toData);
+
+  // with no stt level below level 0, each merge goes to the data files and every byte is written twice
+  SMergeSim sim(TSDB_MERGE_POLICY_TIERED, 4, 64);
+  for (int32_t i = 0; i < 1024; i++) sim.commit(1);
+  EXPECT_EQ(sim.numOfMerge, 256);
+  EXPECT_EQ(sim.mergeWriteBytes, 1024);
+  EXPECT_EQ(sim.mergeReadBytes, 1024);
+  EXPECT_EQ(sim.dataSize, 1024);
+  EXPECT_EQ(sim.numOfSttFiles(), 0);
+  EXPECT_DOUBLE_EQ(sim.writeAmp(), 2.0);
+}
+
+TEST(tsdbMergePolicyTest, leveled) {
+  SMergeSim sim(TSDB_MERGE_POLICY_LEVELED, 4, 64);
+
+  // level 0 is merged with level 1 into one level 1 file until it outgrows the target size of level 1
+  for (int32_t i = 0; i < 64; i++) sim.commit(1);
+  ASSERT_EQ(sim.levels.size(), 2);
+  EXPECT_EQ(sim.levels[0].size(), 0);
+  EXPECT_EQ(sim.levels[1].size(), 1);
+  EXPECT_EQ(sim.levels[1][0], 64);
+
+  // then level 1 goes on into level 2
+  for (int32_t i = 0; i < 4; i++) sim.commit(1);
+  ASSERT_EQ(sim.levels.size(), 3);
+  EXPECT_EQ(sim.levels[1].size(), 0);
+  EXPECT_EQ(sim.levels[2].size(), 1);
+  EXPECT_EQ(sim.levels[2][0], 68);
+
+  // each stt level keeps at most one file
+  for (int32_t i = 68; i < 4096; i++) {
+    sim.commit(1);
+    for (int32_t level = 1; level < (int32_t)sim.levels.size(); level++) {
+      ASSERT_LE(sim.levels[level].size(), 1);
+    }
+    ASSERT_LE((int32_t)sim.levels.size(), TSDB_MERGE_LEVELED_MAX_LEVEL + 1);
+  }
+  EXPECT_EQ(sim.ingestBytes, 4096);
+  EXPECT_EQ(sim.mergeWriteBytes, sim.mergeReadBytes);
+  EXPECT_GT(sim.dataSize, 0);
+  EXPECT_LE(sim.numOfSttFiles(), TSDB_MERGE_LEVELED_MAX_LEVEL + 3);
+}
+
+TEST(tsdbMergePolicyTest, amplification) {
+  SMergeSim tiered(TSDB_MERGE_POLICY_TIERED, 8, 16);
+  SMergeSim leveled(TSDB_MERGE_POLICY_LEVELED, 8, 16);
+
+  for (int32_t i = 0; i < 8192; i++) {
+    tiered.commit(1);
+    leveled.commit(1);
+  }
+
+  // tiered hands every batch of level 0 files to the data files
+  EXPECT_EQ(tiered.mergeWriteBytes, 8192);
+  EXPECT_EQ(tiered.numOfDataMerge, 1024);
+  EXPECT_EQ(tiered.numOfSttFiles(), 0);
+  EXPECT_DOUBLE_EQ(tiered.writeAmp(), 2.0);
+
+  // leveled rewrites the stt levels more often, and rewrites the data files far less often
+  EXPECT_EQ(leveled.mergeWriteBytes, 65000);
+  EXPECT_EQ(leveled.numOfDataMerge, 7);
+  EXPECT_EQ(leveled.numOfSttFiles(), 2);
+  EXPECT_DOUBLE_EQ(leveled.writeAmp(), (8192.0 + 65000.0) / 8192.0);
+}
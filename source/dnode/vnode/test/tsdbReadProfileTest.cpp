@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "tsdbTestUtil.h"
+
+namespace {
+
+const int32_t kSzPage = 4096;
+const int32_t kSzPageContent = kSzPage - sizeof(TSCKSUM);
+const int32_t kNumOfPages = 4;
+
+// a data file of kNumOfPages pages opened for read
+struct SReadProfileEnv : public STsdbTestEnv {
+  std::string          dataPath = root + TD_DIRSEP + "v2f1ver1.data";
+  std::vector<uint8_t> content;
+  STsdbFD             *pFD = NULL;
+
+  SReadProfileEnv() : STsdbTestEnv("tsdbReadProfileTest") {
+    content.resize(kNumOfPages * kSzPageContent);
+    for (size_t i = 0; i < content.size(); i++) content[i] = (uint8_t)(i * 7 + i / 251);
+
+    tsdbTestWriteDataFile(dataPath, content.data(), content.size(), kSzPage);
+    EXPECT_EQ(tsdbOpenFile(dataPath.c_str(), NULL, kSzPage, TD_FILE_READ, &pFD), 0);
+  }
+
+  ~SReadProfileEnv() {
+    tsdbBindReadProfile(NULL);
+    tsdbCloseFile(&pFD);
+  }
+
+  void read(int64_t offset, int64_t size) {
+    std::vector<uint8_t> buf(size);
+    ASSERT_EQ(tsdbReadFile(pFD, offset, buf.data(), size), 0);
+    EXPECT_TRUE(std::equal(buf.begin(), buf.end(), content.begin() + offset)) << "offset " << offset;
+  }
+};
+
+}  // namespace
+
+TEST(tsdbReadProfileTest, fileReads) {
+  SReadProfileEnv       env;
+  STableScanAnalyzeInfo profile = {0};
+
+  // nothing is counted while no profile is bound
+  env.read(0, 100);
+  EXPECT_EQ(tsdbGetReadProfile(), nullptr);
+
+  // the rest of the page in the buffer, then two pages from the disk
+  EXPECT_EQ(tsdbBindReadProfile(&profile), nullptr);
+  env.read(100, 200);
+  EXPECT_EQ(profile.diskReadBytes, 0);
+  EXPECT_EQ(profile.cacheReadBytes, 200);
+
+  env.read(kSzPageContent + 10, kSzPageContent);
+  EXPECT_EQ(profile.diskReadBytes, 2 * kSzPage);
+  EXPECT_EQ(profile.cacheReadBytes, 200);
+
+  // the last page read is still buffered
+  env.read(2 * kSzPageContent, kSzPageContent);
+  EXPECT_EQ(profile.diskReadBytes, 2 * kSzPage);
+  EXPECT_EQ(profile.cacheReadBytes, 200 + kSzPageContent);
+
+  // an inner reader charges its own profile until the outer one is bound back
+  STableScanAnalyzeInfo inner = {0};
+  EXPECT_EQ(tsdbBindReadProfile(&inner), &profile);
+  env.read(0, 10);
+  EXPECT_EQ(inner.diskReadBytes, kSzPage);
+  EXPECT_EQ(profile.diskReadBytes, 2 * kSzPage);
+
+  EXPECT_EQ(tsdbBindReadProfile(&profile), &inner);
+  env.read(3 * kSzPageContent, 10);
+  EXPECT_EQ(profile.diskReadBytes, 3 * kSzPage);
+  EXPECT_EQ(inner.diskReadBytes, kSzPage);
+
+  EXPECT_EQ(tsdbBindReadProfile(NULL), &profile);
+  env.read(0, 10);
+  EXPECT_EQ(profile.diskReadBytes, 3 * kSzPage);
+  EXPECT_EQ(inner.diskReadBytes, kSzPage);
+}
+
+TEST(tsdbReadProfileTest, decompressTime) {
+  const int32_t        nVal = 1000000;
+  std::vector<int64_t> values(nVal);
+  for (int32_t i = 0; i < nVal; i++) values[i] = 1700000000000 + (int64_t)i * 1000 + i % 7;
+
+  uint8_t *pCmpr = NULL, *pBuf = NULL, *pOut = NULL;
+  int32_t  szCmpr = 0;
+  ASSERT_EQ(tsdbCmprData((uint8_t *)values.data(), nVal * sizeof(int64_t), TSDB_DATA_TYPE_BIGINT, TWO_STAGE_COMP,
+                         &pCmpr, 0, &szCmpr, &pBuf),
+            0);
+
+  // a decompression with no profile bound is not timed
+  STableScanAnalyzeInfo profile = {0};
+  ASSERT_EQ(tsdbDecmprData(pCmpr, szCmpr, TSDB_DATA_TYPE_BIGINT, TWO_STAGE_COMP, &pOut, nVal * sizeof(int64_t), &pBuf),
+            0);
+  EXPECT_EQ(profile.decompressTime[TSDB_DATA_TYPE_BIGINT], 0);
+
+  // it is charged to the type of the column
+  tsdbBindReadProfile(&profile);
+  ASSERT_EQ(tsdbDecmprData(pCmpr, szCmpr, TSDB_DATA_TYPE_BIGINT, TWO_STAGE_COMP, &pOut, nVal * sizeof(int64_t), &pBuf),
+            0);
+  tsdbBindReadProfile(NULL);
+
+  EXPECT_EQ(memcmp(pOut, values.data(), nVal * sizeof(int64_t)), 0);
+  EXPECT_GT(profile.decompressTime[TSDB_DATA_TYPE_BIGINT], 0);
+  for (int32_t type = 0; type < TSDB_DATA_TYPE_MAX; type++) {
+    if (type != TSDB_DATA_TYPE_BIGINT) EXPECT_EQ(profile.decompressTime[type], 0) << tDataTypes[type].name;
+  }
+
+  tFree(pCmpr);
+  tFree(pBuf);
+  tFree(pOut);
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "tsdbFS2.h"
+#include "tsdbFSet2.h"
+#include "tsdbTestUtil.h"
+
+extern "C" int32_t tsdbRetention(STsdb *tsdb, int64_t now, int32_t sync);
+
+namespace {
+
+const int32_t kSzPage = 4096;
+const int64_t kNow = 1700000000;  // in seconds
+const int32_t kDay = 1440;        // in minutes
+
+// a tsdb on two tiers, files older than 10 days go to the second tier
+struct SRetentionEnv : public STsdbTestEnv {
+  SRetentionEnv() : STsdbTestEnv("tsdbRetentionTest") {
+    pVnode->config.tsdbPageSize = kSzPage;
+    pVnode->config.sttTrigger = 1;
+    openTfs(2);
+
+    STsdbKeepCfg keepCfg = {0};
+    keepCfg.precision = TSDB_TIME_PRECISION_MILLI;
+    keepCfg.days = kDay;
+    keepCfg.keep0 = 10 * kDay;
+    keepCfg.keep1 = 100 * kDay;
+    keepCfg.keep2 = 1000 * kDay;
+    openTsdb(&keepCfg);
+  }
+
+  ~SRetentionEnv() { tsRetentionSpeedLimitMB = 0; }
+
+  // the file set of the day daysAgo days before now
+  int32_t fidOf(int32_t daysAgo) {
+    return tsdbKeyFid((kNow - daysAgo * 86400LL) * 1000, kDay, TSDB_TIME_PRECISION_MILLI);
+  }
+
+  std::string content(const STFile &f) {
+    std::string data(tsdbLogicToFileSize(f.size, kSzPage), '\0');
+    for (size_t i = 0; i < data.size(); i++) data[i] = (char)(f.fid * 7 + f.type * 13 + i);
+    return data;
+  }
+
+  // a file set with head, data, sma and one stt file on the first tier
+  std::vector<STFile> createFSet(int32_t fid, int64_t nPage) {
+    std::vector<STFile> files;
+    int64_t             cid = tsdbFSAllocEid(pTsdb->pFS);
+    for (int32_t ftype : {TSDB_FTYPE_HEAD, TSDB_FTYPE_DATA, TSDB_FTYPE_SMA, TSDB_FTYPE_STT}) {
+      STFile f = {};
+      f.type = (tsdb_ftype_t)ftype;
+      f.did = {0, 0};
+      f.fid = fid;
+      f.cid = cid;
+      f.size = nPage * (kSzPage - sizeof(TSCKSUM));
+      files.push_back(f);
+    }
+
+    TFileOpArray fopArr[1];
+    TARRAY2_INIT(fopArr);
+    for (const STFile &f : files) {
+      char fname[TSDB_FILENAME_LEN];
+      tsdbTFileName(pTsdb, &f, fname);
+      TdFilePtr   pFile = taosOpenFile(fname, TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
+      std::string data = content(f);
+      EXPECT_EQ(taosWriteFile(pFile, data.data(), data.size()), (int64_t)data.size());
+      taosCloseFile(&pFile);
+
+      STFileOp op = {.optype = TSDB_FOP_CREATE, .fid = fid};
+      op.nf = f;
+      TARRAY2_APPEND(fopArr, op);
+    }
+
+    EXPECT_EQ(tsdbFSEditBegin(pTsdb->pFS, fopArr, TSDB_FEDIT_COMMIT), 0);
+    EXPECT_EQ(tsdbFSEditCommit(pTsdb->pFS), 0);
+    TARRAY2_DESTROY(fopArr, NULL);
+    return files;
+  }
+
+  // run a retention and wait for it
+  void retention() {
+    ASSERT_EQ(tsdbRetention(pTsdb, kNow, 0), 0);
+    tsdbFSDisableBgTask(pTsdb->pFS);
+    tsdbFSEnableBgTask(pTsdb->pFS);
+  }
+
+  // the files of the file set are on the tier, with their content, and no longer on the other tier
+  void checkFSet(const std::vector<STFile> &files, int32_t level) {
+    STFileSet *fset = NULL;
+    ASSERT_EQ(tsdbFSGetFSet(pTsdb->pFS, files[0].fid, &fset), 0);
+    ASSERT_NE(fset, nullptr);
+
+    for (const STFile &f : files) {
+      const STFileObj *fobj = NULL;
+      if (f.type == TSDB_FTYPE_STT) {
+        SSttLvl *lvl = tsdbTFileSetGetSttLvl(fset, 0);
+        ASSERT_NE(lvl, nullptr);
+        ASSERT_EQ(TARRAY2_SIZE(lvl->fobjArr), 1);
+        fobj = TARRAY2_FIRST(lvl->fobjArr);
+      } else {
+        fobj = fset->farr[f.type];
+      }
+      ASSERT_NE(fobj, nullptr);
+      EXPECT_EQ(fobj->f->did.level, level);
+      EXPECT_EQ(fobj->f->size, f.size);
+
+      std::string data(content(f).size(), '\0');
+      TdFilePtr   pFile = taosOpenFile(fobj->fname, TD_FILE_READ);
+      ASSERT_NE(pFile, nullptr);
+      EXPECT_EQ(taosReadFile(pFile, &data[0], data.size()), (int64_t)data.size());
+      taosCloseFile(&pFile);
+      EXPECT_EQ(data, content(f));
+
+      STFile other = f;
+      other.did.level = 1 - level;
+      EXPECT_FALSE(fileExists(other));
+    }
+  }
+
+  bool fileExists(const STFile &f) {
+    char fname[TSDB_FILENAME_LEN];
+    tsdbTFileName(pTsdb, &f, fname);
+    return taosCheckExistFile(fname);
+  }
+};
+
+int64_t filesSize(const std::vector<STFile> &files) {
+  int64_t size = 0;
+  for (const STFile &f : files) size += tsdbLogicToFileSize(f.size, kSzPage);
+  return size;
+}
+
+}  // namespace
+
+TEST(tsdbRetentionTest, migrateToNextTier) {
+  SRetentionEnv env;
+
+  std::vector<STFile> hot = env.createFSet(env.fidOf(1), 4);
+  std::vector<STFile> warm1 = env.createFSet(env.fidOf(50), 64);
+  std::vector<STFile> warm2 = env.createFSet(env.fidOf(60), 64);
+
+  // at most 4MB/s from and to each disk, all copies go from the one disk of the first tier to the one of the second
+  tsRetentionSpeedLimitMB = 4;
+  int64_t st = taosGetTimestampUs();
+  env.retention();
+  int64_t elapsed = taosGetTimestampUs() - st;
+
+  env.checkFSet(hot, 0);
+  env.checkFSet(warm1, 1);
+  env.checkFSet(warm2, 1);
+
+  int64_t size = filesSize(warm1) + filesSize(warm2);
+  EXPECT_GE(elapsed, (size - filesSize({warm2.back()})) * 1000000 / (4 << 20) * 9 / 10);
+
+  int64_t migrateBytes = 0;
+  int32_t migrateQueue = 0;
+  tsdbGetMigrateStat(env.pTsdb, &migrateBytes, &migrateQueue);
+  EXPECT_EQ(migrateBytes, size);
+  EXPECT_EQ(migrateQueue, 0);
+
+  // the files moved are not counted as merge i/o
+  int64_t ingestBytes = 0, mergeWriteBytes = 0, mergeReadBytes = 0;
+  int32_t numOfFSets = 0, numOfSttFiles = 0;
+  tsdbGetAmpStat(env.pTsdb, &ingestBytes, &mergeWriteBytes, &mergeReadBytes, &numOfFSets, &numOfSttFiles);
+  EXPECT_EQ(mergeWriteBytes, 0);
+  EXPECT_EQ(mergeReadBytes, 0);
+
+  // nothing is left to migrate
+  env.retention();
+  tsdbGetMigrateStat(env.pTsdb, &migrateBytes, &migrateQueue);
+  EXPECT_EQ(migrateBytes, size);
+  env.checkFSet(warm1, 1);
+}
+
+TEST(tsdbRetentionTest, failedFSetIsNotCommitted) {
+  SRetentionEnv env;
+
+  std::vector<STFile> warm1 = env.createFSet(env.fidOf(50), 8);
+  std::vector<STFile> warm2 = env.createFSet(env.fidOf(60), 8);
+
+  // the last file to copy is gone, so is the file set it belongs to, the file set copied before is committed
+  STFile lost = warm1.back();
+  char   fname[TSDB_FILENAME_LEN];
+  tsdbTFileName(env.pTsdb, &lost, fname);
+  taosRemoveFile(fname);
+
+  env.retention();
+
+  env.checkFSet(warm2, 1);
+
+  STFileSet *fset = NULL;
+  ASSERT_EQ(tsdbFSGetFSet(env.pTsdb->pFS, warm1[0].fid, &fset), 0);
+  ASSERT_NE(fset, nullptr);
+  for (int32_t i = 0; i + 1 < (int32_t)warm1.size(); i++) {
+    STFile copied = warm1[i];
+    copied.did.level = 1;
+    EXPECT_EQ(fset->farr[warm1[i].type]->f->did.level, 0);
+    EXPECT_TRUE(env.fileExists(warm1[i]));
+    EXPECT_FALSE(env.fileExists(copied));
+  }
+
+  int32_t migrateQueue = -1;
+  int64_t migrateBytes = 0;
+  tsdbGetMigrateStat(env.pTsdb, &migrateBytes, &migrateQueue);
+  EXPECT_EQ(migrateQueue, 0);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "stub.h"
+#include "tsdbTestUtil.h"
+#include "vndCos.h"
+
+namespace {
+
+const int32_t kSzPage = 4096;
+const int32_t kNumOfPages = 10;  // blocks of 4 pages, the last block holds 2 pages
+
+// the object on s3 and the ranged reads served from it
+std::vector<uint8_t>                     s3Object;
+std::vector<std::pair<int64_t, int64_t>> s3Gets;
+
+int32_t s3GetObjectBlockStub(const char *object_name, int64_t offset, int64_t size, uint8_t **ppBlock) {
+  if (offset < 0 || offset + size > (int64_t)s3Object.size()) return TSDB_CODE_FILE_CORRUPTED;
+
+  s3Gets.push_back({offset, size});
+  *ppBlock = (uint8_t *)taosMemoryMalloc(size);
+  memcpy(*ppBlock, s3Object.data() + offset, size);
+  return 0;
+}
+
+long s3SizeStub(const char *object_name) { return s3Object.size(); }
+
+bool s3GetStub(const char *object_name, const char *path) {
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC);
+  if (pFile == NULL) return false;
+  bool ok = taosWriteFile(pFile, s3Object.data(), s3Object.size()) == (int64_t)s3Object.size();
+  taosCloseFile(&pFile);
+  return ok;
+}
+
+void s3EvictCacheStub(const char *path, long object_size) {}
+
+// a tsdb with nothing but its caches, and a data file of it that lives only on s3
+struct SS3CacheEnv : public STsdbTestEnv {
+  std::string          dataPath = root + TD_DIRSEP + "v2f1ver1.data";
+  std::vector<uint8_t> content;  // the logical content of the data file
+  Stub                 stub;
+
+  SS3CacheEnv() : STsdbTestEnv("tsdbS3CacheTest") {
+    content.resize(kNumOfPages * (kSzPage - sizeof(TSCKSUM)));
+    for (size_t i = 0; i < content.size(); i++) content[i] = (uint8_t)(i * 31 + i / 4093);
+    tsdbTestWriteDataFile(dataPath, content.data(), content.size(), kSzPage);
+
+    // move the file to s3
+    TdFilePtr pFile = taosOpenFile(dataPath.c_str(), TD_FILE_READ);
+    s3Object.resize(kNumOfPages * kSzPage);
+    EXPECT_EQ(taosReadFile(pFile, s3Object.data(), s3Object.size()), (int64_t)s3Object.size());
+    taosCloseFile(&pFile);
+    taosRemoveFile(dataPath.c_str());
+    s3Gets.clear();
+
+    stub.set(s3GetObjectBlock, s3GetObjectBlockStub);
+    stub.set(s3Size, s3SizeStub);
+    stub.set(s3Get, s3GetStub);
+    stub.set(s3EvictCache, s3EvictCacheStub);
+    tsS3Enabled = true;
+    tsS3BlockSize = 4 * kSzPage / 1024;
+    tsS3ReadAheadBlocks = 1;
+
+    initTsdb();
+    EXPECT_EQ(tsdbOpenCache(pTsdb), 0);
+    EXPECT_NE(pTsdb->s3Cache, nullptr);
+  }
+
+  ~SS3CacheEnv() {
+    tsdbCloseCache(pTsdb);
+    tsS3Enabled = false;
+  }
+
+  void checkRead(STsdbFD *pFD, int64_t offset, int64_t size) {
+    std::vector<uint8_t> buf(size);
+    ASSERT_EQ(tsdbReadFile(pFD, offset, buf.data(), size), 0);
+    EXPECT_EQ(memcmp(buf.data(), content.data() + offset, size), 0);
+  }
+
+  void checkStat(int64_t hits, int64_t misses, int64_t fetchBytes) {
+    int64_t h = 0, m = 0, b = 0;
+    tsdbGetS3CacheStat(pTsdb, &h, &m, &b);
+    EXPECT_EQ(h, hits);
+    EXPECT_EQ(m, misses);
+    EXPECT_EQ(b, fetchBytes);
+  }
+};
+
+}  // namespace
+
+TEST(tsdbS3CacheTest, readByBlock) {
+  SS3CacheEnv env;
+  int64_t     szPgCont = kSzPage - sizeof(TSCKSUM);
+  int64_t     szBlock = 4 * kSzPage;
+
+  STsdbFD *pFD = NULL;
+  ASSERT_EQ(tsdbOpenFile(env.dataPath.c_str(), env.pTsdb, kSzPage, TD_FILE_READ, &pFD), 0);
+
+  // a miss fetches its block and the block read ahead of it by one ranged read
+  env.checkRead(pFD, 10, 2 * szPgCont - 20);
+  ASSERT_EQ(s3Gets.size(), 1);
+  EXPECT_EQ(s3Gets[0], std::make_pair((int64_t)0, 2 * szBlock));
+  env.checkStat(0, 1, 2 * szBlock);
+
+  // the block read ahead is a hit
+  env.checkRead(pFD, 5 * szPgCont + 7, 100);
+  EXPECT_EQ(s3Gets.size(), 1);
+  env.checkStat(1, 1, 2 * szBlock);
+
+  // the last block is cut at the end of the object
+  env.checkRead(pFD, 8 * szPgCont, 2 * szPgCont);
+  ASSERT_EQ(s3Gets.size(), 2);
+  EXPECT_EQ(s3Gets[1], std::make_pair(2 * szBlock, (int64_t)(kNumOfPages - 8) * kSzPage));
+  env.checkStat(1, 2, kNumOfPages * kSzPage);
+
+  // all blocks are cached
+  env.checkRead(pFD, 0, env.content.size());
+  EXPECT_EQ(s3Gets.size(), 2);
+  env.checkStat(4, 2, kNumOfPages * kSzPage);
+  tsdbCloseFile(&pFD);
+
+  // a writer appends to the file, it is downloaded as a whole and no block is fetched
+  ASSERT_EQ(tsdbOpenFile(env.dataPath.c_str(), env.pTsdb, kSzPage, TD_FILE_READ | TD_FILE_WRITE, &pFD), 0);
+  env.checkRead(pFD, 3 * szPgCont, 4 * szPgCont);
+  EXPECT_EQ(pFD->szFile, kNumOfPages);
+  EXPECT_FALSE(pFD->s3File);
+  EXPECT_EQ(s3Gets.size(), 2);
+  tsdbCloseFile(&pFD);
+}
+
+TEST(tsdbS3CacheTest, readAhead) {
+  SS3CacheEnv env;
+  int64_t     szPgCont = kSzPage - sizeof(TSCKSUM);
+  int64_t     szBlock = 4 * kSzPage;
+
+  STsdbFD *pFD = NULL;
+  ASSERT_EQ(tsdbOpenFile(env.dataPath.c_str(), env.pTsdb, kSzPage, TD_FILE_READ, &pFD), 0);
+
+  // no read ahead, the blocks are fetched one by one
+  tsS3ReadAheadBlocks = 0;
+  env.checkRead(pFD, 0, szPgCont);
+  env.checkRead(pFD, 4 * szPgCont, szPgCont);
+  ASSERT_EQ(s3Gets.size(), 2);
+  EXPECT_EQ(s3Gets[0], std::make_pair((int64_t)0, szBlock));
+  EXPECT_EQ(s3Gets[1], std::make_pair(szBlock, szBlock));
+
+  // read ahead never goes past the end of the object
+  tsS3ReadAheadBlocks = 4;
+  env.checkRead(pFD, 8 * szPgCont, 1);
+  ASSERT_EQ(s3Gets.size(), 3);
+  EXPECT_EQ(s3Gets[2], std::make_pair(2 * szBlock, (int64_t)(kNumOfPages - 8) * kSzPage));
+  env.checkStat(0, 3, kNumOfPages * kSzPage);
+  tsdbCloseFile(&pFD);
+
+  tsS3ReadAheadBlocks = 1;
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "tsdbSttFileRW.h"
+#include "tsdbTestUtil.h"
+
+extern "C" int32_t tLDataIterOpen2(SLDataIter *pIter, SSttFileReader *pSttFileReader, int32_t iStt, int8_t backward,
+                                   uint64_t suid, uint64_t uid, STimeWindow *pTimeWindow, SVersionRange *pRange,
+                                   SSttBlockLoadInfo *pBlockLoadInfo, const char *idStr, bool strictTimeRange,
+                                   _load_tomb_fn loadTombFn, void *pReader1);
+
+namespace {
+
+const int32_t kSzPage = 4096;
+const int64_t kSuid = 1000;
+const int64_t kMinUid = 1001;
+const int32_t kNumOfTables = 200;  // child tables kMinUid, kMinUid + 2, ... are in the stt file, the others are not
+const int32_t kRowsPerTable = 10;
+
+int32_t loadTombStub(STsdbReader *pReader, SSttFileReader *pSttFileReader, SSttBlockLoadInfo *pLoadInfo) { return 0; }
+
+// a tsdb with nothing but a path, and the stt files written into it
+struct SSttEnv : public STsdbTestEnv {
+  STSchema *pTSchema = NULL;
+  int64_t   cid = 0;
+
+  SSttEnv() : STsdbTestEnv("tsdbSttBloomFilterTest") {
+    initTsdb();
+
+    SSchema schema[2] = {{TSDB_DATA_TYPE_TIMESTAMP, 0, 1, 8}, {TSDB_DATA_TYPE_INT, 0, 2, 4}};
+    pTSchema = tBuildTSchema(schema, 2, 1);
+    EXPECT_NE(pTSchema, nullptr);
+  }
+
+  ~SSttEnv() {
+    tsSttBloomFilter = true;
+    tDestroyTSchema(pTSchema);
+  }
+
+  // an stt file with the rows of every other child table, as many blocks as maxRow makes of them
+  STFile writeSttFile(int32_t maxRow) {
+    SBlockData bData;
+    TABLEID    id = {.suid = kSuid, .uid = 0};
+    EXPECT_EQ(tBlockDataCreate(&bData), 0);
+    EXPECT_EQ(tBlockDataInit(&bData, &id, pTSchema, NULL, 0), 0);
+
+    SArray *aColVal = taosArrayInit(2, sizeof(SColVal));
+    for (int32_t iTable = 0; iTable < kNumOfTables; iTable += 2) {
+      for (int32_t iRow = 0; iRow < kRowsPerTable; iRow++) {
+        taosArrayClear(aColVal);
+        SColVal ts = {.cid = 1, .type = TSDB_DATA_TYPE_TIMESTAMP, .flag = CV_FLAG_VALUE};
+        ts.value.val = 1700000000000 + iRow;
+        SColVal v = {.cid = 2, .type = TSDB_DATA_TYPE_INT, .flag = CV_FLAG_VALUE};
+        v.value.val = iTable * kRowsPerTable + iRow;
+        taosArrayPush(aColVal, &ts);
+        taosArrayPush(aColVal, &v);
+        tsdbTestAppendRow(&bData, pTSchema, aColVal, kMinUid + iTable, 1);
+      }
+    }
+    taosArrayDestroy(aColVal);
+
+    SSkmInfo             skmTb = {.suid = kSuid, .uid = 0, .pTSchema = pTSchema};
+    SSttFileWriterConfig config = {0};
+    config.tsdb = pTsdb;
+    config.maxRow = maxRow;
+    config.szPage = kSzPage;
+    config.cmprAlg = TWO_STAGE_COMP;
+    config.compactVersion = INT64_MAX;
+    config.fid = 1;
+    config.cid = ++cid;
+    config.skmTb = &skmTb;
+
+    SSttFileWriter *writer = NULL;
+    TFileOpArray    opArr[1];
+    TARRAY2_INIT(opArr);
+    EXPECT_EQ(tsdbSttFileWriterOpen(&config, &writer), 0);
+    EXPECT_EQ(tsdbSttFileWriteBlockData(writer, &bData), 0);
+    EXPECT_EQ(tsdbSttFileWriterClose(&writer, 0, opArr), 0);
+    tBlockDataDestroy(&bData);
+
+    EXPECT_EQ(TARRAY2_SIZE(opArr), 1);
+    STFile file = TARRAY2_FIRST(opArr).nf;
+    TARRAY2_DESTROY(opArr, NULL);
+    return file;
+  }
+
+  SSttFileReader *openReader(const STFile &file) {
+    SSttFileReaderConfig config = {0};
+    config.tsdb = pTsdb;
+    config.szPage = kSzPage;
+    config.file[0] = file;
+
+    SSttFileReader *reader = NULL;
+    EXPECT_EQ(tsdbSttFileReaderOpen(NULL, &config, &reader), 0);
+    return reader;
+  }
+
+  // opens an stt iterator of the table on the file, the file is skipped for the table if it is counted as such
+  bool skipped(SSttFileReader *reader, int64_t uid, bool *found) {
+    SSttBlockLoadInfo *pLoadInfo = tCreateOneLastBlockLoadInfo(pTSchema, NULL, 0);
+    STimeWindow        w = {.skey = INT64_MIN, .ekey = INT64_MAX};
+    SVersionRange      range = {.minVer = 0, .maxVer = INT64_MAX};
+    SLDataIter         iter = {};
+
+    EXPECT_EQ(tLDataIterOpen2(&iter, reader, 0, 0, kSuid, uid, &w, &range, pLoadInfo, "", false, loadTombStub, NULL),
+              0);
+    bool skip = pLoadInfo->cost.skipFiles > 0;
+    *found = iter.pSttBlk != NULL;
+    destroyLastBlockLoadInfo(pLoadInfo);
+    return skip;
+  }
+};
+
+}  // namespace
+
+TEST(tsdbSttBloomFilterTest, skipTablesNotInFile) {
+  SSttEnv env;
+  STFile  file = env.writeSttFile(64);
+
+  SSttFileReader *reader = env.openReader(file);
+  ASSERT_NE(reader, nullptr);
+
+  const SBloomFilter *pFilter = NULL;
+  ASSERT_EQ(tsdbSttFileReadBloomFilter(reader, &pFilter), 0);
+  ASSERT_NE(pFilter, nullptr);
+
+  // the filter is read once
+  const SBloomFilter *pFilter2 = NULL;
+  ASSERT_EQ(tsdbSttFileReadBloomFilter(reader, &pFilter2), 0);
+  EXPECT_EQ(pFilter2, pFilter);
+
+  // no table in the file is ever ruled out, few of the others are let through
+  int32_t nFalsePositive = 0;
+  int64_t uidNotIn = 0;
+  for (int32_t iTable = 0; iTable < kNumOfTables; iTable++) {
+    int64_t uid = kMinUid + iTable;
+    bool    noContain = tBloomFilterNoContain(pFilter, &uid, sizeof(uid)) == TSDB_CODE_SUCCESS;
+    if (iTable % 2 == 0) {
+      EXPECT_FALSE(noContain) << "uid " << uid;
+    } else if (!noContain) {
+      nFalsePositive++;
+    } else if (uidNotIn == 0) {
+      uidNotIn = uid;
+    }
+  }
+  EXPECT_LE(nFalsePositive, kNumOfTables / 2 / 10);
+  ASSERT_NE(uidNotIn, 0);
+
+  // the iterator of a table in the file finds its block, that of a table not in it skips the file
+  bool found = false;
+  EXPECT_FALSE(env.skipped(reader, kMinUid + 100, &found));
+  EXPECT_TRUE(found);
+  EXPECT_TRUE(env.skipped(reader, uidNotIn, &found));
+  EXPECT_FALSE(found);
+
+  tsdbSttFileReaderClose(&reader);
+}
+
+TEST(tsdbSttBloomFilterTest, fileWithoutFilter) {
+  SSttEnv env;
+
+  // a file written without a filter, as by the versions before it, has an empty slot for it in its footer
+  tsSttBloomFilter = false;
+  STFile file = env.writeSttFile(64);
+  tsSttBloomFilter = true;
+
+  SSttFileReader *reader = env.openReader(file);
+  ASSERT_NE(reader, nullptr);
+
+  const SBloomFilter *pFilter = NULL;
+  ASSERT_EQ(tsdbSttFileReadBloomFilter(reader, &pFilter), 0);
+  EXPECT_EQ(pFilter, nullptr);
+
+  // the file is never skipped, whether the table is in it or not
+  bool found = false;
+  for (int32_t iTable = 0; iTable < kNumOfTables; iTable++) {
+    EXPECT_FALSE(env.skipped(reader, kMinUid + iTable, &found)) << "uid " << kMinUid + iTable;
+    if (iTable % 2 == 0) EXPECT_TRUE(found) << "uid " << kMinUid + iTable;
+  }
+
+  tsdbSttFileReaderClose(&reader);
+}
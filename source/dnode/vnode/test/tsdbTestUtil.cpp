@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "tsdbTestUtil.h"
+
+STsdbTestEnv::STsdbTestEnv(const char *name) : root(std::string(TD_TMP_DIR_PATH) + name) {
+  taosRemoveDir(root.c_str());
+  taosMulMkDir(root.c_str());
+
+  pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+  pVnode->config.vgId = 2;
+  pVnode->config.cacheLastSize = 1;
+}
+
+STsdbTestEnv::~STsdbTestEnv() {
+  if (pVnode->pTfs != NULL) {
+    closeTsdb();
+    tfsClose(pVnode->pTfs);
+  } else {
+    taosMemoryFree(pTsdb);
+  }
+  taosMemoryFree(pVnode);
+  if (inited) vnodeCleanup();
+  taosRemoveDir(root.c_str());
+}
+
+void STsdbTestEnv::initTsdb() {
+  pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+  pTsdb->path = (char *)root.c_str();
+  pTsdb->pVnode = pVnode;
+}
+
+void STsdbTestEnv::openTfs(int32_t nLevel) {
+  ASSERT_EQ(vnodeInit(2), 0);
+  inited = true;
+
+  SDiskCfg disks[TFS_MAX_TIERS] = {0};
+  for (int32_t level = 0; level < nLevel; level++) {
+    snprintf(disks[level].dir, sizeof(disks[level].dir), "%s%sd%d", root.c_str(), TD_DIRSEP, level);
+    disks[level].level = level;
+    disks[level].primary = (level == 0);
+    taosMulMkDir(disks[level].dir);
+  }
+
+  pVnode->path = (char *)"vnode2";
+  pVnode->pTfs = tfsOpen(disks, nLevel);
+  ASSERT_NE(pVnode->pTfs, nullptr);
+  tfsMkdirRecur(pVnode->pTfs, "vnode2/tsdb");
+}
+
+void STsdbTestEnv::openTsdb(STsdbKeepCfg *pKeepCfg) {
+  ASSERT_EQ(tsdbOpen(pVnode, &pTsdb, VNODE_TSDB_DIR, pKeepCfg, 0), 0);
+  pVnode->pTsdb = pTsdb;
+}
+
+void STsdbTestEnv::closeTsdb() {
+  tsdbClose(&pTsdb);
+  pVnode->pTsdb = NULL;
+}
+
+void tsdbTestWriteDataFile(const std::string &path, const void *data, int64_t size, int32_t szPage) {
+  STsdbFD *pFD = NULL;
+  ASSERT_EQ(tsdbOpenFile(path.c_str(), NULL, szPage, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE, &pFD), 0);
+  EXPECT_EQ(tsdbWriteFile(pFD, 0, (const uint8_t *)data, size), 0);
+  EXPECT_EQ(tsdbFsyncFile(pFD), 0);
+  tsdbCloseFile(&pFD);
+}
+
+void tsdbTestAppendRow(SBlockData *pBlockData, STSchema *pTSchema, SArray *aColVal, int64_t uid, int64_t version) {
+  SRow *pRow = NULL;
+  ASSERT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+  TSDBROW row = {.type = TSDBROW_ROW_FMT};
+  row.version = version;
+  row.pTSRow = pRow;
+  EXPECT_EQ(tBlockDataAppendRow(pBlockData, &row, pTSchema, uid), 0);
+  tRowDestroy(pRow);
+}
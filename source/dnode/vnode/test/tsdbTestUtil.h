@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TSDB_TEST_UTIL_H
+#define TSDB_TEST_UTIL_H
+
+#include <string>
+
+#include "tsdbDef.h"
+
+// a directory of its own under the temp dir, removed with the env, and a vnode of vgId 2 with nothing but its config
+struct STsdbTestEnv {
+  std::string root;
+  SVnode     *pVnode = NULL;
+  STsdb      *pTsdb = NULL;
+  bool        inited = false;  // vnodeInit is called by openTfs
+
+  explicit STsdbTestEnv(const char *name);
+  ~STsdbTestEnv();
+
+  // a tsdb that has nothing but the root as its path, none of its file system is opened
+  void initTsdb();
+
+  // disks of nLevel tiers under the root and the tsdb dir of the vnode on them, the vnode is inited before
+  void openTfs(int32_t nLevel);
+
+  // the tsdb opened on the disks as a vnode opens it
+  void openTsdb(STsdbKeepCfg *pKeepCfg);
+
+  // close the tsdb before what it depends on is torn down
+  void closeTsdb();
+};
+
+// a data file of the logical content given, written in pages of szPage
+void tsdbTestWriteDataFile(const std::string &path, const void *data, int64_t size, int32_t szPage);
+
+// build a row of the values given and append it to the block as a row of the table
+void tsdbTestAppendRow(SBlockData *pBlockData, STSchema *pTSchema, SArray *aColVal, int64_t uid, int64_t version);
+
+#endif  // TSDB_TEST_UTIL_H
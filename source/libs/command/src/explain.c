@@ -284,6 +284,78 @@ int32_t qExplainResAppendRow(SExplainCtx *ctx, char *tbuf, int32_t len, int32_t
   return TSDB_CODE_SUCCESS;
 }
 
+// the counters of all the tasks running the node are summed up
+static int32_t qExplainAppendExchangeExecRows(SExplainResNode *pResNode, SExplainCtx *ctx, int32_t level) {
+  int32_t           tlen = 0;
+  bool              isVerboseLine = true;
+  char             *tbuf = ctx->tbuf;
+  bool              gotExecInfo = false;
+  SExchangeExecInfo info = {0};
+
+  for (int32_t i = 0; i < taosArrayGetSize(pResNode->pExecInfo); ++i) {
+    SExplainExecInfo *execInfo = taosArrayGet(pResNode->pExecInfo, i);
+    if (execInfo->verboseInfo == NULL || execInfo->verboseLen < sizeof(SExchangeExecInfo)) {
+      continue;
+    }
+
+    SExchangeExecInfo *pExecInfo = (SExchangeExecInfo *)execInfo->verboseInfo;
+    info.totalRows += pExecInfo->totalRows;
+    info.totalSize += pExecInfo->totalSize;
+    info.waitTime += pExecInfo->waitTime;
+    gotExecInfo = true;
+  }
+
+  if (!gotExecInfo) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  EXPLAIN_ROW_NEW(level, "Exchange: ");
+  EXPLAIN_ROW_APPEND("recv_rows=%" PRId64, info.totalRows);
+  EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  EXPLAIN_ROW_APPEND("recv_bytes=%.2f Kb", info.totalSize / 1024.0);
+  EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  EXPLAIN_ROW_APPEND("wait_time=%.3f ms", info.waitTime / 1000.0);
+  EXPLAIN_ROW_END();
+  return qExplainResAppendRow(ctx, tbuf, tlen, level);
+}
+
+static int32_t qExplainAppendHashExecRows(SExplainResNode *pResNode, SExplainCtx *ctx, int32_t level) {
+  int32_t       tlen = 0;
+  bool          isVerboseLine = true;
+  char         *tbuf = ctx->tbuf;
+  bool          gotExecInfo = false;
+  SHashExecInfo info = {0};
+
+  for (int32_t i = 0; i < taosArrayGetSize(pResNode->pExecInfo); ++i) {
+    SExplainExecInfo *execInfo = taosArrayGet(pResNode->pExecInfo, i);
+    if (execInfo->verboseInfo == NULL || execInfo->verboseLen < sizeof(SHashExecInfo)) {
+      continue;
+    }
+
+    SHashExecInfo *pExecInfo = (SHashExecInfo *)execInfo->verboseInfo;
+    info.hashEntries += pExecInfo->hashEntries;
+    info.hashBytes += pExecInfo->hashBytes;
+    info.spillBytes += pExecInfo->spillBytes;
+    info.loadBytes += pExecInfo->loadBytes;
+    gotExecInfo = true;
+  }
+
+  if (!gotExecInfo) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  EXPLAIN_ROW_NEW(level, "Hash Table: ");
+  EXPLAIN_ROW_APPEND("entries=%" PRId64, info.hashEntries);
+  EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  EXPLAIN_ROW_APPEND("size=%.2f Kb", info.hashBytes / 1024.0);
+  EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  EXPLAIN_ROW_APPEND("spill=%.2f Kb", info.spillBytes / 1024.0);
+  EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+  EXPLAIN_ROW_APPEND("read=%.2f Kb", info.loadBytes / 1024.0);
+  EXPLAIN_ROW_END();
+  return qExplainResAppendRow(ctx, tbuf, tlen, level);
+}
+
 static uint8_t getIntervalPrecision(SIntervalPhysiNode *pIntNode) {
   return ((SColumnNode *)pIntNode->window.pTspk)->node.resType.precision;
 }
@@ -387,6 +459,16 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
           info.totalCheckedRows += pScanInfo->totalCheckedRows;
           info.filterOutBlocks += pScanInfo->filterOutBlocks;
 
+          if (execInfo->verboseLen >= sizeof(STableScanAnalyzeInfo)) {
+            info.memRows += pScanInfo->memRows;
+            info.fileRows += pScanInfo->fileRows;
+            info.diskReadBytes += pScanInfo->diskReadBytes;
+            info.cacheReadBytes += pScanInfo->cacheReadBytes;
+            for (int32_t j = 0; j < TSDB_DATA_TYPE_MAX; ++j) {
+              info.decompressTime[j] += pScanInfo->decompressTime[j];
+            }
+          }
+
           if (pScanInfo->totalRows > totalRows) {
             totalRows = pScanInfo->totalRows;
             maxIndex = i;
@@ -411,6 +493,36 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
 
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
 
+        EXPLAIN_ROW_NEW(level + 1, " ");
+        EXPLAIN_ROW_APPEND("skip_blocks=%.1f", ((double)info.skipBlocks) / nodeNum);
+        EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+        EXPLAIN_ROW_APPEND("filter_out_blocks=%.1f", ((double)info.filterOutBlocks) / nodeNum);
+        EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+        EXPLAIN_ROW_APPEND("mem_rows=%.1f", ((double)info.memRows) / nodeNum);
+        EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+        EXPLAIN_ROW_APPEND("file_rows=%.1f", ((double)info.fileRows) / nodeNum);
+        EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+        EXPLAIN_ROW_APPEND("disk_read=%.2f Kb", info.diskReadBytes / 1024.0 / nodeNum);
+        EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+        EXPLAIN_ROW_APPEND("buffered_read=%.2f Kb", info.cacheReadBytes / 1024.0 / nodeNum);
+        EXPLAIN_ROW_END();
+
+        QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+
+        bool decompressed = false;
+        EXPLAIN_ROW_NEW(level + 1, "Decompress: ");
+        for (int32_t j = 0; j < TSDB_DATA_TYPE_MAX; ++j) {
+          if (info.decompressTime[j] > 0) {
+            EXPLAIN_ROW_APPEND("%s=%.3f ms ", tDataTypes[j].name, info.decompressTime[j] / nodeNum);
+            decompressed = true;
+          }
+        }
+        EXPLAIN_ROW_END();
+
+        if (decompressed) {
+          QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+        }
+
         // Rows out: Avg 4166.7 rows x 24 workers. Max 4187 rows (seg7) with 0.220 ms to first row, 1.738 ms to end,
         // start offset by 1.470 ms.
         SExplainExecInfo      *execInfo = taosArrayGet(pResNode->pExecInfo, maxIndex);
@@ -621,6 +733,10 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
       EXPLAIN_ROW_END();
       QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
 
+      if (EXPLAIN_MODE_ANALYZE == ctx->mode) {
+        QRY_ERR_RET(qExplainAppendHashExecRows(pResNode, ctx, level + 1));
+      }
+
       if (verbose) {
         EXPLAIN_ROW_NEW(level + 1, EXPLAIN_OUTPUT_FORMAT);
         EXPLAIN_ROW_APPEND(EXPLAIN_COLUMNS_FORMAT,
@@ -708,6 +824,10 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
       EXPLAIN_ROW_END();
       QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
 
+      if (EXPLAIN_MODE_ANALYZE == ctx->mode) {
+        QRY_ERR_RET(qExplainAppendExchangeExecRows(pResNode, ctx, level + 1));
+      }
+
       if (verbose) {
         EXPLAIN_ROW_NEW(level + 1, EXPLAIN_OUTPUT_FORMAT);
         EXPLAIN_ROW_APPEND(EXPLAIN_COLUMNS_FORMAT,
@@ -784,6 +904,11 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->sortMethod == SORT_SPILLED_MERGE_SORT_T && execInfo->verboseLen >= sizeof(SSortExecInfo)) {
+          EXPLAIN_ROW_APPEND("  spill:%.2f Kb (raw:%.2f Kb) read:%.2f Kb prefetched pages:%d",
+                             pExecInfo->writeBytes / 1024.0, pExecInfo->rawWriteBytes / 1024.0,
+                             pExecInfo->readBytes / 1024.0, pExecInfo->prefetchPages);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1150,6 +1275,11 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->sortMethod == SORT_SPILLED_MERGE_SORT_T && execInfo->verboseLen >= sizeof(SSortExecInfo)) {
+          EXPLAIN_ROW_APPEND("  spill:%.2f Kb (raw:%.2f Kb) read:%.2f Kb prefetched pages:%d",
+                             pExecInfo->writeBytes / 1024.0, pExecInfo->rawWriteBytes / 1024.0,
+                             pExecInfo->readBytes / 1024.0, pExecInfo->prefetchPages);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1219,6 +1349,27 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
       EXPLAIN_ROW_END();
       QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
 
+      // the block index pages read to count the blocks
+      int32_t nodeNum = taosArrayGetSize(pResNode->pExecInfo);
+      if (EXPLAIN_MODE_ANALYZE == ctx->mode && nodeNum > 0) {
+        int64_t diskReadBytes = 0;
+        int64_t cacheReadBytes = 0;
+        for (int32_t i = 0; i < nodeNum; ++i) {
+          SExplainExecInfo *execInfo = taosArrayGet(pResNode->pExecInfo, i);
+          if (execInfo->verboseLen >= sizeof(STableScanAnalyzeInfo)) {
+            diskReadBytes += ((STableScanAnalyzeInfo *)execInfo->verboseInfo)->diskReadBytes;
+            cacheReadBytes += ((STableScanAnalyzeInfo *)execInfo->verboseInfo)->cacheReadBytes;
+          }
+        }
+
+        EXPLAIN_ROW_NEW(level + 1, "I/O: ");
+        EXPLAIN_ROW_APPEND("disk_read=%.2f Kb", diskReadBytes / 1024.0 / nodeNum);
+        EXPLAIN_ROW_APPEND(EXPLAIN_BLANK_FORMAT);
+        EXPLAIN_ROW_APPEND("buffered_read=%.2f Kb", cacheReadBytes / 1024.0 / nodeNum);
+        EXPLAIN_ROW_END();
+        QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level + 1));
+      }
+
       if (verbose) {
         EXPLAIN_ROW_NEW(level + 1, EXPLAIN_OUTPUT_FORMAT);
         EXPLAIN_ROW_APPEND(EXPLAIN_COLUMNS_FORMAT,
@@ -1369,6 +1520,11 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
         }
 
         EXPLAIN_ROW_APPEND("  loops:%d", pExecInfo->loops);
+        if (pExecInfo->sortMethod == SORT_SPILLED_MERGE_SORT_T && execInfo->verboseLen >= sizeof(SSortExecInfo)) {
+          EXPLAIN_ROW_APPEND("  spill:%.2f Kb (raw:%.2f Kb) read:%.2f Kb prefetched pages:%d",
+                             pExecInfo->writeBytes / 1024.0, pExecInfo->rawWriteBytes / 1024.0,
+                             pExecInfo->readBytes / 1024.0, pExecInfo->prefetchPages);
+        }
         EXPLAIN_ROW_END();
         QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
       }
@@ -1551,6 +1707,10 @@ int32_t qExplainResNodeToRowsImpl(SExplainResNode *pResNode, SExplainCtx *ctx, i
       EXPLAIN_ROW_END();
       QRY_ERR_RET(qExplainResAppendRow(ctx, tbuf, tlen, level));
 
+      if (EXPLAIN_MODE_ANALYZE == ctx->mode) {
+        QRY_ERR_RET(qExplainAppendHashExecRows(pResNode, ctx, level + 1));
+      }
+
       if (verbose) {
         EXPLAIN_ROW_NEW(level + 1, EXPLAIN_OUTPUT_FORMAT);
         EXPLAIN_ROW_APPEND(EXPLAIN_COLUMNS_FORMAT,
@@ -21,6 +21,7 @@ extern "C" {
 
 #include "os.h"
 #include "tcommon.h"
+#include "tdatablock.h"
 #include "theap.h"
 #include "tlosertree.h"
 #include "tsort.h"
@@ -39,6 +40,7 @@ extern "C" {
 #include "tlockfree.h"
 #include "tmsg.h"
 #include "tpagedbuf.h"
+#include "tscalablebf.h"
 // #include "tstream.h"
 // #include "tstreamUpdate.h"
 #include "tlrucache.h"
@@ -143,6 +145,7 @@ typedef struct SLoadRemoteDataInfo {
   uint64_t totalSize;     // total load bytes from remote
   uint64_t totalRows;     // total number of rows
   uint64_t totalElapsed;  // total elapsed time
+  uint64_t waitTime;      // time blocked on the responses of the sources
 } SLoadRemoteDataInfo;
 
 typedef struct SLimitInfo {
@@ -200,6 +203,10 @@ typedef struct SExchangeInfo {
   uint64_t            self;
   SLimitInfo          limitInfo;
   int64_t             openedTs;  // start exec time stamp, todo: move to SLoadRemoteDataInfo
+  int64_t             bufferedBytes;     // size of the blocks in pResultBlockList
+  int64_t             maxBufferedBytes;  // stop fetching ahead once the buffered blocks reach it
+  int64_t             rspSeq;            // arrival sequence of the fetch responses
+  SArray*             pReadySources;
 } SExchangeInfo;
 
 typedef struct SScanInfo {
@@ -239,6 +246,22 @@ typedef struct STableMetaCacheInfo {
   uint64_t   cacheHit;
 } STableMetaCacheInfo;
 
+// keys of the hash join build side pushed down to the probe side table scan, the data blocks and rows that can not
+// match any of them are skipped by the scan
+typedef struct SScanRuntimeFilter {
+  int32_t      slotId;
+  int16_t      colId;     // -1 if the key is not a column of the table, e.g. a tag
+  int8_t       type;
+  bool         hasRange;  // min/max of the keys, integer and timestamp keys only
+  int64_t      min;
+  int64_t      max;
+  SScalableBf* pBloom;
+  bool*        pKeep;
+  int32_t      keepCap;
+  int64_t      filterBlocks;
+  int64_t      filterRows;
+} SScanRuntimeFilter;
+
 typedef struct STableScanBase {
   STsdbReader*           dataReader;
   SFileBlockLoadRecorder readRecorder;
@@ -254,6 +277,7 @@ typedef struct STableScanBase {
   // there are more than one table list exists in one task, if only one vnode exists.
   STableListInfo* pTableListInfo;
   TsdReader       readerAPI;
+  SScanRuntimeFilter* pRuntimeFilter;
 } STableScanBase;
 
 typedef struct STableScanInfo {
@@ -482,6 +506,13 @@ typedef struct SIntervalAggOperatorInfo {
   uint64_t      curGroupId;  // initialize to UINT64_MAX
   uint64_t      handledGroupNum;
   BoundedQueue* pBQ;
+  // sliding window, each row is aggregated once into the pane of sliding length it falls in, and the overlapping
+  // windows are combined from the panes when the input is exhausted
+  bool            paneAgg;
+  bool            paneAnchorSet;
+  TSKEY           paneAnchor;  // start of one aligned window, all pane starts are on its sliding grid
+  SSHashObj*      pPaneHash;   // key: SPaneKey, value: SResultRow*
+  SqlFunctionCtx* pPaneCtx;    // shallow copy of the function ctx, source side of the pane combine
 } SIntervalAggOperatorInfo;
 
 typedef struct SMergeAlignedIntervalAggOperatorInfo {
@@ -659,6 +690,9 @@ SSchemaWrapper* extractQueriedColumnSchema(SScanPhysiNode* pScanNode);
 int32_t initQueriedTableSchemaInfo(SReadHandle* pHandle, SScanPhysiNode* pScanNode, const char* dbName,
                                    SExecTaskInfo* pTaskInfo);
 void    cleanupQueriedTableScanInfo(void* p);
+void    destroyScanRuntimeFilter(SScanRuntimeFilter* pFilter);
+bool    doFilterByRuntimeFilterRange(STableScanBase* pTableScanInfo, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo);
+int32_t doFilterByRuntimeFilter(SScanRuntimeFilter* pFilter, SSDataBlock* pBlock);
 
 void initBasicInfo(SOptrBasicInfo* pInfo, SSDataBlock* pBlock);
 void cleanupBasicInfo(SOptrBasicInfo* pInfo);
@@ -685,6 +719,8 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
 
 void applyAggFunctionOnPartialTuples(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData,
                                      int32_t offset, int32_t forwardStep, int32_t numOfTotal, int32_t numOfOutput);
+void compactFunctions(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx, int32_t numOfOutput,
+                      SExecTaskInfo* pTaskInfo, SColumnInfoData* pTimeWindowData);
 
 int32_t extractDataBlockFromFetchRsp(SSDataBlock* pRes, char* pData, SArray* pColList, char** pNextStart);
 void    updateLoadRemoteInfo(SLoadRemoteDataInfo* pInfo, int64_t numOfRows, int32_t dataLen, int64_t startTs,
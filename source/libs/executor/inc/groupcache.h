@@ -166,6 +166,7 @@ typedef struct SGroupCacheOperatorInfo {
   SGcDownstreamCtx* pDownstreams;
   SGcBlkCacheInfo   blkCache;
   SHashObj*         pGrpHash;  
+  SDBufMemBudget*   pMemBudget;
   SGcExecInfo       execInfo;
 } SGroupCacheOperatorInfo;
 
@@ -21,6 +21,12 @@ extern "C" {
 
 #define HASH_JOIN_DEFAULT_PAGE_SIZE 10485760
 
+#define HJOIN_SPILL_PART_BITS  4
+#define HJOIN_SPILL_PART_NUM   (1 << HJOIN_SPILL_PART_BITS)
+#define HJOIN_SPILL_PAGE_SIZE  (256 * 1024)
+#define HJOIN_SPILL_MEM_PAGES  16
+#define HJOIN_BLOOM_ERROR_RATE 0.01
+
 #pragma pack(push, 1) 
 typedef struct SBufRowInfo {
   void*    next;
@@ -90,8 +96,36 @@ typedef struct SHJoinExecInfo {
   int64_t probeBlkRows;
   int64_t resRows;
   int64_t expectRows;
+  int64_t spillBuildRows;
+  int64_t spillProbeRows;
+  int64_t hashEntries;  // of the largest hash table built, the key hash is freed once the join is done
+  int64_t hashBytes;
 } SHJoinExecInfo;
 
+typedef struct SHJoinSpillPart {
+  SArray*      pBuildPages;
+  SArray*      pProbePages;
+  SSDataBlock* pBuildStage;
+  SSDataBlock* pProbeStage;
+} SHJoinSpillPart;
+
+// Once the build side runs out of the memory budget, the hash table built so far is kept, and the remaining build
+// rows are partitioned to disk by the hash of their keys. Every probe row is joined with the in-memory table and
+// also saved to its partition if that partition has build rows on disk. After the probe side is exhausted, the
+// partitions are joined one by one.
+typedef struct SHJoinSpillCtx {
+  bool            spilled;
+  bool            probeDone;
+  bool            partLoaded;
+  int32_t         partIdx;
+  int32_t         pageIdx;
+  SDiskbasedBuf*  pBuildBuf;
+  SDiskbasedBuf*  pProbeBuf;
+  SSDataBlock*    pBuildBlock;
+  SSDataBlock*    pProbeBlock;
+  SHJoinSpillPart parts[HJOIN_SPILL_PART_NUM];
+} SHJoinSpillCtx;
+
 
 typedef struct SHJoinOperatorInfo {
   int32_t          joinType;
@@ -102,10 +136,13 @@ typedef struct SHJoinOperatorInfo {
   int32_t          pResColNum;
   int8_t*          pResColMap;
   SArray*          pRowBufs;
+  SDBufMemBudget*  pMemBudget;
   SNode*           pCond;
   SSHashObj*       pKeyHash;
   bool             keyHashBuilt;
   SHJoinCtx        ctx;
+  SHJoinSpillCtx   spill;
+  SScanRuntimeFilter* pRuntimeFilter;
   SHJoinExecInfo   execInfo;
 } SHJoinOperatorInfo;
 
@@ -22,6 +22,8 @@ extern "C" {
 
 #define GET_TASKID(_t) (((SExecTaskInfo*)(_t))->id.str)
 
+#define QUERY_BLOCK_MEM_POOL_SIZE (16 * 1048576L)  // column payloads kept for reuse by one task at most
+
 enum {
   // when this task starts to execute, this status will set
       TASK_NOT_COMPLETED = 0x1u,
@@ -97,6 +99,8 @@ struct SExecTaskInfo {
   int8_t                dynamicTask;
   SOperatorParam*       pOpParam;
   bool                  paramSet;
+  SDBufMemBudget        memBudget;  // memory of the operators of this task, charged to the budget of the dnode as well
+  SBlockMemPool*        pBlockMemPool;  // column payloads freed by the operators, reused by the following blocks
 };
 
 void           buildTaskId(uint64_t taskId, uint64_t queryId, char* dst);
@@ -22,6 +22,7 @@ extern "C" {
 
 #include "os.h"
 #include "tcommon.h"
+#include "tpagedbuf.h"
 
 enum {
   SORT_MULTISOURCE_MERGE = 0x1,
@@ -194,6 +195,13 @@ void tsortSetClosed(SSortHandle* pHandle);
 void tsortSetSingleTableMerge(SSortHandle* pHandle);
 void tsortSetAbortCheckFn(SSortHandle* pHandle, bool (*checkFn)(void* param), void* param);
 
+/**
+ * charge the in-memory pages of the external sort buffer to the budget
+ * @param pHandle
+ * @param pBudget
+ */
+void tsortSetMemBudget(SSortHandle* pHandle, SDBufMemBudget* pBudget);
+
 #ifdef __cplusplus
 }
 #endif
@@ -89,6 +89,7 @@ SOperatorInfo* createAggregateOperatorInfo(SOperatorInfo* downstream, SAggPhysiN
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
   }
+  dBufSetMemBudget(pInfo->aggSup.pResultBuf, &pTaskInfo->memBudget);
 
   int32_t    numOfScalarExpr = 0;
   SExprInfo* pScalarExprInfo = NULL;
@@ -22,6 +22,7 @@
 #include "query.h"
 #include "querytask.h"
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "thash.h"
 #include "tmsg.h"
 #include "tname.h"
@@ -43,6 +44,7 @@ typedef struct SSourceDataInfo {
   SArray*            pSrcUidList;
   int32_t            srcOpType;
   bool               tableSeq;
+  int64_t            rspSeq;
 } SSourceDataInfo;
 
 static void  destroyExchangeOperatorInfo(void* param);
@@ -60,113 +62,185 @@ static int32_t handleLimitOffset(SOperatorInfo* pOperator, SLimitInfo* pLimitInf
                                  bool holdDataInBuf);
 static int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDataInfo);
 
-static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeInfo* pExchangeInfo,
-                                           SExecTaskInfo* pTaskInfo) {
-  int32_t code = 0;
-  size_t  totalSources = taosArrayGetSize(pExchangeInfo->pSourceDataInfo);
-  int32_t completed = getCompletedSources(pExchangeInfo->pSourceDataInfo);
-  if (completed == totalSources) {
-    setAllSourcesCompleted(pOperator);
-    return;
+static void waitForSourceRsp(SExchangeInfo* pExchangeInfo) {
+  int64_t st = taosGetTimestampUs();
+  tsem_wait(&pExchangeInfo->ready);
+  pExchangeInfo->loadInfo.waitTime += (taosGetTimestampUs() - st);
+}
+
+static int32_t getExchangeExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SExchangeInfo*     pInfo = pOptr->info;
+  SExchangeExecInfo* pExecInfo = taosMemoryCalloc(1, sizeof(SExchangeExecInfo));
+  if (pExecInfo == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
   }
 
-  SSourceDataInfo* pDataInfo = NULL;
+  pExecInfo->totalRows = pInfo->loadInfo.totalRows;
+  pExecInfo->totalSize = pInfo->loadInfo.totalSize;
+  pExecInfo->waitTime = pInfo->loadInfo.waitTime;
 
-  while (1) {
-    qDebug("prepare wait for ready, %p, %s", pExchangeInfo, GET_TASKID(pTaskInfo));
-    tsem_wait(&pExchangeInfo->ready);
+  *pOptrExplain = pExecInfo;
+  *len = sizeof(SExchangeExecInfo);
+  return TSDB_CODE_SUCCESS;
+}
 
-    if (isTaskKilled(pTaskInfo)) {
-      T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
+static int32_t compareReadySources(const void* p1, const void* p2, const void* param) {
+  const SArray*          pArray = param;
+  const SSourceDataInfo* pLeft = taosArrayGet(pArray, *(const int32_t*)p1);
+  const SSourceDataInfo* pRight = taosArrayGet(pArray, *(const int32_t*)p2);
+  if (pLeft->rspSeq == pRight->rspSeq) {
+    return 0;
+  }
+  return pLeft->rspSeq < pRight->rspSeq ? -1 : 1;
+}
+
+static int32_t handleReadySource(SOperatorInfo* pOperator, SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTaskInfo,
+                                 int32_t i) {
+  size_t           totalSources = taosArrayGetSize(pExchangeInfo->pSourceDataInfo);
+  SSourceDataInfo* pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, i);
+  if (pDataInfo->code != TSDB_CODE_SUCCESS) {
+    return pDataInfo->code;
+  }
+
+  SRetrieveTableRsp*     pRsp = pDataInfo->pRsp;
+  SDownstreamSourceNode* pSource = taosArrayGet(pExchangeInfo->pSources, pDataInfo->index);
+
+  SLoadRemoteDataInfo* pLoadInfo = &pExchangeInfo->loadInfo;
+  if (pRsp->numOfRows == 0) {
+    if (NULL != pDataInfo->pSrcUidList) {
+      pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+    } else {
+      pDataInfo->status = EX_SOURCE_DATA_EXHAUSTED;
+      qDebug("%s vgId:%d, taskId:0x%" PRIx64 " execId:%d index:%d completed, rowsOfSource:%" PRIu64
+             ", totalRows:%" PRIu64 ", try next %d/%" PRIzu,
+             GET_TASKID(pTaskInfo), pSource->addr.nodeId, pSource->taskId, pSource->execId, i, pDataInfo->totalRows,
+             pExchangeInfo->loadInfo.totalRows, i + 1, totalSources);
     }
+    taosMemoryFreeClear(pDataInfo->pRsp);
+    return TSDB_CODE_SUCCESS;
+  }
 
-    for (int32_t i = 0; i < totalSources; ++i) {
-      pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, i);
-      if (pDataInfo->status == EX_SOURCE_DATA_EXHAUSTED) {
-        continue;
-      }
+  int32_t code = doExtractResultBlocks(pExchangeInfo, pDataInfo);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
 
-      if (pDataInfo->status != EX_SOURCE_DATA_READY) {
-        continue;
-      }
+  updateLoadRemoteInfo(pLoadInfo, pRsp->numOfRows, pRsp->compLen, pDataInfo->startTime, pOperator);
+  pDataInfo->totalRows += pRsp->numOfRows;
 
-      if (pDataInfo->code != TSDB_CODE_SUCCESS) {
-        code = pDataInfo->code;
-        goto _error;
-      }
+  if (pRsp->completed == 1) {
+    pDataInfo->status = EX_SOURCE_DATA_EXHAUSTED;
+    qDebug("%s fetch msg rsp from vgId:%d, taskId:0x%" PRIx64
+           " execId:%d index:%d completed, blocks:%d, numOfRows:%" PRId64 ", rowsOfSource:%" PRIu64 ", totalRows:%" PRIu64
+           ", total:%.2f Kb, try next %d/%" PRIzu,
+           GET_TASKID(pTaskInfo), pSource->addr.nodeId, pSource->taskId, pSource->execId, i, pRsp->numOfBlocks,
+           pRsp->numOfRows, pDataInfo->totalRows, pLoadInfo->totalRows, pLoadInfo->totalSize / 1024.0, i + 1,
+           totalSources);
+  } else {
+    qDebug("%s fetch msg rsp from vgId:%d, taskId:0x%" PRIx64
+           " execId:%d blocks:%d, numOfRows:%" PRId64 ", totalRows:%" PRIu64 ", total:%.2f Kb",
+           GET_TASKID(pTaskInfo), pSource->addr.nodeId, pSource->taskId, pSource->execId, pRsp->numOfBlocks,
+           pRsp->numOfRows, pLoadInfo->totalRows, pLoadInfo->totalSize / 1024.0);
+  }
 
-      SRetrieveTableRsp*     pRsp = pDataInfo->pRsp;
-      SDownstreamSourceNode* pSource = taosArrayGet(pExchangeInfo->pSources, pDataInfo->index);
-
-      // todo
-      SLoadRemoteDataInfo* pLoadInfo = &pExchangeInfo->loadInfo;
-      if (pRsp->numOfRows == 0) {
-        if (NULL != pDataInfo->pSrcUidList) {
-          pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
-          code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, i);
-          if (code != TSDB_CODE_SUCCESS) {
-            taosMemoryFreeClear(pDataInfo->pRsp);
-            goto _error;
-          }
-        } else {
-          pDataInfo->status = EX_SOURCE_DATA_EXHAUSTED;
-          qDebug("%s vgId:%d, taskId:0x%" PRIx64 " execId:%d index:%d completed, rowsOfSource:%" PRIu64
-                 ", totalRows:%" PRIu64 ", try next %d/%" PRIzu,
-                 GET_TASKID(pTaskInfo), pSource->addr.nodeId, pSource->taskId, pSource->execId, i, pDataInfo->totalRows,
-                 pExchangeInfo->loadInfo.totalRows, i + 1, totalSources);
-          taosMemoryFreeClear(pDataInfo->pRsp);
-        }
-        break;
-      }
+  taosMemoryFreeClear(pDataInfo->pRsp);
 
-      code = doExtractResultBlocks(pExchangeInfo, pDataInfo);
-      if (code != TSDB_CODE_SUCCESS) {
-        goto _error;
-      }
+  if (pDataInfo->status != EX_SOURCE_DATA_EXHAUSTED || NULL != pDataInfo->pSrcUidList) {
+    pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
+  }
+  return TSDB_CODE_SUCCESS;
+}
 
-      SRetrieveTableRsp* pRetrieveRsp = pDataInfo->pRsp;
-      updateLoadRemoteInfo(pLoadInfo, pRetrieveRsp->numOfRows, pRetrieveRsp->compLen, pDataInfo->startTime, pOperator);
-      pDataInfo->totalRows += pRetrieveRsp->numOfRows;
-
-      if (pRsp->completed == 1) {
-        pDataInfo->status = EX_SOURCE_DATA_EXHAUSTED;
-        qDebug("%s fetch msg rsp from vgId:%d, taskId:0x%" PRIx64
-               " execId:%d index:%d completed, blocks:%d, numOfRows:%" PRId64 ", rowsOfSource:%" PRIu64 ", totalRows:%" PRIu64
-               ", total:%.2f Kb, try next %d/%" PRIzu,
-               GET_TASKID(pTaskInfo), pSource->addr.nodeId, pSource->taskId, pSource->execId, i, pRsp->numOfBlocks,
-               pRsp->numOfRows, pDataInfo->totalRows, pLoadInfo->totalRows, pLoadInfo->totalSize / 1024.0, i + 1,
-               totalSources);
-      } else {
-        qDebug("%s fetch msg rsp from vgId:%d, taskId:0x%" PRIx64
-               " execId:%d blocks:%d, numOfRows:%" PRId64 ", totalRows:%" PRIu64 ", total:%.2f Kb",
-               GET_TASKID(pTaskInfo), pSource->addr.nodeId, pSource->taskId, pSource->execId, pRsp->numOfBlocks,
-               pRsp->numOfRows, pLoadInfo->totalRows, pLoadInfo->totalSize / 1024.0);
-      }
+// Take all the responses arrived so far in the order of arrival, then send the next fetch to every idle source
+// unless the buffered blocks reach the limit. A source task serves one fetch at a time, so keeping each of them
+// busy while the parent consumes the buffered blocks is as far as the prefetch goes.
+static int32_t collectReadySources(SOperatorInfo* pOperator, SExchangeInfo* pExchangeInfo, SExecTaskInfo* pTaskInfo) {
+  size_t totalSources = taosArrayGetSize(pExchangeInfo->pSourceDataInfo);
 
-      taosMemoryFreeClear(pDataInfo->pRsp);
+  taosArrayClear(pExchangeInfo->pReadySources);
+  for (int32_t i = 0; i < totalSources; ++i) {
+    SSourceDataInfo* pDataInfo = taosArrayGet(pExchangeInfo->pSourceDataInfo, i);
+    if (pDataInfo->status == EX_SOURCE_DATA_READY) {
+      taosArrayPush(pExchangeInfo->pReadySources, &i);
+    }
+  }
 
-      if (pDataInfo->status != EX_SOURCE_DATA_EXHAUSTED || NULL != pDataInfo->pSrcUidList) {
-        pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
-        code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, i);
-        if (code != TSDB_CODE_SUCCESS) {
-          taosMemoryFreeClear(pDataInfo->pRsp);
-          goto _error;
-        }
-      }
+  int32_t numOfReady = taosArrayGetSize(pExchangeInfo->pReadySources);
+  if (numOfReady > 1) {
+    taosqsort(pExchangeInfo->pReadySources->pData, numOfReady, sizeof(int32_t), pExchangeInfo->pSourceDataInfo,
+              compareReadySources);
+  }
+
+  for (int32_t j = 0; j < numOfReady; ++j) {
+    int32_t code = handleReadySource(pOperator, pExchangeInfo, pTaskInfo,
+                                     *(int32_t*)taosArrayGet(pExchangeInfo->pReadySources, j));
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  if (pExchangeInfo->bufferedBytes >= pExchangeInfo->maxBufferedBytes) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  for (int32_t i = 0; i < totalSources; ++i) {
+    int32_t code = doSendFetchDataRequest(pExchangeInfo, pTaskInfo, i);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static void concurrentlyLoadRemoteDataImpl(SOperatorInfo* pOperator, SExchangeInfo* pExchangeInfo,
+                                           SExecTaskInfo* pTaskInfo) {
+  int32_t code = 0;
+  size_t  totalSources = taosArrayGetSize(pExchangeInfo->pSourceDataInfo);
+  int32_t completed = getCompletedSources(pExchangeInfo->pSourceDataInfo);
+  if (completed == totalSources) {
+    setAllSourcesCompleted(pOperator);
+    return;
+  }
+
+  while (1) {
+    code = collectReadySources(pOperator, pExchangeInfo, pTaskInfo);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto _error;
+    }
+
+    if (taosArrayGetSize(pExchangeInfo->pResultBlockList) > 0) {
       return;
-    }  // end loop
+    }
 
     int32_t complete1 = getCompletedSources(pExchangeInfo->pSourceDataInfo);
     if (complete1 == totalSources) {
       qDebug("all sources are completed, %s", GET_TASKID(pTaskInfo));
       return;
     }
+
+    // the responses already taken leave their posts behind, so a wake up may find nothing ready
+    qDebug("prepare wait for ready, %p, %s", pExchangeInfo, GET_TASKID(pTaskInfo));
+    waitForSourceRsp(pExchangeInfo);
+
+    if (isTaskKilled(pTaskInfo)) {
+      T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
+    }
   }
 
 _error:
   pTaskInfo->code = code;
 }
 
+static SSDataBlock* popResultBlock(SExchangeInfo* pExchangeInfo) {
+  SSDataBlock* p = taosArrayGetP(pExchangeInfo->pResultBlockList, 0);
+  taosArrayRemove(pExchangeInfo->pResultBlockList, 0);
+  taosArrayPush(pExchangeInfo->pRecycledBlocks, &p);
+
+  pExchangeInfo->bufferedBytes -= blockDataGetSize(p);
+  return p;
+}
+
 static SSDataBlock* doLoadRemoteDataImpl(SOperatorInfo* pOperator) {
   SExchangeInfo* pExchangeInfo = pOperator->info;
   SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
@@ -182,15 +256,17 @@ static SSDataBlock* doLoadRemoteDataImpl(SOperatorInfo* pOperator) {
   }
 
   // we have buffered retrieved datablock, return it directly
-  SSDataBlock* p = NULL;
   if (taosArrayGetSize(pExchangeInfo->pResultBlockList) > 0) {
-    p = taosArrayGetP(pExchangeInfo->pResultBlockList, 0);
-    taosArrayRemove(pExchangeInfo->pResultBlockList, 0);
-  }
+    // take the responses arrived meanwhile and keep their sources fetching
+    if (!pExchangeInfo->seqLoadData) {
+      int32_t code = collectReadySources(pOperator, pExchangeInfo, pTaskInfo);
+      if (code != TSDB_CODE_SUCCESS) {
+        pTaskInfo->code = code;
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+    }
 
-  if (p != NULL) {
-    taosArrayPush(pExchangeInfo->pRecycledBlocks, &p);
-    return p;
+    return popResultBlock(pExchangeInfo);
   } else {
     if (pExchangeInfo->seqLoadData) {
       seqLoadRemoteData(pOperator);
@@ -201,10 +277,7 @@ static SSDataBlock* doLoadRemoteDataImpl(SOperatorInfo* pOperator) {
     if (taosArrayGetSize(pExchangeInfo->pResultBlockList) == 0) {
       return NULL;
     } else {
-      p = taosArrayGetP(pExchangeInfo->pResultBlockList, 0);
-      taosArrayRemove(pExchangeInfo->pResultBlockList, 0);
-      taosArrayPush(pExchangeInfo->pRecycledBlocks, &p);
-      return p;
+      return popResultBlock(pExchangeInfo);
     }
   }
 }
@@ -327,6 +400,8 @@ SOperatorInfo* createExchangeOperatorInfo(void* pTransporter, SExchangePhysiNode
   pInfo->pDummyBlock = createDataBlockFromDescNode(pExNode->node.pOutputDataBlockDesc);
   pInfo->pResultBlockList = taosArrayInit(64, POINTER_BYTES);
   pInfo->pRecycledBlocks = taosArrayInit(64, POINTER_BYTES);
+  pInfo->pReadySources = taosArrayInit(4, sizeof(int32_t));
+  pInfo->maxBufferedBytes = (int64_t)tsQueryExchangeBufferSize * 1048576;
 
   SExchangeOpStopInfo stopInfo = {QUERY_NODE_PHYSICAL_PLAN_EXCHANGE, pInfo->self};
   qAppendTaskStopInfo(pTaskInfo, &stopInfo);
@@ -344,7 +419,8 @@ SOperatorInfo* createExchangeOperatorInfo(void* pTransporter, SExchangePhysiNode
   }
 
   pOperator->fpSet =
-      createOperatorFpSet(prepareLoadRemoteData, loadRemoteData, NULL, destroyExchangeOperatorInfo, optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+      createOperatorFpSet(prepareLoadRemoteData, loadRemoteData, NULL, destroyExchangeOperatorInfo, optrDefaultBufFn,
+                          getExchangeExplainExecInfo, optrDefaultGetNextExtFn, NULL);
   return pOperator;
 
 _error:
@@ -380,6 +456,7 @@ void doDestroyExchangeOperatorInfo(void* param) {
 
   taosArrayDestroyEx(pExInfo->pResultBlockList, freeBlock);
   taosArrayDestroyEx(pExInfo->pRecycledBlocks, freeBlock);
+  taosArrayDestroy(pExInfo->pReadySources);
 
   blockDataDestroy(pExInfo->pDummyBlock);
   tSimpleHashCleanup(pExInfo->pHashSources);
@@ -413,8 +490,10 @@ int32_t loadRemoteDataCallback(void* param, SDataBuf* pMsg, int32_t code) {
 
     qDebug("%s fetch rsp received, index:%d, blocks:%d, rows:%" PRId64 ", %p", pSourceDataInfo->taskId, index, pRsp->numOfBlocks,
            pRsp->numOfRows, pExchangeInfo);
+    pSourceDataInfo->rspSeq = atomic_add_fetch_64(&pExchangeInfo->rspSeq, 1);
   } else {
     taosMemoryFree(pMsg->pData);
+    pSourceDataInfo->rspSeq = atomic_add_fetch_64(&pExchangeInfo->rspSeq, 1);
     pSourceDataInfo->code = code;
     qDebug("%s fetch rsp received, index:%d, error:%s, %p", pSourceDataInfo->taskId, index, tstrerror(code),
            pExchangeInfo);
@@ -682,6 +761,7 @@ int32_t doExtractResultBlocks(SExchangeInfo* pExchangeInfo, SSourceDataInfo* pDa
     }
 
     taosArrayPush(pExchangeInfo->pResultBlockList, &pb);
+    pExchangeInfo->bufferedBytes += blockDataGetSize(pb);
   }
 
   return code;
@@ -705,7 +785,7 @@ int32_t seqLoadRemoteData(SOperatorInfo* pOperator) {
     pDataInfo->status = EX_SOURCE_DATA_NOT_READY;
 
     doSendFetchDataRequest(pExchangeInfo, pTaskInfo, pExchangeInfo->current);
-    tsem_wait(&pExchangeInfo->ready);
+    waitForSourceRsp(pExchangeInfo);
     if (isTaskKilled(pTaskInfo)) {
       T_LONG_JMP(pTaskInfo->env, pTaskInfo->code);
     }
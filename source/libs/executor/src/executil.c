@@ -515,16 +515,19 @@ int32_t getColInfoResultForGroupby(void* pVnode, SNodeList* group, STableListInf
     taosArrayPush(pUidTagList, &info);
   }
 
-  code = pAPI->metaFn.getTableTags(pVnode, pTableListInfo->idInfo.suid, pUidTagList);
-  if (code != TSDB_CODE_SUCCESS) {
-    goto end;
-  }
-
-  int32_t numOfTables = taosArrayGetSize(pUidTagList);
-  pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+  pResBlock = createTagValBlockFromStore(ctx.cInfoList, pUidTagList, pTableListInfo->idInfo.suid, pVnode, pAPI);
   if (pResBlock == NULL) {
-    code = terrno;
-    goto end;
+    code = pAPI->metaFn.getTableTags(pVnode, pTableListInfo->idInfo.suid, pUidTagList);
+    if (code != TSDB_CODE_SUCCESS) {
+      goto end;
+    }
+
+    int32_t numOfTables = taosArrayGetSize(pUidTagList);
+    pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+    if (pResBlock == NULL) {
+      code = terrno;
+      goto end;
+    }
   }
 
   //  int64_t st1 = taosGetTimestampUs();
@@ -926,6 +929,30 @@ SSDataBlock* createTagValBlockForFilter(SArray* pColList, int32_t numOfTables, S
   return pResBlock;
 }
 
+// the tag values of the tables in pUidTagList, or of all child tables if it is empty, from the column store of the
+// super table, NULL if the store does not serve them
+SSDataBlock* createTagValBlockFromStore(SArray* pColList, SArray* pUidTagList, uint64_t suid, void* pVnode,
+                                        SStorageAPI* pStorageAPI) {
+  SSDataBlock* pResBlock = createDataBlock();
+  if (pResBlock == NULL) {
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pColList); ++i) {
+    SColumnInfoData colInfo = {0};
+    colInfo.info = *(SColumnInfo*)taosArrayGet(pColList, i);
+    blockDataAppendColInfo(pResBlock, &colInfo);
+  }
+
+  int32_t code = pStorageAPI->metaFn.getTableTagCols(pVnode, suid, pUidTagList, pResBlock);
+  if (code != TSDB_CODE_SUCCESS) {
+    blockDataDestroy(pResBlock);
+    return NULL;
+  }
+
+  return pResBlock;
+}
+
 static int32_t doSetQualifiedUid(STableListInfo* pListInfo, SArray* pUidList, const SArray* pUidTagList, bool* pResultList, bool addUid) {
   taosArrayClear(pUidList);
 
@@ -937,9 +964,11 @@ static int32_t doSetQualifiedUid(STableListInfo* pListInfo, SArray* pUidList, co
       qDebug("tagfilter get uid:%" PRId64 ", res:%d", uid, pResultList[i]);
 
       info.uid = uid;
-      void* p = taosArrayPush(pListInfo->pTableList, &info);
-      if (p == NULL) {
-        return TSDB_CODE_OUT_OF_MEMORY;
+      if (pListInfo != NULL) {
+        void* p = taosArrayPush(pListInfo->pTableList, &info);
+        if (p == NULL) {
+          return TSDB_CODE_OUT_OF_MEMORY;
+        }
       }
 
       if (addUid) {
@@ -964,8 +993,11 @@ static void copyExistedUids(SArray* pUidTagList, const SArray* pUidList) {
   }
 }
 
+// With changedOnly, only the child tables in pUidList are evaluated, e.g. the ones changed since the cached uid list,
+// the qualified ones are left in pUidList without being added into the table list.
 static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SNode* pTagCond, void* pVnode,
-                                 SIdxFltStatus status, SStorageAPI* pAPI, bool addUid, bool* listAdded) {
+                                 SIdxFltStatus status, SStorageAPI* pAPI, bool addUid, bool* listAdded,
+                                 bool changedOnly) {
   *listAdded = false;
   if (pTagCond == NULL) {
     return TSDB_CODE_SUCCESS;
@@ -1002,7 +1034,7 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
 
   FilterCondType condType = checkTagCond(pTagCond);
 
-  int32_t filter = optimizeTbnameInCond(pVnode, pListInfo->idInfo.suid, pUidTagList, pTagCond, pAPI);
+  int32_t filter = changedOnly ? -1 : optimizeTbnameInCond(pVnode, pListInfo->idInfo.suid, pUidTagList, pTagCond, pAPI);
   if (filter == 0) {  // tbname in filter is activated, do nothing and return
     taosArrayClear(pUidList);
 
@@ -1014,7 +1046,14 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     }
     terrno = 0;
   } else {
-    if ((condType == FILTER_NO_LOGIC || condType == FILTER_AND) && status != SFLT_NOT_INDEX) {
+    bool byUid = changedOnly || ((condType == FILTER_NO_LOGIC || condType == FILTER_AND) && status != SFLT_NOT_INDEX);
+    if (!changedOnly && (!byUid || taosArrayGetSize(pUidTagList) > 0)) {
+      pResBlock = createTagValBlockFromStore(ctx.cInfoList, pUidTagList, pListInfo->idInfo.suid, pVnode, pAPI);
+    }
+
+    if (pResBlock != NULL) {
+      code = TSDB_CODE_SUCCESS;
+    } else if (byUid) {
       code = pAPI->metaFn.getTableTagsByUid(pVnode, pListInfo->idInfo.suid, pUidTagList);
     } else {
       code = pAPI->metaFn.getTableTags(pVnode, pListInfo->idInfo.suid, pUidTagList);
@@ -1026,15 +1065,35 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     }
   }
 
+  if (changedOnly) {
+    // the tables dropped after the changes are retrieved have no tags
+    int32_t numOfExisted = 0;
+    for (int32_t i = 0; i < taosArrayGetSize(pUidTagList); ++i) {
+      STUidTagInfo* pInfo = taosArrayGet(pUidTagList, i);
+      if (pInfo->pTagVal != NULL) {
+        if (i != numOfExisted) {
+          taosArraySet(pUidTagList, numOfExisted, pInfo);
+        }
+        numOfExisted += 1;
+      }
+    }
+    taosArrayPopTailBatch(pUidTagList, taosArrayGetSize(pUidTagList) - numOfExisted);
+    if (numOfExisted == 0) {
+      taosArrayClear(pUidList);
+    }
+  }
+
   int32_t numOfTables = taosArrayGetSize(pUidTagList);
   if (numOfTables == 0) {
     goto end;
   }
 
-  pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
   if (pResBlock == NULL) {
-    code = terrno;
-    goto end;
+    pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+    if (pResBlock == NULL) {
+      code = terrno;
+      goto end;
+    }
   }
 
   //  int64_t st1 = taosGetTimestampUs();
@@ -1055,12 +1114,13 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     goto end;
   }
 
-  code = doSetQualifiedUid(pListInfo, pUidList, pUidTagList, (bool*)output.columnData->pData, addUid);
+  code = doSetQualifiedUid(changedOnly ? NULL : pListInfo, pUidList, pUidTagList, (bool*)output.columnData->pData,
+                           addUid);
   if (code != TSDB_CODE_SUCCESS) {
     terrno = code;
     goto end;
   }
-  *listAdded = true;
+  *listAdded = !changedOnly;
 
 end:
   taosHashCleanup(ctx.colHash);
@@ -1074,11 +1134,49 @@ end:
   return code;
 }
 
+static void putTableListIntoCache(void* pVnode, uint64_t suid, const uint8_t* pKey, int32_t keyLen, SArray* pUidList,
+                                  int64_t ver, SStorageAPI* pStorageAPI) {
+  int32_t numOfTables = taosArrayGetSize(pUidList);
+  size_t  size = numOfTables * sizeof(uint64_t) + sizeof(int32_t);
+  char*   pPayload = taosMemoryMalloc(size);
+  if (pPayload == NULL) {
+    return;
+  }
+
+  *(int32_t*)pPayload = numOfTables;
+  if (numOfTables > 0) {
+    memcpy(pPayload + sizeof(int32_t), taosArrayGet(pUidList, 0), numOfTables * sizeof(uint64_t));
+  }
+
+  pStorageAPI->metaFn.putCachedTableList(pVnode, suid, pKey, keyLen, pPayload, size, 1, ver);
+}
+
+// the cached uid list is patched by evaluating the tag condition over the child tables changed since it was cached
+static int32_t doPatchCachedTableList(STableListInfo* pListInfo, SArray* pUidList, SArray* pChangedList,
+                                      SNode* pTagCond, void* pVnode, SStorageAPI* pStorageAPI) {
+  if (pTagCond != NULL && taosArrayGetSize(pChangedList) > 0) {
+    bool    listAdded = false;
+    int32_t code = doFilterByTagCond(pListInfo, pChangedList, pTagCond, pVnode, SFLT_ACCURATE_INDEX, pStorageAPI,
+                                     true, &listAdded, true);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  if (taosArrayAddAll(pUidList, pChangedList) == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, SNode* pTagIndexCond,
                      STableListInfo* pListInfo, uint8_t* digest, const char* idstr, SStorageAPI* pStorageAPI) {
   int32_t code = TSDB_CODE_SUCCESS;
   size_t  numOfTables = 0;
   bool    listAdded = false;
+  int64_t cacheVer = 0;
+  int64_t cachedVer = 0;
 
   pListInfo->idInfo.suid = pScanNode->suid;
   pListInfo->idInfo.tableType = pScanNode->tableType;
@@ -1091,7 +1189,7 @@ int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, S
     if (pStorageAPI->metaFn.isTableExisted(pVnode, pScanNode->uid)) {
       taosArrayPush(pUidList, &pScanNode->uid);
     }
-    code = doFilterByTagCond(pListInfo, pUidList, pTagCond, pVnode, status, pStorageAPI, false, &listAdded);
+    code = doFilterByTagCond(pListInfo, pUidList, pTagCond, pVnode, status, pStorageAPI, false, &listAdded, false);
     if (code != TSDB_CODE_SUCCESS) {
       goto _end;
     }
@@ -1102,15 +1200,37 @@ int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, S
       // try to retrieve the result from meta cache
       genTagFilterDigest(pTagCond, &context);
 
-      bool acquired = false;
-      pStorageAPI->metaFn.getCachedTableList(pVnode, pScanNode->suid, context.digest, tListLen(context.digest),
-                                             pUidList, &acquired);
+      bool    acquired = false;
+      SArray* pChangedList = taosArrayInit(4, sizeof(uint64_t));
+      if (pChangedList == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _end;
+      }
+
+      code = pStorageAPI->metaFn.getCachedTableList(pVnode, pScanNode->suid, context.digest, tListLen(context.digest),
+                                                    pUidList, &acquired, pChangedList, &cacheVer, &cachedVer);
+      // a list patched only with dropped tables is put back as well, the changes are discarded once no list needs them
+      if (acquired && cachedVer != cacheVer) {
+        code = doPatchCachedTableList(pListInfo, pUidList, pChangedList, pTagCond, pVnode, pStorageAPI);
+        if (code == TSDB_CODE_SUCCESS) {
+          qDebug("patch table uid list in cache, changed tables:%d, %s", (int32_t)taosArrayGetSize(pChangedList),
+                 idstr);
+          putTableListIntoCache(pVnode, pScanNode->suid, context.digest, tListLen(context.digest), pUidList, cacheVer,
+                                pStorageAPI);
+        } else {
+          acquired = false;
+          taosArrayClear(pUidList);
+        }
+      }
+      taosArrayDestroy(pChangedList);
+
       if (acquired) {
         digest[0] = 1;
         memcpy(digest + 1, context.digest, tListLen(context.digest));
         qDebug("retrieve table uid list from cache, numOfTables:%d", (int32_t)taosArrayGetSize(pUidList));
         goto _end;
       }
+      code = TSDB_CODE_SUCCESS;
     }
 
     if (!pTagCond) {  // no tag filter condition exists, let's fetch all tables of this super table
@@ -1135,7 +1255,8 @@ int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, S
       }
     }
 
-    code = doFilterByTagCond(pListInfo, pUidList, pTagCond, pVnode, status, pStorageAPI, tsTagFilterCache, &listAdded);
+    code = doFilterByTagCond(pListInfo, pUidList, pTagCond, pVnode, status, pStorageAPI, tsTagFilterCache, &listAdded,
+                             false);
     if (code != TSDB_CODE_SUCCESS) {
       goto _end;
     }
@@ -1144,15 +1265,8 @@ int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, S
     numOfTables = taosArrayGetSize(pUidList);
 
     if (tsTagFilterCache) {
-      size_t size = numOfTables * sizeof(uint64_t) + sizeof(int32_t);
-      char*  pPayload = taosMemoryMalloc(size);
-
-      *(int32_t*)pPayload = numOfTables;
-      if (numOfTables > 0) {
-        memcpy(pPayload + sizeof(int32_t), taosArrayGet(pUidList, 0), numOfTables * sizeof(uint64_t));
-      }
-
-      pStorageAPI->metaFn.putCachedTableList(pVnode, pScanNode->suid, context.digest, tListLen(context.digest), pPayload, size, 1);
+      putTableListIntoCache(pVnode, pScanNode->suid, context.digest, tListLen(context.digest), pUidList, cacheVer,
+                            pStorageAPI);
       digest[0] = 1;
       memcpy(digest + 1, context.digest, tListLen(context.digest));
     }
@@ -2154,6 +2268,45 @@ int32_t buildGroupIdMapForAllTables(STableListInfo* pTableListInfo, SReadHandle*
   return code;
 }
 
+// Keep the tables of one slice, i.e. the ones with uid % numOfSlices == sliceIdx, so that the scan subplans of the
+// same vgroup running in parallel read disjoint tables. The order of the remaining tables is retained, and so is the
+// grouping of them.
+int32_t tableListSlice(STableListInfo* pTableListInfo, int32_t sliceIdx, int32_t numOfSlices) {
+  size_t  numOfTables = taosArrayGetSize(pTableListInfo->pTableList);
+  int32_t numOfKept = 0;
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    STableKeyInfo* p = taosArrayGet(pTableListInfo->pTableList, i);
+    if (p->uid % numOfSlices == sliceIdx) {
+      *(STableKeyInfo*)taosArrayGet(pTableListInfo->pTableList, numOfKept++) = *p;
+    }
+  }
+  taosArrayPopTailBatch(pTableListInfo->pTableList, numOfTables - numOfKept);
+
+  if (pTableListInfo->numOfOuputGroups == numOfTables && numOfTables > 1) {
+    pTableListInfo->numOfOuputGroups = numOfKept;
+  }
+
+  if (pTableListInfo->groupOffset != NULL) {
+    taosMemoryFreeClear(pTableListInfo->groupOffset);
+    if (numOfKept == 0) {
+      pTableListInfo->numOfOuputGroups = 1;
+    } else {
+      int32_t code = sortTableGroup(pTableListInfo);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    }
+  }
+
+  taosHashClear(pTableListInfo->map);
+  for (int32_t i = 0; i < numOfKept; ++i) {
+    STableKeyInfo* p = taosArrayGet(pTableListInfo->pTableList, i);
+    taosHashPut(pTableListInfo->map, &p->uid, sizeof(uint64_t), &i, sizeof(int32_t));
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t createScanTableListInfo(SScanPhysiNode* pScanNode, SNodeList* pGroupTags, bool groupSort, SReadHandle* pHandle,
                                 STableListInfo* pTableListInfo, SNode* pTagCond, SNode* pTagIndexCond,
                                 SExecTaskInfo* pTaskInfo) {
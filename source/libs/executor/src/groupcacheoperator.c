@@ -184,6 +184,7 @@ static void destroyGroupCacheOperator(void* param) {
   taosMemoryFree(pGrpCacheOperator->groupColsInfo.pBuf);
 
   destroyGroupCacheDownstreamCtx(pGrpCacheOperator);
+  dBufMemBudgetRelease(pGrpCacheOperator->pMemBudget, pGrpCacheOperator->blkCache.blkCacheSize);
   destroySGcBlkCacheInfo(&pGrpCacheOperator->blkCache);
   taosHashCleanup(pGrpCacheOperator->pGrpHash);
 
@@ -345,6 +346,14 @@ static int32_t addBlkToDirtyBufList(SGroupCacheOperatorInfo* pGCache, SGcDownstr
   }
   int32_t code = TSDB_CODE_SUCCESS;
   SGcBlkBufInfo* pWriteHead = NULL;
+  int64_t        writeSize = 0;
+
+  // over the query memory budget, write down all the dirty blocks no matter the cache size
+  bool    overBudget = !dBufMemBudgetAcquire(pGCache->pMemBudget, pBufInfo->basic.bufSize, false);
+  int64_t maxCacheSize = overBudget ? 0 : pGCache->maxCacheSize;
+  if (overBudget) {
+    dBufMemBudgetAcquire(pGCache->pMemBudget, pBufInfo->basic.bufSize, true);
+  }
   
   taosWLockLatch(&pCache->dirtyLock);
   pCache->blkCacheSize += pBufInfo->basic.bufSize;
@@ -357,13 +366,14 @@ static int32_t addBlkToDirtyBufList(SGroupCacheOperatorInfo* pGCache, SGcDownstr
   }
   pCache->pDirtyTail = pBufInfo;
     
-  if (pGCache->maxCacheSize >= 0 && pCache->blkCacheSize > pGCache->maxCacheSize) {
+  if (maxCacheSize >= 0 && pCache->blkCacheSize > maxCacheSize) {
     if (-1 == atomic_val_compare_exchange_32(&pCache->writeDownstreamId, -1, pCtx->id)) {
       pWriteHead = pCache->pDirtyHead;
       SGcBlkBufInfo* pTmp = pCache->pDirtyHead;
       while (NULL != pTmp) {
         pCache->blkCacheSize -= pTmp->basic.bufSize;
-        if (pCache->blkCacheSize <= pGCache->maxCacheSize) {
+        writeSize += pTmp->basic.bufSize;
+        if (pCache->blkCacheSize <= maxCacheSize) {
           pCache->pDirtyHead = pTmp->next;
           pTmp->next = NULL;
           break;
@@ -376,6 +386,7 @@ static int32_t addBlkToDirtyBufList(SGroupCacheOperatorInfo* pGCache, SGcDownstr
 
   if (NULL != pWriteHead) {
     code = saveBlocksToDisk(pGCache, pCtx, pWriteHead);
+    dBufMemBudgetRelease(pGCache->pMemBudget, writeSize);
   }
 
   return code;
@@ -1345,6 +1356,7 @@ SOperatorInfo* createGroupCacheOperatorInfo(SOperatorInfo** pDownstream, int32_t
   setOperatorInfo(pOperator, "GroupCacheOperator", QUERY_NODE_PHYSICAL_PLAN_GROUP_CACHE, false, OP_NOT_OPENED, pInfo, pTaskInfo);
 
   pInfo->maxCacheSize = 0;
+  pInfo->pMemBudget = &pTaskInfo->memBudget;
   pInfo->grpByUid = pPhyciNode->grpByUid;
   pInfo->globalGrp = pPhyciNode->globalGrp;
   pInfo->batchFetch = pPhyciNode->batchFetch;
@@ -38,6 +38,7 @@ typedef struct SGroupbyOperatorInfo {
   int32_t        groupKeyLen;    // total group by column width
   SGroupResInfo  groupResInfo;
   SExprSupp      scalarSup;
+  SHashExecInfo  execInfo;
 } SGroupbyOperatorInfo;
 
 // The sort in partition may be needed later.
@@ -152,6 +153,11 @@ static bool groupKeyCompare(SArray* pGroupCols, SArray* pGroupColVals, SSDataBlo
         return false;
       }
     } else if (IS_VAR_DATA_TYPE(pkey->type)) {
+      // the keys hold the value of the previous row, which may share its payload with this one
+      if (rowIndex > 0 && pColInfoData->varmeta.offset[rowIndex] == pColInfoData->varmeta.offset[rowIndex - 1]) {
+        continue;
+      }
+
       int32_t len = varDataLen(val);
       if (len == varDataLen(pkey->pData) && memcmp(varDataVal(pkey->pData), varDataVal(val), len) == 0) {
         continue;
@@ -421,12 +427,31 @@ static SSDataBlock* hashGroupbyAggregate(SOperatorInfo* pOperator) {
     }
   }
 #endif
+  pInfo->execInfo.hashEntries = tSimpleHashGetSize(pInfo->aggSup.pResultRowHashTable);
+  pInfo->execInfo.hashBytes = tSimpleHashGetMemSize(pInfo->aggSup.pResultRowHashTable);
   initGroupedResultInfo(&pInfo->groupResInfo, pInfo->aggSup.pResultRowHashTable, 0);
 
   pOperator->cost.openCost = (taosGetTimestampUs() - st) / 1000.0;
   return buildGroupResultDataBlock(pOperator);
 }
 
+static int32_t getGroupbyExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SGroupbyOperatorInfo* pInfo = pOptr->info;
+  SHashExecInfo*        pExecInfo = taosMemoryCalloc(1, sizeof(SHashExecInfo));
+  if (pExecInfo == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  SDiskbasedBufStatis statis = getDBufStatis(pInfo->aggSup.pResultBuf);
+  *pExecInfo = pInfo->execInfo;
+  pExecInfo->spillBytes = statis.flushBytes;
+  pExecInfo->loadBytes = statis.loadBytes;
+
+  *pOptrExplain = pExecInfo;
+  *len = sizeof(SHashExecInfo);
+  return TSDB_CODE_SUCCESS;
+}
+
 SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pAggNode, SExecTaskInfo* pTaskInfo) {
   int32_t               code = TSDB_CODE_SUCCESS;
   SGroupbyOperatorInfo* pInfo = taosMemoryCalloc(1, sizeof(SGroupbyOperatorInfo));
@@ -466,6 +491,7 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
   }
+  dBufSetMemBudget(pInfo->aggSup.pResultBuf, &pTaskInfo->memBudget);
 
   code = filterInitFromNode((SNode*)pAggNode->node.pConditions, &pOperator->exprSupp.pFilterInfo, 0);
   if (code != TSDB_CODE_SUCCESS) {
@@ -480,7 +506,7 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
   pInfo->binfo.outputTsOrder = pAggNode->node.outputTsOrder;
 
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, hashGroupbyAggregate, NULL, destroyGroupOperatorInfo,
-                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+                                         optrDefaultBufFn, getGroupbyExplainExecInfo, optrDefaultGetNextExtFn, NULL);
   code = appendDownstream(pOperator, &downstream, 1);
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
@@ -889,6 +915,7 @@ SOperatorInfo* createPartitionOperatorInfo(SOperatorInfo* downstream, SPartition
     pTaskInfo->code = code;
     goto _error;
   }
+  dBufSetMemBudget(pInfo->pBuf, &pTaskInfo->memBudget);
 
   pInfo->rowCapacity = blockDataGetCapacityInRow(pInfo->binfo.pRes, getBufPageSize(pInfo->pBuf),
                                                  blockDataGetSerialMetaSize(taosArrayGetSize(pInfo->binfo.pRes->pDataBlock)));
@@ -22,6 +22,7 @@
 #include "querytask.h"
 #include "tcompare.h"
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "thash.h"
 #include "tmsg.h"
 #include "ttypes.h"
@@ -241,7 +242,7 @@ static int32_t buildHJoinResColMap(SHJoinOperatorInfo* pInfo, SHashJoinPhysiNode
 }
 
 
-static FORCE_INLINE int32_t addPageToHJoinBuf(SArray* pRowBufs) {
+static FORCE_INLINE int32_t addPageToHJoinBuf(SHJoinOperatorInfo* pJoin) {
   SBufPageInfo page;
   page.pageSize = HASH_JOIN_DEFAULT_PAGE_SIZE;
   page.offset = 0;
@@ -250,7 +251,15 @@ static FORCE_INLINE int32_t addPageToHJoinBuf(SArray* pRowBufs) {
     return TSDB_CODE_OUT_OF_MEMORY;
   }
 
-  taosArrayPush(pRowBufs, &page);
+  // out of the budget, the block in progress is finished in memory and the following build blocks go to disk
+  bool spillable = !pJoin->spill.spilled && !pJoin->spill.probeDone && taosArrayGetSize(pJoin->pRowBufs) > 0;
+  if (!dBufMemBudgetAcquire(pJoin->pMemBudget, page.pageSize, !spillable)) {
+    dBufMemBudgetAcquire(pJoin->pMemBudget, page.pageSize, true);
+    pJoin->spill.spilled = true;
+    qDebug("hash join build side exceeds the memory budget, %d pages in memory", (int32_t)taosArrayGetSize(pJoin->pRowBufs));
+  }
+
+  taosArrayPush(pJoin->pRowBufs, &page);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -260,7 +269,7 @@ static int32_t initHJoinBufPages(SHJoinOperatorInfo* pInfo) {
     return TSDB_CODE_OUT_OF_MEMORY;
   }
 
-  return addPageToHJoinBuf(pInfo->pRowBufs);
+  return addPageToHJoinBuf(pInfo);
 }
 
 static void freeHJoinTableInfo(SHJoinTableInfo* pTable) {
@@ -275,6 +284,35 @@ static void freeHJoinBufPage(void* param) {
   taosMemoryFree(pInfo->data);
 }
 
+// keep the first page to build the hash table of the next spilled partition
+static void resetHJoinBufPages(SHJoinOperatorInfo* pJoin) {
+  int32_t pageNum = taosArrayGetSize(pJoin->pRowBufs);
+  for (int32_t i = 1; i < pageNum; ++i) {
+    freeHJoinBufPage(taosArrayGet(pJoin->pRowBufs, i));
+  }
+
+  dBufMemBudgetRelease(pJoin->pMemBudget, (int64_t)(pageNum - 1) * HASH_JOIN_DEFAULT_PAGE_SIZE);
+  taosArrayRemoveBatch(pJoin->pRowBufs, 1, pageNum - 1, NULL);
+
+  SBufPageInfo* pPage = taosArrayGet(pJoin->pRowBufs, 0);
+  pPage->offset = 0;
+}
+
+static void destroyHJoinSpillCtx(SHJoinSpillCtx* pSpill) {
+  for (int32_t i = 0; i < HJOIN_SPILL_PART_NUM; ++i) {
+    SHJoinSpillPart* pPart = &pSpill->parts[i];
+    taosArrayDestroy(pPart->pBuildPages);
+    taosArrayDestroy(pPart->pProbePages);
+    blockDataDestroy(pPart->pBuildStage);
+    blockDataDestroy(pPart->pProbeStage);
+  }
+
+  blockDataDestroy(pSpill->pBuildBlock);
+  blockDataDestroy(pSpill->pProbeBlock);
+  destroyDiskbasedBuf(pSpill->pBuildBuf);
+  destroyDiskbasedBuf(pSpill->pProbeBuf);
+}
+
 static void destroyHJoinKeyHash(SSHashObj** ppHash) {
   if (NULL == ppHash || NULL == (*ppHash)) {
     return;
@@ -297,18 +335,57 @@ static void destroyHJoinKeyHash(SSHashObj** ppHash) {
   *ppHash = NULL;
 }
 
+static void updateHJoinHashSize(SHJoinOperatorInfo* pJoin) {
+  int64_t bytes = tSimpleHashGetMemSize(pJoin->pKeyHash) +
+                  (int64_t)taosArrayGetSize(pJoin->pRowBufs) * HASH_JOIN_DEFAULT_PAGE_SIZE;
+  if (bytes > pJoin->execInfo.hashBytes) {
+    pJoin->execInfo.hashEntries = tSimpleHashGetSize(pJoin->pKeyHash);
+    pJoin->execInfo.hashBytes = bytes;
+  }
+}
+
+static int32_t getHashJoinExplainExecInfo(SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SHJoinOperatorInfo* pJoin = pOptr->info;
+  SHashExecInfo*      pExecInfo = taosMemoryCalloc(1, sizeof(SHashExecInfo));
+  if (pExecInfo == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pExecInfo->hashEntries = pJoin->execInfo.hashEntries;
+  pExecInfo->hashBytes = pJoin->execInfo.hashBytes;
+
+  SDiskbasedBuf* bufs[] = {pJoin->spill.pBuildBuf, pJoin->spill.pProbeBuf};
+  for (int32_t i = 0; i < tListLen(bufs); ++i) {
+    if (bufs[i] != NULL) {
+      SDiskbasedBufStatis statis = getDBufStatis(bufs[i]);
+      pExecInfo->spillBytes += statis.flushBytes;
+      pExecInfo->loadBytes += statis.loadBytes;
+    }
+  }
+
+  *pOptrExplain = pExecInfo;
+  *len = sizeof(SHashExecInfo);
+  return TSDB_CODE_SUCCESS;
+}
+
 static void destroyHashJoinOperator(void* param) {
   SHJoinOperatorInfo* pJoinOperator = (SHJoinOperatorInfo*)param;
-  qError("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64, 
+  qError("hashJoin exec info, buildBlk:%" PRId64 ", buildRows:%" PRId64 ", probeBlk:%" PRId64 ", probeRows:%" PRId64 ", resRows:%" PRId64
+         ", spillBuildRows:%" PRId64 ", spillProbeRows:%" PRId64, 
          pJoinOperator->execInfo.buildBlkNum, pJoinOperator->execInfo.buildBlkRows, pJoinOperator->execInfo.probeBlkNum, 
-         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows);
+         pJoinOperator->execInfo.probeBlkRows, pJoinOperator->execInfo.resRows, pJoinOperator->execInfo.spillBuildRows,
+         pJoinOperator->execInfo.spillProbeRows);
 
   destroyHJoinKeyHash(&pJoinOperator->pKeyHash);
+  destroyHJoinSpillCtx(&pJoinOperator->spill);
+  destroyScanRuntimeFilter(pJoinOperator->pRuntimeFilter);
 
   freeHJoinTableInfo(&pJoinOperator->tbs[0]);
   freeHJoinTableInfo(&pJoinOperator->tbs[1]);
   pJoinOperator->pRes = blockDataDestroy(pJoinOperator->pRes);
   taosMemoryFreeClear(pJoinOperator->pResColMap);
+  dBufMemBudgetRelease(pJoinOperator->pMemBudget,
+                       (int64_t)taosArrayGetSize(pJoinOperator->pRowBufs) * HASH_JOIN_DEFAULT_PAGE_SIZE);
   taosArrayDestroyEx(pJoinOperator->pRowBufs, freeHJoinBufPage);
   nodesDestroyNode(pJoinOperator->pCond);
 
@@ -571,7 +648,8 @@ static FORCE_INLINE void copyValColsDataToBuf(SHJoinTableInfo* pTable, int32_t r
 }
 
 
-static FORCE_INLINE int32_t getValBufFromPages(SArray* pPages, int32_t bufSize, char** pBuf, SBufRowInfo* pRow) {
+static FORCE_INLINE int32_t getValBufFromPages(SHJoinOperatorInfo* pJoin, int32_t bufSize, char** pBuf, SBufRowInfo* pRow) {
+  SArray* pPages = pJoin->pRowBufs;
   if (0 == bufSize) {
     pRow->pageId = -1;
     return TSDB_CODE_SUCCESS;
@@ -592,7 +670,7 @@ static FORCE_INLINE int32_t getValBufFromPages(SArray* pPages, int32_t bufSize,
       return TSDB_CODE_SUCCESS;
     }
 
-    int32_t code = addPageToHJoinBuf(pPages);
+    int32_t code = addPageToHJoinBuf(pJoin);
     if (code) {
       return code;
     }
@@ -634,7 +712,7 @@ static int32_t addRowToHashImpl(SHJoinOperatorInfo* pJoin, SGroupData* pGroup, S
     }
   }
 
-  int32_t code = getValBufFromPages(pJoin->pRowBufs, getHJoinValBufSize(pTable, rowIdx), &pTable->valData, pRow);
+  int32_t code = getValBufFromPages(pJoin, getHJoinValBufSize(pTable, rowIdx), &pTable->valData, pRow);
   if (code) {
     taosMemoryFree(pRow);
     return code;
@@ -691,6 +769,345 @@ static int32_t addBlockRowsToHash(SSDataBlock* pBlock, SHJoinOperatorInfo* pJoin
   return code;
 }
 
+static FORCE_INLINE int32_t getHJoinSpillPartIdx(SHJoinTableInfo* pTable, int32_t rowIdx) {
+  size_t bufLen = 0;
+  copyKeyColsDataToBuf(pTable, rowIdx, &bufLen);
+
+  // the high bits, the low ones decide the slot of the key in the hash table of the partition
+  return MurmurHash3_32(pTable->keyData, bufLen) >> (32 - HJOIN_SPILL_PART_BITS);
+}
+
+static int32_t createHJoinSpillBuf(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock, const char* label,
+                                   SDiskbasedBuf** ppBuf) {
+  if (!osTempSpaceAvailable()) {
+    terrno = TSDB_CODE_NO_DISKSPACE;
+    qError("hash join spill failed since %s, tempDir:%s", terrstr(), tsTempDir);
+    return terrno;
+  }
+
+  int32_t pageSize = TMAX(HJOIN_SPILL_PAGE_SIZE, blockDataGetRowSize(pBlock) +
+                                                     blockDataGetSerialMetaSize(taosArrayGetSize(pBlock->pDataBlock)));
+  int32_t code = createDiskbasedBuf(ppBuf, pageSize, pageSize * HJOIN_SPILL_MEM_PAGES, label, tsTempDir);
+  if (code) {
+    return code;
+  }
+
+  dBufSetMemBudget(*ppBuf, pJoin->pMemBudget);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t flushHJoinSpillStage(SDiskbasedBuf* pBuf, SSDataBlock* pStage, SArray* pPages) {
+  int32_t start = 0;
+  while (start < pStage->info.rows) {
+    int32_t stop = 0;
+    blockDataSplitRows(pStage, pStage->info.hasVarCol, start, &stop, getBufPageSize(pBuf));
+    SSDataBlock* p = blockDataExtractBlock(pStage, start, stop - start + 1);
+    if (p == NULL) {
+      return terrno;
+    }
+
+    int32_t pageId = -1;
+    void*   pPage = getNewBufPage(pBuf, &pageId);
+    if (pPage == NULL) {
+      blockDataDestroy(p);
+      return terrno;
+    }
+
+    taosArrayPush(pPages, &pageId);
+    blockDataToBuf(pPage, p);
+
+    setBufPageDirty(pPage, true);
+    releaseBufPage(pBuf, pPage);
+
+    blockDataDestroy(p);
+    start = stop + 1;
+  }
+
+  blockDataCleanup(pStage);
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t addRowToHJoinSpill(SDiskbasedBuf* pBuf, SSDataBlock** ppStage, SArray** ppPages, SSDataBlock* pBlock,
+                                  int32_t rowIdx) {
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (NULL == *ppStage) {
+    *ppStage = createOneDataBlock(pBlock, false);
+    *ppPages = taosArrayInit(4, sizeof(int32_t));
+    if (NULL == *ppStage || NULL == *ppPages) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+
+    int32_t rows = (getBufPageSize(pBuf) - blockDataGetSerialMetaSize(taosArrayGetSize(pBlock->pDataBlock))) /
+                   blockDataGetRowSize(pBlock);
+    code = blockDataEnsureCapacity(*ppStage, TMAX(rows, 1));
+    if (code) {
+      return code;
+    }
+  }
+
+  SSDataBlock* pStage = *ppStage;
+  size_t       numOfCols = taosArrayGetSize(pBlock->pDataBlock);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pSrc = taosArrayGet(pBlock->pDataBlock, i);
+    SColumnInfoData* pDst = taosArrayGet(pStage->pDataBlock, i);
+    if (NULL == pSrc->pData || colDataIsNull_s(pSrc, rowIdx)) {
+      code = colDataSetVal(pDst, pStage->info.rows, NULL, true);
+    } else {
+      code = colDataSetVal(pDst, pStage->info.rows, colDataGetData(pSrc, rowIdx), false);
+    }
+    if (code) {
+      return code;
+    }
+  }
+
+  pStage->info.rows++;
+  if (pStage->info.rows >= pStage->info.capacity) {
+    code = flushHJoinSpillStage(pBuf, pStage, *ppPages);
+  }
+
+  return code;
+}
+
+static int32_t spillHJoinBuildBlock(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock) {
+  SHJoinSpillCtx*  pSpill = &pJoin->spill;
+  SHJoinTableInfo* pBuild = pJoin->pBuild;
+  int32_t          code = setKeyColsData(pBlock, pBuild);
+  if (code) {
+    return code;
+  }
+
+  if (NULL == pSpill->pBuildBuf) {
+    code = createHJoinSpillBuf(pJoin, pBlock, "hashJoinBuildBuf", &pSpill->pBuildBuf);
+    if (code) {
+      return code;
+    }
+    pSpill->pBuildBlock = createOneDataBlock(pBlock, false);
+    if (NULL == pSpill->pBuildBlock) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    SHJoinSpillPart* pPart = &pSpill->parts[getHJoinSpillPartIdx(pBuild, i)];
+    code = addRowToHJoinSpill(pSpill->pBuildBuf, &pPart->pBuildStage, &pPart->pBuildPages, pBlock, i);
+    if (code) {
+      return code;
+    }
+  }
+
+  pJoin->execInfo.spillBuildRows += pBlock->info.rows;
+  return TSDB_CODE_SUCCESS;
+}
+
+// only the rows of the partitions with build rows on disk are saved
+static int32_t spillHJoinProbeBlock(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock) {
+  SHJoinSpillCtx*  pSpill = &pJoin->spill;
+  SHJoinTableInfo* pProbe = pJoin->pProbe;
+  int32_t          code = setKeyColsData(pBlock, pProbe);
+  if (code) {
+    return code;
+  }
+
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    SHJoinSpillPart* pPart = &pSpill->parts[getHJoinSpillPartIdx(pProbe, i)];
+    if (NULL == pPart->pBuildPages) {
+      continue;
+    }
+
+    if (NULL == pSpill->pProbeBuf) {
+      code = createHJoinSpillBuf(pJoin, pBlock, "hashJoinProbeBuf", &pSpill->pProbeBuf);
+      if (code) {
+        return code;
+      }
+      pSpill->pProbeBlock = createOneDataBlock(pBlock, false);
+      if (NULL == pSpill->pProbeBlock) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+    }
+
+    code = addRowToHJoinSpill(pSpill->pProbeBuf, &pPart->pProbeStage, &pPart->pProbePages, pBlock, i);
+    if (code) {
+      return code;
+    }
+    pJoin->execInfo.spillProbeRows++;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t finishHJoinSpill(SDiskbasedBuf* pBuf, bool build, SHJoinSpillCtx* pSpill) {
+  for (int32_t i = 0; i < HJOIN_SPILL_PART_NUM; ++i) {
+    SHJoinSpillPart* pPart = &pSpill->parts[i];
+    SSDataBlock**    ppStage = build ? &pPart->pBuildStage : &pPart->pProbeStage;
+    if (NULL == *ppStage) {
+      continue;
+    }
+
+    int32_t code = flushHJoinSpillStage(pBuf, *ppStage, build ? pPart->pBuildPages : pPart->pProbePages);
+    if (code) {
+      return code;
+    }
+    *ppStage = blockDataDestroy(*ppStage);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t loadHJoinSpillPart(SHJoinOperatorInfo* pJoin, SHJoinSpillPart* pPart) {
+  SHJoinSpillCtx* pSpill = &pJoin->spill;
+
+  destroyHJoinKeyHash(&pJoin->pKeyHash);
+  resetHJoinBufPages(pJoin);
+
+  pJoin->pKeyHash = tSimpleHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  if (NULL == pJoin->pKeyHash) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t pageNum = taosArrayGetSize(pPart->pBuildPages);
+  for (int32_t i = 0; i < pageNum; ++i) {
+    int32_t* pageId = taosArrayGet(pPart->pBuildPages, i);
+    void*    pPage = getBufPage(pSpill->pBuildBuf, *pageId);
+    if (NULL == pPage) {
+      return terrno;
+    }
+
+    int32_t code = blockDataFromBuf(pSpill->pBuildBlock, pPage);
+    releaseBufPage(pSpill->pBuildBuf, pPage);
+    if (code) {
+      return code;
+    }
+
+    code = addBlockRowsToHash(pSpill->pBuildBlock, pJoin);
+    if (code) {
+      return code;
+    }
+  }
+
+  updateHJoinHashSize(pJoin);
+  return TSDB_CODE_SUCCESS;
+}
+
+static SSDataBlock* getNextHJoinSpillProbeBlock(struct SOperatorInfo* pOperator) {
+  SHJoinOperatorInfo* pJoin = pOperator->info;
+  SHJoinSpillCtx*     pSpill = &pJoin->spill;
+  SExecTaskInfo*      pTaskInfo = pOperator->pTaskInfo;
+  int32_t             code = TSDB_CODE_SUCCESS;
+
+  while (pSpill->partIdx < HJOIN_SPILL_PART_NUM) {
+    SHJoinSpillPart* pPart = &pSpill->parts[pSpill->partIdx];
+    if (pSpill->pageIdx >= taosArrayGetSize(pPart->pProbePages)) {
+      pSpill->partIdx++;
+      pSpill->pageIdx = 0;
+      pSpill->partLoaded = false;
+      continue;
+    }
+
+    if (!pSpill->partLoaded) {
+      code = loadHJoinSpillPart(pJoin, pPart);
+      if (code) {
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+      pSpill->partLoaded = true;
+    }
+
+    int32_t* pageId = taosArrayGet(pPart->pProbePages, pSpill->pageIdx++);
+    void*    pPage = getBufPage(pSpill->pProbeBuf, *pageId);
+    if (NULL == pPage) {
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+
+    code = blockDataFromBuf(pSpill->pProbeBlock, pPage);
+    releaseBufPage(pSpill->pProbeBuf, pPage);
+    if (code) {
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    return pSpill->pProbeBlock;
+  }
+
+  return NULL;
+}
+
+static void initHJoinRuntimeFilter(SHJoinOperatorInfo* pJoin, SHashJoinPhysiNode* pJoinNode) {
+  SHJoinTableInfo* pBuild = pJoin->pBuild;
+  SHJoinTableInfo* pProbe = pJoin->pProbe;
+  int32_t          probeType = pProbe->downStream->operatorType;
+  if (1 != pBuild->keyNum || (QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN != probeType &&
+                              QUERY_NODE_PHYSICAL_PLAN_TABLE_MERGE_SCAN != probeType)) {
+    return;
+  }
+
+  SColumnNode* pBuildKey = (SColumnNode*)nodesListGetNode(0 == pBuild->downStreamIdx ? pJoinNode->pOnLeft : pJoinNode->pOnRight, 0);
+  SColumnNode* pProbeKey = (SColumnNode*)nodesListGetNode(0 == pProbe->downStreamIdx ? pJoinNode->pOnLeft : pJoinNode->pOnRight, 0);
+  int8_t       type = pProbeKey->node.resType.type;
+  if (type != pBuildKey->node.resType.type || TSDB_DATA_TYPE_JSON == type) {
+    return;
+  }
+
+  SScanRuntimeFilter* pFilter = taosMemoryCalloc(1, sizeof(SScanRuntimeFilter));
+  if (NULL == pFilter) {
+    return;
+  }
+
+  uint64_t expectedRows = pBuild->inputStat.inputRowNum > 0 ? pBuild->inputStat.inputRowNum : 1024;
+  pFilter->pBloom = tScalableBfInit(expectedRows, HJOIN_BLOOM_ERROR_RATE);
+  if (NULL == pFilter->pBloom) {
+    taosMemoryFree(pFilter);
+    return;
+  }
+
+  pFilter->slotId = pProbe->keyCols[0].srcSlot;
+  pFilter->type = type;
+  pFilter->hasRange = IS_SIGNED_NUMERIC_TYPE(type) || TSDB_DATA_TYPE_TIMESTAMP == type;
+  pFilter->min = INT64_MAX;
+  pFilter->max = INT64_MIN;
+  pJoin->pRuntimeFilter = pFilter;
+}
+
+static int32_t updateHJoinRuntimeFilter(SHJoinOperatorInfo* pJoin, SSDataBlock* pBlock) {
+  SScanRuntimeFilter* pFilter = pJoin->pRuntimeFilter;
+  if (NULL == pFilter) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pJoin->pBuild->keyCols[0].srcSlot);
+  bool             varType = IS_VAR_DATA_TYPE(pCol->info.type);
+  for (int32_t i = 0; i < pBlock->info.rows; ++i) {
+    if (colDataIsNull_s(pCol, i)) {
+      continue;
+    }
+
+    char* pData = colDataGetData(pCol, i);
+    if (pFilter->hasRange) {
+      int64_t v = 0;
+      GET_TYPED_DATA(v, int64_t, pFilter->type, pData);
+      pFilter->min = TMIN(pFilter->min, v);
+      pFilter->max = TMAX(pFilter->max, v);
+    }
+
+    int32_t code = tScalableBfPut(pFilter->pBloom, pData, varType ? varDataTLen(pData) : pCol->info.bytes);
+    if (TSDB_CODE_OUT_OF_MEMORY == code) {
+      return code;
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+// the probe side is not read until the build side is done, so the scan sees all the keys
+static void installHJoinRuntimeFilter(SHJoinOperatorInfo* pJoin) {
+  if (NULL == pJoin->pRuntimeFilter) {
+    return;
+  }
+
+  if (setTableScanRuntimeFilter(pJoin->pProbe->downStream, pJoin->pRuntimeFilter)) {
+    qDebug("hash join keys pushed down to the probe scan, min:%" PRId64 ", max:%" PRId64, pJoin->pRuntimeFilter->min,
+           pJoin->pRuntimeFilter->max);
+    pJoin->pRuntimeFilter = NULL;
+  }
+}
+
 static int32_t buildHJoinKeyHash(struct SOperatorInfo* pOperator) {
   SHJoinOperatorInfo* pJoin = pOperator->info;
   SSDataBlock* pBlock = NULL;
@@ -705,12 +1122,30 @@ static int32_t buildHJoinKeyHash(struct SOperatorInfo* pOperator) {
     pJoin->execInfo.buildBlkNum++;
     pJoin->execInfo.buildBlkRows += pBlock->info.rows;
 
-    code = addBlockRowsToHash(pBlock, pJoin);
+    code = updateHJoinRuntimeFilter(pJoin, pBlock);
+    if (code) {
+      return code;
+    }
+
+    if (pJoin->spill.spilled) {
+      code = spillHJoinBuildBlock(pJoin, pBlock);
+    } else {
+      code = addBlockRowsToHash(pBlock, pJoin);
+    }
     if (code) {
       return code;
     }
   }
 
+  if (pJoin->spill.spilled) {
+    code = finishHJoinSpill(pJoin->spill.pBuildBuf, true, &pJoin->spill);
+    if (code) {
+      return code;
+    }
+  }
+
+  updateHJoinHashSize(pJoin);
+  installHJoinRuntimeFilter(pJoin);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -770,7 +1205,7 @@ static SSDataBlock* doHashJoin(struct SOperatorInfo* pOperator) {
       T_LONG_JMP(pTaskInfo->env, code);
     }
 
-    if (tSimpleHashGetSize(pJoin->pKeyHash) <= 0) {
+    if (tSimpleHashGetSize(pJoin->pKeyHash) <= 0 && !pJoin->spill.spilled) {
       setHJoinDone(pOperator);
       goto _return;
     }
@@ -790,14 +1225,39 @@ static SSDataBlock* doHashJoin(struct SOperatorInfo* pOperator) {
   }
 
   while (true) {
-    SSDataBlock* pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+    SSDataBlock* pBlock = NULL;
+    if (pJoin->spill.probeDone) {
+      pBlock = getNextHJoinSpillProbeBlock(pOperator);
+    } else {
+      pBlock = getNextBlockFromDownstream(pOperator, pJoin->pProbe->downStreamIdx);
+      if (NULL == pBlock && pJoin->spill.spilled) {
+        pJoin->spill.probeDone = true;
+        code = finishHJoinSpill(pJoin->spill.pProbeBuf, false, &pJoin->spill);
+        if (code) {
+          pTaskInfo->code = code;
+          T_LONG_JMP(pTaskInfo->env, code);
+        }
+        continue;
+      }
+    }
+
     if (NULL == pBlock) {
       setHJoinDone(pOperator);
       break;
     }
 
-    pJoin->execInfo.probeBlkNum++;
-    pJoin->execInfo.probeBlkRows += pBlock->info.rows;
+    if (!pJoin->spill.probeDone) {
+      pJoin->execInfo.probeBlkNum++;
+      pJoin->execInfo.probeBlkRows += pBlock->info.rows;
+
+      if (pJoin->spill.spilled) {
+        code = spillHJoinProbeBlock(pJoin, pBlock);
+        if (code) {
+          pTaskInfo->code = code;
+          T_LONG_JMP(pTaskInfo->env, code);
+        }
+      }
+    }
     
     code = launchBlockHashJoin(pOperator, pBlock);
     if (code) {
@@ -853,6 +1313,9 @@ SOperatorInfo* createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t n
     goto _error;
   }
 
+  initHJoinRuntimeFilter(pInfo, pJoinNode);
+
+  pInfo->pMemBudget = &pTaskInfo->memBudget;
   code = initHJoinBufPages(pInfo);
   if (code) {
     goto _error;
@@ -900,7 +1363,8 @@ SOperatorInfo* createHashJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t n
     goto _error;
   }
 
-  pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, doHashJoin, NULL, destroyHashJoinOperator, optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+  pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, doHashJoin, NULL, destroyHashJoinOperator, optrDefaultBufFn,
+                                         getHashJoinExplainExecInfo, optrDefaultGetNextExtFn, NULL);
 
   qError("create hash Join operator done");
 
@@ -68,6 +68,9 @@ typedef struct SMJoinOperatorInfo {
   SSHashObj*   rightBuildTable;
   SMJoinRowCtx  rowCtx;
 
+  int32_t*      leftMatchRows;   // row index pairs of the timestamps matched one to one, see mergeJoinMatchUniqueTs
+  int32_t*      rightMatchRows;
+
   int64_t       resRows;
 } SMJoinOperatorInfo;
 
@@ -249,6 +252,13 @@ SOperatorInfo* createMergeJoinOperatorInfo(SOperatorInfo** pDownstream, int32_t
   initResultSizeInfo(&pOperator->resultInfo, 4096);
   blockDataEnsureCapacity(pInfo->pRes, pOperator->resultInfo.capacity);
 
+  pInfo->leftMatchRows = taosMemoryMalloc(pOperator->resultInfo.capacity * sizeof(int32_t));
+  pInfo->rightMatchRows = taosMemoryMalloc(pOperator->resultInfo.capacity * sizeof(int32_t));
+  if (pInfo->leftMatchRows == NULL || pInfo->rightMatchRows == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _error;
+  }
+
   setOperatorInfo(pOperator, "MergeJoinOperator", QUERY_NODE_PHYSICAL_PLAN_MERGE_JOIN, false, OP_NOT_OPENED, pInfo, pTaskInfo);
   pOperator->exprSupp.pExprInfo = pExprInfo;
   pOperator->exprSupp.numOfExprs = numOfCols;
@@ -362,6 +372,8 @@ void destroyMergeJoinOperator(void* param) {
     taosArrayDestroy(pJoinOperator->leftEqOnCondCols);
   }
   nodesDestroyNode(pJoinOperator->pCondAfterMerge);
+  taosMemoryFreeClear(pJoinOperator->leftMatchRows);
+  taosMemoryFreeClear(pJoinOperator->rightMatchRows);
 
   taosArrayDestroy(pJoinOperator->rowCtx.leftCreatedBlocks);
   taosArrayDestroy(pJoinOperator->rowCtx.rightCreatedBlocks);
@@ -408,21 +420,50 @@ typedef struct SRowLocation {
   int32_t      pos;
 } SRowLocation;
 
+// The first row in [startPos, numOfRows) not ordered before timestamp, or after it as well if skipEqual. The rows
+// sought are usually close to startPos, so gallop from there and binary search the last step.
+static int32_t mergeJoinGallopTs(const int64_t* tsCol, int32_t startPos, int32_t numOfRows, int64_t timestamp,
+                                 bool asc, bool skipEqual) {
+#define MJ_TS_BEFORE(_v) \
+  (asc ? ((_v) < timestamp || (skipEqual && (_v) == timestamp)) : ((_v) > timestamp || (skipEqual && (_v) == timestamp)))
+
+  int32_t lo = startPos;
+  int32_t hi = startPos;
+  int32_t step = 1;
+  while (hi < numOfRows && MJ_TS_BEFORE(tsCol[hi])) {
+    lo = hi + 1;
+    hi += step;
+    step <<= 1;
+  }
+  if (hi > numOfRows) {
+    hi = numOfRows;
+  }
+
+  while (lo < hi) {
+    int32_t mid = lo + ((hi - lo) >> 1);
+    if (MJ_TS_BEFORE(tsCol[mid])) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+#undef MJ_TS_BEFORE
+  return lo;
+}
+
+static FORCE_INLINE const int64_t* mergeJoinGetTsCol(SSDataBlock* pBlock, int16_t tsSlotId) {
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, tsSlotId);
+  return (const int64_t*)pCol->pData;
+}
+
 // pBlock[tsSlotId][startPos, endPos) == timestamp,
 static int32_t mergeJoinGetBlockRowsEqualTs(SSDataBlock* pBlock, int16_t tsSlotId, int32_t startPos, int64_t timestamp,
-                                            int32_t* pEndPos, SArray* rowLocations, SArray* createdBlocks) {
+                                            bool asc, int32_t* pEndPos, SArray* rowLocations, SArray* createdBlocks) {
   int32_t numRows = pBlock->info.rows;
   ASSERT(startPos < numRows);
-  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, tsSlotId);
 
-  int32_t i = startPos;
-  for (; i < numRows; ++i) {
-    char* pNextVal = colDataGetData(pCol, i);
-    if (timestamp != *(int64_t*)pNextVal) {
-      break;
-    }
-  }
-  int32_t endPos = i;
+  int32_t endPos = mergeJoinGallopTs(mergeJoinGetTsCol(pBlock, tsSlotId), startPos, numRows, timestamp, asc, true);
   *pEndPos = endPos;
 
   if (endPos - startPos == 0) {
@@ -453,9 +494,10 @@ static int32_t mergeJoinGetDownStreamRowsEqualTimeStamp(SOperatorInfo* pOperator
   ASSERT(whichChild == 0 || whichChild == 1);
 
   SMJoinOperatorInfo* pJoinInfo = pOperator->info;
+  bool               asc = (pJoinInfo->inputOrder == TSDB_ORDER_ASC);
   int32_t            endPos = -1;
   SSDataBlock*       dataBlock = startDataBlock;
-  mergeJoinGetBlockRowsEqualTs(dataBlock, tsSlotId, startPos, timestamp, &endPos, rowLocations, createdBlocks);
+  mergeJoinGetBlockRowsEqualTs(dataBlock, tsSlotId, startPos, timestamp, asc, &endPos, rowLocations, createdBlocks);
   while (endPos == dataBlock->info.rows) {
     SOperatorInfo* ds = pOperator->pDownstream[whichChild];
     dataBlock = getNextBlockFromDownstreamRemain(pOperator, whichChild);
@@ -474,7 +516,7 @@ static int32_t mergeJoinGetDownStreamRowsEqualTimeStamp(SOperatorInfo* pOperator
       break;
     }
 
-    mergeJoinGetBlockRowsEqualTs(dataBlock, tsSlotId, 0, timestamp, &endPos, rowLocations, createdBlocks);
+    mergeJoinGetBlockRowsEqualTs(dataBlock, tsSlotId, 0, timestamp, asc, &endPos, rowLocations, createdBlocks);
   }
   if (endPos != -1) {
     if (whichChild == 0) {
@@ -655,6 +697,85 @@ static int32_t mergeJoinJoinDownstreamTsRanges(SOperatorInfo* pOperator, int64_t
   return TSDB_CODE_SUCCESS;
 }
 
+// Emit the matched rows column by column, pRes[startRow + k] = left[leftMatchRows[k]] ++ right[rightMatchRows[k]].
+static void mergeJoinCopyMatchedRows(SOperatorInfo* pOperator, SSDataBlock* pRes, int32_t startRow, int32_t numOfRows) {
+  SMJoinOperatorInfo* pJoinInfo = pOperator->info;
+
+  for (int32_t i = 0; i < pOperator->exprSupp.numOfExprs; ++i) {
+    SColumnInfoData* pDst = taosArrayGet(pRes->pDataBlock, i);
+    SExprInfo*       pExprInfo = &pOperator->exprSupp.pExprInfo[i];
+
+    int32_t blockId = pExprInfo->base.pParam[0].pCol->dataBlockId;
+    int32_t slotId = pExprInfo->base.pParam[0].pCol->slotId;
+
+    SColumnInfoData* pSrc = NULL;
+    const int32_t*   rows = NULL;
+    if (pJoinInfo->pLeft->info.id.blockId == blockId) {
+      pSrc = taosArrayGet(pJoinInfo->pLeft->pDataBlock, slotId);
+      rows = pJoinInfo->leftMatchRows;
+    } else {
+      pSrc = taosArrayGet(pJoinInfo->pRight->pDataBlock, slotId);
+      rows = pJoinInfo->rightMatchRows;
+    }
+
+    for (int32_t k = 0; k < numOfRows; ++k) {
+      if (colDataIsNull_s(pSrc, rows[k])) {
+        colDataSetNULL(pDst, startRow + k);
+      } else {
+        colDataSetVal(pDst, startRow + k, colDataGetData(pSrc, rows[k]), false);
+      }
+    }
+  }
+}
+
+// Match the current blocks of both sides as long as every timestamp appears at most once on each side, which is the
+// common case of joining two tables on ts. Returns the number of rows emitted, 0 if the timestamp at the current
+// positions has to be joined by mergeJoinJoinDownstreamTsRanges, i.e. it is duplicated, or it is at the end of a
+// block and may continue in the next one.
+static int32_t mergeJoinMatchUniqueTs(SOperatorInfo* pOperator, SSDataBlock* pRes, int32_t* nRows) {
+  SMJoinOperatorInfo* pJoinInfo = pOperator->info;
+  bool                asc = (pJoinInfo->inputOrder == TSDB_ORDER_ASC);
+
+  if (blockDataEnsureCapacity(pRes, pOperator->resultInfo.threshold) != TSDB_CODE_SUCCESS) {
+    return 0;
+  }
+
+  const int64_t* leftTs = mergeJoinGetTsCol(pJoinInfo->pLeft, pJoinInfo->leftCol.slotId);
+  const int64_t* rightTs = mergeJoinGetTsCol(pJoinInfo->pRight, pJoinInfo->rightCol.slotId);
+  int32_t        leftRows = pJoinInfo->pLeft->info.rows;
+  int32_t        rightRows = pJoinInfo->pRight->info.rows;
+  int32_t        leftPos = pJoinInfo->leftPos;
+  int32_t        rightPos = pJoinInfo->rightPos;
+  int32_t        capacity = pOperator->resultInfo.threshold - *nRows;
+  int32_t        num = 0;
+
+  while (num < capacity && leftPos + 1 < leftRows && rightPos + 1 < rightRows) {
+    int64_t lts = leftTs[leftPos];
+    int64_t rts = rightTs[rightPos];
+    if (lts == rts) {
+      if (leftTs[leftPos + 1] == lts || rightTs[rightPos + 1] == rts) {
+        break;
+      }
+      pJoinInfo->leftMatchRows[num] = leftPos++;
+      pJoinInfo->rightMatchRows[num] = rightPos++;
+      num += 1;
+    } else if (asc ? lts < rts : lts > rts) {
+      leftPos = mergeJoinGallopTs(leftTs, leftPos + 1, leftRows, rts, asc, false);
+    } else {
+      rightPos = mergeJoinGallopTs(rightTs, rightPos + 1, rightRows, lts, asc, false);
+    }
+  }
+
+  if (num > 0) {
+    mergeJoinCopyMatchedRows(pOperator, pRes, *nRows, num);
+    *nRows += num;
+  }
+
+  pJoinInfo->leftPos = leftPos;
+  pJoinInfo->rightPos = rightPos;
+  return num;
+}
+
 static void setMergeJoinDone(SOperatorInfo* pOperator) {
   setOperatorCompleted(pOperator);
   if (pOperator->pDownstreamGetParams) {
@@ -750,15 +871,19 @@ static void doMergeJoinImpl(struct SOperatorInfo* pOperator, SSDataBlock* pRes)
     }
 
     if (leftTs == rightTs) {
-      mergeJoinJoinDownstreamTsRanges(pOperator, leftTs, pRes, &nrows);
+      if (pJoinInfo->rowCtx.rowRemains || mergeJoinMatchUniqueTs(pOperator, pRes, &nrows) == 0) {
+        mergeJoinJoinDownstreamTsRanges(pOperator, leftTs, pRes, &nrows);
+      }
     } else if ((asc && leftTs < rightTs) || (!asc && leftTs > rightTs)) {
-      pJoinInfo->leftPos += 1;
+      pJoinInfo->leftPos = mergeJoinGallopTs(mergeJoinGetTsCol(pJoinInfo->pLeft, pJoinInfo->leftCol.slotId),
+                                             pJoinInfo->leftPos + 1, pJoinInfo->pLeft->info.rows, rightTs, asc, false);
 
       if (pJoinInfo->leftPos >= pJoinInfo->pLeft->info.rows && pRes->info.rows < pOperator->resultInfo.threshold) {
         continue;
       }
     } else if ((asc && leftTs > rightTs) || (!asc && leftTs < rightTs)) {
-      pJoinInfo->rightPos += 1;
+      pJoinInfo->rightPos = mergeJoinGallopTs(mergeJoinGetTsCol(pJoinInfo->pRight, pJoinInfo->rightCol.slotId),
+                                              pJoinInfo->rightPos + 1, pJoinInfo->pRight->info.rows, leftTs, asc, false);
       if (pJoinInfo->rightPos >= pJoinInfo->pRight->info.rows && pRes->info.rows < pOperator->resultInfo.threshold) {
         continue;
       }
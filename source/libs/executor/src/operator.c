@@ -274,6 +274,35 @@ int32_t stopTableScanOperator(SOperatorInfo* pOperator, const char* pIdStr, SSto
   return p.code;
 }
 
+// hand the filter over to the scan if pOperator is a table scan and the key slot is one of its result columns
+bool setTableScanRuntimeFilter(SOperatorInfo* pOperator, SScanRuntimeFilter* pFilter) {
+  STableScanBase* pBase = NULL;
+  if (pOperator->operatorType == QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    pBase = &((STableScanInfo*)pOperator->info)->base;
+  } else if (pOperator->operatorType == QUERY_NODE_PHYSICAL_PLAN_TABLE_MERGE_SCAN) {
+    pBase = &((STableMergeScanInfo*)pOperator->info)->base;
+  } else {
+    return false;
+  }
+
+  if (pBase->pRuntimeFilter != NULL) {
+    return false;
+  }
+
+  pFilter->colId = -1;
+  size_t numOfCols = taosArrayGetSize(pBase->matchInfo.pList);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColMatchItem* pItem = taosArrayGet(pBase->matchInfo.pList, i);
+    if (pItem->dstSlotId == pFilter->slotId) {
+      pFilter->colId = pItem->colId;
+      break;
+    }
+  }
+
+  pBase->pRuntimeFilter = pFilter;
+  return true;
+}
+
 SOperatorInfo* createOperator(SPhysiNode* pPhyNode, SExecTaskInfo* pTaskInfo, SReadHandle* pHandle, SNode* pTagCond,
                               SNode* pTagIndexCond, const char* pUser, const char* dbname) {
   int32_t     type = nodeType(pPhyNode);
@@ -310,6 +339,17 @@ SOperatorInfo* createOperator(SPhysiNode* pPhyNode, SExecTaskInfo* pTaskInfo, SR
           qError("failed to createScanTableListInfo, code:%s, %s", tstrerror(code), idstr);
           return NULL;
         }
+
+        if (pTableScanNode->tableSliceNum > 1) {
+          code = tableListSlice(pTableListInfo, pTableScanNode->tableSliceIdx, pTableScanNode->tableSliceNum);
+          if (code) {
+            pTaskInfo->code = code;
+            tableListDestroy(pTableListInfo);
+            return NULL;
+          }
+          qDebug("scan table slice %d/%d, %" PRIu64 " tables, %s", pTableScanNode->tableSliceIdx,
+                 pTableScanNode->tableSliceNum, tableListGetSize(pTableListInfo), idstr);
+        }
       }
 
       pOperator = createTableScanOperatorInfo(pTableScanNode, pHandle, pTableListInfo, pTaskInfo);
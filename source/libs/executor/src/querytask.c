@@ -30,11 +30,15 @@
 #include "query.h"
 #include "querytask.h"
 #include "storageapi.h"
+#include "tglobal.h"
 #include "thash.h"
 #include "ttypes.h"
 
 #define CLEAR_QUERY_STATUS(q, st) ((q)->status &= (~(st)))
 
+// memory used by all query tasks of this dnode, limited by queryBufferSize
+static SDBufMemBudget gQueryMemBudget = {0};
+
 SExecTaskInfo* doCreateTask(uint64_t queryId, uint64_t taskId, int32_t vgId, EOPTR_EXEC_MODEL model, SStorageAPI* pAPI) {
   SExecTaskInfo* pTaskInfo = taosMemoryCalloc(1, sizeof(SExecTaskInfo));
   if (pTaskInfo == NULL) {
@@ -58,7 +62,13 @@ SExecTaskInfo* doCreateTask(uint64_t queryId, uint64_t taskId, int32_t vgId, EOP
   pTaskInfo->id.str = taosMemoryMalloc(64);
   buildTaskId(taskId, queryId, pTaskInfo->id.str);
   pTaskInfo->schemaInfos = taosArrayInit(1, sizeof(SSchemaInfo));
-  
+
+  // the limits may be updated at runtime, pick them up for each new task
+  atomic_store_64(&gQueryMemBudget.limit, (tsQueryBufferSize > 0) ? (int64_t)tsQueryBufferSize * 1048576 : 0);
+  int64_t perQuery = (tsQueryBufferSizePerQuery > 0) ? (int64_t)tsQueryBufferSizePerQuery * 1048576 : 0;
+  dBufMemBudgetInit(&pTaskInfo->memBudget, perQuery, &gQueryMemBudget);
+  pTaskInfo->pBlockMemPool = blockMemPoolCreate(QUERY_BLOCK_MEM_POOL_SIZE);
+
   return pTaskInfo;
 }
 
@@ -221,6 +231,20 @@ void doDestroyTask(SExecTaskInfo* pTaskInfo) {
   destroyOperator(pTaskInfo->pRoot);
   pTaskInfo->pRoot = NULL;
 
+  SDBufMemBudget* pBudget = &pTaskInfo->memBudget;
+  if (pBudget->peak > 0) {
+    qDebug("%s buffer memory peak:%.2f Kb, pages spilled for the memory budget:%" PRId64 ", leaked:%" PRId64,
+           GET_TASKID(pTaskInfo), pBudget->peak / 1024.0, pBudget->spillPages, pBudget->used);
+  }
+  dBufMemBudgetRelease(pBudget, pBudget->used);
+
+  SBlockMemPoolStat stat = {0};
+  blockMemPoolGetStat(pTaskInfo->pBlockMemPool, &stat);
+  if (stat.numOfAlloc > 0) {
+    qDebug("%s block payloads allocated:%" PRId64 ", reused:%" PRId64 ", recycled:%" PRId64 ", pool peak:%.2f Kb",
+           GET_TASKID(pTaskInfo), stat.numOfAlloc, stat.numOfReuse, stat.numOfRecycle, stat.peakCachedBytes / 1024.0);
+  }
+
   taosArrayDestroyEx(pTaskInfo->schemaInfos, cleanupQueriedTableScanInfo);
   cleanupStreamInfo(&pTaskInfo->streamInfo);
 
@@ -230,6 +254,7 @@ void doDestroyTask(SExecTaskInfo* pTaskInfo) {
   }
 
   taosArrayDestroyEx(pTaskInfo->pResultBlockList, freeBlock);
+  blockMemPoolDestroy(pTaskInfo->pBlockMemPool);
   taosArrayDestroy(pTaskInfo->stopInfo.pStopInfo);
   taosMemoryFreeClear(pTaskInfo->sql);
   taosMemoryFreeClear(pTaskInfo->id.str);
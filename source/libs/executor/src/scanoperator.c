@@ -246,6 +246,89 @@ static bool doLoadBlockSMA(STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
   return true;
 }
 
+void destroyScanRuntimeFilter(SScanRuntimeFilter* pFilter) {
+  if (pFilter == NULL) {
+    return;
+  }
+
+  tScalableBfDestroy(pFilter->pBloom);
+  taosMemoryFree(pFilter->pKeep);
+  taosMemoryFree(pFilter);
+}
+
+static FORCE_INLINE bool runtimeFilterOverlap(const SScanRuntimeFilter* pFilter, int64_t min, int64_t max) {
+  return !(max < pFilter->min || min > pFilter->max);
+}
+
+// check the time range or the block SMA of the key column before the data block is loaded
+bool doFilterByRuntimeFilterRange(STableScanBase* pTableScanInfo, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
+  SScanRuntimeFilter* pFilter = pTableScanInfo->pRuntimeFilter;
+  if (pFilter == NULL || !pFilter->hasRange || pFilter->colId == -1) {
+    return true;
+  }
+
+  if (pFilter->colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
+    return runtimeFilterOverlap(pFilter, pBlock->info.window.skey, pBlock->info.window.ekey);
+  }
+
+  bool keep = true;
+  if (doLoadBlockSMA(pTableScanInfo, pBlock, pTaskInfo)) {
+    SColumnDataAgg* pAgg = pBlock->pBlockAgg[pFilter->slotId];
+    if (pAgg != NULL && pAgg->numOfNull == 0) {
+      keep = runtimeFilterOverlap(pFilter, pAgg->min, pAgg->max);
+    }
+  }
+
+  taosMemoryFreeClear(pBlock->pBlockAgg);
+  return keep;
+}
+
+// rows with null keys are kept, they are left to the join as before
+int32_t doFilterByRuntimeFilter(SScanRuntimeFilter* pFilter, SSDataBlock* pBlock) {
+  int32_t rows = pBlock->info.rows;
+  if (rows == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (pFilter->keepCap < rows) {
+    bool* p = taosMemoryRealloc(pFilter->pKeep, rows * sizeof(bool));
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pFilter->pKeep = p;
+    pFilter->keepCap = rows;
+  }
+
+  SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, pFilter->slotId);
+  bool             varType = IS_VAR_DATA_TYPE(pCol->info.type);
+  int32_t          numOfKeep = 0;
+  for (int32_t i = 0; i < rows; ++i) {
+    bool keep = true;
+    if (!colDataIsNull_s(pCol, i)) {
+      char* pData = colDataGetData(pCol, i);
+      if (pFilter->hasRange) {
+        int64_t v = 0;
+        GET_TYPED_DATA(v, int64_t, pFilter->type, pData);
+        keep = (v >= pFilter->min && v <= pFilter->max);
+      }
+      if (keep && pFilter->pBloom != NULL) {
+        int32_t len = varType ? varDataTLen(pData) : pCol->info.bytes;
+        keep = (tScalableBfNoContain(pFilter->pBloom, pData, len) != TSDB_CODE_SUCCESS);
+      }
+    }
+
+    pFilter->pKeep[i] = keep;
+    numOfKeep += keep;
+  }
+
+  if (numOfKeep < rows) {
+    pFilter->filterRows += rows - numOfKeep;
+    trimDataBlock(pBlock, rows, pFilter->pKeep);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static void doSetTagColumnData(STableScanBase* pTableScanInfo, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo,
                                int32_t rows) {
   if (pTableScanInfo->pseudoSup.numOfExprs > 0) {
@@ -305,7 +388,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
 
   bool loadSMA = false;
   *status = pTableScanInfo->dataBlockLoadFlag;
-  if (pOperator->exprSupp.pFilterInfo != NULL ||
+  if (pOperator->exprSupp.pFilterInfo != NULL || pTableScanInfo->pRuntimeFilter != NULL ||
       overlapWithTimeWindow(&pTableScanInfo->pdInfo.interval, &pBlock->info, pTableScanInfo->cond.order)) {
     (*status) = FUNC_DATA_REQUIRED_DATA_LOAD;
   }
@@ -367,6 +450,18 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   // free the sma info, since it should not be involved in later computing process.
   taosMemoryFreeClear(pBlock->pBlockAgg);
 
+  // try to filter data block according to the join keys pushed down
+  if (!doFilterByRuntimeFilterRange(pTableScanInfo, pBlock, pTaskInfo)) {
+    qDebug("%s data block filter out by join keys, brange:%" PRId64 "-%" PRId64 ", rows:%" PRId64,
+           GET_TASKID(pTaskInfo), pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
+    pCost->filterOutBlocks += 1;
+    pTableScanInfo->pRuntimeFilter->filterBlocks += 1;
+    (*status) = FUNC_DATA_REQUIRED_FILTEROUT;
+
+    pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+    return TSDB_CODE_SUCCESS;
+  }
+
   // try to filter data block according to current results
   doDynamicPruneDataBlock(pOperator, pBlockInfo, status);
   if (*status == FUNC_DATA_REQUIRED_NOT_LOAD) {
@@ -398,6 +493,11 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   // restore the previous value
   pCost->totalRows -= pBlock->info.rows;
 
+  if (pTableScanInfo->pRuntimeFilter != NULL) {
+    int32_t code = doFilterByRuntimeFilter(pTableScanInfo->pRuntimeFilter, pBlock);
+    if (code != TSDB_CODE_SUCCESS) return code;
+  }
+
   if (pOperator->exprSupp.pFilterInfo != NULL) {
     int32_t code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
     if (code != TSDB_CODE_SUCCESS) return code;
@@ -893,6 +993,8 @@ static SSDataBlock* groupSeqTableScan(SOperatorInfo* pOperator) {
     if (code != TSDB_CODE_SUCCESS) {
       T_LONG_JMP(pTaskInfo->env, code);
     }
+
+    pAPI->tsdReader.tsdSetReaderProfile(pInfo->base.dataReader, &pInfo->base.readRecorder);
   
     if (pInfo->pResBlock->info.capacity > pOperator->resultInfo.capacity) {
       pOperator->resultInfo.capacity = pInfo->pResBlock->info.capacity;
@@ -994,6 +1096,13 @@ static int32_t getTableScannerExecInfo(struct SOperatorInfo* pOptr, void** pOptr
 static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
   cleanupQueryTableDataCond(&pBase->cond);
 
+  if (pBase->pRuntimeFilter != NULL) {
+    qDebug("runtime filter of join keys, filter out blocks:%" PRId64 ", rows:%" PRId64,
+           pBase->pRuntimeFilter->filterBlocks, pBase->pRuntimeFilter->filterRows);
+    destroyScanRuntimeFilter(pBase->pRuntimeFilter);
+    pBase->pRuntimeFilter = NULL;
+  }
+
   pAPI->tsdReaderClose(pBase->dataReader);
   pBase->dataReader = NULL;
 
@@ -1185,6 +1294,8 @@ static SSDataBlock* readPreVersionData(SOperatorInfo* pTableScanOp, uint64_t tbU
     return NULL;
   }
 
+  pAPI->tsdReader.tsdSetReaderProfile(pReader, &pTableScanInfo->base.readRecorder);
+
   bool hasNext = false;
   code = pAPI->tsdReader.tsdNextDataBlock(pReader, &hasNext);
   if (code != TSDB_CODE_SUCCESS) {
@@ -3063,6 +3174,86 @@ static SSDataBlock* doTagScanFromCtbIdx(SOperatorInfo* pOperator) {
   return (pRes->info.rows == 0) ? NULL : pInfo->pRes;
 }
 
+// the tags and names of the next tables of the table list from the column store of the super table, false if the store
+// does not serve them
+static bool doTagScanFromTagColStore(SOperatorInfo* pOperator, SSDataBlock* pRes, int32_t* pCount) {
+  SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
+  SStorageAPI*   pAPI = &pTaskInfo->storageAPI;
+  STagScanInfo*  pInfo = pOperator->info;
+  SExprInfo*     pExprInfo = &pOperator->exprSupp.pExprInfo[0];
+  int32_t        numOfExprs = pOperator->exprSupp.numOfExprs;
+  int32_t        size = tableListGetSize(pInfo->pTableListInfo);
+  int32_t        numOfTables = TMIN(size - pInfo->curPos, pOperator->resultInfo.capacity);
+  SSDataBlock*   pTagBlock = NULL;
+  bool           served = false;
+
+  SArray*  aUidTags = taosArrayInit(numOfTables, sizeof(STUidTagInfo));
+  SArray*  pColList = taosArrayInit(numOfExprs, sizeof(SColumnInfo));
+  int32_t* aTagCol = taosMemoryMalloc(numOfExprs * sizeof(int32_t));
+  if (aUidTags == NULL || pColList == NULL || aTagCol == NULL) {
+    goto _end;
+  }
+
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    STableKeyInfo* item = tableListGetInfo(pInfo->pTableListInfo, pInfo->curPos + i);
+    STUidTagInfo   info = {.uid = item->uid};
+    taosArrayPush(aUidTags, &info);
+  }
+
+  for (int32_t j = 0; j < numOfExprs; ++j) {
+    SColumnInfoData* pDst = taosArrayGet(pRes->pDataBlock, pExprInfo[j].base.resSchema.slotId);
+    SColumnInfo      cInfo = {.type = pDst->info.type, .bytes = pDst->info.bytes};
+
+    aTagCol[j] = -1;
+    if (QUERY_NODE_FUNCTION == pExprInfo[j].pExpr->nodeType) {
+      if (FUNCTION_TYPE_TBNAME != pExprInfo[j].pExpr->_function.functionType) {
+        continue;
+      }
+      cInfo.colId = -1;
+    } else {
+      cInfo.colId = pExprInfo[j].base.pParam[0].pCol->colId;
+    }
+    aTagCol[j] = taosArrayGetSize(pColList);
+    taosArrayPush(pColList, &cInfo);
+  }
+
+  pTagBlock = createTagValBlockFromStore(pColList, aUidTags, pInfo->suid, pInfo->readHandle.vnode, pAPI);
+  if (pTagBlock == NULL) {
+    goto _end;
+  }
+
+  for (int32_t j = 0; j < numOfExprs; ++j) {
+    SColumnInfoData* pDst = taosArrayGet(pRes->pDataBlock, pExprInfo[j].base.resSchema.slotId);
+    if (aTagCol[j] >= 0) {
+      SColumnInfo info = pDst->info;
+      colDataAssign(pDst, taosArrayGet(pTagBlock->pDataBlock, aTagCol[j]), numOfTables, &pRes->info);
+      pDst->info = info;
+    } else if (FUNCTION_TYPE_TBUID == pExprInfo[j].pExpr->_function.functionType) {
+      for (int32_t i = 0; i < numOfTables; ++i) {
+        colDataSetVal(pDst, i, (char*)&((STUidTagInfo*)taosArrayGet(aUidTags, i))->uid, false);
+      }
+    } else if (FUNCTION_TYPE_VGID == pExprInfo[j].pExpr->_function.functionType) {
+      for (int32_t i = 0; i < numOfTables; ++i) {
+        colDataSetVal(pDst, i, (char*)&pTaskInfo->id.vgId, false);
+      }
+    }
+  }
+
+  pInfo->curPos += numOfTables;
+  if (pInfo->curPos >= size) {
+    setOperatorCompleted(pOperator);
+  }
+  *pCount = numOfTables;
+  served = true;
+
+_end:
+  blockDataDestroy(pTagBlock);
+  taosArrayDestroy(aUidTags);
+  taosArrayDestroy(pColList);
+  taosMemoryFree(aTagCol);
+  return served;
+}
+
 static SSDataBlock* doTagScanFromMetaEntry(SOperatorInfo* pOperator) {
   if (pOperator->status == OP_EXEC_DONE) {
     return NULL;
@@ -3085,6 +3276,12 @@ static SSDataBlock* doTagScanFromMetaEntry(SOperatorInfo* pOperator) {
   char        str[512] = {0};
   int32_t     count = 0;
   SMetaReader mr = {0};
+
+  // each table is a group of its own with slimit, the tables are read one by one then
+  if (pInfo->pSlimit == NULL && pInfo->suid != 0 && doTagScanFromTagColStore(pOperator, pRes, &count)) {
+    goto _end;
+  }
+
   pAPI->metaReaderFn.initReader(&mr, pInfo->readHandle.vnode, 0, &pAPI->metaFn);
 
   while (pInfo->curPos < size && count < pOperator->resultInfo.capacity) {
@@ -3108,6 +3305,7 @@ static SSDataBlock* doTagScanFromMetaEntry(SOperatorInfo* pOperator) {
 
   pAPI->metaReaderFn.clearReader(&mr);
 
+_end:
   // qDebug("QInfo:0x%"PRIx64" create tag values results completed, rows:%d", GET_TASKID(pRuntimeEnv), count);
   if (pOperator->status == OP_EXEC_DONE) {
     setTaskStatus(pTaskInfo, TASK_COMPLETED);
@@ -3332,6 +3530,7 @@ int32_t startGroupTableMergeScan(SOperatorInfo* pOperator) {
     tsortSetAbortCheckFn(pInfo->pSortHandle, isTaskKilled, pOperator->pTaskInfo);
   }
 
+  tsortSetMemBudget(pInfo->pSortHandle, &pTaskInfo->memBudget);
   tsortSetFetchRawDataFp(pInfo->pSortHandle, getBlockForTableMergeScan, NULL, NULL);
 
   // one table has one data block
@@ -3341,6 +3540,9 @@ int32_t startGroupTableMergeScan(SOperatorInfo* pOperator) {
   param->pOperator = pOperator;
   STableKeyInfo* startKeyInfo = tableListGetInfo(pInfo->base.pTableListInfo, tableStartIdx);
   pAPI->tsdReader.tsdReaderOpen(pHandle->vnode, &pInfo->base.cond, startKeyInfo, numOfTable, pInfo->pReaderBlock, (void**)&pInfo->base.dataReader, GET_TASKID(pTaskInfo), false, NULL);
+  if (pInfo->base.dataReader != NULL) {
+    pAPI->tsdReader.tsdSetReaderProfile(pInfo->base.dataReader, &pInfo->base.readRecorder);
+  }
 
   SSortSource* ps = taosMemoryCalloc(1, sizeof(SSortSource));
   ps->param = param;
@@ -3372,6 +3574,8 @@ int32_t stopGroupTableMergeScan(SOperatorInfo* pOperator) {
   pInfo->sortExecInfo.loops += sortExecInfo.loops;
   pInfo->sortExecInfo.readBytes += sortExecInfo.readBytes;
   pInfo->sortExecInfo.writeBytes += sortExecInfo.writeBytes;
+  pInfo->sortExecInfo.rawWriteBytes += sortExecInfo.rawWriteBytes;
+  pInfo->sortExecInfo.prefetchPages += sortExecInfo.prefetchPages;
 
   if (pInfo->base.dataReader != NULL) {
     pAPI->tsdReader.tsdReaderClose(pInfo->base.dataReader);
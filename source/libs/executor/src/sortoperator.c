@@ -206,6 +206,7 @@ int32_t doOpenSortOperator(SOperatorInfo* pOperator) {
   pInfo->pSortHandle = tsortCreateSortHandle(pInfo->pSortInfo, SORT_SINGLESOURCE_SORT, -1, -1, NULL, pTaskInfo->id.str,
                                              pInfo->maxRows, pInfo->maxTupleLength, tsPQSortMemThreshold * 1024 * 1024);
 
+  tsortSetMemBudget(pInfo->pSortHandle, &pTaskInfo->memBudget);
   tsortSetFetchRawDataFp(pInfo->pSortHandle, loadNextDataBlock, applyScalarFunction, pOperator);
 
   SSortSource* ps = taosMemoryCalloc(1, sizeof(SSortSource));
@@ -409,6 +410,7 @@ int32_t beginSortGroup(SOperatorInfo* pOperator) {
   pInfo->pCurrSortHandle =
       tsortCreateSortHandle(pInfo->pSortInfo, SORT_SINGLESOURCE_SORT, -1, -1, NULL, pTaskInfo->id.str, 0, 0, 0);
 
+  tsortSetMemBudget(pInfo->pCurrSortHandle, &pTaskInfo->memBudget);
   tsortSetFetchRawDataFp(pInfo->pCurrSortHandle, fetchNextGroupSortDataBlock, applyScalarFunction, pOperator);
 
   SSortSource*           ps = taosMemoryCalloc(1, sizeof(SSortSource));
@@ -607,6 +609,7 @@ int32_t openMultiwayMergeOperator(SOperatorInfo* pOperator) {
   pInfo->pSortHandle = tsortCreateSortHandle(pInfo->pSortInfo, SORT_MULTISOURCE_MERGE, pInfo->bufPageSize, numOfBufPage,
                                              pInfo->pInputBlock, pTaskInfo->id.str, 0, 0, 0);
 
+  tsortSetMemBudget(pInfo->pSortHandle, &pTaskInfo->memBudget);
   tsortSetFetchRawDataFp(pInfo->pSortHandle, loadNextDataBlock, NULL, NULL);
   tsortSetCompareGroupId(pInfo->pSortHandle, pInfo->groupSort);
 
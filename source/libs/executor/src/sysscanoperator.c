@@ -87,11 +87,12 @@ typedef struct MergeIndex {
 } MergeIndex;
 
 typedef struct SBlockDistInfo {
-  SSDataBlock*    pResBlock;
-  STsdbReader*    pHandle;
-  SReadHandle     readHandle;
-  STableListInfo* pTableListInfo;
-  uint64_t        uid;  // table uid
+  SSDataBlock*           pResBlock;
+  STsdbReader*           pHandle;
+  SReadHandle            readHandle;
+  STableListInfo*        pTableListInfo;
+  uint64_t               uid;  // table uid
+  SFileBlockLoadRecorder readRecorder;
 } SBlockDistInfo;
 
 static int32_t sysChkFilter__Comm(SNode* pNode);
@@ -2245,6 +2246,15 @@ static SSDataBlock* doBlockInfoScan(SOperatorInfo* pOperator) {
   return pBlock;
 }
 
+static int32_t getBlockDistScanExecInfo(struct SOperatorInfo* pOptr, void** pOptrExplain, uint32_t* len) {
+  SFileBlockLoadRecorder* pRecorder = taosMemoryCalloc(1, sizeof(SFileBlockLoadRecorder));
+  SBlockDistInfo*         pInfo = pOptr->info;
+  *pRecorder = pInfo->readRecorder;
+  *pOptrExplain = pRecorder;
+  *len = sizeof(SFileBlockLoadRecorder);
+  return 0;
+}
+
 static void destroyBlockDistScanOperatorInfo(void* param) {
   SBlockDistInfo* pDistInfo = (SBlockDistInfo*)param;
   blockDataDestroy(pDistInfo->pResBlock);
@@ -2309,6 +2319,7 @@ SOperatorInfo* createDataBlockInfoScanOperator(SReadHandle* readHandle, SBlockDi
     if (code != 0) {
       goto _error;
     }
+    readHandle->api.tsdReader.tsdSetReaderProfile(pInfo->pHandle, &pInfo->readRecorder);
   }
 
   pInfo->readHandle = *readHandle;
@@ -2324,7 +2335,7 @@ SOperatorInfo* createDataBlockInfoScanOperator(SReadHandle* readHandle, SBlockDi
   setOperatorInfo(pOperator, "DataBlockDistScanOperator", QUERY_NODE_PHYSICAL_PLAN_BLOCK_DIST_SCAN, false,
                   OP_NOT_OPENED, pInfo, pTaskInfo);
   pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, doBlockInfoScan, NULL, destroyBlockDistScanOperatorInfo,
-                                         optrDefaultBufFn, NULL, optrDefaultGetNextExtFn, NULL);
+                                         optrDefaultBufFn, getBlockDistScanExecInfo, optrDefaultGetNextExtFn, NULL);
   return pOperator;
 
 _error:
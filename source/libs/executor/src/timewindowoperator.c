@@ -61,6 +61,17 @@ typedef struct SOpenWindowInfo {
   uint64_t           groupId;
 } SOpenWindowInfo;
 
+typedef struct SPaneKey {
+  uint64_t groupId;
+  TSKEY    skey;
+} SPaneKey;
+
+typedef struct SPane {
+  uint64_t           groupId;
+  TSKEY              skey;
+  SResultRowPosition pos;
+} SPane;
+
 static int64_t* extractTsCol(SSDataBlock* pBlock, const SIntervalAggOperatorInfo* pInfo);
 
 static SResultRowPosition addToOpenWindowList(SResultRowInfo* pResultRowInfo, const SResultRow* pResult,
@@ -844,6 +855,261 @@ int64_t* extractTsCol(SSDataBlock* pBlock, const SIntervalAggOperatorInfo* pInfo
   return tsCols;
 }
 
+static TSKEY getPaneStartKey(SIntervalAggOperatorInfo* pInfo, TSKEY ts) {
+  if (!pInfo->paneAnchorSet) {
+    pInfo->paneAnchor = getAlignQueryTimeWindow(&pInfo->interval, ts).skey;
+    pInfo->paneAnchorSet = true;
+  }
+
+  int64_t sliding = pInfo->interval.sliding;
+  int64_t delta = ts - pInfo->paneAnchor;
+  int64_t n = delta / sliding;
+  if (delta < 0 && (delta % sliding) != 0) {
+    n -= 1;
+  }
+
+  return pInfo->paneAnchor + n * sliding;
+}
+
+// the pane rows live in the result buffer of the windows, the page of the row returned is held until
+// releasePaneRow is called
+static SResultRow* setPaneOutputBuf(SOperatorInfo* pOperator, uint64_t groupId, TSKEY skey) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+  SAggSupporter*            pAggSup = &pInfo->aggSup;
+
+  SPaneKey            key = {.groupId = groupId, .skey = skey};
+  SResultRowPosition* p = tSimpleHashGet(pInfo->pPaneHash, &key, sizeof(key));
+  SResultRow*         pRow = NULL;
+
+  if (p != NULL) {
+    pRow = getResultRowByPos(pAggSup->pResultBuf, p, true);
+    if (pRow == NULL) {
+      T_LONG_JMP(pOperator->pTaskInfo->env, terrno);
+    }
+  } else {
+    pRow = getNewResultRow(pAggSup->pResultBuf, &pAggSup->currentPageId, pAggSup->resultRowSize);
+    if (pRow == NULL) {
+      T_LONG_JMP(pOperator->pTaskInfo->env, terrno);
+    }
+
+    SResultRowPosition pos = {.pageId = pRow->pageId, .offset = pRow->offset};
+    if (tSimpleHashPut(pInfo->pPaneHash, &key, sizeof(key), &pos, sizeof(SResultRowPosition)) != 0) {
+      T_LONG_JMP(pOperator->pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+
+    pRow->win.skey = skey;
+    pRow->win.ekey = skey + pInfo->interval.sliding - 1;
+  }
+
+  setResultRowInitCtx(pRow, pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset);
+  return pRow;
+}
+
+static void releasePaneRow(SIntervalAggOperatorInfo* pInfo, SResultRow* pRow) {
+  releaseBufPage(pInfo->aggSup.pResultBuf, (char*)pRow - pRow->offset);
+}
+
+// aggregate the rows of the block into the panes, each row is processed only once no matter how many windows it
+// belongs to. The scan loads the data of any block that spans more than one pane, so a block without the primary
+// timestamp column is a single pane.
+static void hashPaneAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+
+  int64_t* tsCols = extractTsCol(pBlock, pInfo);
+  int32_t  order = pInfo->binfo.inputTsOrder;
+  int32_t  startPos = 0;
+
+  while (startPos < pBlock->info.rows) {
+    TSKEY       ts = (tsCols != NULL) ? tsCols[startPos] : pBlock->info.window.skey;
+    SResultRow* pRow = setPaneOutputBuf(pOperator, pBlock->info.id.groupId, getPaneStartKey(pInfo, ts));
+
+    TSKEY   ekey = (order == TSDB_ORDER_ASC) ? pRow->win.ekey : pRow->win.skey;
+    int32_t forwardRows =
+        getNumOfRowsInTimeWindow(&pBlock->info, tsCols, startPos, ekey, binarySearchForKey, NULL, order);
+
+    updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &pRow->win, 1);
+    applyAggFunctionOnPartialTuples(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, startPos, forwardRows,
+                                    pBlock->info.rows, pSup->numOfExprs);
+    releasePaneRow(pInfo, pRow);
+    startPos += forwardRows;
+  }
+}
+
+static int32_t paneCompare(const void* p1, const void* p2) {
+  const SPane* pLeft = p1;
+  const SPane* pRight = p2;
+
+  if (pLeft->groupId != pRight->groupId) {
+    return (pLeft->groupId < pRight->groupId) ? -1 : 1;
+  }
+
+  if (pLeft->skey == pRight->skey) {
+    return 0;
+  }
+  return (pLeft->skey < pRight->skey) ? -1 : 1;
+}
+
+// combine the intermediate result of pSrc into pDest, pDest is initialized first if it is a cleared row
+static void combinePaneRow(SOperatorInfo* pOperator, SResultRow* pDest, const SResultRow* pSrc,
+                           SColumnInfoData* pTimeWindowData) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+
+  setResultRowInitCtx(pDest, pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset);
+  for (int32_t i = 0; i < pSup->numOfExprs; ++i) {
+    pInfo->pPaneCtx[i].resultInfo = getResultEntryInfo(pSrc, i, pSup->rowEntryInfoOffset);
+  }
+
+  compactFunctions(pSup->pCtx, pInfo->pPaneCtx, pSup->numOfExprs, pOperator->pTaskInfo, pTimeWindowData);
+}
+
+static void combinePane(SOperatorInfo* pOperator, SResultRow* pDest, SPane* pPane) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+
+  SResultRow* pRow = getResultRowByPos(pInfo->aggSup.pResultBuf, &pPane->pos, false);
+  if (pRow == NULL) {
+    T_LONG_JMP(pOperator->pTaskInfo->env, terrno);
+  }
+
+  combinePaneRow(pOperator, pDest, pRow, NULL);
+  releasePaneRow(pInfo, pRow);
+}
+
+#define PANE_ROW(_buf, _i, _size) ((SResultRow*)((char*)(_buf) + (int64_t)(_i) * (_size)))
+
+// Build the windows of one group from its panes sorted by start key. The panes in the current window form a FIFO
+// queue kept as two stacks: the front part holds suffix aggregates of the panes evicted next, the back part one
+// running aggregate of the panes pushed since the last flip. Every window is then the combination of two rows and
+// each pane is combined a constant number of times, whatever the ratio of interval to sliding is.
+static void buildWindowsFromPanes(SOperatorInfo* pOperator, SPane* pPanes, int32_t num, char* pFront,
+                                  SResultRow* pBack) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+
+  int32_t rowSize = pInfo->aggSup.resultRowSize;
+  int64_t interval = pInfo->interval.interval;
+  int64_t sliding = pInfo->interval.sliding;
+  int32_t head = 0;   // first pane in the window
+  int32_t front = 0;  // panes in [head, front) are in the front stack, in [front, tail) aggregated in pBack
+  int32_t base = 0;   // pane of the first front stack slot
+  int32_t tail = 0;
+
+  memset(pBack, 0, rowSize);
+  TSKEY wstart = pPanes[0].skey - interval + sliding;
+
+  while (head < num) {
+    while (tail < num && pPanes[tail].skey < wstart + interval) {
+      combinePane(pOperator, pBack, &pPanes[tail]);
+      tail += 1;
+    }
+
+    while (head < tail && pPanes[head].skey < wstart) {
+      if (head == front) {  // flip the back stack into the front one
+        for (int32_t j = tail - 1; j >= head; --j) {
+          SResultRow* pSlot = PANE_ROW(pFront, j - head, rowSize);
+          memset(pSlot, 0, rowSize);
+          combinePane(pOperator, pSlot, &pPanes[j]);
+          if (j + 1 < tail) {
+            combinePaneRow(pOperator, pSlot, PANE_ROW(pFront, j + 1 - head, rowSize), NULL);
+          }
+        }
+
+        base = head;
+        front = tail;
+        memset(pBack, 0, rowSize);
+      }
+      head += 1;
+    }
+
+    if (head == tail) {  // no data in the window, move to the first window of the next pane
+      if (tail < num) {
+        wstart = pPanes[tail].skey - interval + sliding;
+      }
+      continue;
+    }
+
+    STimeWindow win = {.skey = wstart, .ekey = wstart + interval - 1};
+    SResultRow* pResult = NULL;
+    int32_t     code = setTimeWindowOutputBuf(&pInfo->binfo.resultRowInfo, &win, true, &pResult, pPanes[0].groupId,
+                                              pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset, &pInfo->aggSup,
+                                              pTaskInfo);
+    if (code != TSDB_CODE_SUCCESS || pResult == NULL) {
+      T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+    }
+
+    updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &win, 1);
+    if (head < front) {
+      combinePaneRow(pOperator, pResult, PANE_ROW(pFront, head - base, rowSize), &pInfo->twAggSup.timeWindowData);
+    }
+    if (front < tail) {
+      combinePaneRow(pOperator, pResult, pBack, &pInfo->twAggSup.timeWindowData);
+    }
+
+    wstart += sliding;
+  }
+}
+
+static void buildWindowsFromAllPanes(SOperatorInfo* pOperator) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+
+  int32_t numOfPanes = tSimpleHashGetSize(pInfo->pPaneHash);
+  if (numOfPanes == 0) {
+    return;
+  }
+
+  SPane* pPanes = taosMemoryMalloc(numOfPanes * sizeof(SPane));
+  if (pPanes == NULL) {
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+  }
+
+  int32_t num = 0;
+  int32_t iter = 0;
+  void*   p = NULL;
+  while ((p = tSimpleHashIterate(pInfo->pPaneHash, p, &iter)) != NULL) {
+    SPaneKey* pKey = tSimpleHashGetKey(p, NULL);
+    pPanes[num++] = (SPane){.groupId = pKey->groupId, .skey = pKey->skey, .pos = *(SResultRowPosition*)p};
+  }
+
+  taosSort(pPanes, num, sizeof(SPane), paneCompare);
+
+  // one window holds no more than interval/sliding panes, plus the one evicted when the window slides
+  int64_t maxSlots = TMIN(pInfo->interval.interval / pInfo->interval.sliding + 1, num);
+  char*   pFront = taosMemoryMalloc(maxSlots * pInfo->aggSup.resultRowSize);
+  char*   pBack = taosMemoryMalloc(pInfo->aggSup.resultRowSize);
+  if (pFront == NULL || pBack == NULL) {
+    taosMemoryFree(pFront);
+    taosMemoryFree(pBack);
+    taosMemoryFree(pPanes);
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+  }
+
+  for (int32_t start = 0; start < num;) {
+    int32_t end = start + 1;
+    while (end < num && pPanes[end].groupId == pPanes[start].groupId) {
+      end += 1;
+    }
+
+    buildWindowsFromPanes(pOperator, pPanes + start, end - start, pFront, (SResultRow*)pBack);
+    start = end;
+  }
+
+  taosMemoryFree(pFront);
+  taosMemoryFree(pBack);
+  taosMemoryFree(pPanes);
+}
+
+// the pane rows are left in the result buffer, they go with it
+static void destroyPanes(SIntervalAggOperatorInfo* pInfo) {
+  tSimpleHashCleanup(pInfo->pPaneHash);
+  pInfo->pPaneHash = NULL;
+  taosMemoryFreeClear(pInfo->pPaneCtx);
+}
+
 static int32_t doOpenIntervalAgg(SOperatorInfo* pOperator) {
   if (OPTR_IS_OPENED(pOperator)) {
     return TSDB_CODE_SUCCESS;
@@ -873,7 +1139,16 @@ static int32_t doOpenIntervalAgg(SOperatorInfo* pOperator) {
 
     // the pDataBlock are always the same one, no need to call this again
     setInputDataBlock(pSup, pBlock, pInfo->binfo.inputTsOrder, scanFlag, true);
-    if (hashIntervalAgg(pOperator, &pInfo->binfo.resultRowInfo, pBlock, scanFlag)) break;
+    if (pInfo->paneAgg) {
+      hashPaneAgg(pOperator, pBlock);
+    } else if (hashIntervalAgg(pOperator, &pInfo->binfo.resultRowInfo, pBlock, scanFlag)) {
+      break;
+    }
+  }
+
+  if (pInfo->paneAgg) {
+    buildWindowsFromAllPanes(pOperator);
+    destroyPanes(pInfo);
   }
 
   initGroupedResultInfo(&pInfo->groupResInfo, pInfo->aggSup.pResultRowHashTable, pInfo->binfo.outputTsOrder);
@@ -1150,6 +1425,7 @@ void destroyIntervalOperatorInfo(void* param) {
   cleanupGroupResInfo(&pInfo->groupResInfo);
   colDataDestroy(&pInfo->twAggSup.timeWindowData);
   destroyBoundedQueue(pInfo->pBQ);
+  destroyPanes(pInfo);
   taosMemoryFreeClear(param);
 }
 
@@ -1207,6 +1483,38 @@ static bool timeWindowinterpNeeded(SqlFunctionCtx* pCtx, int32_t numOfCols, SInt
   return needed;
 }
 
+// Panes pay off when the windows overlap, and only work when the windows lie on a fixed sliding grid and every
+// function can merge intermediate results, since the window results are combined from the pane results.
+static bool paneAggApplicable(SqlFunctionCtx* pCtx, int32_t numOfCols, SIntervalAggOperatorInfo* pInfo) {
+  SInterval* pInterval = &pInfo->interval;
+  if (IS_CALENDAR_TIME_DURATION(pInterval->intervalUnit) || IS_CALENDAR_TIME_DURATION(pInterval->slidingUnit) ||
+      IS_CALENDAR_TIME_DURATION(pInterval->offsetUnit)) {
+    return false;
+  }
+
+  if (pInterval->sliding <= 0 || pInterval->interval <= pInterval->sliding ||
+      (pInterval->interval % pInterval->sliding) != 0) {
+    return false;
+  }
+
+  if (pInfo->timeWindowInterpo || pInfo->limited || pInfo->slimited) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    if (fmIsWindowPseudoColumnFunc(pCtx[i].functionId)) {
+      continue;
+    }
+
+    if (pCtx[i].isPseudoFunc || pCtx[i].functionId == -1 || pCtx[i].fpSet.combine == NULL ||
+        pCtx[i].subsidiaries.num > 0 || fmIsUserDefinedFunc(pCtx[i].functionId)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 SOperatorInfo* createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPhysiNode* pPhyNode,
                                           SExecTaskInfo* pTaskInfo) {
   SIntervalAggOperatorInfo* pInfo = taosMemoryCalloc(1, sizeof(SIntervalAggOperatorInfo));
@@ -1232,6 +1540,7 @@ SOperatorInfo* createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPh
   if (code != TSDB_CODE_SUCCESS) {
     goto _error;
   }
+  dBufSetMemBudget(pInfo->aggSup.pResultBuf, &pTaskInfo->memBudget);
 
   SInterval interval = {.interval = pPhyNode->interval,
                         .sliding = pPhyNode->sliding,
@@ -1287,6 +1596,17 @@ SOperatorInfo* createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPh
     }
   }
 
+  pInfo->paneAgg = paneAggApplicable(pSup->pCtx, num, pInfo);
+  if (pInfo->paneAgg) {
+    pInfo->pPaneHash = tSimpleHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+    pInfo->pPaneCtx = taosMemoryMalloc(num * sizeof(SqlFunctionCtx));
+    if (pInfo->pPaneHash == NULL || pInfo->pPaneCtx == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _error;
+    }
+    memcpy(pInfo->pPaneCtx, pSup->pCtx, num * sizeof(SqlFunctionCtx));
+  }
+
   initResultRowInfo(&pInfo->binfo.resultRowInfo);
   setOperatorInfo(pOperator, "TimeIntervalAggOperator", QUERY_NODE_PHYSICAL_PLAN_HASH_INTERVAL, true, OP_NOT_OPENED,
                   pInfo, pTaskInfo);
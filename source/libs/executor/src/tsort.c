@@ -74,12 +74,19 @@ struct SSortHandle {
 
   bool (*abortCheckFn)(void* param);
   void* abortCheckParam;
+
+  SDBufMemBudget* pMemBudget;
 };
 
 void tsortSetSingleTableMerge(SSortHandle* pHandle) {
   pHandle->singleTableMerge = true;
 }
 
+void tsortSetMemBudget(SSortHandle* pHandle, SDBufMemBudget* pBudget) {
+  pHandle->pMemBudget = pBudget;
+  dBufSetMemBudget(pHandle->pBuf, pBudget);
+}
+
 void tsortSetAbortCheckFn(SSortHandle *pHandle, bool (*checkFn)(void *), void* param) {
   pHandle->abortCheckFn = checkFn;
   pHandle->abortCheckParam = param;
@@ -346,6 +353,7 @@ static int32_t doAddToBuf(SSDataBlock* pDataBlock, SSortHandle* pHandle) {
     int32_t code = createDiskbasedBuf(&pHandle->pBuf, pHandle->pageSize, pHandle->numOfPages * pHandle->pageSize,
                                       "sortExternalBuf", tsTempDir);
     dBufSetPrintInfo(pHandle->pBuf);
+    dBufSetMemBudget(pHandle->pBuf, pHandle->pMemBudget);
     if (code != TSDB_CODE_SUCCESS) {
       return code;
     }
@@ -412,6 +420,7 @@ static int32_t sortComparInit(SMsortComparParam* pParam, SArray* pSources, int32
     code = createDiskbasedBuf(&pHandle->pBuf, pHandle->pageSize, pHandle->numOfPages * pHandle->pageSize,
                               "sortComparInit", tsTempDir);
     dBufSetPrintInfo(pHandle->pBuf);
+    dBufSetMemBudget(pHandle->pBuf, pHandle->pMemBudget);
     if (code != TSDB_CODE_SUCCESS) {
       terrno = code;
       return code;
@@ -825,6 +834,7 @@ static int32_t createPageBuf(SSortHandle* pHandle) {
     int32_t code = createDiskbasedBuf(&pHandle->pBuf, pHandle->pageSize, pHandle->numOfPages * pHandle->pageSize,
                                       "tableBlocksBuf", tsTempDir);
     dBufSetPrintInfo(pHandle->pBuf);
+    dBufSetMemBudget(pHandle->pBuf, pHandle->pMemBudget);
     if (code != TSDB_CODE_SUCCESS) {
       return code;
     }
@@ -1562,6 +1572,8 @@ SSortExecInfo tsortGetSortExecInfo(SSortHandle* pHandle) {
       SDiskbasedBufStatis st = getDBufStatis(pHandle->pBuf);
       info.writeBytes = st.flushBytes;
       info.readBytes = st.loadBytes;
+      info.rawWriteBytes = st.rawBytes;
+      info.prefetchPages = st.prefetchPages;
     }
   }
 
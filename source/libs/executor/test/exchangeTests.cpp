@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "executorInt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+#include "tref.h"
+
+namespace {
+
+const int32_t kRowsPerFetch = 100;
+const int64_t kSourceKeyRange = 1000000;
+
+// the value of row i of a source is source * kSourceKeyRange + i
+struct SExchangeSource {
+  int32_t numOfFetches;  // each fetch returns one block, the last one is marked completed
+  int32_t fetched;
+};
+
+struct SExchangeTest {
+  std::vector<SExchangeSource> sources;
+  SExchangeInfo*               pExchange;
+  int32_t                      fetchCalls;
+  int32_t                      fetchesOverLimit;  // fetches sent while the buffered blocks were at the limit
+  int32_t                      fetchesAfterCompleted;
+};
+
+// serves the fetch of a source run in the same task, as the query worker does for a local source
+int32_t doLocalFetch(void* handle, uint64_t sId, uint64_t queryId, uint64_t taskId, int64_t rId, int32_t eId,
+                     void** pRsp, SArray* explainRes) {
+  SExchangeTest*   pTest = reinterpret_cast<SExchangeTest*>(handle);
+  SExchangeSource& source = pTest->sources[taskId];
+
+  pTest->fetchCalls += 1;
+  if (pTest->pExchange->bufferedBytes >= pTest->pExchange->maxBufferedBytes) {
+    pTest->fetchesOverLimit += 1;
+  }
+  if (source.fetched >= source.numOfFetches && source.fetched > 0) {
+    pTest->fetchesAfterCompleted += 1;
+  }
+
+  if (source.numOfFetches == 0) {
+    SRetrieveTableRsp* p = (SRetrieveTableRsp*)taosMemoryCalloc(1, sizeof(SRetrieveTableRsp));
+    p->completed = 1;
+    source.fetched += 1;
+    *pRsp = p;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SSDataBlock*    pBlock = createDataBlock();
+  SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 1);
+  blockDataAppendColInfo(pBlock, &col);
+  blockDataEnsureCapacity(pBlock, kRowsPerFetch);
+  for (int32_t i = 0; i < kRowsPerFetch; ++i) {
+    int64_t v = (int64_t)taskId * kSourceKeyRange + source.fetched * kRowsPerFetch + i;
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0), i, (const char*)&v, false);
+  }
+  pBlock->info.rows = kRowsPerFetch;
+  source.fetched += 1;
+
+  int32_t            len = blockGetEncodeSize(pBlock);
+  SRetrieveTableRsp* p = (SRetrieveTableRsp*)taosMemoryCalloc(1, sizeof(SRetrieveTableRsp) + len);
+  int32_t            dataLen = blockEncode(pBlock, p->data, 1);
+  p->completed = (source.fetched >= source.numOfFetches);
+  p->compLen = htonl(dataLen);
+  p->numOfRows = htobe64(kRowsPerFetch);
+  p->numOfCols = htonl(1);
+  p->numOfBlocks = htonl(1);
+  blockDataDestroy(pBlock);
+
+  *pRsp = p;
+  return TSDB_CODE_SUCCESS;
+}
+
+SExchangePhysiNode* createExchangeNode(int32_t numOfSources) {
+  SExchangePhysiNode* pNode = (SExchangePhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_EXCHANGE);
+  for (int32_t i = 0; i < numOfSources; ++i) {
+    SDownstreamSourceNode* pSource = (SDownstreamSourceNode*)nodesMakeNode(QUERY_NODE_DOWNSTREAM_SOURCE);
+    pSource->addr.nodeId = i + 1;
+    pSource->taskId = i;
+    pSource->localExec = true;
+    nodesListMakeAppend(&pNode->pSrcEndPoints, (SNode*)pSource);
+  }
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  SSlotDescNode*      pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = 0;
+  pSlot->dataType.type = TSDB_DATA_TYPE_BIGINT;
+  pSlot->dataType.bytes = sizeof(int64_t);
+  pSlot->output = true;
+  nodesListMakeAppend(&pDesc->pSlots, (SNode*)pSlot);
+  pNode->node.pOutputDataBlockDesc = pDesc;
+  return pNode;
+}
+
+// the rows in the order the exchange returns them, and the fetches sent by the time each block is returned
+void runExchange(SExchangeTest* pTest, int64_t maxBufferedBytes, std::vector<int64_t>* pRows,
+                 std::vector<int32_t>* pFetchCalls) {
+  if (exchangeObjRefPool < 0) {
+    exchangeObjRefPool = taosOpenRef(1024, doDestroyExchangeOperatorInfo);
+  }
+
+  SStorageAPI    api = {};
+  SExecTaskInfo* pTaskInfo = doCreateTask(0, 0, 0, OPTR_EXEC_MODEL_BATCH, &api);
+  pTaskInfo->localFetch.handle = pTest;
+  pTaskInfo->localFetch.localExec = true;
+  pTaskInfo->localFetch.fp = doLocalFetch;
+
+  SExchangePhysiNode* pNode = createExchangeNode((int32_t)pTest->sources.size());
+  SOperatorInfo*      pExchange = createExchangeOperatorInfo(NULL, pNode, pTaskInfo);
+  ASSERT_NE(pExchange, nullptr);
+  pTest->pExchange = (SExchangeInfo*)pExchange->info;
+  if (maxBufferedBytes > 0) {
+    pTest->pExchange->maxBufferedBytes = maxBufferedBytes;
+  }
+
+  while (1) {
+    SSDataBlock* pBlock = pExchange->fpSet.getNextFn(pExchange);
+    if (pBlock == NULL) break;
+
+    SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+      pRows->push_back(*(int64_t*)colDataGetData(pCol, r));
+    }
+    pFetchCalls->push_back(pTest->fetchCalls);
+  }
+  EXPECT_EQ(pTaskInfo->code, 0);
+
+  destroyOperator(pExchange);
+  nodesDestroyNode((SNode*)pNode);
+  doDestroyTask(pTaskInfo);
+}
+
+// every row of every source is returned once, and the rows of a source in the order it sent them
+void checkRows(const SExchangeTest& test, const std::vector<int64_t>& rows) {
+  std::vector<int64_t> next(test.sources.size(), 0);
+  for (int64_t v : rows) {
+    size_t source = v / kSourceKeyRange;
+    ASSERT_LT(source, test.sources.size());
+    ASSERT_EQ(v % kSourceKeyRange, next[source]) << "source " << source;
+    next[source] += 1;
+  }
+
+  for (size_t i = 0; i < test.sources.size(); ++i) {
+    EXPECT_EQ(next[i], (int64_t)test.sources[i].numOfFetches * kRowsPerFetch) << "source " << i;
+  }
+  EXPECT_EQ(test.fetchesAfterCompleted, 0);
+}
+
+SExchangeTest createTest(const std::vector<int32_t>& numOfFetches) {
+  SExchangeTest test = {};
+  for (int32_t n : numOfFetches) test.sources.push_back(SExchangeSource{n, 0});
+  return test;
+}
+
+}  // namespace
+
+TEST(exchangeTest, fetchAhead) {
+  // a source that has sent its blocks is asked for the next ones before the parent takes them
+  SExchangeTest        test = createTest({5, 3, 0, 8});
+  std::vector<int64_t> rows;
+  std::vector<int32_t> fetchCalls;
+  runExchange(&test, 0, &rows, &fetchCalls);
+
+  checkRows(test, rows);
+  ASSERT_FALSE(fetchCalls.empty());
+  EXPECT_EQ(fetchCalls[0], 4 + 3);
+  EXPECT_EQ(test.fetchCalls, 5 + 3 + 1 + 8);
+  EXPECT_EQ(test.fetchesOverLimit, 0);
+}
+
+TEST(exchangeTest, bufferLimit) {
+  // once the buffered blocks reach the limit no source is asked for more until the parent drains them
+  SExchangeTest        test = createTest({5, 5, 5});
+  std::vector<int64_t> rows;
+  std::vector<int32_t> fetchCalls;
+  runExchange(&test, 1, &rows, &fetchCalls);
+
+  checkRows(test, rows);
+  ASSERT_EQ(fetchCalls.size(), 15);
+  for (size_t i = 0; i < fetchCalls.size(); ++i) {
+    EXPECT_EQ(fetchCalls[i], (int32_t)(i / 3 + 1) * 3) << "block " << i;
+  }
+  EXPECT_EQ(test.fetchesOverLimit, 0);
+
+  // a limit of a few blocks lets the sources run ahead up to it
+  SExchangeTest other = createTest({7, 2, 4});
+  rows.clear();
+  fetchCalls.clear();
+  runExchange(&other, 4 * (kRowsPerFetch * sizeof(int64_t)), &rows, &fetchCalls);
+
+  checkRows(other, rows);
+  EXPECT_EQ(other.fetchCalls, 7 + 2 + 4);
+  EXPECT_EQ(other.fetchesOverLimit, 0);
+}
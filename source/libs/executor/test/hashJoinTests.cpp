@@ -0,0 +1,477 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "executorInt.h"
+#include "hashjoin.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+const int16_t kBuildBlkId = 1;
+const int16_t kProbeBlkId = 2;
+const int16_t kResBlkId = 3;
+
+// a task with no storage behind it, the storage api is copied into the task
+SExecTaskInfo* createTask() {
+  SStorageAPI api = {};
+  return doCreateTask(0, 0, 0, OPTR_EXEC_MODEL_BATCH, &api);
+}
+
+// the blocks an input operator returns, it passes them through the runtime filter handed to it as a table scan does
+struct SJoinInput {
+  STableScanInfo            scan;
+  std::vector<SSDataBlock*> blocks;
+  size_t                    next;
+  SSDataBlock*              pOut;
+};
+
+SSDataBlock* getNextInputBlock(SOperatorInfo* pOperator) {
+  SJoinInput* pInput = reinterpret_cast<SJoinInput*>(pOperator->info);
+  if (pInput->next >= pInput->blocks.size()) {
+    return NULL;
+  }
+
+  blockDataDestroy(pInput->pOut);
+  pInput->pOut = createOneDataBlock(pInput->blocks[pInput->next++], true);
+  if (pInput->scan.base.pRuntimeFilter != NULL) {
+    EXPECT_EQ(doFilterByRuntimeFilter(pInput->scan.base.pRuntimeFilter, pInput->pOut), 0);
+  }
+  return pInput->pOut;
+}
+
+void destroyInput(void* param) {
+  SJoinInput* pInput = reinterpret_cast<SJoinInput*>(param);
+  for (SSDataBlock* pBlock : pInput->blocks) blockDataDestroy(pBlock);
+  blockDataDestroy(pInput->pOut);
+  destroyScanRuntimeFilter(pInput->scan.base.pRuntimeFilter);
+  taosArrayDestroy(pInput->scan.base.matchInfo.pList);
+  delete pInput;
+}
+
+// an input of the key and a value in slot 0 and 1, a table scan on the primary timestamp key if asScan is set
+SOperatorInfo* createInputOperator(int16_t blkId, const std::vector<SSDataBlock*>& blocks, bool asScan,
+                                   SExecTaskInfo* pTaskInfo) {
+  SJoinInput* pInput = new SJoinInput();
+  memset(&pInput->scan, 0, sizeof(pInput->scan));
+  pInput->blocks = blocks;
+  pInput->next = 0;
+  pInput->pOut = NULL;
+
+  SOperatorInfo* pOperator = static_cast<SOperatorInfo*>(taosMemoryCalloc(1, sizeof(SOperatorInfo)));
+  setOperatorInfo(pOperator, "joinInput", asScan ? QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN : 0, false, OP_NOT_OPENED,
+                  &pInput->scan, pTaskInfo);
+  pOperator->resultDataBlockId = blkId;
+  pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, getNextInputBlock, NULL, destroyInput, optrDefaultBufFn,
+                                         NULL, optrDefaultGetNextExtFn, NULL);
+
+  if (asScan) {
+    pInput->scan.base.matchInfo.pList = taosArrayInit(2, sizeof(SColMatchItem));
+    SColMatchItem ts = {.colId = PRIMARYKEY_TIMESTAMP_COL_ID, .srcSlotId = 0, .dstSlotId = 0, .needOutput = true};
+    SColMatchItem v = {.colId = 2, .srcSlotId = 1, .dstSlotId = 1, .needOutput = true};
+    taosArrayPush(pInput->scan.base.matchInfo.pList, &ts);
+    taosArrayPush(pInput->scan.base.matchInfo.pList, &v);
+  }
+  return pOperator;
+}
+
+// blocks of the key and a value column, the value is a varchar of valLen bytes if valLen > 0, an int otherwise
+std::vector<SSDataBlock*> createBlocks(int8_t keyType, const std::vector<int64_t>& keys, int32_t valLen,
+                                       int32_t rowsPerBlock) {
+  std::vector<SSDataBlock*> blocks;
+  std::string               val(valLen + VARSTR_HEADER_SIZE, '\0');
+  for (size_t start = 0; start < keys.size(); start += rowsPerBlock) {
+    int32_t      rows = (int32_t)std::min(keys.size() - start, (size_t)rowsPerBlock);
+    SSDataBlock* pBlock = createDataBlock();
+
+    SColumnInfoData key = createColumnInfoData(keyType, tDataTypes[keyType].bytes, 1);
+    SColumnInfoData value = valLen > 0 ? createColumnInfoData(TSDB_DATA_TYPE_VARCHAR, valLen + VARSTR_HEADER_SIZE, 2)
+                                       : createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 2);
+    blockDataAppendColInfo(pBlock, &key);
+    blockDataAppendColInfo(pBlock, &value);
+    blockDataEnsureCapacity(pBlock, rows);
+
+    SColumnInfoData* pKey = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    for (int32_t i = 0; i < rows; ++i) {
+      int64_t k = keys[start + i];
+      int32_t k32 = (int32_t)k;
+      colDataSetVal(pKey, i, keyType == TSDB_DATA_TYPE_INT ? (const char*)&k32 : (const char*)&k, false);
+      if (valLen > 0) {
+        std::string s = std::to_string(k) + ":" + std::to_string(start + i);
+        s.resize(valLen, (char)('a' + (start + i) % 26));
+        STR_TO_VARSTR(&val[0], s.c_str());
+        colDataSetVal(pVal, i, val.data(), false);
+      } else {
+        int32_t v = (int32_t)(start + i);
+        colDataSetVal(pVal, i, (const char*)&v, false);
+      }
+    }
+    pBlock->info.rows = rows;
+    if (keyType == TSDB_DATA_TYPE_TIMESTAMP) {
+      pBlock->info.window.skey = *std::min_element(keys.begin() + start, keys.begin() + start + rows);
+      pBlock->info.window.ekey = *std::max_element(keys.begin() + start, keys.begin() + start + rows);
+    }
+    blocks.push_back(pBlock);
+  }
+  return blocks;
+}
+
+SColumnNode* createColumn(int16_t blkId, int16_t slotId, int8_t type, int32_t bytes) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->dataBlockId = blkId;
+  pCol->slotId = slotId;
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = bytes;
+  return pCol;
+}
+
+// build.key = probe.key, the result is the key and the value of each side
+SHashJoinPhysiNode* createJoinNode(int8_t keyType, int32_t valLen, int64_t buildRows, int64_t probeRows) {
+  SHashJoinPhysiNode* pNode = (SHashJoinPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_JOIN);
+  pNode->joinType = JOIN_TYPE_INNER;
+  pNode->inputStat[0].inputRowNum = buildRows;
+  pNode->inputStat[1].inputRowNum = probeRows;
+
+  int32_t keyBytes = tDataTypes[keyType].bytes;
+  nodesListMakeAppend(&pNode->pOnLeft, (SNode*)createColumn(kBuildBlkId, 0, keyType, keyBytes));
+  nodesListMakeAppend(&pNode->pOnRight, (SNode*)createColumn(kProbeBlkId, 0, keyType, keyBytes));
+
+  SColumnNode* aCol[4] = {createColumn(kBuildBlkId, 0, keyType, keyBytes),
+                          createColumn(kBuildBlkId, 1, TSDB_DATA_TYPE_VARCHAR, valLen + VARSTR_HEADER_SIZE),
+                          createColumn(kProbeBlkId, 0, keyType, keyBytes),
+                          createColumn(kProbeBlkId, 1, TSDB_DATA_TYPE_INT, sizeof(int32_t))};
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = kResBlkId;
+  for (int16_t i = 0; i < 4; ++i) {
+    SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+    pSlot->slotId = i;
+    pSlot->dataType = aCol[i]->node.resType;
+    pSlot->output = true;
+    nodesListMakeAppend(&pDesc->pSlots, (SNode*)pSlot);
+
+    STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+    pTarget->dataBlockId = kResBlkId;
+    pTarget->slotId = i;
+    pTarget->pExpr = (SNode*)aCol[i];
+    nodesListMakeAppend(&pNode->pTargets, (SNode*)pTarget);
+  }
+  pNode->node.pOutputDataBlockDesc = pDesc;
+  return pNode;
+}
+
+typedef std::tuple<int64_t, std::string, int64_t, int32_t> SJoinRow;
+
+struct SJoinResult {
+  std::vector<SJoinRow> rows;
+  int64_t               spillBuildRows = 0;
+  int64_t               spillProbeRows = 0;
+  int64_t               filterRows = -1;  // rows the runtime filter took out of the probe side, -1 if not pushed down
+};
+
+int64_t getKey(SColumnInfoData* pCol, int32_t row) {
+  char* p = colDataGetData(pCol, row);
+  return pCol->info.type == TSDB_DATA_TYPE_INT ? *(int32_t*)p : *(int64_t*)p;
+}
+
+// joins the blocks, the probe side is a table scan if pushDown is set
+SJoinResult runHashJoin(int8_t keyType, const std::vector<int64_t>& buildKeys, const std::vector<int64_t>& probeKeys,
+                        int32_t valLen, bool pushDown) {
+  SExecTaskInfo* pTaskInfo = createTask();
+
+  SOperatorInfo* pDownstream[2] = {
+      createInputOperator(kBuildBlkId, createBlocks(keyType, buildKeys, valLen, 1024), false, pTaskInfo),
+      createInputOperator(kProbeBlkId, createBlocks(keyType, probeKeys, 0, 1024), pushDown, pTaskInfo)};
+  SJoinInput* pProbeInput = reinterpret_cast<SJoinInput*>(pDownstream[1]->info);
+
+  SHashJoinPhysiNode* pNode = createJoinNode(keyType, valLen, buildKeys.size(), probeKeys.size());
+  SOperatorInfo*      pJoin = createHashJoinOperatorInfo(pDownstream, 2, pNode, pTaskInfo);
+  nodesDestroyNode((SNode*)pNode);
+
+  SJoinResult res;
+  EXPECT_NE(pJoin, nullptr);
+  if (pJoin == NULL) {
+    doDestroyTask(pTaskInfo);
+    return res;
+  }
+
+  while (true) {
+    SSDataBlock* pBlock = pJoin->fpSet.getNextFn(pJoin);
+    if (pBlock == NULL) break;
+
+    SColumnInfoData* aCol[4];
+    for (int32_t i = 0; i < 4; ++i) aCol[i] = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, i);
+    for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+      char* pVal = colDataGetData(aCol[1], r);
+      res.rows.push_back(SJoinRow(getKey(aCol[0], r), std::string(varDataVal(pVal), varDataLen(pVal)),
+                                  getKey(aCol[2], r), *(int32_t*)colDataGetData(aCol[3], r)));
+    }
+  }
+  std::sort(res.rows.begin(), res.rows.end());
+
+  SHJoinOperatorInfo* pInfo = (SHJoinOperatorInfo*)pJoin->info;
+  res.spillBuildRows = pInfo->execInfo.spillBuildRows;
+  res.spillProbeRows = pInfo->execInfo.spillProbeRows;
+  if (pProbeInput->scan.base.pRuntimeFilter != NULL) {
+    res.filterRows = pProbeInput->scan.base.pRuntimeFilter->filterRows;
+  }
+
+  destroyOperator(pJoin);
+  doDestroyTask(pTaskInfo);
+  return res;
+}
+
+// the rows a nested loop join gives
+std::vector<std::tuple<int64_t, size_t, int64_t, int32_t>> expectedJoin(const std::vector<int64_t>& buildKeys,
+                                                                       const std::vector<int64_t>& probeKeys) {
+  std::vector<std::tuple<int64_t, size_t, int64_t, int32_t>> rows;
+  for (size_t p = 0; p < probeKeys.size(); ++p) {
+    for (size_t b = 0; b < buildKeys.size(); ++b) {
+      if (buildKeys[b] == probeKeys[p]) rows.push_back(std::make_tuple(buildKeys[b], b, probeKeys[p], (int32_t)p));
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+void checkJoinResult(const SJoinResult& res, const std::vector<int64_t>& buildKeys,
+                     const std::vector<int64_t>& probeKeys) {
+  std::vector<std::tuple<int64_t, size_t, int64_t, int32_t>> actual;
+  for (const SJoinRow& row : res.rows) {
+    // the value of a build row starts with its key and its index
+    const std::string& val = std::get<1>(row);
+    size_t             b = std::stoul(val.substr(val.find(':') + 1));
+    actual.push_back(std::make_tuple(std::get<0>(row), b, std::get<2>(row), std::get<3>(row)));
+  }
+  std::sort(actual.begin(), actual.end());
+  ASSERT_EQ(actual.size(), expectedJoin(buildKeys, probeKeys).size());
+  EXPECT_TRUE(actual == expectedJoin(buildKeys, probeKeys));
+}
+
+// a filter of the keys as the hash join builds it
+SScanRuntimeFilter* createRuntimeFilter(int32_t slotId, int8_t type, const std::vector<int64_t>& keys) {
+  SScanRuntimeFilter* pFilter = (SScanRuntimeFilter*)taosMemoryCalloc(1, sizeof(SScanRuntimeFilter));
+  pFilter->slotId = slotId;
+  pFilter->colId = -1;
+  pFilter->type = type;
+  pFilter->hasRange = true;
+  pFilter->min = INT64_MAX;
+  pFilter->max = INT64_MIN;
+  pFilter->pBloom = tScalableBfInit(keys.size(), HJOIN_BLOOM_ERROR_RATE);
+  for (int64_t k : keys) {
+    pFilter->min = TMIN(pFilter->min, k);
+    pFilter->max = TMAX(pFilter->max, k);
+    int32_t k32 = (int32_t)k;
+    tScalableBfPut(pFilter->pBloom, type == TSDB_DATA_TYPE_INT ? (void*)&k32 : (void*)&k, tDataTypes[type].bytes);
+  }
+  return pFilter;
+}
+
+// a block of three rows of a table, the tag value is filled into slot 2 as the scan does
+SSDataBlock* createTagBlock(int32_t tagVal) {
+  SSDataBlock*    pBlock = createDataBlock();
+  SColumnInfoData ts = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+  SColumnInfoData v = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 2);
+  SColumnInfoData tag = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 3);
+  blockDataAppendColInfo(pBlock, &ts);
+  blockDataAppendColInfo(pBlock, &v);
+  blockDataAppendColInfo(pBlock, &tag);
+  blockDataEnsureCapacity(pBlock, 3);
+  for (int32_t r = 0; r < 3; ++r) {
+    int64_t k = r + 1;
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0), r, (const char*)&k, false);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1), r, (const char*)&r, false);
+  }
+  colDataSetNItems((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2), 0, (const char*)&tagVal, 3, false);
+  pBlock->info.rows = 3;
+  return pBlock;
+}
+
+SColumnDataAgg gKeyAgg;
+
+int32_t retrieveKeyAggStub(void* pReader, SSDataBlock* pBlock, bool* allHave, bool* hasNullSMA) {
+  pBlock->pBlockAgg = (SColumnDataAgg**)taosMemoryCalloc(taosArrayGetSize(pBlock->pDataBlock), POINTER_BYTES);
+  pBlock->pBlockAgg[1] = &gKeyAgg;
+  *allHave = true;
+  *hasNullSMA = false;
+  return 0;
+}
+
+}  // namespace
+
+TEST(hashJoinTest, spillMatchesInMemory) {
+  // 16MB of build rows, more than the 10MB page of the hash table, and no more than 4MB for the query
+  const int32_t        valLen = 2000;
+  std::vector<int64_t> buildKeys, probeKeys;
+  for (int64_t i = 0; i < 8000; ++i) buildKeys.push_back((i * 7919) % 6000);
+  for (int64_t i = 0; i < 20000; ++i) probeKeys.push_back((i * 104729) % 7000);
+
+  int32_t bufferSize = tsQueryBufferSizePerQuery;
+  tsQueryBufferSizePerQuery = -1;
+  SJoinResult inMem = runHashJoin(TSDB_DATA_TYPE_INT, buildKeys, probeKeys, valLen, false);
+  EXPECT_EQ(inMem.spillBuildRows, 0);
+  EXPECT_EQ(inMem.spillProbeRows, 0);
+
+  tsQueryBufferSizePerQuery = 4;
+  SJoinResult spilled = runHashJoin(TSDB_DATA_TYPE_INT, buildKeys, probeKeys, valLen, false);
+  tsQueryBufferSizePerQuery = bufferSize;
+
+  // some build rows went to disk and the probe rows of their partitions with them
+  EXPECT_GT(spilled.spillBuildRows, 0);
+  EXPECT_LT(spilled.spillBuildRows, (int64_t)buildKeys.size());
+  EXPECT_GT(spilled.spillProbeRows, 0);
+
+  EXPECT_FALSE(inMem.rows.empty());
+  EXPECT_TRUE(spilled.rows == inMem.rows);
+  checkJoinResult(spilled, buildKeys, probeKeys);
+}
+
+TEST(hashJoinTest, keysPushedDownToScan) {
+  // the probe keys outside of the build keys are taken out by the scan, the result is the same
+  std::vector<int64_t> buildKeys, probeKeys;
+  for (int64_t i = 0; i < 500; ++i) buildKeys.push_back(1700000000000 + i * 4);
+  for (int64_t i = 0; i < 10000; ++i) probeKeys.push_back(1700000000000 - 5000 + i);
+
+  SJoinResult plain = runHashJoin(TSDB_DATA_TYPE_TIMESTAMP, buildKeys, probeKeys, 32, false);
+  EXPECT_EQ(plain.filterRows, -1);
+
+  SJoinResult pushed = runHashJoin(TSDB_DATA_TYPE_TIMESTAMP, buildKeys, probeKeys, 32, true);
+  EXPECT_GE(pushed.filterRows, (int64_t)probeKeys.size() - 2000);
+  EXPECT_LE(pushed.filterRows, (int64_t)probeKeys.size() - 500);
+
+  EXPECT_TRUE(pushed.rows == plain.rows);
+  checkJoinResult(pushed, buildKeys, probeKeys);
+}
+
+TEST(runtimeFilterTest, nullKeysAreKept) {
+  std::vector<int64_t>      keys = {10, 20, 30};
+  SScanRuntimeFilter*       pFilter = createRuntimeFilter(0, TSDB_DATA_TYPE_INT, keys);
+  std::vector<SSDataBlock*> blocks = createBlocks(TSDB_DATA_TYPE_INT, {5, 10, 0, 20, 25, 0, 30, 35}, 0, 8);
+
+  // the rows 2 and 5 have null keys
+  SColumnInfoData* pKey = (SColumnInfoData*)taosArrayGet(blocks[0]->pDataBlock, 0);
+  colDataSetNULL(pKey, 2);
+  colDataSetNULL(pKey, 5);
+
+  ASSERT_EQ(doFilterByRuntimeFilter(pFilter, blocks[0]), 0);
+  ASSERT_EQ(blocks[0]->info.rows, 5);
+  SColumnInfoData* pVal = (SColumnInfoData*)taosArrayGet(blocks[0]->pDataBlock, 1);
+  std::vector<int32_t> kept;
+  for (int32_t r = 0; r < blocks[0]->info.rows; ++r) kept.push_back(*(int32_t*)colDataGetData(pVal, r));
+  EXPECT_EQ(kept, std::vector<int32_t>({1, 2, 3, 5, 6}));
+  EXPECT_TRUE(colDataIsNull_s(pKey, 1));
+  EXPECT_TRUE(colDataIsNull_s(pKey, 3));
+  EXPECT_EQ(pFilter->filterRows, 3);
+
+  // a block of null keys only is not touched
+  SSDataBlock* pNulls = blocks[0];
+  for (int32_t r = 0; r < pNulls->info.rows; ++r) colDataSetNULL(pKey, r);
+  ASSERT_EQ(doFilterByRuntimeFilter(pFilter, pNulls), 0);
+  EXPECT_EQ(pNulls->info.rows, 5);
+  EXPECT_EQ(pFilter->filterRows, 3);
+
+  blockDataDestroy(pNulls);
+  destroyScanRuntimeFilter(pFilter);
+}
+
+TEST(runtimeFilterTest, tagKey) {
+  // the key is a tag, it is no column of the table, no block is skipped by a range but the rows are filtered
+  SExecTaskInfo* pTaskInfo = createTask();
+  std::vector<SSDataBlock*> blocks;
+  SOperatorInfo* pScan = createInputOperator(kProbeBlkId, blocks, true, pTaskInfo);
+  STableScanInfo* pInfo = (STableScanInfo*)pScan->info;
+
+  SScanRuntimeFilter* pFilter = createRuntimeFilter(2, TSDB_DATA_TYPE_INT, {100, 200});
+  ASSERT_TRUE(setTableScanRuntimeFilter(pScan, pFilter));
+  EXPECT_EQ(pFilter->colId, -1);
+
+  // a second filter is not taken
+  SScanRuntimeFilter* pOther = createRuntimeFilter(0, TSDB_DATA_TYPE_TIMESTAMP, {1});
+  EXPECT_FALSE(setTableScanRuntimeFilter(pScan, pOther));
+  destroyScanRuntimeFilter(pOther);
+
+  // all rows of a table share the tag, the block out of the key range is still loaded, its rows are dropped
+  SSDataBlock* pBlock = createTagBlock(300);
+  EXPECT_TRUE(doFilterByRuntimeFilterRange(&pInfo->base, pBlock, pTaskInfo));
+  ASSERT_EQ(doFilterByRuntimeFilter(pFilter, pBlock), 0);
+  EXPECT_EQ(pBlock->info.rows, 0);
+  EXPECT_EQ(pFilter->filterRows, 3);
+
+  // the rows of a table with a key tag are all kept
+  blockDataDestroy(pBlock);
+  pBlock = createTagBlock(200);
+  ASSERT_EQ(doFilterByRuntimeFilter(pFilter, pBlock), 0);
+  EXPECT_EQ(pBlock->info.rows, 3);
+
+  blockDataDestroy(pBlock);
+  destroyOperator(pScan);
+  doDestroyTask(pTaskInfo);
+}
+
+TEST(runtimeFilterTest, tsKeyAndColumnKey) {
+  SExecTaskInfo* pTaskInfo = createTask();
+  pTaskInfo->storageAPI.tsdReader.tsdReaderRetrieveBlockSMAInfo = (int32_t(*)())retrieveKeyAggStub;
+  std::vector<SSDataBlock*> blocks;
+  SOperatorInfo*  pScan = createInputOperator(kProbeBlkId, blocks, true, pTaskInfo);
+  STableScanInfo* pInfo = (STableScanInfo*)pScan->info;
+
+  // the primary timestamp key, blocks are checked by their time range
+  SScanRuntimeFilter* pFilter = createRuntimeFilter(0, TSDB_DATA_TYPE_TIMESTAMP, {1000, 1010, 1020});
+  ASSERT_TRUE(setTableScanRuntimeFilter(pScan, pFilter));
+  EXPECT_EQ(pFilter->colId, PRIMARYKEY_TIMESTAMP_COL_ID);
+
+  std::vector<SSDataBlock*> tsBlocks =
+      createBlocks(TSDB_DATA_TYPE_TIMESTAMP, {900, 950, 999, 990, 1000, 1005, 1011, 1015, 1021, 1030}, 0, 3);
+  EXPECT_FALSE(doFilterByRuntimeFilterRange(&pInfo->base, tsBlocks[0], pTaskInfo));  // 900 - 999
+  EXPECT_TRUE(doFilterByRuntimeFilterRange(&pInfo->base, tsBlocks[1], pTaskInfo));   // 990 - 1005
+  EXPECT_TRUE(doFilterByRuntimeFilterRange(&pInfo->base, tsBlocks[2], pTaskInfo));   // 1011 - 1021
+  EXPECT_FALSE(doFilterByRuntimeFilterRange(&pInfo->base, tsBlocks[3], pTaskInfo));  // 1030
+
+  // rows in the range but not among the keys are dropped
+  ASSERT_EQ(doFilterByRuntimeFilter(pFilter, tsBlocks[1]), 0);
+  ASSERT_EQ(tsBlocks[1]->info.rows, 1);
+  EXPECT_EQ(*(int64_t*)colDataGetData((SColumnInfoData*)taosArrayGet(tsBlocks[1]->pDataBlock, 0), 0), 1000);
+  for (SSDataBlock* pBlock : tsBlocks) blockDataDestroy(pBlock);
+
+  // a key of a normal column, blocks are checked by the SMA of the column if it has no null
+  destroyScanRuntimeFilter(pFilter);
+  pInfo->base.pRuntimeFilter = NULL;
+  pFilter = createRuntimeFilter(1, TSDB_DATA_TYPE_INT, {50, 60});
+  ASSERT_TRUE(setTableScanRuntimeFilter(pScan, pFilter));
+  EXPECT_EQ(pFilter->colId, 2);
+
+  SSDataBlock* pBlock = createBlocks(TSDB_DATA_TYPE_TIMESTAMP, {1, 2}, 0, 2)[0];
+  gKeyAgg = {.colId = 2, .numOfNull = 0, .sum = 0, .max = 49, .min = 0};
+  EXPECT_FALSE(doFilterByRuntimeFilterRange(&pInfo->base, pBlock, pTaskInfo));
+  EXPECT_EQ(pBlock->pBlockAgg, nullptr);
+  gKeyAgg = {.colId = 2, .numOfNull = 0, .sum = 0, .max = 55, .min = 40};
+  EXPECT_TRUE(doFilterByRuntimeFilterRange(&pInfo->base, pBlock, pTaskInfo));
+  gKeyAgg = {.colId = 2, .numOfNull = 1, .sum = 0, .max = 49, .min = 0};
+  EXPECT_TRUE(doFilterByRuntimeFilterRange(&pInfo->base, pBlock, pTaskInfo));
+
+  blockDataDestroy(pBlock);
+  destroyOperator(pScan);
+  doDestroyTask(pTaskInfo);
+}
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+const int16_t kInputBlkId = 1;
+const int16_t kResBlkId = 2;
+const int64_t kInterval = 10000;  // interval(10s) sliding(2s), each window is made of five panes
+const int64_t kSliding = 2000;
+const int64_t kStartTs = 1700000000000;
+
+struct SWinAgg {
+  int64_t count = 0;
+  int64_t sum = 0;
+  int32_t max = INT32_MIN;
+
+  bool operator==(const SWinAgg& o) const { return count == o.count && sum == o.sum && max == o.max; }
+};
+
+typedef std::map<std::pair<uint64_t, int64_t>, SWinAgg> SWinResult;  // (group id, window start) -> result
+
+struct SIntervalInput {
+  std::vector<SSDataBlock*> blocks;
+  size_t                    next;
+};
+
+SSDataBlock* getNextInputBlock(SOperatorInfo* pOperator) {
+  SIntervalInput* pInput = reinterpret_cast<SIntervalInput*>(pOperator->info);
+  return (pInput->next < pInput->blocks.size()) ? pInput->blocks[pInput->next++] : NULL;
+}
+
+void destroyInput(void* param) {
+  SIntervalInput* pInput = reinterpret_cast<SIntervalInput*>(param);
+  for (SSDataBlock* pBlock : pInput->blocks) blockDataDestroy(pBlock);
+  delete pInput;
+}
+
+SOperatorInfo* createInputOperator(const std::vector<SSDataBlock*>& blocks, SExecTaskInfo* pTaskInfo) {
+  SIntervalInput* pInput = new SIntervalInput();
+  pInput->blocks = blocks;
+  pInput->next = 0;
+
+  SOperatorInfo* pOperator = static_cast<SOperatorInfo*>(taosMemoryCalloc(1, sizeof(SOperatorInfo)));
+  setOperatorInfo(pOperator, "intervalInput", 0, false, OP_NOT_OPENED, pInput, pTaskInfo);
+  pOperator->resultDataBlockId = kInputBlkId;
+  pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, getNextInputBlock, NULL, destroyInput, optrDefaultBufFn,
+                                         NULL, optrDefaultGetNextExtFn, NULL);
+  return pOperator;
+}
+
+int32_t valueOf(int64_t ts) { return (int32_t)(ts % 997) - 400; }
+
+// a block of one group, the primary timestamp in slot 0 and an int value in slot 1
+SSDataBlock* createBlock(uint64_t groupId, const std::vector<int64_t>& ts) {
+  SSDataBlock*    pBlock = createDataBlock();
+  SColumnInfoData tsCol = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+  SColumnInfoData vCol = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 2);
+  blockDataAppendColInfo(pBlock, &tsCol);
+  blockDataAppendColInfo(pBlock, &vCol);
+  blockDataEnsureCapacity(pBlock, ts.size());
+
+  SColumnInfoData* pTs = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+  SColumnInfoData* pVal = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+  for (size_t i = 0; i < ts.size(); ++i) {
+    int32_t v = valueOf(ts[i]);
+    colDataSetVal(pTs, i, (const char*)&ts[i], false);
+    colDataSetVal(pVal, i, (const char*)&v, false);
+  }
+
+  pBlock->info.rows = ts.size();
+  pBlock->info.dataLoad = 1;
+  pBlock->info.id.groupId = groupId;
+  pBlock->info.window.skey = ts.front();
+  pBlock->info.window.ekey = ts.back();
+  return pBlock;
+}
+
+// the rows of one group every step ms, cut in blocks of rowsPerBlock rows
+std::vector<SSDataBlock*> createBlocks(uint64_t groupId, int32_t numOfRows, int64_t step, int32_t rowsPerBlock,
+                                       std::vector<int64_t>* pAllTs) {
+  std::vector<int64_t> ts;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    if ((i / 500) % 4 == 3) continue;  // a gap longer than the interval every 2000 rows
+    ts.push_back(kStartTs + 300 + i * step);
+  }
+  pAllTs->insert(pAllTs->end(), ts.begin(), ts.end());
+
+  std::vector<SSDataBlock*> blocks;
+  for (size_t start = 0; start < ts.size(); start += rowsPerBlock) {
+    size_t end = std::min(ts.size(), start + rowsPerBlock);
+    blocks.push_back(createBlock(groupId, std::vector<int64_t>(ts.begin() + start, ts.begin() + end)));
+  }
+  return blocks;
+}
+
+// the windows of the rows computed one row and window at a time
+void addExpected(SWinResult* pRes, uint64_t groupId, const std::vector<int64_t>& ts) {
+  for (int64_t t : ts) {
+    for (int64_t wstart = t - t % kSliding; wstart > t - kInterval; wstart -= kSliding) {
+      SWinAgg& agg = (*pRes)[std::make_pair(groupId, wstart)];
+      agg.count += 1;
+      agg.sum += valueOf(t);
+      agg.max = std::max(agg.max, valueOf(t));
+    }
+  }
+}
+
+SColumnNode* createColumn(int16_t slotId, int16_t colId, int8_t type, int32_t bytes) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->dataBlockId = kInputBlkId;
+  pCol->slotId = slotId;
+  pCol->colId = colId;
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = bytes;
+  pCol->node.resType.precision = TSDB_TIME_PRECISION_MILLI;
+  return pCol;
+}
+
+SFunctionNode* createFunction(const char* name, bool onValue) {
+  SFunctionNode* pFunc = (SFunctionNode*)nodesMakeNode(QUERY_NODE_FUNCTION);
+  tstrncpy(pFunc->functionName, name, sizeof(pFunc->functionName));
+  pFunc->node.resType.precision = TSDB_TIME_PRECISION_MILLI;
+  if (onValue) {
+    nodesListMakeAppend(&pFunc->pParameterList, (SNode*)createColumn(1, 2, TSDB_DATA_TYPE_INT, sizeof(int32_t)));
+  }
+
+  char msg[128] = {0};
+  EXPECT_EQ(fmGetFuncInfo(pFunc, msg, sizeof(msg)), 0) << name << ": " << msg;
+  return pFunc;
+}
+
+// select _wstart, count(v), sum(v), max(v) interval(10s) sliding(2s)
+SIntervalPhysiNode* createIntervalNode() {
+  SIntervalPhysiNode* pNode = (SIntervalPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_HASH_INTERVAL);
+  pNode->interval = kInterval;
+  pNode->sliding = kSliding;
+  pNode->intervalUnit = 's';
+  pNode->slidingUnit = 's';
+  pNode->window.node.inputTsOrder = ORDER_ASC;
+  pNode->window.node.outputTsOrder = ORDER_ASC;
+  pNode->window.pTspk = (SNode*)createColumn(0, PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t));
+
+  SFunctionNode* aFunc[4] = {createFunction("_wstart", false), createFunction("count", true),
+                             createFunction("sum", true), createFunction("max", true)};
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = kResBlkId;
+  for (int16_t i = 0; i < 4; ++i) {
+    SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+    pSlot->slotId = i;
+    pSlot->dataType = aFunc[i]->node.resType;
+    pSlot->output = true;
+    nodesListMakeAppend(&pDesc->pSlots, (SNode*)pSlot);
+
+    STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+    pTarget->dataBlockId = kResBlkId;
+    pTarget->slotId = i;
+    pTarget->pExpr = (SNode*)aFunc[i];
+    nodesListMakeAppend(&pNode->window.pFuncs, (SNode*)pTarget);
+  }
+  pNode->window.node.pOutputDataBlockDesc = pDesc;
+  return pNode;
+}
+
+struct SIntervalResult {
+  SWinResult windows;
+  bool       paneAgg = false;
+  int64_t    flushBytes = 0;  // bytes of the result buffer spilled to disk
+};
+
+SIntervalResult runInterval(const std::vector<SSDataBlock*>& blocks) {
+  SStorageAPI    api = {};
+  SExecTaskInfo* pTaskInfo = doCreateTask(0, 0, 0, OPTR_EXEC_MODEL_BATCH, &api);
+  pTaskInfo->window = {.skey = INT64_MIN, .ekey = INT64_MAX};
+
+  SIntervalPhysiNode* pNode = createIntervalNode();
+  SOperatorInfo*      pInterval = createIntervalOperatorInfo(createInputOperator(blocks, pTaskInfo), pNode, pTaskInfo);
+
+  SIntervalResult res;
+  EXPECT_NE(pInterval, nullptr);
+  if (pInterval == NULL) {
+    nodesDestroyNode((SNode*)pNode);
+    doDestroyTask(pTaskInfo);
+    return res;
+  }
+
+  SIntervalAggOperatorInfo* pInfo = (SIntervalAggOperatorInfo*)pInterval->info;
+  res.paneAgg = pInfo->paneAgg;
+
+  while (true) {
+    SSDataBlock* pBlock = pInterval->fpSet.getNextFn(pInterval);
+    if (pBlock == NULL) break;
+
+    SColumnInfoData* aCol[4];
+    for (int32_t i = 0; i < 4; ++i) aCol[i] = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, i);
+    for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+      SWinAgg agg;
+      agg.count = *(int64_t*)colDataGetData(aCol[1], r);
+      agg.sum = *(int64_t*)colDataGetData(aCol[2], r);
+      agg.max = *(int32_t*)colDataGetData(aCol[3], r);
+
+      auto key = std::make_pair(pBlock->info.id.groupId, *(int64_t*)colDataGetData(aCol[0], r));
+      EXPECT_EQ(res.windows.count(key), 0) << "group " << key.first << " window " << key.second;
+      res.windows[key] = agg;
+    }
+  }
+  res.flushBytes = getDBufStatis(pInfo->aggSup.pResultBuf).flushBytes;
+
+  destroyOperator(pInterval);
+  nodesDestroyNode((SNode*)pNode);
+  doDestroyTask(pTaskInfo);
+  return res;
+}
+
+void checkResult(const SIntervalResult& res, const SWinResult& expected) {
+  EXPECT_TRUE(res.paneAgg);
+  ASSERT_EQ(res.windows.size(), expected.size());
+  for (const auto& w : expected) {
+    auto it = res.windows.find(w.first);
+    ASSERT_NE(it, res.windows.end()) << "group " << w.first.first << " window " << w.first.second;
+    EXPECT_TRUE(it->second == w.second) << "group " << w.first.first << " window " << w.first.second << ": count "
+                                        << it->second.count << " sum " << it->second.sum << " max "
+                                        << it->second.max;
+  }
+}
+
+}  // namespace
+
+TEST(intervalPaneTest, panesAcrossBlocks) {
+  // a row every 700ms, the blocks of 333 rows end in the middle of the panes and of the windows
+  std::vector<int64_t>      ts;
+  std::vector<SSDataBlock*> blocks = createBlocks(1, 5000, 700, 333, &ts);
+
+  SWinResult expected;
+  addExpected(&expected, 1, ts);
+  checkResult(runInterval(blocks), expected);
+}
+
+TEST(intervalPaneTest, panesAcrossGroups) {
+  // the blocks of three groups come in turn, a pane of a group is continued after the blocks of the others
+  std::vector<std::vector<SSDataBlock*>> groupBlocks;
+  SWinResult                             expected;
+  for (uint64_t groupId = 1; groupId <= 3; ++groupId) {
+    std::vector<int64_t> ts;
+    groupBlocks.push_back(createBlocks(groupId, 4000, 300 * groupId + 100, 250, &ts));
+    addExpected(&expected, groupId, ts);
+  }
+
+  std::vector<SSDataBlock*> blocks;
+  for (size_t i = 0; i < groupBlocks[0].size(); ++i) {
+    for (const std::vector<SSDataBlock*>& b : groupBlocks) {
+      if (i < b.size()) blocks.push_back(b[i]);
+    }
+  }
+
+  checkResult(runInterval(blocks), expected);
+}
+
+TEST(intervalPaneTest, panesSpilled) {
+  // a row in each pane, the pane rows and the window rows do not fit in 1MB and are spilled with the result buffer
+  int32_t bufSize = tsQueryBufferSizePerQuery;
+  tsQueryBufferSizePerQuery = 1;
+
+  std::vector<int64_t>      ts;
+  std::vector<SSDataBlock*> blocks = createBlocks(1, 40000, kSliding, 4096, &ts);
+
+  SWinResult expected;
+  addExpected(&expected, 1, ts);
+  SIntervalResult res = runInterval(blocks);
+  tsQueryBufferSizePerQuery = bufSize;
+
+  EXPECT_GT(res.flushBytes, 0);
+  checkResult(res, expected);
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include "executorInt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+const int16_t kLeftBlkId = 1;
+const int16_t kRightBlkId = 2;
+const int16_t kResBlkId = 3;
+
+// the ts of a result row, and the index of its left and right input row
+typedef std::tuple<int64_t, int32_t, int32_t> SMergeJoinRow;
+
+SExecTaskInfo* createTask() {
+  SStorageAPI api = {};
+  return doCreateTask(0, 0, 0, OPTR_EXEC_MODEL_BATCH, &api);
+}
+
+// the blocks an input operator returns, they are kept until the operator is destroyed as the rows of a ts may be
+// referred to across blocks
+struct SMergeJoinInput {
+  std::vector<SSDataBlock*> blocks;
+  size_t                    next;
+};
+
+SSDataBlock* getNextInputBlock(SOperatorInfo* pOperator) {
+  SMergeJoinInput* pInput = reinterpret_cast<SMergeJoinInput*>(pOperator->info);
+  return pInput->next < pInput->blocks.size() ? pInput->blocks[pInput->next++] : NULL;
+}
+
+void destroyInput(void* param) {
+  SMergeJoinInput* pInput = reinterpret_cast<SMergeJoinInput*>(param);
+  for (SSDataBlock* pBlock : pInput->blocks) blockDataDestroy(pBlock);
+  delete pInput;
+}
+
+// blocks of the ts in slot 0 and the index of the row in the input in slot 1
+SOperatorInfo* createInputOperator(int16_t blkId, const std::vector<int64_t>& keys, int32_t rowsPerBlock,
+                                   SExecTaskInfo* pTaskInfo) {
+  SMergeJoinInput* pInput = new SMergeJoinInput();
+  pInput->next = 0;
+  for (size_t start = 0; start < keys.size(); start += rowsPerBlock) {
+    int32_t      rows = (int32_t)std::min(keys.size() - start, (size_t)rowsPerBlock);
+    SSDataBlock* pBlock = createDataBlock();
+
+    SColumnInfoData ts = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), 1);
+    SColumnInfoData idx = createColumnInfoData(TSDB_DATA_TYPE_INT, sizeof(int32_t), 2);
+    blockDataAppendColInfo(pBlock, &ts);
+    blockDataAppendColInfo(pBlock, &idx);
+    blockDataEnsureCapacity(pBlock, rows);
+    for (int32_t i = 0; i < rows; ++i) {
+      int32_t index = (int32_t)(start + i);
+      colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0), i, (const char*)&keys[index], false);
+      colDataSetVal((SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1), i, (const char*)&index, false);
+    }
+    pBlock->info.rows = rows;
+    pBlock->info.id.blockId = blkId;
+    pInput->blocks.push_back(pBlock);
+  }
+
+  SOperatorInfo* pOperator = static_cast<SOperatorInfo*>(taosMemoryCalloc(1, sizeof(SOperatorInfo)));
+  setOperatorInfo(pOperator, "mergeJoinInput", 0, false, OP_NOT_OPENED, pInput, pTaskInfo);
+  pOperator->resultDataBlockId = blkId;
+  pOperator->fpSet = createOperatorFpSet(optrDummyOpenFn, getNextInputBlock, NULL, destroyInput, optrDefaultBufFn,
+                                         NULL, optrDefaultGetNextExtFn, NULL);
+  return pOperator;
+}
+
+SColumnNode* createColumn(int16_t blkId, int16_t slotId, int8_t type, int32_t bytes) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->dataBlockId = blkId;
+  pCol->slotId = slotId;
+  pCol->node.resType.type = type;
+  pCol->node.resType.bytes = bytes;
+  return pCol;
+}
+
+// left.ts = right.ts, the result is the ts and the row index of each side
+SSortMergeJoinPhysiNode* createJoinNode(bool asc) {
+  SSortMergeJoinPhysiNode* pNode = (SSortMergeJoinPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_MERGE_JOIN);
+  pNode->joinType = JOIN_TYPE_INNER;
+  pNode->node.inputTsOrder = asc ? ORDER_ASC : ORDER_DESC;
+
+  SOperatorNode* pCond = (SOperatorNode*)nodesMakeNode(QUERY_NODE_OPERATOR);
+  pCond->opType = OP_TYPE_EQUAL;
+  pCond->pLeft = (SNode*)createColumn(kLeftBlkId, 0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t));
+  pCond->pRight = (SNode*)createColumn(kRightBlkId, 0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t));
+  pNode->pPrimKeyCond = (SNode*)pCond;
+
+  SColumnNode* aCol[4] = {createColumn(kLeftBlkId, 0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t)),
+                          createColumn(kLeftBlkId, 1, TSDB_DATA_TYPE_INT, sizeof(int32_t)),
+                          createColumn(kRightBlkId, 0, TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t)),
+                          createColumn(kRightBlkId, 1, TSDB_DATA_TYPE_INT, sizeof(int32_t))};
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  pDesc->dataBlockId = kResBlkId;
+  for (int16_t i = 0; i < 4; ++i) {
+    SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+    pSlot->slotId = i;
+    pSlot->dataType = aCol[i]->node.resType;
+    pSlot->output = true;
+    nodesListMakeAppend(&pDesc->pSlots, (SNode*)pSlot);
+
+    STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+    pTarget->dataBlockId = kResBlkId;
+    pTarget->slotId = i;
+    pTarget->pExpr = (SNode*)aCol[i];
+    nodesListMakeAppend(&pNode->pTargets, (SNode*)pTarget);
+  }
+  pNode->node.pOutputDataBlockDesc = pDesc;
+  return pNode;
+}
+
+// joins the keys in the order they are given, which is the input order
+std::vector<SMergeJoinRow> runMergeJoin(const std::vector<int64_t>& leftKeys, const std::vector<int64_t>& rightKeys,
+                                        int32_t leftRowsPerBlock, int32_t rightRowsPerBlock, bool asc) {
+  SExecTaskInfo* pTaskInfo = createTask();
+  SOperatorInfo* pDownstream[2] = {createInputOperator(kLeftBlkId, leftKeys, leftRowsPerBlock, pTaskInfo),
+                                   createInputOperator(kRightBlkId, rightKeys, rightRowsPerBlock, pTaskInfo)};
+
+  SSortMergeJoinPhysiNode* pNode = createJoinNode(asc);
+  SOperatorInfo*           pJoin = createMergeJoinOperatorInfo(pDownstream, 2, pNode, pTaskInfo);
+
+  std::vector<SMergeJoinRow> rows;
+  EXPECT_NE(pJoin, nullptr);
+  while (pJoin != NULL) {
+    SSDataBlock* pBlock = pJoin->fpSet.getNextFn(pJoin);
+    if (pBlock == NULL) break;
+
+    SColumnInfoData* aCol[4];
+    for (int32_t i = 0; i < 4; ++i) aCol[i] = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, i);
+    for (int32_t r = 0; r < pBlock->info.rows; ++r) {
+      int64_t ts = *(int64_t*)colDataGetData(aCol[0], r);
+      EXPECT_EQ(*(int64_t*)colDataGetData(aCol[2], r), ts);
+      rows.push_back(
+          SMergeJoinRow(ts, *(int32_t*)colDataGetData(aCol[1], r), *(int32_t*)colDataGetData(aCol[3], r)));
+    }
+  }
+
+  destroyOperator(pJoin);
+  nodesDestroyNode((SNode*)pNode);
+  doDestroyTask(pTaskInfo);
+  return rows;
+}
+
+// the result has the rows of a nested loop join, and it is in the input order
+void checkMergeJoin(const std::vector<int64_t>& leftKeys, const std::vector<int64_t>& rightKeys,
+                    int32_t leftRowsPerBlock, int32_t rightRowsPerBlock, bool asc) {
+  std::vector<SMergeJoinRow> rows = runMergeJoin(leftKeys, rightKeys, leftRowsPerBlock, rightRowsPerBlock, asc);
+  for (size_t i = 1; i < rows.size(); ++i) {
+    int64_t prev = std::get<0>(rows[i - 1]), ts = std::get<0>(rows[i]);
+    ASSERT_TRUE(asc ? prev <= ts : prev >= ts) << "row " << i;
+  }
+
+  std::vector<SMergeJoinRow> expected;
+  for (size_t l = 0; l < leftKeys.size(); ++l) {
+    for (size_t r = 0; r < rightKeys.size(); ++r) {
+      if (leftKeys[l] == rightKeys[r]) expected.push_back(SMergeJoinRow(leftKeys[l], (int32_t)l, (int32_t)r));
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  std::sort(expected.begin(), expected.end());
+  ASSERT_EQ(rows.size(), expected.size());
+  EXPECT_TRUE(rows == expected);
+}
+
+// the keys in the order of the input
+std::vector<int64_t> ordered(std::vector<int64_t> keys, bool asc) {
+  if (!asc) std::reverse(keys.begin(), keys.end());
+  return keys;
+}
+
+}  // namespace
+
+TEST(mergeJoinTest, uniqueTs) {
+  // every ts appears once on each side, the matches are emitted in bulk and go on across the blocks of each side,
+  // and across more than one result block
+  std::vector<int64_t> leftKeys, rightKeys;
+  for (int64_t i = 0; i < 20000; ++i) leftKeys.push_back(1700000000000 + i * 2);
+  for (int64_t i = 0; i < 15000; ++i) rightKeys.push_back(1700000000000 + i * 3);
+
+  for (bool asc : {true, false}) {
+    SCOPED_TRACE(asc ? "asc" : "desc");
+    checkMergeJoin(ordered(leftKeys, asc), ordered(rightKeys, asc), 1000, 777, asc);
+  }
+}
+
+TEST(mergeJoinTest, duplicateTs) {
+  // a ts repeated on the left side, on the right side or on both sides is joined as a range, one repeated 100 times
+  // on both sides gives more rows than a result block holds
+  std::vector<int64_t> leftKeys, rightKeys;
+  for (int64_t t = 0; t < 5000; ++t) {
+    int32_t nLeft = (t == 2500) ? 100 : (t % 7 == 0 ? 3 : 1);
+    int32_t nRight = (t == 2500) ? 100 : (t % 3 == 1 ? 0 : (t % 5 == 0 ? 2 : 1));
+    leftKeys.insert(leftKeys.end(), nLeft, 1700000000000 + t);
+    rightKeys.insert(rightKeys.end(), nRight, 1700000000000 + t);
+  }
+
+  for (bool asc : {true, false}) {
+    SCOPED_TRACE(asc ? "asc" : "desc");
+    checkMergeJoin(ordered(leftKeys, asc), ordered(rightKeys, asc), 64, 100, asc);
+  }
+}
+
+TEST(mergeJoinTest, matchesAcrossBlocks) {
+  // left blocks of 4 rows: [1 2 3 3] [3 3 4 5] [6 7 8 9], right blocks of 3 rows: [3 4 5] [6 7 7] [7 8 9]
+  // 3 runs across the left blocks, 7 across the right ones, 5 and 9 end a block on both sides
+  std::vector<int64_t> leftKeys = {1, 2, 3, 3, 3, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<int64_t> rightKeys = {3, 4, 5, 6, 7, 7, 7, 8, 9};
+
+  for (bool asc : {true, false}) {
+    SCOPED_TRACE(asc ? "asc" : "desc");
+    checkMergeJoin(ordered(leftKeys, asc), ordered(rightKeys, asc), 4, 3, asc);
+  }
+
+  // each row in a block of its own
+  checkMergeJoin(leftKeys, rightKeys, 1, 1, true);
+  checkMergeJoin(ordered(leftKeys, false), ordered(rightKeys, false), 1, 1, false);
+}
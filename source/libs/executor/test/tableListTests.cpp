@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+#include "executil.h"
+
+namespace {
+
+enum ETestGrouping { kOneGroup, kGroupPerTable, kGroupByGid };
+
+// a table list of the uids given, the gid of a table is uid % numOfGids when it is grouped by gid, the tables are
+// ordered by group and the offsets of the groups set, as a group sorted scan keeps them
+STableListInfo* createTableList(const std::vector<uint64_t>& uids, ETestGrouping grouping, int32_t numOfGids) {
+  std::vector<uint64_t> ordered = uids;
+  if (grouping == kGroupByGid) {
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [numOfGids](uint64_t a, uint64_t b) { return a % numOfGids < b % numOfGids; });
+  }
+
+  STableListInfo* pList = tableListCreate();
+  for (uint64_t uid : ordered) {
+    uint64_t gid = (grouping == kGroupPerTable) ? uid : ((grouping == kGroupByGid) ? uid % numOfGids : 0);
+    tableListAddTableInfo(pList, uid, gid);
+  }
+
+  if (grouping == kOneGroup) {
+    pList->numOfOuputGroups = 1;
+  } else if (grouping == kGroupPerTable) {
+    pList->oneTableForEachGroup = true;
+    pList->numOfOuputGroups = ordered.size();
+  } else {
+    std::vector<int32_t> offsets;
+    for (int32_t i = 0; i < (int32_t)ordered.size(); ++i) {
+      if (i == 0 || ordered[i] % numOfGids != ordered[i - 1] % numOfGids) offsets.push_back(i);
+    }
+    pList->numOfOuputGroups = offsets.size();
+    pList->groupOffset = (int32_t*)taosMemoryMalloc(sizeof(int32_t) * offsets.size());
+    std::copy(offsets.begin(), offsets.end(), pList->groupOffset);
+  }
+  return pList;
+}
+
+std::vector<uint64_t> uidsOf(const STableListInfo* pList) {
+  std::vector<uint64_t> uids;
+  for (int32_t i = 0; i < (int32_t)tableListGetSize(pList); ++i) uids.push_back(tableListGetInfo(pList, i)->uid);
+  return uids;
+}
+
+// each slice keeps the tables of its uids in the order they were listed, the map and the groups follow them
+void checkSlices(const std::vector<uint64_t>& uids, ETestGrouping grouping, int32_t numOfGids, int32_t numOfSlices) {
+  std::set<uint64_t> scanned;
+  for (int32_t sliceIdx = 0; sliceIdx < numOfSlices; ++sliceIdx) {
+    STableListInfo*       pList = createTableList(uids, grouping, numOfGids);
+    std::vector<uint64_t> listed = uidsOf(pList);
+    ASSERT_EQ(tableListSlice(pList, sliceIdx, numOfSlices), TSDB_CODE_SUCCESS);
+
+    std::vector<uint64_t> expected;
+    for (uint64_t uid : listed) {
+      if (uid % numOfSlices == sliceIdx) expected.push_back(uid);
+    }
+    std::vector<uint64_t> kept = uidsOf(pList);
+    if (grouping == kGroupByGid) {
+      std::sort(expected.begin(), expected.end());
+      std::sort(kept.begin(), kept.end());
+    }
+    ASSERT_EQ(kept, expected) << "slice " << sliceIdx;
+
+    for (uint64_t uid : uids) {
+      int32_t* pSlot = (int32_t*)taosHashGet(pList->map, &uid, sizeof(uid));
+      if (uid % numOfSlices == sliceIdx) {
+        ASSERT_NE(pSlot, nullptr) << "uid " << uid;
+        EXPECT_EQ(tableListGetInfo(pList, *pSlot)->uid, uid);
+        EXPECT_TRUE(scanned.insert(uid).second) << "uid " << uid;
+      } else {
+        EXPECT_EQ(pSlot, nullptr) << "uid " << uid;
+      }
+    }
+
+    int32_t numOfGroups = tableListGetOutputGroups(pList);
+    if (grouping == kOneGroup) {
+      EXPECT_EQ(numOfGroups, 1);
+    } else if (grouping == kGroupPerTable) {
+      EXPECT_EQ(numOfGroups, (int32_t)expected.size());
+    } else {
+      std::set<uint64_t> gids;
+      for (uint64_t uid : expected) gids.insert(uid % numOfGids);
+      EXPECT_EQ(numOfGroups, expected.empty() ? 1 : (int32_t)gids.size()) << "slice " << sliceIdx;
+    }
+
+    // the groups hold every table kept once, and the tables of a group share its gid
+    int32_t            numOfTables = 0;
+    std::set<uint64_t> groupIds;
+    for (int32_t g = 0; g < numOfGroups && !expected.empty(); ++g) {
+      STableKeyInfo* pKeyInfo = NULL;
+      int32_t        size = 0;
+      ASSERT_EQ(tableListGetGroupList(pList, g, &pKeyInfo, &size), TSDB_CODE_SUCCESS);
+      ASSERT_GT(size, 0);
+      for (int32_t i = 0; i < size; ++i) {
+        EXPECT_EQ(pKeyInfo[i].groupId, pKeyInfo[0].groupId) << "group " << g;
+      }
+      if (grouping != kOneGroup) EXPECT_TRUE(groupIds.insert(pKeyInfo[0].groupId).second) << "group " << g;
+      numOfTables += size;
+    }
+    EXPECT_EQ(numOfTables, (int32_t)expected.size()) << "slice " << sliceIdx;
+
+    tableListDestroy(pList);
+  }
+  EXPECT_EQ(scanned, std::set<uint64_t>(uids.begin(), uids.end()));
+}
+
+}  // namespace
+
+TEST(tableListTest, unevenSlices) {
+  // 10 tables in 3 slices of 3, 4 and 3 tables
+  std::vector<uint64_t> uids = {7, 2, 10, 5, 1, 9, 4, 8, 3, 6};
+  for (ETestGrouping grouping : {kOneGroup, kGroupPerTable, kGroupByGid}) {
+    checkSlices(uids, grouping, 4, 3);
+  }
+
+  STableListInfo* pList = createTableList(uids, kOneGroup, 0);
+  ASSERT_EQ(tableListSlice(pList, 1, 3), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(uidsOf(pList), std::vector<uint64_t>({7, 10, 1, 4}));
+  tableListDestroy(pList);
+}
+
+TEST(tableListTest, moreSlicesThanTables) {
+  // 3 tables in 8 slices, 5 of them get no table
+  std::vector<uint64_t> uids = {13, 6, 23};
+  for (ETestGrouping grouping : {kOneGroup, kGroupPerTable, kGroupByGid}) {
+    checkSlices(uids, grouping, 2, 8);
+  }
+
+  STableListInfo* pList = createTableList(uids, kGroupByGid, 2);
+  ASSERT_EQ(tableListSlice(pList, 0, 8), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(tableListGetSize(pList), 0);
+  EXPECT_EQ(tableListGetOutputGroups(pList), 1);
+  tableListDestroy(pList);
+}
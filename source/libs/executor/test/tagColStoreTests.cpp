@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "executil.h"
+#include "executorInt.h"
+#include "functionMgt.h"
+#include "operator.h"
+#include "querytask.h"
+#include "tdatablock.h"
+
+namespace {
+
+const uint64_t kSuid = 1000;
+const int16_t  kCidGid = 3;
+const int16_t  kCidLocation = 4;
+const int32_t  kLocationBytes = 16 + VARSTR_HEADER_SIZE;
+
+struct STestTable {
+  uint64_t    uid;
+  std::string name;
+  int32_t     gid;
+  bool        hasLocation;
+  std::string location;
+  STag*       pTag;
+};
+
+// the child tables of a super table with an int tag and a varchar tag, the tags are served by the tag blobs and, once
+// the store is on, by the column store as the meta does
+struct STestVnode {
+  std::vector<STestTable> tables;
+  bool                    storeOn = false;
+  int32_t                 storeCalls = 0;
+
+  explicit STestVnode(int32_t numOfTables) {
+    SArray* pTagVals = taosArrayInit(2, sizeof(STagVal));
+    for (int32_t i = 0; i < numOfTables; i++) {
+      STestTable t = {kSuid + 1 + i, "d" + std::to_string(i), i % 10, i % 5 != 0, "loc" + std::to_string(i % 7), NULL};
+
+      taosArrayClear(pTagVals);
+      STagVal gid = {.cid = kCidGid, .type = TSDB_DATA_TYPE_INT};
+      gid.i64 = t.gid;
+      taosArrayPush(pTagVals, &gid);
+      if (t.hasLocation) {
+        STagVal loc = {.cid = kCidLocation, .type = TSDB_DATA_TYPE_VARCHAR};
+        loc.pData = (uint8_t*)t.location.c_str();
+        loc.nData = t.location.size();
+        taosArrayPush(pTagVals, &loc);
+      }
+      EXPECT_EQ(tTagNew(pTagVals, 1, false, &t.pTag), 0);
+      tables.push_back(t);
+    }
+    taosArrayDestroy(pTagVals);
+  }
+
+  ~STestVnode() {
+    for (STestTable& t : tables) taosMemoryFree(t.pTag);
+  }
+
+  const STestTable* find(uint64_t uid) const {
+    if (uid <= kSuid || uid > kSuid + tables.size()) return NULL;
+    return &tables[uid - kSuid - 1];
+  }
+};
+
+void* copyTag(const STag* pTag) {
+  void* p = taosMemoryMalloc(pTag->len);
+  memcpy(p, pTag, pTag->len);
+  return p;
+}
+
+int32_t getTableTags(void* pVnode, uint64_t suid, SArray* pUidTagList) {
+  STestVnode* pTest = reinterpret_cast<STestVnode*>(pVnode);
+  if (taosArrayGetSize(pUidTagList) == 0) {
+    for (const STestTable& t : pTest->tables) {
+      STUidTagInfo info = {.uid = t.uid};
+      info.pTagVal = copyTag(t.pTag);
+      taosArrayPush(pUidTagList, &info);
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pUidTagList); i++) {
+    STUidTagInfo*     pInfo = (STUidTagInfo*)taosArrayGet(pUidTagList, i);
+    const STestTable* pTable = pTest->find(pInfo->uid);
+    if (pTable != NULL && pInfo->pTagVal == NULL) pInfo->pTagVal = copyTag(pTable->pTag);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t getTableTagsByUid(void* pVnode, int64_t suid, SArray* pUidTagList) {
+  return getTableTags(pVnode, suid, pUidTagList);
+}
+
+const void* extractTagVal(const void* pTag, int16_t type, STagVal* pVal) {
+  return tTagGet((const STag*)pTag, pVal) ? pVal : NULL;
+}
+
+int32_t getChildTableList(void* pVnode, int64_t suid, SArray* pUidList) {
+  for (const STestTable& t : reinterpret_cast<STestVnode*>(pVnode)->tables) taosArrayPush(pUidList, &t.uid);
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t getTableNameByUid(void* pVnode, uint64_t uid, char* tbName) {
+  const STestTable* pTable = reinterpret_cast<STestVnode*>(pVnode)->find(uid);
+  if (pTable == NULL) return TSDB_CODE_PAR_TABLE_NOT_EXIST;
+  STR_TO_VARSTR(tbName, pTable->name.c_str());
+  return TSDB_CODE_SUCCESS;
+}
+
+// the tables in pUidTagList, or all child tables appended to it, column by column
+int32_t getTableTagCols(void* pVnode, uint64_t suid, SArray* pUidTagList, SSDataBlock* pBlock) {
+  STestVnode* pTest = reinterpret_cast<STestVnode*>(pVnode);
+  pTest->storeCalls += 1;
+  if (!pTest->storeOn) {
+    return TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+  if (taosArrayGetSize(pUidTagList) == 0) {
+    for (const STestTable& t : pTest->tables) {
+      STUidTagInfo info = {.uid = t.uid};
+      taosArrayPush(pUidTagList, &info);
+    }
+  }
+
+  int32_t numOfRows = taosArrayGetSize(pUidTagList);
+  EXPECT_EQ(blockDataEnsureCapacity(pBlock, numOfRows), 0);
+  char buf[TSDB_TABLE_NAME_LEN + VARSTR_HEADER_SIZE] = {0};
+  for (int32_t row = 0; row < numOfRows; row++) {
+    const STestTable* pTable = pTest->find(((STUidTagInfo*)taosArrayGet(pUidTagList, row))->uid);
+    if (pTable == NULL) return TSDB_CODE_OPS_NOT_SUPPORT;
+
+    for (int32_t j = 0; j < taosArrayGetSize(pBlock->pDataBlock); j++) {
+      SColumnInfoData* pCol = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, j);
+      if (pCol->info.colId == -1) {
+        STR_TO_VARSTR(buf, pTable->name.c_str());
+        colDataSetVal(pCol, row, buf, false);
+      } else if (pCol->info.colId == kCidGid) {
+        colDataSetVal(pCol, row, (const char*)&pTable->gid, false);
+      } else if (pCol->info.colId == kCidLocation && pTable->hasLocation) {
+        STR_TO_VARSTR(buf, pTable->location.c_str());
+        colDataSetVal(pCol, row, buf, false);
+      } else if (pCol->info.colId == kCidLocation) {
+        colDataSetNULL(pCol, row);
+      } else {
+        return TSDB_CODE_OPS_NOT_SUPPORT;
+      }
+    }
+  }
+  pBlock->info.rows = numOfRows;
+  return TSDB_CODE_SUCCESS;
+}
+
+void initReader(SMetaReader* pReader, void* pVnode, int32_t flags, SStoreMeta* pAPI) {
+  memset(pReader, 0, sizeof(*pReader));
+  pReader->pMeta = pVnode;
+}
+
+void clearReader(SMetaReader* pReader) {}
+
+int32_t getTableEntryByUid(SMetaReader* pReader, tb_uid_t uid) {
+  const STestTable* pTable = reinterpret_cast<STestVnode*>(pReader->pMeta)->find(uid);
+  if (pTable == NULL) {
+    terrno = TSDB_CODE_PAR_TABLE_NOT_EXIST;
+    return terrno;
+  }
+  pReader->me.uid = uid;
+  pReader->me.type = TSDB_CHILD_TABLE;
+  pReader->me.name = (char*)pTable->name.c_str();
+  pReader->me.ctbEntry.suid = kSuid;
+  pReader->me.ctbEntry.pTags = (uint8_t*)pTable->pTag;
+  return TSDB_CODE_SUCCESS;
+}
+
+SExecTaskInfo* createTask() {
+  SStorageAPI api = {};
+  api.metaFn.getTableTags = getTableTags;
+  api.metaFn.getTableTagsByUid = getTableTagsByUid;
+  api.metaFn.getTableTagCols = getTableTagCols;
+  api.metaFn.extractTagVal = extractTagVal;
+  api.metaFn.getTableNameByUid = getTableNameByUid;
+  api.metaFn.getChildTableList = getChildTableList;
+  api.metaReaderFn.initReader = initReader;
+  api.metaReaderFn.clearReader = clearReader;
+  api.metaReaderFn.getTableEntryByUid = getTableEntryByUid;
+  return doCreateTask(0, 0, 0, OPTR_EXEC_MODEL_BATCH, &api);
+}
+
+SColumnNode* createTagColumn(int16_t colId) {
+  SColumnNode* pCol = (SColumnNode*)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->colId = colId;
+  pCol->colType = COLUMN_TYPE_TAG;
+  pCol->node.resType.type = (colId == kCidGid) ? TSDB_DATA_TYPE_INT : TSDB_DATA_TYPE_VARCHAR;
+  pCol->node.resType.bytes = (colId == kCidGid) ? sizeof(int32_t) : kLocationBytes;
+  return pCol;
+}
+
+SNode* createCompare(EOperatorType type, int16_t colId, SValueNode* pValue) {
+  SOperatorNode* pOp = (SOperatorNode*)nodesMakeNode(QUERY_NODE_OPERATOR);
+  pOp->opType = type;
+  pOp->node.resType.type = TSDB_DATA_TYPE_BOOL;
+  pOp->node.resType.bytes = sizeof(bool);
+  pOp->pLeft = (SNode*)createTagColumn(colId);
+  pOp->pRight = (SNode*)pValue;
+  return (SNode*)pOp;
+}
+
+// gid > 4 and location = 'loc3'
+SNode* createTagCond() {
+  SValueNode* pGid = (SValueNode*)nodesMakeNode(QUERY_NODE_VALUE);
+  pGid->node.resType.type = TSDB_DATA_TYPE_INT;
+  pGid->node.resType.bytes = sizeof(int32_t);
+  pGid->datum.i = 4;
+
+  SValueNode* pLoc = (SValueNode*)nodesMakeNode(QUERY_NODE_VALUE);
+  pLoc->node.resType.type = TSDB_DATA_TYPE_VARCHAR;
+  pLoc->node.resType.bytes = kLocationBytes;
+  pLoc->datum.p = (char*)taosMemoryCalloc(1, kLocationBytes);
+  STR_TO_VARSTR(pLoc->datum.p, "loc3");
+
+  SLogicConditionNode* pCond = (SLogicConditionNode*)nodesMakeNode(QUERY_NODE_LOGIC_CONDITION);
+  pCond->condType = LOGIC_COND_TYPE_AND;
+  pCond->node.resType.type = TSDB_DATA_TYPE_BOOL;
+  pCond->node.resType.bytes = sizeof(bool);
+  nodesListMakeAppend(&pCond->pParameterList, createCompare(OP_TYPE_GREATER_THAN, kCidGid, pGid));
+  nodesListMakeAppend(&pCond->pParameterList, createCompare(OP_TYPE_EQUAL, kCidLocation, pLoc));
+  return (SNode*)pCond;
+}
+
+SNodeList* createGroupTags() {
+  SNodeList* pGroup = NULL;
+  nodesListMakeAppend(&pGroup, (SNode*)createTagColumn(kCidGid));
+  nodesListMakeAppend(&pGroup, (SNode*)createTagColumn(kCidLocation));
+  return pGroup;
+}
+
+// the table list of a scan of the super table, with the tag condition and grouped by both tags if asked for, as the
+// uid and group id of each table
+std::map<uint64_t, uint64_t> createTableList(STestVnode* pVnode, bool withCond, bool withGroup) {
+  SExecTaskInfo* pTaskInfo = createTask();
+  SNode*         pTagCond = withCond ? createTagCond() : NULL;
+  SNodeList*     pGroupTags = withGroup ? createGroupTags() : NULL;
+  SScanPhysiNode scanNode = {};
+  scanNode.suid = kSuid;
+  scanNode.uid = kSuid;
+  scanNode.tableType = TSDB_SUPER_TABLE;
+
+  SReadHandle handle = {};
+  handle.vnode = pVnode;
+  STableListInfo* pListInfo = tableListCreate();
+  EXPECT_EQ(createScanTableListInfo(&scanNode, pGroupTags, false, &handle, pListInfo, pTagCond, NULL, pTaskInfo), 0);
+
+  std::map<uint64_t, uint64_t> tables;
+  for (int32_t i = 0; i < tableListGetSize(pListInfo); i++) {
+    STableKeyInfo* pInfo = tableListGetInfo(pListInfo, i);
+    tables[pInfo->uid] = pInfo->groupId;
+  }
+
+  tableListDestroy(pListInfo);
+  nodesDestroyList(pGroupTags);
+  nodesDestroyNode(pTagCond);
+  doDestroyTask(pTaskInfo);
+  return tables;
+}
+
+typedef std::tuple<std::string, int32_t, bool, std::string> STagRow;  // tbname, gid, location is set, location
+
+STargetNode* createTarget(int16_t slotId, SNode* pExpr, SDataBlockDescNode* pDesc) {
+  SSlotDescNode* pSlot = (SSlotDescNode*)nodesMakeNode(QUERY_NODE_SLOT_DESC);
+  pSlot->slotId = slotId;
+  pSlot->dataType = ((SExprNode*)pExpr)->resType;
+  pSlot->output = true;
+  nodesListMakeAppend(&pDesc->pSlots, (SNode*)pSlot);
+
+  STargetNode* pTarget = (STargetNode*)nodesMakeNode(QUERY_NODE_TARGET);
+  pTarget->slotId = slotId;
+  pTarget->pExpr = pExpr;
+  return pTarget;
+}
+
+// select tbname, gid, location from the super table, each block returned is checked to hold no more than capacity
+std::vector<STagRow> tagScan(STestVnode* pVnode, int32_t* pNumOfBlocks) {
+  SExecTaskInfo* pTaskInfo = createTask();
+
+  STagScanPhysiNode* pNode = (STagScanPhysiNode*)nodesMakeNode(QUERY_NODE_PHYSICAL_PLAN_TAG_SCAN);
+  pNode->scan.suid = kSuid;
+  pNode->scan.uid = kSuid;
+  pNode->scan.tableType = TSDB_SUPER_TABLE;
+
+  SFunctionNode* pTbName = (SFunctionNode*)nodesMakeNode(QUERY_NODE_FUNCTION);
+  tstrncpy(pTbName->functionName, "tbname", sizeof(pTbName->functionName));
+  char msg[128] = {0};
+  EXPECT_EQ(fmGetFuncInfo(pTbName, msg, sizeof(msg)), 0) << msg;
+
+  SDataBlockDescNode* pDesc = (SDataBlockDescNode*)nodesMakeNode(QUERY_NODE_DATABLOCK_DESC);
+  nodesListMakeAppend(&pNode->scan.pScanPseudoCols, (SNode*)createTarget(0, (SNode*)pTbName, pDesc));
+  nodesListMakeAppend(&pNode->scan.pScanPseudoCols, (SNode*)createTarget(1, (SNode*)createTagColumn(kCidGid), pDesc));
+  nodesListMakeAppend(&pNode->scan.pScanPseudoCols,
+                      (SNode*)createTarget(2, (SNode*)createTagColumn(kCidLocation), pDesc));
+  pNode->scan.node.pOutputDataBlockDesc = pDesc;
+
+  STableListInfo* pListInfo = tableListCreate();
+  pListInfo->idInfo.suid = kSuid;
+  for (const STestTable& t : pVnode->tables) tableListAddTableInfo(pListInfo, t.uid, 0);
+
+  SReadHandle    handle = {};
+  handle.vnode = pVnode;
+  SOperatorInfo* pOperator = createTagScanOperatorInfo(&handle, pNode, pListInfo, NULL, NULL, pTaskInfo);
+
+  std::vector<STagRow> rows;
+  *pNumOfBlocks = 0;
+  while (pOperator != NULL) {
+    SSDataBlock* pBlock = pOperator->fpSet.getNextFn(pOperator);
+    if (pBlock == NULL) break;
+
+    *pNumOfBlocks += 1;
+    EXPECT_LE(pBlock->info.rows, pOperator->resultInfo.capacity);
+    SColumnInfoData* pName = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 0);
+    SColumnInfoData* pGid = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 1);
+    SColumnInfoData* pLoc = (SColumnInfoData*)taosArrayGet(pBlock->pDataBlock, 2);
+    for (int32_t i = 0; i < pBlock->info.rows; i++) {
+      char*       name = colDataGetData(pName, i);
+      bool        hasLocation = !colDataIsNull_s(pLoc, i);
+      std::string location;
+      if (hasLocation) location.assign(varDataVal(colDataGetData(pLoc, i)), varDataLen(colDataGetData(pLoc, i)));
+      rows.push_back(STagRow(std::string(varDataVal(name), varDataLen(name)), *(int32_t*)colDataGetData(pGid, i),
+                             hasLocation, location));
+    }
+  }
+  EXPECT_EQ(pTaskInfo->code, 0);
+
+  destroyOperator(pOperator);
+  nodesDestroyNode((SNode*)pNode);
+  doDestroyTask(pTaskInfo);
+  return rows;
+}
+
+}  // namespace
+
+TEST(tagColStoreTest, filterByTagCond) {
+  STestVnode vnode(1000);
+
+  std::map<uint64_t, uint64_t> expect;
+  for (const STestTable& t : vnode.tables) {
+    if (t.gid > 4 && t.hasLocation && t.location == "loc3") expect[t.uid] = 0;
+  }
+  ASSERT_FALSE(expect.empty());
+
+  // the tags are read from the blobs while the store does not serve them
+  EXPECT_EQ(createTableList(&vnode, true, false), expect);
+  EXPECT_EQ(vnode.storeCalls, 1);
+
+  vnode.storeOn = true;
+  EXPECT_EQ(createTableList(&vnode, true, false), expect);
+  EXPECT_EQ(vnode.storeCalls, 2);
+}
+
+TEST(tagColStoreTest, groupByTags) {
+  STestVnode vnode(1000);
+
+  std::map<uint64_t, uint64_t> fromBlobs = createTableList(&vnode, false, true);
+  vnode.storeOn = true;
+  std::map<uint64_t, uint64_t> fromStore = createTableList(&vnode, false, true);
+  EXPECT_EQ(vnode.storeCalls, 2);
+  ASSERT_EQ(fromBlobs.size(), vnode.tables.size());
+  EXPECT_EQ(fromStore, fromBlobs);
+
+  // the tables of the same tags, and only they, are in one group
+  std::map<std::tuple<int32_t, bool, std::string>, uint64_t> groupOfTags;
+  for (const STestTable& t : vnode.tables) {
+    auto key = std::make_tuple(t.gid, t.hasLocation, t.location);
+    if (groupOfTags.count(key) == 0) groupOfTags[key] = fromStore[t.uid];
+    EXPECT_EQ(fromStore[t.uid], groupOfTags[key]) << t.name;
+  }
+  std::vector<uint64_t> groupIds;
+  for (auto& it : groupOfTags) groupIds.push_back(it.second);
+  std::sort(groupIds.begin(), groupIds.end());
+  EXPECT_EQ(std::unique(groupIds.begin(), groupIds.end()), groupIds.end());
+
+  // both together, the qualified tables are grouped from the store
+  vnode.storeCalls = 0;
+  std::map<uint64_t, uint64_t> filtered = createTableList(&vnode, true, true);
+  EXPECT_EQ(vnode.storeCalls, 2);
+  EXPECT_FALSE(filtered.empty());
+  for (auto& it : filtered) EXPECT_EQ(it.second, fromStore[it.first]);
+}
+
+TEST(tagColStoreTest, tagScan) {
+  // more tables than the capacity of a block, the store serves the table list a block at a time
+  STestVnode vnode(5000);
+
+  std::vector<STagRow> expect;
+  for (const STestTable& t : vnode.tables) {
+    expect.push_back(STagRow(t.name, t.gid, t.hasLocation, t.hasLocation ? t.location : ""));
+  }
+
+  int32_t numOfBlocks = 0;
+  EXPECT_EQ(tagScan(&vnode, &numOfBlocks), expect);
+  EXPECT_EQ(numOfBlocks, 2);
+
+  vnode.storeOn = true;
+  vnode.storeCalls = 0;
+  EXPECT_EQ(tagScan(&vnode, &numOfBlocks), expect);
+  EXPECT_EQ(numOfBlocks, 2);
+  EXPECT_EQ(vnode.storeCalls, 2);
+}
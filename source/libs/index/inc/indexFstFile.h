@@ -22,8 +22,6 @@
 extern "C" {
 #endif
 
-//#define USE_MMAP 1
-
 #define DefaultMem 1024 * 1024
 
 static char tmpFile[] = "./index";
@@ -49,9 +47,7 @@ typedef struct IFileCtx {
       int32_t wBufOffset;
       int32_t wBufCap;
 
-#ifdef USE_MMAP
-      char* ptr;
-#endif
+      char* ptr;  // read-only mapping of the whole file, NULL if not mapped
     } file;
     struct {
       int32_t cap;
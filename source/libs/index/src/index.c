@@ -164,13 +164,25 @@ void indexDestroy(void* handle) {
 void indexClose(SIndex* sIdx) {
   bool ref = 0;
   if (sIdx->colObj != NULL) {
-    void* iter = taosHashIterate(sIdx->colObj, NULL);
+    // schedule all the columns first, so that their tfiles are built in parallel by the index threads
+    int32_t nMerge = 0;
+    void*   iter = taosHashIterate(sIdx->colObj, NULL);
     while (iter) {
       IndexCache** pCache = iter;
       idxCacheForceToMerge((void*)(*pCache));
       indexInfo("%s wait to merge", (*pCache)->colName);
+      nMerge++;
+      iter = taosHashIterate(sIdx->colObj, iter);
+    }
+
+    for (int32_t i = 0; i < nMerge; i++) {
       indexWait((void*)(sIdx));
-      indexInfo("%s finish to wait", (*pCache)->colName);
+    }
+    indexInfo("suid %" PRIu64 " finish to wait %d merges", sIdx->suid, nMerge);
+
+    iter = taosHashIterate(sIdx->colObj, NULL);
+    while (iter) {
+      IndexCache** pCache = iter;
       iter = taosHashIterate(sIdx->colObj, iter);
       idxCacheUnRef(*pCache);
     }
@@ -81,12 +81,12 @@ static FORCE_INLINE int idxFileCtxDoWrite(IFileCtx* ctx, uint8_t* buf, int len)
 static FORCE_INLINE int idxFileCtxDoRead(IFileCtx* ctx, uint8_t* buf, int len) {
   int nRead = 0;
   if (ctx->type == TFILE) {
-#ifdef USE_MMAP
-    nRead = len < ctx->file.size ? len : ctx->file.size;
-    memcpy(buf, ctx->file.ptr, nRead);
-#else
-    nRead = taosReadFile(ctx->file.pFile, buf, len);
-#endif
+    if (ctx->file.ptr != NULL) {
+      nRead = TMAX(0, TMIN(len, ctx->file.size - ctx->offset));
+      memcpy(buf, ctx->file.ptr + ctx->offset, nRead);
+    } else {
+      nRead = taosReadFile(ctx->file.pFile, buf, len);
+    }
   } else {
     memcpy(buf, ctx->mem.buf + ctx->offset, len);
   }
@@ -102,6 +102,13 @@ static int idxFileCtxDoReadFrom(IFileCtx* ctx, uint8_t* buf, int len, int32_t of
 
   if (offset >= ctx->file.size) return 0;
 
+  if (ctx->file.ptr != NULL) {
+    // mapped file, the page cache keeps the hot blocks
+    total = TMIN(len, ctx->file.size - offset);
+    memcpy(buf, ctx->file.ptr + offset, total);
+    return total;
+  }
+
   do {
     char key[1024] = {0};
     ASSERT(strlen(ctx->file.buf) + 1 + 64 < sizeof(key));
@@ -161,9 +168,8 @@ static FORCE_INLINE int idxFileCtxGetSize(IFileCtx* ctx) {
     if (ctx->file.readOnly == false) {
       return ctx->offset;
     } else {
-      int64_t file_size = 0;
-      taosStatFile(ctx->file.buf, &file_size, NULL, NULL);
-      return (int)file_size;
+      // tfile is immutable once written
+      return (int)ctx->file.size;
     }
   }
   return 0;
@@ -212,9 +218,8 @@ IFileCtx* idxFileCtxCreate(WriterType type, const char* path, bool readOnly, int
 
       ctx->file.wBufOffset = 0;
 
-#ifdef USE_MMAP
-      ctx->file.ptr = (char*)tfMmapReadOnly(ctx->file.pFile, ctx->file.size);
-#endif
+      // fall back to block reads through the lru if the file cannot be mapped
+      ctx->file.ptr = (char*)taosMmapReadOnlyFile(ctx->file.pFile, ctx->file.size);
     }
     if (ctx->file.pFile == NULL) {
       indexError("failed to open file, error %d", errno);
@@ -254,9 +259,8 @@ void idxFileCtxDestroy(IFileCtx* ctx, bool remove) {
     taosMemoryFreeClear(ctx->file.wBuf);
     taosCloseFile(&ctx->file.pFile);
     if (ctx->file.readOnly) {
-#ifdef USE_MMAP
-      munmap(ctx->file.ptr, ctx->file.size);
-#endif
+      taosMunmapFile(ctx->file.ptr, ctx->file.size);
+      ctx->file.ptr = NULL;
     }
     if (remove) {
       unlink(ctx->file.buf);
@@ -35,7 +35,7 @@ static void initLog() {
   const int32_t maxLogFileNum = 10;
 
   tsAsyncLog = 0;
-  idxDebugFlag = 143;
+  idxDebugFlag = 131;
   strcpy(tsLogDir, logDir.c_str());
   taosRemoveDir(tsLogDir);
   taosMkDir(tsLogDir);
@@ -56,24 +56,19 @@ class Idx {
     path += _path;
   }
   int SetUp(bool remove) {
-    initLog();
-
     if (remove) taosRemoveDir(path.c_str());
-
-    int ret = indexJsonOpen(&opts, path.c_str(), &index);
-    return ret;
+    taosMkDir(path.c_str());
+    return indexOpen(&opts, path.c_str(), &index);
   }
   int Write(WriteBatch *batch, uint64_t uid) {
     // write batch
-    indexJsonPut(index, batch->terms, uid);
-    return 0;
-  }
-  int Read(const char *json, void *key, int64_t *id) {
-    // read batch
+    indexPut(index, batch->terms, uid);
     return 0;
   }
+  int Read(const char *colName, const char *colVal, SArray *result);
 
-  void TearDown() { indexJsonClose(index); }
+  // close flushes the cache of every column into its tfile
+  void TearDown() { indexClose(index); }
 
   std::string path;
 
@@ -94,20 +89,26 @@ SIndexTerm *indexTermCreateT(int64_t suid, SIndexOperOnColumn oper, uint8_t colT
   }
   return NULL;
 }
-int initWriteBatch(WriteBatch *wb, int batchSize) {
-  SIndexMultiTerm *terms = indexMultiTermCreate();
 
-  std::string colName;
-  std::string colVal;
+int Idx::Read(const char *colName, const char *colVal, SArray *result) {
+  SIndexMultiTermQuery *mq = indexMultiTermQueryCreate(MUST);
+  SIndexTerm *q = indexTermCreateT(0, ADD_VALUE, TSDB_DATA_TYPE_BINARY, colName, strlen(colName), colVal, strlen(colVal));
+  indexMultiTermQueryAdd(mq, q, QUERY_TERM);
+  int ret = indexSearch(index, mq, result);
+  indexMultiTermQueryDestroy(mq);
+  return ret;
+}
+
+static std::string benchColName(int col) { return "tag" + std::to_string(col); }
+static std::string benchColVal(int col, int val) { return "val_" + std::to_string(col) + "_" + std::to_string(val); }
 
-  for (int i = 0; i < 64; i++) {
-    colName += '0' + i;
-    colVal += '0' + i;
-  }
+// each table puts one value for each of nCols tag columns, drawn from nVals distinct values
+int initWriteBatch(WriteBatch *wb, int nCols, int nVals, uint64_t uid) {
+  SIndexMultiTerm *terms = indexMultiTermCreate();
 
-  for (int i = 0; i < batchSize; i++) {
-    colVal[i % colVal.size()] = '0' + i % 128;
-    colName[i % colName.size()] = '0' + i % 128;
+  for (int i = 0; i < nCols; i++) {
+    std::string colName = benchColName(i);
+    std::string colVal = benchColVal(i, (uid * (i + 1)) % nVals);
     SIndexTerm *term = indexTermCreateT(0, ADD_VALUE, TSDB_DATA_TYPE_BINARY, colName.c_str(), colName.size(),
                                         colVal.c_str(), colVal.size());
     indexMultiTermAdd(terms, term);
@@ -117,24 +118,72 @@ int initWriteBatch(WriteBatch *wb, int batchSize) {
   return 0;
 }
 
-int BenchWrite(Idx *idx, int batchSize, int limit) {
-  for (int i = 0; i < limit; i += batchSize) {
+int BenchWrite(Idx *idx, int nCols, int nVals, int nTables) {
+  int64_t st = taosGetTimestampUs();
+  for (int i = 0; i < nTables; i++) {
     WriteBatch wb;
+    initWriteBatch(&wb, nCols, nVals, i);
     idx->Write(&wb, i);
+    indexMultiTermDestroy(wb.terms);
   }
+  int64_t put = taosGetTimestampUs() - st;
+
+  // build the tfiles of all columns
+  st = taosGetTimestampUs();
+  idx->TearDown();
+  int64_t build = taosGetTimestampUs() - st;
+
+  printf("write %d tables x %d cols: put %.2f terms/s, build tfile %" PRId64 "ms, %.2f terms/s\n", nTables, nCols,
+         (double)nTables * nCols * 1000000 / TMAX(put, 1), build / 1000,
+         (double)nTables * nCols * 1000000 / TMAX(build, 1));
   return 0;
 }
 
-int BenchRead(Idx *idx) { return 0; }
-
-int main() {
-  // Idx *idx = new Idx;
-  // if (idx->SetUp(true) != 0) {
-  //   std::cout << "failed to setup index" << std::endl;
-  //   return 0;
-  // } else {
-  //   std::cout << "succ to setup index" << std::endl;
-  // }
-  //  BenchWrite(idx, 100, 10000);
-  return 1;
+int BenchRead(Idx *idx, int nCols, int nVals, int nQuery) {
+  SArray *result = taosArrayInit(1024, sizeof(uint64_t));
+  int64_t nFound = 0;
+
+  int64_t st = taosGetTimestampUs();
+  for (int i = 0; i < nQuery; i++) {
+    int         col = i % nCols;
+    std::string colName = benchColName(col);
+    std::string colVal = benchColVal(col, (i * 7) % nVals);
+    taosArrayClear(result);
+    idx->Read(colName.c_str(), colVal.c_str(), result);
+    nFound += taosArrayGetSize(result);
+  }
+  int64_t cost = taosGetTimestampUs() - st;
+  taosArrayDestroy(result);
+
+  printf("lookup %d terms: %.2f lookups/s, %.2f uids/s, avg %.2fus\n", nQuery, (double)nQuery * 1000000 / TMAX(cost, 1),
+         (double)nFound * 1000000 / TMAX(cost, 1), (double)cost / TMAX(nQuery, 1));
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  int nCols = argc > 1 ? atoi(argv[1]) : 8;
+  int nTables = argc > 2 ? atoi(argv[2]) : 100000;
+  int nVals = argc > 3 ? atoi(argv[3]) : 1000;
+  int nQuery = argc > 4 ? atoi(argv[4]) : 100000;
+
+  initLog();
+
+  Idx *idx = new Idx;
+  if (idx->SetUp(true) != 0) {
+    std::cout << "failed to setup index" << std::endl;
+    return 1;
+  }
+  BenchWrite(idx, nCols, nVals, nTables);
+
+  // reopen from the tfiles only, lookups are served by the mapped files
+  if (idx->SetUp(false) != 0) {
+    std::cout << "failed to reopen index" << std::endl;
+    return 1;
+  }
+  BenchRead(idx, nCols, nVals, nQuery);
+  idx->TearDown();
+
+  delete idx;
+  indexCleanup();
+  return 0;
 }
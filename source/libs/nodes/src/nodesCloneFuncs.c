@@ -422,6 +422,8 @@ static int32_t logicScanCopy(const SScanLogicNode* pSrc, SScanLogicNode* pDst) {
   COPY_SCALAR_FIELD(igLastNull);
   COPY_SCALAR_FIELD(groupOrderScan);
   COPY_SCALAR_FIELD(onlyMetaCtbIdx);
+  COPY_SCALAR_FIELD(tableSliceIdx);
+  COPY_SCALAR_FIELD(tableSliceNum);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -633,6 +635,8 @@ static int32_t physiTableScanCopy(const STableScanPhysiNode* pSrc, STableScanPhy
   COPY_SCALAR_FIELD(triggerType);
   COPY_SCALAR_FIELD(watermark);
   COPY_SCALAR_FIELD(igExpired);
+  COPY_SCALAR_FIELD(tableSliceIdx);
+  COPY_SCALAR_FIELD(tableSliceNum);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -51,6 +51,14 @@ bool isPartTableAgg(SAggLogicNode* pAgg);
 bool isPartTagAgg(SAggLogicNode* pAgg);
 bool isPartTableWinodw(SWindowLogicNode* pWindow);
 
+#define SPLIT_FLAG_MASK(n) (1 << n)
+
+#define SPLIT_FLAG_STABLE_SPLIT SPLIT_FLAG_MASK(0)
+#define SPLIT_FLAG_INSERT_SPLIT SPLIT_FLAG_MASK(1)
+
+#define SPLIT_FLAG_SET_MASK(val, mask)  (val) |= (mask)
+#define SPLIT_FLAG_TEST_MASK(val, mask) (((val) & (mask)) != 0)
+
 #define CLONE_LIMIT 1
 #define CLONE_SLIMIT 1 << 1
 #define CLONE_LIMIT_SLIMIT (CLONE_LIMIT | CLONE_SLIMIT)
@@ -14,6 +14,7 @@
  */
 
 #include "planInt.h"
+#include "tglobal.h"
 
 typedef struct SScaleOutContext {
   SPlanContext* pPlanCxt;
@@ -82,6 +83,54 @@ static int32_t scaleOutByVgroups(SScaleOutContext* pCxt, SLogicSubplan* pSubplan
   return code;
 }
 
+// The partial aggregate over the super table scan of a split subplan is merged by its parent anyway, so the tables of
+// one vgroup can be divided among several such subplans executed in parallel by the query workers of the vnode.
+static bool canScaleOutByTableSlices(SScaleOutContext* pCxt, SLogicSubplan* pSubplan) {
+  if (tsQueryScanParallelism <= 1 || pCxt->pPlanCxt->streamQuery ||
+      !SPLIT_FLAG_TEST_MASK(pSubplan->splitFlag, SPLIT_FLAG_STABLE_SPLIT)) {
+    return false;
+  }
+
+  SLogicNode* pRoot = pSubplan->pNode;
+  if (QUERY_NODE_LOGIC_PLAN_AGG != nodeType(pRoot) || 1 != LIST_LENGTH(pRoot->pChildren)) {
+    return false;
+  }
+
+  SLogicNode* pChild = (SLogicNode*)nodesListGetNode(pRoot->pChildren, 0);
+  if (QUERY_NODE_LOGIC_PLAN_SCAN != nodeType(pChild)) {
+    return false;
+  }
+
+  SScanLogicNode* pScan = (SScanLogicNode*)pChild;
+  return SCAN_TYPE_TABLE == pScan->scanType && TSDB_SUPER_TABLE == pScan->tableType && !pScan->groupSort &&
+         !pScan->groupOrderScan && !pScan->node.dynamicOp;
+}
+
+static int32_t scaleOutByTableSlices(SScaleOutContext* pCxt, SLogicSubplan* pSubplan, int32_t level,
+                                     SNodeList* pGroup) {
+  int32_t numOfSlices = tsQueryScanParallelism;
+  int32_t code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; i < pSubplan->pVgroupList->numOfVgroups; ++i) {
+    for (int32_t j = 0; j < numOfSlices; ++j) {
+      SLogicSubplan* pNewSubplan = singleCloneSubLogicPlan(pCxt, pSubplan, level);
+      if (NULL == pNewSubplan) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+      SScanLogicNode* pScan = (SScanLogicNode*)nodesListGetNode(pNewSubplan->pNode->pChildren, 0);
+      pScan->tableSliceIdx = j;
+      pScan->tableSliceNum = numOfSlices;
+      code = setScanVgroup(pNewSubplan->pNode, pSubplan->pVgroupList->vgroups + i);
+      if (TSDB_CODE_SUCCESS == code) {
+        code = nodesListStrictAppend(pGroup, (SNode*)pNewSubplan);
+      }
+      if (TSDB_CODE_SUCCESS != code) {
+        return code;
+      }
+    }
+  }
+  return code;
+}
+
 static int32_t scaleOutForMerge(SScaleOutContext* pCxt, SLogicSubplan* pSubplan, int32_t level, SNodeList* pGroup) {
   return nodesListStrictAppend(pGroup, (SNode*)singleCloneSubLogicPlan(pCxt, pSubplan, level));
 }
@@ -120,7 +169,9 @@ static int32_t scaleOutForModify(SScaleOutContext* pCxt, SLogicSubplan* pSubplan
 }
 
 static int32_t scaleOutForScan(SScaleOutContext* pCxt, SLogicSubplan* pSubplan, int32_t level, SNodeList* pGroup) {
-  if (pSubplan->pVgroupList && !pCxt->pPlanCxt->streamQuery) {
+  if (pSubplan->pVgroupList && canScaleOutByTableSlices(pCxt, pSubplan)) {
+    return scaleOutByTableSlices(pCxt, pSubplan, level, pGroup);
+  } else if (pSubplan->pVgroupList && !pCxt->pPlanCxt->streamQuery) {
     return scaleOutByVgroups(pCxt, pSubplan, level, pGroup);
   } else {
     return scaleOutForMerge(pCxt, pSubplan, level, pGroup);
@@ -17,14 +17,6 @@
 #include "planInt.h"
 #include "tglobal.h"
 
-#define SPLIT_FLAG_MASK(n) (1 << n)
-
-#define SPLIT_FLAG_STABLE_SPLIT SPLIT_FLAG_MASK(0)
-#define SPLIT_FLAG_INSERT_SPLIT SPLIT_FLAG_MASK(1)
-
-#define SPLIT_FLAG_SET_MASK(val, mask)  (val) |= (mask)
-#define SPLIT_FLAG_TEST_MASK(val, mask) (((val) & (mask)) != 0)
-
 typedef struct SSplitContext {
   SPlanContext* pPlanCxt;
   uint64_t      queryId;
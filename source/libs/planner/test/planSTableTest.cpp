@@ -13,11 +13,48 @@
  * along with this program. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <map>
+#include <set>
+
 #include "planTestUtil.h"
+#include "tglobal.h"
 
 using namespace std;
 
-class PlanSuperTableTest : public PlannerTestBase {};
+class PlanSuperTableTest : public PlannerTestBase {
+ protected:
+  virtual void SetUp() { scanParallelism_ = tsQueryScanParallelism; }
+
+  virtual void TearDown() { tsQueryScanParallelism = scanParallelism_; }
+
+  // the {tableSliceIdx, tableSliceNum} of the table scans in the physical subplans of the last sql, by vgroup
+  map<int32_t, vector<pair<int32_t, int32_t>>> scanSlices() {
+    map<int32_t, vector<pair<int32_t, int32_t>>> slices;
+    for (const string& str : physiSubplans()) {
+      SNode* pNode = NULL;
+      EXPECT_EQ(nodesStringToNode(str.c_str(), &pNode), TSDB_CODE_SUCCESS);
+      SSubplan* pSubplan = (SSubplan*)pNode;
+      collectScanSlices((SNode*)pSubplan->pNode, &slices[pSubplan->execNode.nodeId]);
+      if (slices[pSubplan->execNode.nodeId].empty()) {
+        slices.erase(pSubplan->execNode.nodeId);
+      }
+      nodesDestroyNode(pNode);
+    }
+    return slices;
+  }
+
+ private:
+  static void collectScanSlices(SNode* pNode, vector<pair<int32_t, int32_t>>* pSlices) {
+    if (QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN == nodeType(pNode)) {
+      STableScanPhysiNode* pScan = (STableScanPhysiNode*)pNode;
+      pSlices->push_back(make_pair(pScan->tableSliceIdx, pScan->tableSliceNum));
+    }
+    SNode* pChild = NULL;
+    FOREACH(pChild, ((SPhysiNode*)pNode)->pChildren) { collectScanSlices(pChild, pSlices); }
+  }
+
+  int32_t scanParallelism_;
+};
 
 TEST_F(PlanSuperTableTest, pseudoCol) {
   useDb("root", "test");
@@ -40,3 +77,46 @@ TEST_F(PlanSuperTableTest, orderBy) {
 
   run("SELECT -1 * c1, c1 FROM st1 ORDER BY -1 * c1");
 }
+
+TEST_F(PlanSuperTableTest, scanParallelism) {
+  useDb("root", "test");
+
+  // the scan of each vgroup is not sliced by default
+  run("SELECT c1 FROM st1");
+  auto unsliced = scanSlices();
+  ASSERT_FALSE(unsliced.empty());
+  for (const auto& vg : unsliced) {
+    EXPECT_EQ(vg.second, (vector<pair<int32_t, int32_t>>{{0, 0}})) << "vgroup " << vg.first;
+  }
+
+  tsQueryScanParallelism = 4;
+
+  // a partial aggregate over the scan of a vgroup is cloned for each slice of its tables
+  run("SELECT COUNT(*), AVG(c1) FROM st1");
+  auto sliced = scanSlices();
+  ASSERT_EQ(sliced.size(), unsliced.size());
+  for (const auto& vg : sliced) {
+    EXPECT_EQ(unsliced.count(vg.first), 1) << "vgroup " << vg.first;
+    set<pair<int32_t, int32_t>> slices(vg.second.begin(), vg.second.end());
+    EXPECT_EQ(vg.second.size(), 4) << "vgroup " << vg.first;
+    EXPECT_EQ(slices, (set<pair<int32_t, int32_t>>{{0, 4}, {1, 4}, {2, 4}, {3, 4}})) << "vgroup " << vg.first;
+  }
+
+  // the tables of a vgroup are scanned once whether its scan is sliced or not
+  run("SELECT COUNT(*) FROM st1 GROUP BY tag1");
+  for (const auto& vg : scanSlices()) {
+    set<pair<int32_t, int32_t>> slices(vg.second.begin(), vg.second.end());
+    EXPECT_EQ(slices.size(), vg.second.size()) << "vgroup " << vg.first;
+    EXPECT_TRUE(slices == (set<pair<int32_t, int32_t>>{{0, 0}}) ||
+                slices == (set<pair<int32_t, int32_t>>{{0, 4}, {1, 4}, {2, 4}, {3, 4}}))
+        << "vgroup " << vg.first;
+  }
+
+  // a scan without an aggregate over it is left to one subplan of each vgroup
+  run("SELECT c1 FROM st1");
+  EXPECT_EQ(scanSlices(), unsliced);
+
+  tsQueryScanParallelism = 1;
+  run("SELECT COUNT(*), AVG(c1) FROM st1");
+  EXPECT_EQ(scanSlices(), unsliced);
+}
@@ -36,6 +36,8 @@ class PlannerTestBase : public testing::Test {
   void prepare(const std::string& sql);
   void bindParams(TAOS_MULTI_BIND* pParams, int32_t colIdx);
   void exec();
+  // the physical subplans of the last sql, as the string of each
+  const std::vector<std::string>& physiSubplans();
 
  private:
   std::unique_ptr<PlannerTestBaseImpl> impl_;
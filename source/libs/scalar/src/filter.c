@@ -3151,6 +3151,11 @@ static FORCE_INLINE bool filterExecuteImplNotNull(void *pinfo, int32_t numOfRows
   return all;
 }
 
+// a non-null value of a variant column sharing the payload of the previous row has the same result
+static FORCE_INLINE bool filterSameAsPrevRow(SColumnInfoData *pData, int32_t i) {
+  return i > 0 && IS_VAR_DATA_TYPE(pData->info.type) && pData->varmeta.offset[i] == pData->varmeta.offset[i - 1];
+}
+
 bool filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis,
                             int16_t numOfCols, int32_t *numOfQualified) {
   SFilterInfo  *info = (SFilterInfo *)pinfo;
@@ -3176,8 +3181,12 @@ bool filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *pRe
       continue;
     }
 
-    void *colData = colDataGetData(pData, i);
-    p[i] = (*rfunc)(colData, colData, valData, valData2, func);
+    if (filterSameAsPrevRow(pData, i)) {
+      p[i] = p[i - 1];
+    } else {
+      void *colData = colDataGetData(pData, i);
+      p[i] = (*rfunc)(colData, colData, valData, valData2, func);
+    }
 
     if (p[i] == 0) {
       all = false;
@@ -3209,9 +3218,11 @@ bool filterExecuteImplMisc(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes
     }
 
     void *colData = colDataGetData((SColumnInfoData *)info->cunits[uidx].colData, i);
-    // match/nmatch for nchar type need convert from ucs4 to mbs
-    if (info->cunits[uidx].dataType == TSDB_DATA_TYPE_NCHAR &&
-        (info->cunits[uidx].optr == OP_TYPE_MATCH || info->cunits[uidx].optr == OP_TYPE_NMATCH)) {
+    if (filterSameAsPrevRow((SColumnInfoData *)info->cunits[uidx].colData, i)) {
+      p[i] = p[i - 1];
+      // match/nmatch for nchar type need convert from ucs4 to mbs
+    } else if (info->cunits[uidx].dataType == TSDB_DATA_TYPE_NCHAR &&
+               (info->cunits[uidx].optr == OP_TYPE_MATCH || info->cunits[uidx].optr == OP_TYPE_NMATCH)) {
       char   *newColData = taosMemoryCalloc(info->cunits[uidx].dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
       int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
       if (len < 0) {
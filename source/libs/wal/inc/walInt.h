@@ -162,6 +162,35 @@ int64_t walChangeWrite(SWal* pWal, int64_t ver);
 int     walInitWriteFile(SWal* pWal);
 // seek section end
 
+// read cache section
+typedef struct {
+  int64_t     ver;
+  int64_t     fileFirstVer;
+  int64_t     offset;  // offset of the entry head in its log file
+  SWalCkHead* pHead;
+} SWalCacheEntry;
+
+typedef struct SWalReadCache {
+  TdThreadMutex  mutex;
+  int64_t        size;
+  SArray*        pReaders;      // the readers registered, idle or not
+  int32_t        numOfReaders;  // the readers registered that fetched lately
+  int64_t        lastSweepTs;
+  int64_t        hits;
+  int64_t        misses;
+  SWalCacheEntry entries[WAL_READ_CACHE_SLOTS];
+} SWalReadCache;
+
+SWalReadCache* walReadCacheOpen();
+void           walReadCacheClose(SWalReadCache* pCache);
+void           walReadCacheClear(SWalReadCache* pCache);
+void           walReadCacheRegister(SWalReader* pReader);
+void           walReadCacheUnregister(SWalReader* pReader);
+int32_t        walReadCachePut(SWalReader* pReader, int64_t offset);
+bool           walReadCacheGet(SWalReader* pReader, int64_t ver);
+void           walGetReadCacheStats(SWal* pWal, int64_t* pHits, int64_t* pMisses, int32_t* pReaders);
+// read cache section end
+
 int64_t walGetSeq();
 int     walSeekWriteVer(SWal* pWal, int64_t ver);
 int32_t walRollImpl(SWal* pWal);
@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "taoserror.h"
+#include "walInt.h"
+
+// The read cache keeps the committed entries most recently fetched by tq readers of one wal, so that the
+// subscriptions positioned near the same version read and verify each entry once. Entries are placed in the
+// slot of ver % WAL_READ_CACHE_SLOTS, readers lagging out of the window simply miss and read the files. Only the
+// readers that fetched in the last WAL_READ_CACHE_IDLE_MS are counted, sharing is off once fewer than two of them are.
+
+SWalReadCache *walReadCacheOpen() {
+  SWalReadCache *pCache = taosMemoryCalloc(1, sizeof(SWalReadCache));
+  if (pCache == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pCache->pReaders = taosArrayInit(4, POINTER_BYTES);
+  if (pCache->pReaders == NULL) {
+    taosMemoryFree(pCache);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < WAL_READ_CACHE_SLOTS; i++) {
+    pCache->entries[i].ver = -1;
+  }
+
+  taosThreadMutexInit(&pCache->mutex, NULL);
+  return pCache;
+}
+
+static void walReadCacheEvict(SWalReadCache *pCache, SWalCacheEntry *pEntry) {
+  if (pEntry->pHead != NULL) {
+    pCache->size -= sizeof(SWalCkHead) + pEntry->pHead->head.bodyLen;
+    taosMemoryFreeClear(pEntry->pHead);
+  }
+  pEntry->ver = -1;
+}
+
+void walReadCacheClear(SWalReadCache *pCache) {
+  if (pCache == NULL) return;
+
+  taosThreadMutexLock(&pCache->mutex);
+  for (int32_t i = 0; i < WAL_READ_CACHE_SLOTS; i++) {
+    walReadCacheEvict(pCache, &pCache->entries[i]);
+  }
+  taosThreadMutexUnlock(&pCache->mutex);
+}
+
+void walReadCacheClose(SWalReadCache *pCache) {
+  if (pCache == NULL) return;
+
+  walReadCacheClear(pCache);
+  taosArrayDestroy(pCache->pReaders);
+  taosThreadMutexDestroy(&pCache->mutex);
+  taosMemoryFree(pCache);
+}
+
+// count the readers that fetched lately, with the mutex held. The entries are dropped once sharing is off as
+// nobody would consume them any more.
+static void walReadCacheCountReaders(SWalReadCache *pCache, int64_t now) {
+  int32_t numOfReaders = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pCache->pReaders); i++) {
+    SWalReader *pReader = *(SWalReader **)taosArrayGet(pCache->pReaders, i);
+    if (now - atomic_load_64(&pReader->lastFetchTs) < WAL_READ_CACHE_IDLE_MS) numOfReaders++;
+  }
+
+  if (numOfReaders < 2 && pCache->numOfReaders >= 2) {
+    for (int32_t i = 0; i < WAL_READ_CACHE_SLOTS; i++) {
+      walReadCacheEvict(pCache, &pCache->entries[i]);
+    }
+  }
+  atomic_store_32(&pCache->numOfReaders, numOfReaders);
+  atomic_store_64(&pCache->lastSweepTs, now);
+}
+
+// called on each fetch, the readers are counted again when one joins or comes back from idle, and at most once per
+// WAL_READ_CACHE_SWEEP_MS otherwise to notice the ones gone idle
+void walReadCacheRegister(SWalReader *pReader) {
+  SWalReadCache *pCache = pReader->pWal->pReadCache;
+  if (pCache == NULL) return;
+
+  int64_t now = taosGetTimestampMs();
+  int64_t lastFetchTs = atomic_exchange_64(&pReader->lastFetchTs, now);
+  if (pReader->sharedScan && now - lastFetchTs < WAL_READ_CACHE_IDLE_MS &&
+      now - atomic_load_64(&pCache->lastSweepTs) < WAL_READ_CACHE_SWEEP_MS) {
+    return;
+  }
+
+  taosThreadMutexLock(&pCache->mutex);
+  if (!pReader->sharedScan) {
+    if (taosArrayPush(pCache->pReaders, &pReader) == NULL) {
+      taosThreadMutexUnlock(&pCache->mutex);
+      return;
+    }
+    pReader->sharedScan = 1;
+  }
+  walReadCacheCountReaders(pCache, now);
+  taosThreadMutexUnlock(&pCache->mutex);
+}
+
+void walReadCacheUnregister(SWalReader *pReader) {
+  SWalReadCache *pCache = pReader->pWal->pReadCache;
+  if (pCache == NULL || !pReader->sharedScan) return;
+
+  taosThreadMutexLock(&pCache->mutex);
+  for (int32_t i = 0; i < taosArrayGetSize(pCache->pReaders); i++) {
+    if (*(SWalReader **)taosArrayGet(pCache->pReaders, i) == pReader) {
+      taosArrayRemove(pCache->pReaders, i);
+      break;
+    }
+  }
+  pReader->sharedScan = 0;
+  walReadCacheCountReaders(pCache, taosGetTimestampMs());
+  taosThreadMutexUnlock(&pCache->mutex);
+}
+
+int32_t walReadCachePut(SWalReader *pReader, int64_t offset) {
+  SWalReadCache *pCache = pReader->pWal->pReadCache;
+  SWalCkHead    *pHead = pReader->pHead;
+  int64_t        len = sizeof(SWalCkHead) + pHead->head.bodyLen;
+
+  // a single reader has nobody to share with
+  if (pCache == NULL || atomic_load_32(&pCache->numOfReaders) < 2) return 0;
+  if (len > WAL_READ_CACHE_ENTRY_MAX) return 0;
+
+  int64_t         ver = pHead->head.version;
+  int32_t         slot = ver % WAL_READ_CACHE_SLOTS;
+  SWalCacheEntry *pEntry = &pCache->entries[slot];
+
+  taosThreadMutexLock(&pCache->mutex);
+  if (pEntry->ver == ver && pEntry->fileFirstVer == pReader->curFileFirstVer) {
+    taosThreadMutexUnlock(&pCache->mutex);
+    return 0;
+  }
+
+  walReadCacheEvict(pCache, pEntry);
+
+  // evict the oldest entries, i.e. the ones following the slot in the ring
+  for (int32_t i = 1; i < WAL_READ_CACHE_SLOTS && pCache->size + len > WAL_READ_CACHE_SIZE; i++) {
+    walReadCacheEvict(pCache, &pCache->entries[(slot + i) % WAL_READ_CACHE_SLOTS]);
+  }
+
+  SWalCkHead *pCopy = taosMemoryMalloc(len);
+  if (pCopy == NULL) {
+    taosThreadMutexUnlock(&pCache->mutex);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  memcpy(pCopy, pHead, len);
+  pEntry->ver = ver;
+  pEntry->fileFirstVer = pReader->curFileFirstVer;
+  pEntry->offset = offset;
+  pEntry->pHead = pCopy;
+  pCache->size += len;
+  taosThreadMutexUnlock(&pCache->mutex);
+  return 0;
+}
+
+// fill pReader->pHead with the whole entry of ver and move the read position after it. Only entries in the log
+// file the reader is positioned on are served, others are left to the regular seek.
+bool walReadCacheGet(SWalReader *pReader, int64_t ver) {
+  SWalReadCache *pCache = pReader->pWal->pReadCache;
+  if (pCache == NULL || pReader->curFileFirstVer == -1 || atomic_load_32(&pCache->numOfReaders) < 2) {
+    return false;
+  }
+
+  SWalCacheEntry *pEntry = &pCache->entries[ver % WAL_READ_CACHE_SLOTS];
+
+  taosThreadMutexLock(&pCache->mutex);
+  if (pEntry->ver != ver || pEntry->fileFirstVer != pReader->curFileFirstVer) {
+    pCache->misses++;
+    taosThreadMutexUnlock(&pCache->mutex);
+    return false;
+  }
+
+  int32_t bodyLen = pEntry->pHead->head.bodyLen;
+  if (pReader->capacity < bodyLen) {
+    SWalCkHead *ptr = (SWalCkHead *)taosMemoryRealloc(pReader->pHead, sizeof(SWalCkHead) + bodyLen);
+    if (ptr == NULL) {
+      taosThreadMutexUnlock(&pCache->mutex);
+      return false;
+    }
+    pReader->pHead = ptr;
+    pReader->capacity = bodyLen;
+  }
+
+  memcpy(pReader->pHead, pEntry->pHead, sizeof(SWalCkHead) + bodyLen);
+  pReader->logOffset = pEntry->offset + sizeof(SWalCkHead);
+  pCache->hits++;
+  taosThreadMutexUnlock(&pCache->mutex);
+
+  pReader->curVersion = ver;
+  pReader->bodyCached = 1;
+  return true;
+}
+
+void walGetReadCacheStats(SWal *pWal, int64_t *pHits, int64_t *pMisses, int32_t *pReaders) {
+  SWalReadCache *pCache = pWal->pReadCache;
+  *pHits = 0;
+  *pMisses = 0;
+  *pReaders = 0;
+  if (pCache == NULL) return;
+
+  taosThreadMutexLock(&pCache->mutex);
+  *pHits = pCache->hits;
+  *pMisses = pCache->misses;
+  *pReaders = pCache->numOfReaders;
+  taosThreadMutexUnlock(&pCache->mutex);
+}
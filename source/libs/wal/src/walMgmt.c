@@ -114,6 +114,12 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
     goto _err;
   }
 
+  pWal->pReadCache = walReadCacheOpen();
+  if (pWal->pReadCache == NULL) {
+    wError("vgId:%d, failed to init read cache since %s", pWal->cfg.vgId, tstrerror(terrno));
+    goto _err;
+  }
+
   // open meta
   walResetVer(&pWal->vers);
   pWal->pLogFile = NULL;
@@ -170,6 +176,7 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
 _err:
   taosArrayDestroy(pWal->fileInfoSet);
   taosHashCleanup(pWal->pRefHash);
+  walReadCacheClose(pWal->pReadCache);
   taosThreadMutexDestroy(&pWal->mutex);
   taosMemoryFree(pWal);
   pWal = NULL;
@@ -239,6 +246,9 @@ static void walFreeObj(void *wal) {
   SWal *pWal = wal;
   wDebug("vgId:%d, wal:%p is freed", pWal->cfg.vgId, pWal);
 
+  walReadCacheClose(pWal->pReadCache);
+  pWal->pReadCache = NULL;
+
   taosThreadMutexDestroy(&pWal->mutex);
   taosMemoryFreeClear(pWal);
 }
@@ -30,6 +30,8 @@ SWalReader *walOpenReader(SWal *pWal, SWalFilterCond *cond, int64_t id) {
   pReader->curVersion = -1;
   pReader->curFileFirstVer = -1;
   pReader->capacity = 0;
+  pReader->idxCacheFirstVer = -1;
+  pReader->rollbackSeq = atomic_load_64(&pWal->rollbackSeq);
   if (cond) {
     pReader->cond = *cond;
   } else {
@@ -56,12 +58,85 @@ SWalReader *walOpenReader(SWal *pWal, SWalFilterCond *cond, int64_t id) {
 }
 
 void walCloseReader(SWalReader *pReader) {
+  walReadCacheUnregister(pReader);
   taosCloseFile(&pReader->pIdxFile);
   taosCloseFile(&pReader->pLogFile);
   taosMemoryFreeClear(pReader->pHead);
+  taosMemoryFreeClear(pReader->pReadBuf);
+  taosMemoryFreeClear(pReader->pIdxCache);
   taosMemoryFree(pReader);
 }
 
+static void walReadAheadReset(SWalReader *pReader) {
+  pReader->readBufOffset = 0;
+  pReader->readBufLen = 0;
+  pReader->idxCacheFirstVer = -1;
+  pReader->idxCacheNum = 0;
+}
+
+// bytes beyond the commit version may be truncated and rewritten by a rollback, drop everything buffered then.
+static void walReadAheadCheckRollback(SWalReader *pReader) {
+  int64_t rollbackSeq = atomic_load_64(&pReader->pWal->rollbackSeq);
+  if (pReader->rollbackSeq != rollbackSeq) {
+    walReadAheadReset(pReader);
+    pReader->rollbackSeq = rollbackSeq;
+  }
+}
+
+// read from the current log file at logOffset, served from the read-ahead buffer whenever possible.
+// returns the number of bytes read, which is less than size only when the end of file is reached.
+static int64_t walReadLogFile(SWalReader *pReader, void *buf, int64_t size) {
+  int64_t nRead = 0;
+
+  if (pReader->pReadBuf == NULL) {
+    pReader->pReadBuf = taosMemoryMalloc(WAL_READ_BUF_SIZE);
+    if (pReader->pReadBuf == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
+    pReader->readBufLen = 0;
+  }
+
+  while (nRead < size) {
+    int64_t pos = pReader->logOffset;
+    int64_t bufEnd = pReader->readBufOffset + pReader->readBufLen;
+
+    if (pos >= pReader->readBufOffset && pos < bufEnd) {
+      int64_t n = TMIN(size - nRead, bufEnd - pos);
+      memcpy((char *)buf + nRead, pReader->pReadBuf + (pos - pReader->readBufOffset), n);
+      nRead += n;
+      pReader->logOffset += n;
+      continue;
+    }
+
+    int64_t n = 0;
+    if (size - nRead >= WAL_READ_BUF_SIZE) {
+      // large bodies are read directly into the destination
+      n = taosPReadFile(pReader->pLogFile, (char *)buf + nRead, size - nRead, pos);
+      if (n < 0) {
+        terrno = TAOS_SYSTEM_ERROR(errno);
+        return -1;
+      }
+      nRead += n;
+      pReader->logOffset += n;
+    } else {
+      n = taosPReadFile(pReader->pLogFile, pReader->pReadBuf, WAL_READ_BUF_SIZE, pos);
+      if (n < 0) {
+        terrno = TAOS_SYSTEM_ERROR(errno);
+        return -1;
+      }
+      pReader->readBufOffset = pos;
+      pReader->readBufLen = n;
+    }
+
+    if (n == 0) {
+      break;
+    }
+  }
+
+  return nRead;
+}
+
 int32_t walNextValidMsg(SWalReader *pReader) {
   int64_t fetchVer = pReader->curVersion;
   int64_t lastVer = walGetLastVer(pReader->pWal);
@@ -129,26 +204,29 @@ void walReaderVerifyOffset(SWalReader *pWalReader, STqOffsetVal* pOffset){
   }
 }
 
-static int64_t walReadSeekFilePos(SWalReader *pReader, int64_t fileFirstVer, int64_t ver) {
-  int64_t ret = 0;
+static int32_t walReadIdxEntry(SWalReader *pReader, int64_t fileFirstVer, int64_t ver, SWalIdxEntry *pEntry) {
+  if (ver >= pReader->idxCacheFirstVer && ver < pReader->idxCacheFirstVer + pReader->idxCacheNum) {
+    *pEntry = pReader->pIdxCache[ver - pReader->idxCacheFirstVer];
+    return 0;
+  }
 
-  TdFilePtr pIdxTFile = pReader->pIdxFile;
-  TdFilePtr pLogTFile = pReader->pLogFile;
+  if (pReader->pIdxCache == NULL) {
+    pReader->pIdxCache = taosMemoryMalloc(WAL_READ_IDX_NUM * sizeof(SWalIdxEntry));
+    if (pReader->pIdxCache == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
+  }
 
-  // seek position
+  // load a window of idx entries starting from ver, so that following seeks nearby need no io
   int64_t offset = (ver - fileFirstVer) * sizeof(SWalIdxEntry);
-  ret = taosLSeekFile(pIdxTFile, offset, SEEK_SET);
-  if (ret < 0) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, failed to seek idx file, index:%" PRId64 ", pos:%" PRId64 ", since %s", pReader->pWal->cfg.vgId,
-           ver, offset, terrstr());
-    return -1;
-  }
-  SWalIdxEntry entry = {0};
-  if ((ret = taosReadFile(pIdxTFile, &entry, sizeof(SWalIdxEntry))) != sizeof(SWalIdxEntry)) {
+  int64_t ret = taosPReadFile(pReader->pIdxFile, pReader->pIdxCache, WAL_READ_IDX_NUM * sizeof(SWalIdxEntry), offset);
+  if (ret < (int64_t)sizeof(SWalIdxEntry)) {
+    pReader->idxCacheNum = 0;
     if (ret < 0) {
       terrno = TAOS_SYSTEM_ERROR(errno);
-      wError("vgId:%d, failed to read idx file, since %s", pReader->pWal->cfg.vgId, terrstr());
+      wError("vgId:%d, failed to read idx file, index:%" PRId64 ", pos:%" PRId64 ", since %s",
+             pReader->pWal->cfg.vgId, ver, offset, terrstr());
     } else {
       terrno = TSDB_CODE_WAL_FILE_CORRUPTED;
       wError("vgId:%d, read idx file incompletely, read bytes %" PRId64 ", bytes should be %ld",
@@ -157,14 +235,20 @@ static int64_t walReadSeekFilePos(SWalReader *pReader, int64_t fileFirstVer, int
     return -1;
   }
 
-  ret = taosLSeekFile(pLogTFile, entry.offset, SEEK_SET);
-  if (ret < 0) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, failed to seek log file, index:%" PRId64 ", pos:%" PRId64 ", since %s", pReader->pWal->cfg.vgId,
-           ver, entry.offset, terrstr());
+  pReader->idxCacheFirstVer = ver;
+  pReader->idxCacheNum = ret / sizeof(SWalIdxEntry);
+  *pEntry = pReader->pIdxCache[0];
+  return 0;
+}
+
+static int64_t walReadSeekFilePos(SWalReader *pReader, int64_t fileFirstVer, int64_t ver) {
+  SWalIdxEntry entry = {0};
+  if (walReadIdxEntry(pReader, fileFirstVer, ver, &entry) < 0) {
     return -1;
   }
-  return ret;
+
+  pReader->logOffset = entry.offset;
+  return entry.offset;
 }
 
 static int32_t walReadChangeFile(SWalReader *pReader, int64_t fileFirstVer) {
@@ -172,6 +256,7 @@ static int32_t walReadChangeFile(SWalReader *pReader, int64_t fileFirstVer) {
 
   taosCloseFile(&pReader->pIdxFile);
   taosCloseFile(&pReader->pLogFile);
+  walReadAheadReset(pReader);
 
   walBuildLogName(pReader->pWal, fileFirstVer, fnameStr);
   TdFilePtr pLogFile = taosOpenFile(fnameStr, TD_FILE_READ);
@@ -267,6 +352,15 @@ int32_t walFetchHead(SWalReader *pRead, int64_t ver) {
     return -1;
   }
 
+  walReadAheadCheckRollback(pRead);
+  walReadCacheRegister(pRead);
+  pRead->bodyCached = 0;
+
+  // already read by another subscription scanning the same range
+  if (ver >= pRead->pWal->vers.firstVer && walReadCacheGet(pRead, ver)) {
+    return 0;
+  }
+
   if (pRead->curVersion != ver) {
     code = walReaderSeekVer(pRead, ver);
     if (code < 0) {
@@ -276,7 +370,7 @@ int32_t walFetchHead(SWalReader *pRead, int64_t ver) {
   }
 
   while (1) {
-    contLen = taosReadFile(pRead->pLogFile, pRead->pHead, sizeof(SWalCkHead));
+    contLen = walReadLogFile(pRead, pRead->pHead, sizeof(SWalCkHead));
     if (contLen == sizeof(SWalCkHead)) {
       break;
     } else if (contLen == 0 && !seeked) {
@@ -286,9 +380,7 @@ int32_t walFetchHead(SWalReader *pRead, int64_t ver) {
       seeked = true;
       continue;
     } else {
-      if (contLen < 0) {
-        terrno = TAOS_SYSTEM_ERROR(errno);
-      } else {
+      if (contLen >= 0) {
         terrno = TSDB_CODE_WAL_FILE_CORRUPTED;
       }
       return -1;
@@ -313,12 +405,9 @@ int32_t walSkipFetchBody(SWalReader *pRead) {
          pRead->pWal->cfg.vgId, pRead->pHead->head.version, pRead->pWal->vers.firstVer, pRead->pWal->vers.commitVer,
          pRead->pWal->vers.lastVer, pRead->pWal->vers.appliedVer, pRead->readerId);
 
-  int64_t code = taosLSeekFile(pRead->pLogFile, pRead->pHead->head.bodyLen, SEEK_CUR);
-  if (code < 0) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return -1;
-  }
-
+  // no io here, the body is either skipped within the read-ahead buffer or by the next read position
+  pRead->logOffset += pRead->pHead->head.bodyLen;
+  pRead->bodyCached = 0;
   pRead->curVersion++;
   return 0;
 }
@@ -334,6 +423,13 @@ int32_t walFetchBody(SWalReader *pRead) {
          vgId, ver, pRead->pWal->vers.firstVer, pRead->pWal->vers.commitVer, pRead->pWal->vers.lastVer,
          pRead->pWal->vers.appliedVer, id);
 
+  if (pRead->bodyCached) {
+    pRead->logOffset += pReadHead->bodyLen;
+    pRead->bodyCached = 0;
+    pRead->curVersion++;
+    return 0;
+  }
+
   if (pRead->capacity < pReadHead->bodyLen) {
     SWalCkHead *ptr = (SWalCkHead *)taosMemoryRealloc(pRead->pHead, sizeof(SWalCkHead) + pReadHead->bodyLen);
     if (ptr == NULL) {
@@ -345,9 +441,9 @@ int32_t walFetchBody(SWalReader *pRead) {
     pRead->capacity = pReadHead->bodyLen;
   }
 
-  if (pReadHead->bodyLen != taosReadFile(pRead->pLogFile, pReadHead->body, pReadHead->bodyLen)) {
-    if (pReadHead->bodyLen < 0) {
-      terrno = TAOS_SYSTEM_ERROR(errno);
+  int64_t contLen = walReadLogFile(pRead, pReadHead->body, pReadHead->bodyLen);
+  if (pReadHead->bodyLen != contLen) {
+    if (contLen < 0) {
       wError("vgId:%d, wal fetch body error:%" PRId64 ", read request index:%" PRId64 ", since %s, 0x%"PRIx64,
              vgId, pReadHead->version, ver, tstrerror(terrno), id);
     } else {
@@ -371,6 +467,9 @@ int32_t walFetchBody(SWalReader *pRead) {
     return -1;
   }
 
+  // share the verified entry with the other readers, failing to do so does not fail this read
+  (void)walReadCachePut(pRead, pRead->logOffset - pReadHead->bodyLen - sizeof(SWalCkHead));
+
   pRead->curVersion++;
   return 0;
 }
@@ -394,6 +493,7 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
   }
 
   taosThreadMutexLock(&pReader->mutex);
+  walReadAheadCheckRollback(pReader);
 
   if (pReader->curVersion != ver) {
     if (walReaderSeekVer(pReader, ver) < 0) {
@@ -405,7 +505,7 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
   }
 
   while (1) {
-    contLen = taosReadFile(pReader->pLogFile, pReader->pHead, sizeof(SWalCkHead));
+    contLen = walReadLogFile(pReader, pReader->pHead, sizeof(SWalCkHead));
     if (contLen == sizeof(SWalCkHead)) {
       break;
     } else if (contLen == 0 && !seeked) {
@@ -416,9 +516,7 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
       seeked = true;
       continue;
     } else {
-      if (contLen < 0) {
-        terrno = TAOS_SYSTEM_ERROR(errno);
-      } else {
+      if (contLen >= 0) {
         terrno = TSDB_CODE_WAL_FILE_CORRUPTED;
       }
       wError("vgId:%d, failed to read WAL record head, index:%" PRId64 ", from log file since %s",
@@ -449,11 +547,9 @@ int32_t walReadVer(SWalReader *pReader, int64_t ver) {
     pReader->capacity = pReader->pHead->head.bodyLen;
   }
 
-  if ((contLen = taosReadFile(pReader->pLogFile, pReader->pHead->head.body, pReader->pHead->head.bodyLen)) !=
+  if ((contLen = walReadLogFile(pReader, pReader->pHead->head.body, pReader->pHead->head.bodyLen)) !=
       pReader->pHead->head.bodyLen) {
-    if (contLen < 0)
-      terrno = TAOS_SYSTEM_ERROR(errno);
-    else {
+    if (contLen >= 0) {
       terrno = TSDB_CODE_WAL_FILE_CORRUPTED;
     }
     wError("vgId:%d, failed to read WAL record body, index:%" PRId64 ", from log file since %s",
@@ -494,6 +590,7 @@ void walReadReset(SWalReader *pReader) {
   taosThreadMutexLock(&pReader->mutex);
   taosCloseFile(&pReader->pIdxFile);
   taosCloseFile(&pReader->pLogFile);
+  walReadAheadReset(pReader);
   pReader->curFileFirstVer = -1;
   pReader->curVersion = -1;
   taosThreadMutexUnlock(&pReader->mutex);
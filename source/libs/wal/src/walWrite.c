@@ -38,6 +38,7 @@ int32_t walRestoreFromSnapshot(SWal *pWal, int64_t ver) {
 
   taosCloseFile(&pWal->pLogFile);
   taosCloseFile(&pWal->pIdxFile);
+  walReadCacheClear(pWal->pReadCache);
 
   if (pWal->vers.firstVer != -1) {
     int32_t fileSetSize = taosArrayGetSize(pWal->fileInfoSet);
@@ -109,6 +110,9 @@ int32_t walRollback(SWal *pWal, int64_t ver) {
     return -1;
   }
 
+  // invalidate the read-ahead data of all readers, the log after ver is about to be rewritten
+  atomic_add_fetch_64(&pWal->rollbackSeq, 1);
+
   // find correct file
   if (ver < walGetLastFileFirstVer(pWal)) {
     // change current files
@@ -361,6 +361,136 @@ TEST_F(WalKeepEnv, readHandleRead) {
   walCloseReader(pRead);
 }
 
+TEST_F(WalKeepEnv, readHandleFetchAfterRollback) {
+  walResetEnv();
+  int         code;
+  SWalReader* pRead = walOpenReader(pWal, NULL, 0);
+  ASSERT(pRead != NULL);
+
+  int i;
+  for (i = 0; i < 100; i++) {
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, i);
+    code = walWrite(pWal, i, 0, newStr, strlen(newStr));
+    ASSERT_EQ(code, 0);
+  }
+  code = walCommit(pWal, 49);
+  ASSERT_EQ(code, 0);
+
+  // scan sequentially, skipping the odd versions, the tail is buffered by the read-ahead
+  for (i = 0; i < 50; i++) {
+    code = walFetchHead(pRead, i);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead->pHead->head.version, i);
+    code = (i % 2 == 0) ? walFetchBody(pRead) : walSkipFetchBody(pRead);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead->curVersion, i + 1);
+  }
+
+  // rewrite the uncommitted tail, the reader must not return the stale buffered entries
+  code = walRollback(pWal, 50);
+  ASSERT_EQ(code, 0);
+  for (i = 50; i < 100; i++) {
+    char newStr[100];
+    sprintf(newStr, "%s-%d-new", ranStr, i);
+    code = walWrite(pWal, i, 0, newStr, strlen(newStr));
+    ASSERT_EQ(code, 0);
+  }
+  code = walCommit(pWal, 99);
+  ASSERT_EQ(code, 0);
+
+  for (i = 50; i < 100; i++) {
+    code = walFetchHead(pRead, i);
+    ASSERT_EQ(code, 0);
+    code = walFetchBody(pRead);
+    ASSERT_EQ(code, 0);
+    char newStr[100];
+    sprintf(newStr, "%s-%d-new", ranStr, i);
+    int len = strlen(newStr);
+    ASSERT_EQ(pRead->pHead->head.bodyLen, len);
+    ASSERT_EQ(memcmp(newStr, pRead->pHead->head.body, len), 0);
+  }
+  walCloseReader(pRead);
+}
+
+TEST_F(WalKeepEnv, readHandleSharedScan) {
+  walResetEnv();
+  int         code;
+  SWalReader* pRead1 = walOpenReader(pWal, NULL, 0);
+  SWalReader* pRead2 = walOpenReader(pWal, NULL, 0);
+  ASSERT(pRead1 != NULL);
+  ASSERT(pRead2 != NULL);
+
+  int i;
+  for (i = 0; i < 100; i++) {
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, i);
+    code = walWrite(pWal, i, 0, newStr, strlen(newStr));
+    ASSERT_EQ(code, 0);
+  }
+  code = walCommit(pWal, 99);
+  ASSERT_EQ(code, 0);
+
+  // the second reader follows the first one closely and is served by the entries it read
+  for (i = 0; i < 100; i++) {
+    SWalReader* readers[2] = {pRead1, pRead2};
+    for (int j = 0; j < 2; j++) {
+      SWalReader* pRead = readers[j];
+      code = walFetchHead(pRead, i);
+      ASSERT_EQ(code, 0);
+      code = (j == 1 && i % 3 == 0) ? walSkipFetchBody(pRead) : walFetchBody(pRead);
+      ASSERT_EQ(code, 0);
+      ASSERT_EQ(pRead->curVersion, i + 1);
+      if (j == 1 && i % 3 == 0) continue;
+
+      char newStr[100];
+      sprintf(newStr, "%s-%d", ranStr, i);
+      int len = strlen(newStr);
+      ASSERT_EQ(pRead->pHead->head.version, i);
+      ASSERT_EQ(pRead->pHead->head.bodyLen, len);
+      ASSERT_EQ(memcmp(newStr, pRead->pHead->head.body, len), 0);
+    }
+  }
+  int64_t hits = 0, misses = 0;
+  int32_t numOfReaders = 0;
+  walGetReadCacheStats(pWal, &hits, &misses, &numOfReaders);
+  ASSERT_GT(hits, 0);
+  ASSERT_GT(misses, 0);
+  ASSERT_EQ(numOfReaders, 2);
+
+  // the first reader gone idle, the second one reads alone from the files
+  pRead1->lastFetchTs -= WAL_READ_CACHE_IDLE_MS;
+  pWal->pReadCache->lastSweepTs -= WAL_READ_CACHE_SWEEP_MS;
+  walReaderSeekVer(pRead2, 10);
+  for (i = 10; i < 20; i++) {
+    code = walFetchHead(pRead2, i);
+    ASSERT_EQ(code, 0);
+    code = walFetchBody(pRead2);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead2->pHead->head.version, i);
+  }
+
+  int64_t idleHits = 0, idleMisses = 0;
+  walGetReadCacheStats(pWal, &idleHits, &idleMisses, &numOfReaders);
+  ASSERT_EQ(idleHits, hits);
+  ASSERT_EQ(idleMisses, misses);
+  ASSERT_EQ(numOfReaders, 1);
+  ASSERT_EQ(pWal->pReadCache->size, 0);
+
+  // it is counted again as soon as it fetches
+  code = walFetchHead(pRead1, 20);
+  ASSERT_EQ(code, 0);
+  walGetReadCacheStats(pWal, &hits, &misses, &numOfReaders);
+  ASSERT_EQ(numOfReaders, 2);
+
+  walCloseReader(pRead1);
+  walGetReadCacheStats(pWal, &hits, &misses, &numOfReaders);
+  ASSERT_EQ(numOfReaders, 1);
+  walCloseReader(pRead2);
+  walGetReadCacheStats(pWal, &hits, &misses, &numOfReaders);
+  ASSERT_EQ(numOfReaders, 0);
+}
+
 TEST_F(WalRetentionEnv, repairMeta1) {
   walResetEnv();
   int code;
@@ -687,6 +687,35 @@ int32_t taosFsyncFile(TdFilePtr pFile) {
   return 0;
 }
 
+void *taosMmapReadOnlyFile(TdFilePtr pFile, int64_t size) {
+  if (pFile == NULL || pFile->fd < 0 || size <= 0) {
+    return NULL;
+  }
+#ifdef WINDOWS
+  return NULL;
+#else
+  void *ptr = mmap(NULL, size, PROT_READ, MAP_SHARED, pFile->fd, 0);
+  if (ptr == MAP_FAILED) {
+    return NULL;
+  }
+  return ptr;
+#endif
+}
+
+int32_t taosMunmapFile(void *ptr, int64_t size) {
+  if (ptr == NULL) {
+    return 0;
+  }
+#ifdef WINDOWS
+  return 0;
+#else
+  if (munmap(ptr, size) != 0) {
+    return -1;
+  }
+  return 0;
+#endif
+}
+
 int64_t taosFSendFile(TdFilePtr pFileOut, TdFilePtr pFileIn, int64_t *offset, int64_t size) {
   if (pFileOut == NULL || pFileIn == NULL) {
     return 0;
@@ -814,6 +814,278 @@ int32_t tsDecompressTimestampImp(const char *const input, const int32_t nelement
     return -1;
   }
 }
+/* --------------------------------------------ALP Float/Double Compression
+ * ---------------------------------------------- */
+// Floats read from sensors mostly carry a few decimal digits, such a value v is kept as the integer
+// d = round(v * 10^e / 10^f) and restored as d * 10^f / 10^e. The integers are bit packed against their minimum,
+// the values which do not come back bit for bit are stored as they are.
+//
+// | FP_ALP_MODE(1) | e(1) | f(1) | width(1) | base(8) | nExc(4) | packed integers | exception positions | values |
+bool tsAlpFloat = false;
+bool tsAlpDouble = false;
+
+#define ALP_HEADER_SIZE    16
+#define ALP_MAX_EXP_FLOAT  10
+#define ALP_MAX_EXP_DOUBLE 18
+#define ALP_MAX_INT        ((double)(1LL << 50))
+#define ALP_MAX_INT_FLOAT  ((double)INT32_MAX)
+#define ALP_NUM_OF_SAMPLES 64
+
+static const double ALP_F10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8, 1e9,
+                                 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18};
+static const double ALP_IF10[] = {1e0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8, 1e-9,
+                                  1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18};
+
+static FORCE_INLINE double alpGetValue(const char *const input, int32_t i, bool isFloat) {
+  return isFloat ? (double)((float *)input)[i] : ((double *)input)[i];
+}
+
+static FORCE_INLINE double alpDecodeValue(int64_t d, int8_t e, int8_t f) {
+  return (double)d * ALP_F10[f] * ALP_IF10[e];
+}
+
+// the integer of a value, false if the value does not survive the round trip
+static FORCE_INLINE bool alpEncodeValue(double v, int8_t e, int8_t f, bool isFloat, int64_t *d) {
+  double t = v * ALP_F10[e] * ALP_IF10[f];
+  if (!(t > -(isFloat ? ALP_MAX_INT_FLOAT : ALP_MAX_INT) && t < (isFloat ? ALP_MAX_INT_FLOAT : ALP_MAX_INT))) {
+    return false;
+  }
+
+  *d = (int64_t)round(t);
+  if (isFloat) {
+    float r = (float)alpDecodeValue(*d, e, f), o = (float)v;
+    return memcmp(&r, &o, sizeof(float)) == 0;
+  } else {
+    double r = alpDecodeValue(*d, e, f);
+    return memcmp(&r, &v, sizeof(double)) == 0;
+  }
+}
+
+static FORCE_INLINE int32_t alpBitWidth(uint64_t range) {
+  int32_t width = range ? (64 - BUILDIN_CLZL(range)) : 0;
+  return width > 56 ? 64 : width;  // the unpacking window holds 56 bits
+}
+
+// pick e and f on a sample by the estimated size of the integers and the exceptions
+static void alpChooseExponent(const char *const input, int32_t nelements, bool isFloat, int8_t *e, int8_t *f) {
+  int8_t  maxExp = isFloat ? ALP_MAX_EXP_FLOAT : ALP_MAX_EXP_DOUBLE;
+  int32_t step = TMAX(nelements / ALP_NUM_OF_SAMPLES, 1);
+  int64_t minCost = INT64_MAX;
+
+  *e = 0;
+  *f = 0;
+  for (int8_t ie = maxExp; ie >= 0; ie--) {
+    for (int8_t jf = ie; jf >= 0; jf--) {
+      int64_t min = INT64_MAX, max = INT64_MIN;
+      int32_t nSample = 0, nExc = 0;
+
+      for (int32_t i = 0; i < nelements; i += step, nSample++) {
+        int64_t d;
+        if (alpEncodeValue(alpGetValue(input, i, isFloat), ie, jf, isFloat, &d)) {
+          min = TMIN(min, d);
+          max = TMAX(max, d);
+        } else {
+          nExc++;
+        }
+      }
+
+      int64_t cost = (int64_t)nExc * (sizeof(int32_t) + (isFloat ? FLOAT_BYTES : DOUBLE_BYTES)) * BITS_PER_BYTE;
+      if (nExc < nSample) cost += (int64_t)nSample * alpBitWidth((uint64_t)max - (uint64_t)min);
+      if (cost < minCost) {
+        minCost = cost;
+        *e = ie;
+        *f = jf;
+      }
+    }
+  }
+}
+
+static int32_t tsCompressAlpImp(const char *const input, const int32_t nelements, char *const output, bool isFloat) {
+  int32_t bytes = isFloat ? FLOAT_BYTES : DOUBLE_BYTES;
+  int8_t  e, f;
+
+  if (nelements <= 0) return -1;
+
+  alpChooseExponent(input, nelements, isFloat, &e, &f);
+
+  // the exceptions take the place of the first integer so that they do not widen the range
+  int64_t min = INT64_MAX, max = INT64_MIN, fill = 0;
+  int32_t nExc = 0;
+  for (int32_t i = 0; i < nelements; i++) {
+    int64_t d;
+    if (alpEncodeValue(alpGetValue(input, i, isFloat), e, f, isFloat, &d)) {
+      if (min > max) fill = d;
+      min = TMIN(min, d);
+      max = TMAX(max, d);
+    } else {
+      nExc++;
+    }
+  }
+  if (nExc == nelements) return -1;
+
+  int32_t width = alpBitWidth((uint64_t)max - (uint64_t)min);
+  int32_t szPacked = (int32_t)(((int64_t)nelements * width + BITS_PER_BYTE - 1) / BITS_PER_BYTE);
+  int32_t size = ALP_HEADER_SIZE + szPacked + nExc * (sizeof(int32_t) + bytes);
+  if (size >= nelements * bytes + 1) return -1;
+
+  output[0] = FP_ALP_MODE;
+  output[1] = e;
+  output[2] = f;
+  output[3] = width;
+  memcpy(output + 4, &min, sizeof(min));
+  memcpy(output + 12, &nExc, sizeof(nExc));
+
+  char    *packed = output + ALP_HEADER_SIZE;
+  char    *excPos = packed + szPacked;
+  char    *excVal = excPos + nExc * sizeof(int32_t);
+  uint64_t acc = 0;
+  int32_t  nAcc = 0, opos = 0;
+  for (int32_t i = 0; i < nelements; i++) {
+    int64_t d;
+    if (!alpEncodeValue(alpGetValue(input, i, isFloat), e, f, isFloat, &d)) {
+      memcpy(excPos, &i, sizeof(int32_t));
+      memcpy(excVal, input + i * bytes, bytes);
+      excPos += sizeof(int32_t);
+      excVal += bytes;
+      d = fill;
+    }
+
+    uint64_t u = (uint64_t)d - (uint64_t)min;
+    if (width == 64) {
+      memcpy(packed + opos, &u, sizeof(u));
+      opos += sizeof(u);
+      continue;
+    }
+
+    acc |= u << nAcc;
+    nAcc += width;
+    while (nAcc >= BITS_PER_BYTE) {
+      packed[opos++] = (char)(acc & INT64MASK(8));
+      acc >>= BITS_PER_BYTE;
+      nAcc -= BITS_PER_BYTE;
+    }
+  }
+  if (nAcc > 0) packed[opos++] = (char)(acc & INT64MASK(8));
+  ASSERT(opos == szPacked);
+
+  return size;
+}
+
+int32_t tsCompressFloatAlpImp(const char *const input, const int32_t nelements, char *const output) {
+  return tsCompressAlpImp(input, nelements, output, true);
+}
+
+int32_t tsCompressDoubleAlpImp(const char *const input, const int32_t nelements, char *const output) {
+  return tsCompressAlpImp(input, nelements, output, false);
+}
+
+// unpack the integers relative to the base, into the output as uint64_t or uint32_t when it holds floats
+static const char *alpUnpack(const char *const input, const int32_t nelements, char *const output, bool isFloat) {
+  int32_t     width = (uint8_t)input[3];
+  const char *packed = input + ALP_HEADER_SIZE;
+
+  if (width == 64) {
+    memcpy(output, packed, nelements * sizeof(uint64_t));
+    return packed + nelements * sizeof(uint64_t);
+  }
+
+  uint64_t mask = INT64MASK(width);
+  uint64_t acc = 0;
+  int32_t  nAcc = 0, ipos = 0;
+  for (int32_t i = 0; i < nelements; i++) {
+    while (nAcc < width) {
+      acc |= ((uint64_t)(uint8_t)packed[ipos++]) << nAcc;
+      nAcc += BITS_PER_BYTE;
+    }
+
+    if (isFloat) {
+      ((uint32_t *)output)[i] = (uint32_t)(acc & mask);
+    } else {
+      ((uint64_t *)output)[i] = acc & mask;
+    }
+    acc >>= width;
+    nAcc -= width;
+  }
+
+  return packed + ((int64_t)nelements * width + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+}
+
+static void alpPatch(const char *excPos, int32_t nExc, char *const output, int32_t bytes) {
+  const char *excVal = excPos + nExc * sizeof(int32_t);
+  for (int32_t i = 0; i < nExc; i++) {
+    int32_t pos;
+    memcpy(&pos, excPos + i * sizeof(int32_t), sizeof(int32_t));
+    memcpy(output + pos * bytes, excVal + i * bytes, bytes);
+  }
+}
+
+static int32_t tsDecompressDoubleAlpImp(const char *const input, const int32_t nelements, char *const output) {
+  int8_t  e = input[1], f = input[2];
+  int64_t base;
+  int32_t nExc;
+  memcpy(&base, input + 4, sizeof(base));
+  memcpy(&nExc, input + 12, sizeof(nExc));
+
+  const char *excPos = alpUnpack(input, nelements, output, false);
+
+  uint64_t *pu = (uint64_t *)output;
+  double   *pd = (double *)output;
+  int32_t   i = 0;
+#if __AVX2__
+  if (tsAVX2Enable && tsSIMDBuiltins) {
+    // the integers stay below 2^51, they are turned into doubles exactly through the magic number 2^52 + 2^51
+    __m256i vbase = _mm256_set1_epi64x(base + 0x4338000000000000LL);
+    __m256d vmagic = _mm256_set1_pd(6755399441055744.0);
+    __m256d vf = _mm256_set1_pd(ALP_F10[f]);
+    __m256d ve = _mm256_set1_pd(ALP_IF10[e]);
+    for (; i + 4 <= nelements; i += 4) {
+      __m256i v = _mm256_add_epi64(_mm256_loadu_si256((__m256i *)(pu + i)), vbase);
+      __m256d d = _mm256_sub_pd(_mm256_castsi256_pd(v), vmagic);
+      _mm256_storeu_pd(pd + i, _mm256_mul_pd(_mm256_mul_pd(d, vf), ve));
+    }
+  }
+#endif
+  for (; i < nelements; i++) {
+    pd[i] = alpDecodeValue((int64_t)(pu[i] + (uint64_t)base), e, f);
+  }
+
+  alpPatch(excPos, nExc, output, DOUBLE_BYTES);
+  return nelements * DOUBLE_BYTES;
+}
+
+static int32_t tsDecompressFloatAlpImp(const char *const input, const int32_t nelements, char *const output) {
+  int8_t  e = input[1], f = input[2];
+  int64_t base;
+  int32_t nExc;
+  memcpy(&base, input + 4, sizeof(base));
+  memcpy(&nExc, input + 12, sizeof(nExc));
+
+  const char *excPos = alpUnpack(input, nelements, output, true);
+
+  uint32_t *pu = (uint32_t *)output;
+  float    *pf = (float *)output;
+  int32_t   i = 0;
+#if __AVX2__
+  if (tsAVX2Enable && tsSIMDBuiltins) {
+    // the integers of floats fit in an int32_t
+    __m128i vbase = _mm_set1_epi32((int32_t)base);
+    __m256d vf = _mm256_set1_pd(ALP_F10[f]);
+    __m256d ve = _mm256_set1_pd(ALP_IF10[e]);
+    for (; i + 4 <= nelements; i += 4) {
+      __m128i v = _mm_add_epi32(_mm_loadu_si128((__m128i *)(pu + i)), vbase);
+      __m256d d = _mm256_cvtepi32_pd(v);
+      _mm_storeu_ps(pf + i, _mm256_cvtpd_ps(_mm256_mul_pd(_mm256_mul_pd(d, vf), ve)));
+    }
+  }
+#endif
+  for (; i < nelements; i++) {
+    pf[i] = (float)alpDecodeValue((int64_t)(int32_t)(pu[i] + (uint32_t)base), e, f);
+  }
+
+  alpPatch(excPos, nExc, output, FLOAT_BYTES);
+  return nelements * FLOAT_BYTES;
+}
+
 /* --------------------------------------------Double Compression
  * ---------------------------------------------- */
 void encodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t *const pos) {
@@ -931,6 +1203,8 @@ int32_t tsDecompressDoubleImp(const char *const input, const int32_t nelements,
   if (input[0] == 1) {
     memcpy(output, input + 1, nelements * DOUBLE_BYTES);
     return nelements * DOUBLE_BYTES;
+  } else if (input[0] == FP_ALP_MODE) {
+    return tsDecompressDoubleAlpImp(input, nelements, output);
   }
 
   uint8_t  flags = 0;
@@ -1074,6 +1348,8 @@ int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, c
   if (input[0] == 1) {
     memcpy(output, input + 1, nelements * FLOAT_BYTES);
     return nelements * FLOAT_BYTES;
+  } else if (input[0] == FP_ALP_MODE) {
+    return tsDecompressFloatAlpImp(input, nelements, output);
   }
 
   uint8_t  flags = 0;
@@ -1868,6 +2144,43 @@ static int32_t tCompFloatStart(SCompressor *pCmprsor, int8_t type, int8_t cmprAl
   return code;
 }
 
+// re-encode the float/double values with ALP, kept if it is selected for the type and comes out smaller than XOR
+static int32_t tCompFloatingAlp(SCompressor *pCmprsor) {
+  int32_t  code = 0;
+  bool     isFloat = (pCmprsor->type == TSDB_DATA_TYPE_FLOAT);
+  int32_t  size = DATA_TYPE_INFO[pCmprsor->type].bytes * pCmprsor->nVal;
+  uint8_t *pRaw = NULL;
+  uint8_t *pAlp = NULL;
+
+  if (!(isFloat ? tsAlpFloat : tsAlpDouble) || pCmprsor->nVal == 0) return code;
+
+  code = tRealloc(&pRaw, size);
+  if (code) goto _exit;
+  code = tRealloc(&pAlp, size + 1);
+  if (code) goto _exit;
+
+  if (pCmprsor->pBuf[0] == 1) {
+    memcpy(pRaw, pCmprsor->pBuf + 1, size);
+  } else if (isFloat) {
+    tsDecompressFloatImp(pCmprsor->pBuf, pCmprsor->nVal, pRaw);
+  } else {
+    tsDecompressDoubleImp(pCmprsor->pBuf, pCmprsor->nVal, pRaw);
+  }
+
+  int32_t nAlp = tsCompressAlpImp(pRaw, pCmprsor->nVal, pAlp, isFloat);
+  if (nAlp > 0 && nAlp < pCmprsor->nBuf) {
+    uint8_t *pBuf = pCmprsor->pBuf;
+    pCmprsor->pBuf = pAlp;
+    pCmprsor->nBuf = nAlp;
+    pAlp = pBuf;
+  }
+
+_exit:
+  tFree(pRaw);
+  tFree(pAlp);
+  return code;
+}
+
 static int32_t tCompFloatSwitchToCopy(SCompressor *pCmprsor) {
   int32_t code = 0;
 
@@ -1990,6 +2303,9 @@ static int32_t tCompFloatEnd(SCompressor *pCmprsor, const uint8_t **ppData, int3
     if (code) return code;
   }
 
+  code = tCompFloatingAlp(pCmprsor);
+  if (code) return code;
+
   if (pCmprsor->cmprAlg == TWO_STAGE_COMP) {
     code = tTwoStageComp(pCmprsor, nData);
     if (code) return code;
@@ -2143,6 +2459,9 @@ static int32_t tCompDoubleEnd(SCompressor *pCmprsor, const uint8_t **ppData, int
     if (code) return code;
   }
 
+  code = tCompFloatingAlp(pCmprsor);
+  if (code) return code;
+
   if (pCmprsor->cmprAlg == TWO_STAGE_COMP) {
     code = tTwoStageComp(pCmprsor, nData);
     if (code) return code;
@@ -2351,6 +2670,14 @@ int32_t tsDecompressTimestamp(void *pIn, int32_t nIn, int32_t nEle, void *pOut,
 }
 
 // Float =====================================================
+static int32_t tsCompressFloatLosslessImp(void *pIn, int32_t nEle, void *pOut) {
+  if (tsAlpFloat) {
+    int32_t len = tsCompressFloatAlpImp(pIn, nEle, pOut);
+    if (len > 0) return len;
+  }
+  return tsCompressFloatImp(pIn, nEle, pOut);
+}
+
 int32_t tsCompressFloat(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32_t nOut, uint8_t cmprAlg, void *pBuf,
                         int32_t nBuf) {
 #ifdef TD_TSZ
@@ -2361,9 +2688,9 @@ int32_t tsCompressFloat(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32_
   } else {
 #endif
     if (cmprAlg == ONE_STAGE_COMP) {
-      return tsCompressFloatImp(pIn, nEle, pOut);
+      return tsCompressFloatLosslessImp(pIn, nEle, pOut);
     } else if (cmprAlg == TWO_STAGE_COMP) {
-      int32_t len = tsCompressFloatImp(pIn, nEle, pBuf);
+      int32_t len = tsCompressFloatLosslessImp(pIn, nEle, pBuf);
       return tsCompressStringImp(pBuf, len, pOut, nOut);
     } else {
       ASSERTS(0, "compress algo invalid");
@@ -2398,6 +2725,14 @@ int32_t tsDecompressFloat(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int3
 }
 
 // Double =====================================================
+static int32_t tsCompressDoubleLosslessImp(void *pIn, int32_t nEle, void *pOut) {
+  if (tsAlpDouble) {
+    int32_t len = tsCompressDoubleAlpImp(pIn, nEle, pOut);
+    if (len > 0) return len;
+  }
+  return tsCompressDoubleImp(pIn, nEle, pOut);
+}
+
 int32_t tsCompressDouble(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32_t nOut, uint8_t cmprAlg, void *pBuf,
                          int32_t nBuf) {
 #ifdef TD_TSZ
@@ -2408,9 +2743,9 @@ int32_t tsCompressDouble(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32
 #endif
     // lossless mode
     if (cmprAlg == ONE_STAGE_COMP) {
-      return tsCompressDoubleImp(pIn, nEle, pOut);
+      return tsCompressDoubleLosslessImp(pIn, nEle, pOut);
     } else if (cmprAlg == TWO_STAGE_COMP) {
-      int32_t len = tsCompressDoubleImp(pIn, nEle, pBuf);
+      int32_t len = tsCompressDoubleLosslessImp(pIn, nEle, pBuf);
       return tsCompressStringImp(pBuf, len, pOut, nOut);
     } else {
       ASSERTS(0, "compress algo invalid");
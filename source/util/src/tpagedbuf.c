@@ -11,6 +11,10 @@
 #define HAS_DATA_IN_DISK(_p)           ((_p)->offset >= 0)
 #define NO_IN_MEM_AVAILABLE_PAGES(_b)  (listNEles((_b)->lruList) >= (_b)->inMemPages)
 
+#define DBUF_WRITE_BEHIND_SIZE (1024 * 1024)
+#define DBUF_READ_AHEAD_SIZE   (256 * 1024)
+#define DBUF_READ_AHEAD_SLOTS  4
+
 typedef struct SPageDiskInfo {
   int64_t offset;
   int32_t length;
@@ -22,10 +26,20 @@ struct SPageInfo {
   int64_t    offset;
   int32_t    pageId;
   int32_t    length : 29;
-  bool       used : 1;   // set current page is in used
-  bool       dirty : 1;  // set current buffer page is dirty or not
+  bool       used : 1;        // set current page is in used
+  bool       dirty : 1;       // set current buffer page is dirty or not
+  bool       compressed : 1;  // the data on disk is compressed
 };
 
+// one sequential read stream on the file, e.g. a sorted run read back during merge sort
+typedef struct SReadAheadSlot {
+  char*   buf;
+  int64_t offset;   // file offset of buf
+  int32_t len;      // valid bytes in buf
+  int64_t nextPos;  // end of the last page loaded by this stream
+  int64_t lastUse;
+} SReadAheadSlot;
+
 struct SDiskbasedBuf {
   int32_t   numOfPages;
   int64_t   totalBufSize;
@@ -43,9 +57,21 @@ struct SDiskbasedBuf {
   void*     emptyDummyIdList;  // dummy id list
   void*     assistBuf;         // assistant buffer for compress/decompress data
   SArray*   pFree;             // free area in file
+  int32_t   assistBufSize;
   bool      comp;              // compressed before flushed to disk
   uint64_t  nextPos;           // next page flush position
 
+  // pages flushed to disk are staged in the write behind buffer, and written with one io once it is full
+  char*          pWriteBuf;
+  int32_t        writeBufCap;
+  int32_t        writeBufLen;
+  int64_t        writeBufOffset;  // file offset of the first byte in pWriteBuf
+  SReadAheadSlot readAhead[DBUF_READ_AHEAD_SLOTS];
+  int64_t        readAheadTick;
+
+  SDBufMemBudget* pBudget;
+  int64_t         memAcquired;  // bytes of the in-memory pages charged to pBudget
+
   char*               id;           // for debug purpose
   bool                printStatis;  // Print statistics info when closing this buffer.
   SDiskbasedBufStatis statis;
@@ -70,29 +96,33 @@ static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
   return TSDB_CODE_SUCCESS;
 }
 
-static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  if (!pBuf->comp) {
-    *dst = srcSize;
+// compress the page with lz4 into the assist buffer, the page is flushed as it is if it does not get smaller
+static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf, bool* compressed) {
+  *dst = srcSize;
+  *compressed = false;
+  if (!pBuf->comp || pBuf->assistBuf == NULL) {
     return data;
   }
 
-  *dst = tsCompressString(data, srcSize, 1, pBuf->assistBuf, srcSize, ONE_STAGE_COMP, NULL, 0);
+  int32_t len = tsCompressString(data, srcSize, 1, pBuf->assistBuf, pBuf->assistBufSize, ONE_STAGE_COMP, NULL, 0);
+  if (len <= 0 || len >= srcSize || ((char*)pBuf->assistBuf)[0] != 1) {
+    return data;
+  }
 
-  memcpy(data, pBuf->assistBuf, *dst);
-  return data;
+  *dst = len;
+  *compressed = true;
+  return pBuf->assistBuf;
 }
 
-static char* doDecompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  if (!pBuf->comp) {
-    *dst = srcSize;
-    return data;
+static int32_t doDecompressData(const char* src, int32_t srcSize, char* pPage, SDiskbasedBuf* pBuf) {
+  int32_t fullSize = pBuf->pageSize + sizeof(SFilePage);
+  int32_t len = tsDecompressString((void*)src, srcSize, 1, pPage, fullSize, ONE_STAGE_COMP, NULL, 0);
+  if (len != fullSize) {
+    uError("failed to decompress buf page, size:%d, expect:%d, %s", len, fullSize, pBuf->id);
+    return TSDB_CODE_FILE_CORRUPTED;
   }
 
-  *dst = tsDecompressString(data, srcSize, 1, pBuf->assistBuf, pBuf->pageSize, ONE_STAGE_COMP, NULL, 0);
-  if (*dst > 0) {
-    memcpy(data, pBuf->assistBuf, *dst);
-  }
-  return data;
+  return TSDB_CODE_SUCCESS;
 }
 
 static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
@@ -129,17 +159,65 @@ static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
 
 static FORCE_INLINE size_t getAllocPageSize(int32_t pageSize) { return pageSize + POINTER_BYTES + sizeof(SFilePage); }
 
-static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
-  int32_t ret = taosLSeekFile(pBuf->pFile, offset, SEEK_SET);
-  if (ret == -1) {
+static int32_t doWriteFile(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
+  int64_t ret = taosPWriteFile(pBuf->pFile, pData, size, offset);
+  if (ret != size) {
     terrno = TAOS_SYSTEM_ERROR(errno);
     return terrno;
   }
 
-  ret = (int32_t)taosWriteFile(pBuf->pFile, pData, size);
-  if (ret != size) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return terrno;
+  pBuf->statis.flushWrites += 1;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t flushWriteBuf(SDiskbasedBuf* pBuf) {
+  if (pBuf->writeBufLen == 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = doWriteFile(pBuf, pBuf->writeBufOffset, pBuf->pWriteBuf, pBuf->writeBufLen);
+  pBuf->writeBufLen = 0;
+  return code;
+}
+
+// keep the read ahead data identical to the file when the range is written again
+static void updateReadAhead(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
+  for (int32_t i = 0; i < DBUF_READ_AHEAD_SLOTS; ++i) {
+    SReadAheadSlot* pSlot = &pBuf->readAhead[i];
+    if (pSlot->len > 0 && offset < pSlot->offset + pSlot->len && pSlot->offset < offset + size) {
+      int64_t start = TMAX(offset, pSlot->offset);
+      int64_t end = TMIN(offset + size, pSlot->offset + pSlot->len);
+      memcpy(pSlot->buf + (start - pSlot->offset), pData + (start - offset), end - start);
+    }
+  }
+}
+
+static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
+  updateReadAhead(pBuf, offset, pData, size);
+
+  int64_t pendingEnd = pBuf->writeBufOffset + pBuf->writeBufLen;
+  if (pBuf->writeBufLen > 0 && offset >= pBuf->writeBufOffset && offset + size <= pendingEnd) {
+    // rewrite a page that is still in the write behind buffer
+    memcpy(pBuf->pWriteBuf + (offset - pBuf->writeBufOffset), pData, size);
+  } else if (pBuf->writeBufLen > 0 && offset == pendingEnd && pBuf->writeBufLen + size <= pBuf->writeBufCap) {
+    memcpy(pBuf->pWriteBuf + pBuf->writeBufLen, pData, size);
+    pBuf->writeBufLen += size;
+  } else {
+    int32_t code = flushWriteBuf(pBuf);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+
+    if (size <= pBuf->writeBufCap) {
+      memcpy(pBuf->pWriteBuf, pData, size);
+      pBuf->writeBufOffset = offset;
+      pBuf->writeBufLen = size;
+    } else {
+      code = doWriteFile(pBuf, offset, pData, size);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    }
   }
 
   // extend the file
@@ -164,9 +242,10 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
   int64_t offset = pg->offset;
 
   char* t = NULL;
+  bool  compressed = pg->compressed;
   if ((!HAS_DATA_IN_DISK(pg)) || pg->dirty) {
     void* payload = GET_PAYLOAD_DATA(pg);
-    t = doCompressData(payload, pBuf->pageSize + sizeof(SFilePage), &size, pBuf);
+    t = doCompressData(payload, pBuf->pageSize + sizeof(SFilePage), &size, pBuf, &compressed);
     if (size < 0) {
       uError("failed to compress data when flushing data to disk, %s", pBuf->id);
       terrno = TSDB_CODE_INVALID_PARA;
@@ -201,6 +280,7 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
         return NULL;
       }
     }
+    pBuf->statis.rawBytes += pBuf->pageSize + sizeof(SFilePage);
   } else {  // NOTE: the size may be -1, the this recycle page has not been flushed to disk yet.
     size = pg->length;
   }
@@ -214,9 +294,31 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
 
   pg->offset = offset;
   pg->length = size;  // on disk size
+  pg->compressed = compressed;
   return pDataBuf;
 }
 
+static int32_t prepareSpillBuf(SDiskbasedBuf* pBuf) {
+  int32_t allocSize = getAllocPageSize(pBuf->pageSize);
+
+  // the assist buffer keeps the compressed page, or the page as it is plus the lz4 indicator byte
+  if (pBuf->comp && pBuf->assistBuf == NULL) {
+    pBuf->assistBufSize = allocSize;
+    pBuf->assistBuf = taosMemoryMalloc(pBuf->assistBufSize);
+    if (pBuf->assistBuf == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  pBuf->writeBufCap = TMAX(DBUF_WRITE_BEHIND_SIZE, allocSize * 4);
+  pBuf->pWriteBuf = taosMemoryMalloc(pBuf->writeBufCap);
+  if (pBuf->pWriteBuf == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static char* flushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
   int32_t ret = TSDB_CODE_SUCCESS;
 
@@ -225,6 +327,11 @@ static char* flushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
       terrno = ret;
       return NULL;
     }
+
+    if ((ret = prepareSpillBuf(pBuf)) != TSDB_CODE_SUCCESS) {
+      terrno = ret;
+      return NULL;
+    }
   }
 
   char* p = doFlushBufPage(pBuf, pg);
@@ -234,6 +341,87 @@ static char* flushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
   return p;
 }
 
+static const char* getPageFromIoBuf(SDiskbasedBuf* pBuf, int64_t offset, int32_t length) {
+  if (pBuf->writeBufLen > 0 && offset >= pBuf->writeBufOffset &&
+      offset + length <= pBuf->writeBufOffset + pBuf->writeBufLen) {
+    return pBuf->pWriteBuf + (offset - pBuf->writeBufOffset);
+  }
+
+  for (int32_t i = 0; i < DBUF_READ_AHEAD_SLOTS; ++i) {
+    SReadAheadSlot* pSlot = &pBuf->readAhead[i];
+    if (pSlot->len > 0 && offset >= pSlot->offset && offset + length <= pSlot->offset + pSlot->len) {
+      pSlot->nextPos = offset + length;
+      pSlot->lastUse = ++pBuf->readAheadTick;
+      return pSlot->buf + (offset - pSlot->offset);
+    }
+  }
+
+  return NULL;
+}
+
+// The page continues a sequential read stream if it starts where the last page of the stream ended, e.g. the pages
+// of one sorted run, which are flushed one after another. The following part of the file is then read along with
+// the page. Pages of other streams take the least recently used slot to record their position.
+static SReadAheadSlot* getReadAheadSlot(SDiskbasedBuf* pBuf, int64_t offset, bool* sequential) {
+  SReadAheadSlot* pLru = &pBuf->readAhead[0];
+  for (int32_t i = 0; i < DBUF_READ_AHEAD_SLOTS; ++i) {
+    SReadAheadSlot* pSlot = &pBuf->readAhead[i];
+    if (pSlot->lastUse > 0 && pSlot->nextPos == offset) {
+      *sequential = true;
+      return pSlot;
+    }
+
+    if (pSlot->lastUse < pLru->lastUse) {
+      pLru = pSlot;
+    }
+  }
+
+  *sequential = false;
+  return pLru;
+}
+
+static int32_t readPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg, char* dst) {
+  bool            sequential = false;
+  SReadAheadSlot* pSlot = getReadAheadSlot(pBuf, pg->offset, &sequential);
+
+  pSlot->len = 0;
+  pSlot->nextPos = pg->offset + pg->length;
+  pSlot->lastUse = ++pBuf->readAheadTick;
+
+  int32_t length = pg->length;
+  int64_t end = TMIN(pg->offset + TMAX(DBUF_READ_AHEAD_SIZE, length), (int64_t)pBuf->fileSize);
+  if (pBuf->writeBufLen > 0 && pBuf->writeBufOffset >= pg->offset + pg->length) {
+    end = TMIN(end, pBuf->writeBufOffset);  // the staged part is not in the file yet
+  }
+
+  if (sequential && end > pg->offset + pg->length) {
+    if (pSlot->buf == NULL) {
+      pSlot->buf = taosMemoryMalloc(TMAX(DBUF_READ_AHEAD_SIZE, getAllocPageSize(pBuf->pageSize)));
+    }
+
+    if (pSlot->buf != NULL) {
+      int64_t ret = taosPReadFile(pBuf->pFile, pSlot->buf, end - pg->offset, pg->offset);
+      if (ret < pg->length) {
+        return TAOS_SYSTEM_ERROR(errno);
+      }
+
+      pSlot->offset = pg->offset;
+      pSlot->len = (int32_t)ret;
+      pBuf->statis.loadBytes += ret;
+      memcpy(dst, pSlot->buf, pg->length);
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
+  int64_t ret = taosPReadFile(pBuf->pFile, dst, pg->length, pg->offset);
+  if (ret != pg->length) {
+    return TAOS_SYSTEM_ERROR(errno);
+  }
+
+  pBuf->statis.loadBytes += pg->length;
+  return TSDB_CODE_SUCCESS;
+}
+
 // load file block data in disk
 static int32_t loadPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg) {
   if (pg->offset < 0 || pg->length <= 0) {
@@ -241,25 +429,30 @@ static int32_t loadPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg) {
     return TSDB_CODE_INVALID_PARA;
   }
 
-  int32_t ret = taosLSeekFile(pBuf->pFile, pg->offset, SEEK_SET);
-  if (ret == -1) {
-    ret = TAOS_SYSTEM_ERROR(errno);
-    return ret;
-  }
-
-  void* pPage = (void*)GET_PAYLOAD_DATA(pg);
-  ret = (int32_t)taosReadFile(pBuf->pFile, pPage, pg->length);
-  if (ret != pg->length) {
-    ret = TAOS_SYSTEM_ERROR(errno);
-    return ret;
+  char*       pPage = GET_PAYLOAD_DATA(pg);
+  const char* pSrc = getPageFromIoBuf(pBuf, pg->offset, pg->length);
+  if (pSrc != NULL) {
+    pBuf->statis.prefetchPages += 1;
+  } else {
+    // read the compressed page into the assist buffer, it is inflated into the page afterwards
+    char*   dst = pg->compressed ? pBuf->assistBuf : pPage;
+    int32_t code = readPageFromDisk(pBuf, pg, dst);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    pSrc = dst;
   }
 
-  pBuf->statis.loadBytes += pg->length;
   pBuf->statis.loadPages += 1;
 
-  int32_t fullSize = 0;
-  doDecompressData(pPage, pg->length, &fullSize, pBuf);
-  return 0;
+  if (pg->compressed) {
+    return doDecompressData(pSrc, pg->length, pPage, pBuf);
+  }
+
+  if (pSrc != pPage) {
+    memcpy(pPage, pSrc, pg->length);
+  }
+  return TSDB_CODE_SUCCESS;
 }
 
 static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
@@ -278,6 +471,7 @@ static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
   ppi->used = true;
   ppi->pn = NULL;
   ppi->dirty = false;
+  ppi->compressed = false;
 
   return *(SPageInfo**)taosArrayPush(pBuf->pIdList, &ppi);
 }
@@ -355,6 +549,7 @@ int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMem
   pPBuf->fileSize = 0;
   pPBuf->pFree = taosArrayInit(4, sizeof(SFreeListItem));
   pPBuf->freePgList = tdListNew(POINTER_BYTES);
+  pPBuf->comp = true;
 
   // at least more than 2 pages must be in memory
   if (inMemBufSize < pagesize * 2) {
@@ -391,23 +586,52 @@ _error:
   return TSDB_CODE_OUT_OF_MEMORY;
 }
 
+static void releasePageMem(SDiskbasedBuf* pBuf) {
+  if (pBuf->pBudget != NULL) {
+    int64_t allocSize = getAllocPageSize(pBuf->pageSize);
+    dBufMemBudgetRelease(pBuf->pBudget, allocSize);
+    pBuf->memAcquired -= allocSize;
+  }
+}
+
 static char* doExtractPage(SDiskbasedBuf* pBuf, bool* newPage) {
-  char* availablePage = NULL;
+  char*   availablePage = NULL;
+  int64_t allocSize = getAllocPageSize(pBuf->pageSize);
+
   if (NO_IN_MEM_AVAILABLE_PAGES(pBuf)) {
     availablePage = evictBufPage(pBuf);
     if (availablePage == NULL) {
       uWarn("no available buf pages, current:%d, max:%d, reason: %s, %s", listNEles(pBuf->lruList), pBuf->inMemPages,
             terrstr(), pBuf->id)
     }
-  } else {
-    availablePage =
-        taosMemoryCalloc(1, getAllocPageSize(pBuf->pageSize));  // add extract bytes in case of zipped buffer increased.
-    if (availablePage == NULL) {
-      terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return availablePage;
+  }
+
+  if (pBuf->pBudget != NULL && !dBufMemBudgetAcquire(pBuf->pBudget, allocSize, false)) {
+    // the budget is used up, reuse the memory of an unused page by spilling it. If all pages are in use, the budget
+    // is exceeded rather than failing the query.
+    availablePage = evictBufPage(pBuf);
+    if (availablePage != NULL) {
+      atomic_add_fetch_64(&pBuf->pBudget->spillPages, 1);
+      return availablePage;
     }
-    *newPage = true;
+
+    terrno = 0;
+    dBufMemBudgetAcquire(pBuf->pBudget, allocSize, true);
+  }
+
+  availablePage = taosMemoryCalloc(1, allocSize);  // add extract bytes in case of zipped buffer increased.
+  if (availablePage == NULL) {
+    dBufMemBudgetRelease(pBuf->pBudget, allocSize);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
   }
 
+  if (pBuf->pBudget != NULL) {
+    pBuf->memAcquired += allocSize;
+  }
+
+  *newPage = true;
   return availablePage;
 }
 
@@ -435,6 +659,7 @@ void* getNewBufPage(SDiskbasedBuf* pBuf, int32_t* pageId) {
     pi = registerNewPageInfo(pBuf, *pageId);
     if (pi == NULL) {
       if (newPage) {
+        releasePageMem(pBuf);
         taosMemoryFree(availablePage);
       }
       return NULL;
@@ -517,6 +742,7 @@ void* getBufPage(SDiskbasedBuf* pBuf, int32_t id) {
       int32_t code = loadPageFromDisk(pBuf, *pi);
       if (code != 0) {
         if (newPage) {
+          releasePageMem(pBuf);
           taosMemoryFree((*pi)->pData);
         }
 
@@ -625,6 +851,12 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
 
   taosMemoryFreeClear(pBuf->id);
   taosMemoryFreeClear(pBuf->assistBuf);
+  taosMemoryFreeClear(pBuf->pWriteBuf);
+  for (int32_t i = 0; i < DBUF_READ_AHEAD_SLOTS; ++i) {
+    taosMemoryFreeClear(pBuf->readAhead[i].buf);
+  }
+
+  dBufMemBudgetRelease(pBuf->pBudget, pBuf->memAcquired);
   taosMemoryFreeClear(pBuf);
 }
 
@@ -649,8 +881,12 @@ void setBufPageDirty(void* pPage, bool dirty) {
 
 void setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp) {
   pBuf->comp = comp;
-  if (comp  && (pBuf->assistBuf == NULL)) {
-    pBuf->assistBuf = taosMemoryMalloc(pBuf->pageSize + 2);  // EXTRA BYTES
+  if (comp && pBuf->pFile != NULL && pBuf->assistBuf == NULL) {
+    pBuf->assistBufSize = getAllocPageSize(pBuf->pageSize);
+    pBuf->assistBuf = taosMemoryMalloc(pBuf->assistBufSize);
+    if (pBuf->assistBuf == NULL) {
+      pBuf->comp = false;
+    }
   }
 }
 
@@ -665,6 +901,7 @@ void dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage) {
   taosMemoryFreeClear(ppi->pData);
   taosMemoryFreeClear(pNode);
   ppi->pn = NULL;
+  releasePageMem(pBuf);
 
   tdListAppend(pBuf->freePgList, &ppi);
 }
@@ -721,4 +958,70 @@ void clearDiskbasedBuf(SDiskbasedBuf* pBuf) {
   pBuf->totalBufSize = 0;
   pBuf->allocateId = -1;
   pBuf->fileSize = 0;
+
+  pBuf->writeBufLen = 0;
+  for (int32_t i = 0; i < DBUF_READ_AHEAD_SLOTS; ++i) {
+    pBuf->readAhead[i].len = 0;
+    pBuf->readAhead[i].lastUse = 0;
+  }
+  pBuf->readAheadTick = 0;
+
+  dBufMemBudgetRelease(pBuf->pBudget, pBuf->memAcquired);
+  pBuf->memAcquired = 0;
+}
+
+void dBufSetMemBudget(SDiskbasedBuf* pBuf, SDBufMemBudget* pBudget) {
+  if (pBuf == NULL) {
+    return;
+  }
+
+  dBufMemBudgetRelease(pBuf->pBudget, pBuf->memAcquired);
+  pBuf->pBudget = pBudget;
+  pBuf->memAcquired = 0;
+
+  if (pBudget != NULL) {
+    pBuf->memAcquired = listNEles(pBuf->lruList) * (int64_t)getAllocPageSize(pBuf->pageSize);
+    dBufMemBudgetAcquire(pBudget, pBuf->memAcquired, true);
+  }
+}
+
+void dBufMemBudgetInit(SDBufMemBudget* pBudget, int64_t limit, SDBufMemBudget* parent) {
+  memset(pBudget, 0, sizeof(SDBufMemBudget));
+  pBudget->limit = limit;
+  pBudget->parent = parent;
+}
+
+bool dBufMemBudgetAcquire(SDBufMemBudget* pBudget, int64_t size, bool force) {
+  for (SDBufMemBudget* p = pBudget; p != NULL; p = p->parent) {
+    int64_t used = atomic_add_fetch_64(&p->used, size);
+    int64_t limit = atomic_load_64(&p->limit);
+
+    if (!force && limit > 0 && used > limit) {
+      for (SDBufMemBudget* q = pBudget; q != p->parent; q = q->parent) {
+        atomic_sub_fetch_64(&q->used, size);
+      }
+      return false;
+    }
+
+    int64_t peak = atomic_load_64(&p->peak);
+    while (used > peak) {
+      int64_t old = atomic_val_compare_exchange_64(&p->peak, peak, used);
+      if (old == peak) {
+        break;
+      }
+      peak = old;
+    }
+  }
+
+  return true;
+}
+
+void dBufMemBudgetRelease(SDBufMemBudget* pBudget, int64_t size) {
+  if (size == 0) {
+    return;
+  }
+
+  for (SDBufMemBudget* p = pBudget; p != NULL; p = p->parent) {
+    atomic_sub_fetch_64(&p->used, size);
+  }
 }
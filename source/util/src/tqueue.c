@@ -23,6 +23,81 @@ int64_t tsRpcQueueMemoryUsed = 0;
 
 void taosSetQueueMemoryCapacity(STaosQueue *queue, int64_t cap) { queue->memLimit = cap; }
 void taosSetQueueCapacity(STaosQueue *queue, int64_t size) { queue->itemLimit = size; }
+void taosSetQueueLockFree(STaosQueue *queue, bool lockFree) { queue->lockFree = lockFree; }
+
+// Move the items written to a lock free queue so far behind its tail, called with the queue mutex held by readers.
+static void taosMoveQueueInbox(STaosQueue *queue) {
+  STaosQnode *pNode = atomic_exchange_ptr(&queue->inbox, NULL);
+  if (pNode == NULL) return;
+
+  // the inbox is in reverse order of writing
+  STaosQnode *pFirst = NULL;
+  STaosQnode *pLast = pNode;
+  while (pNode) {
+    STaosQnode *pNext = pNode->next;
+    pNode->next = pFirst;
+    pFirst = pNode;
+
+    queue->numOfHeadItems++;
+    queue->memOfHeadItems += (pNode->size + pNode->dataSize);
+    pNode = pNext;
+  }
+
+  if (queue->tail) {
+    queue->tail->next = pFirst;
+  } else {
+    queue->head = pFirst;
+  }
+  queue->tail = pLast;
+}
+
+static FORCE_INLINE bool taosQueueMayHaveItems(STaosQueue *queue) {
+  return queue->head != NULL || (queue->lockFree && atomic_load_ptr(&queue->inbox) != NULL);
+}
+
+// take the first item out of a queue, called with the queue mutex held
+static STaosQnode *taosTakeQueueHead(STaosQueue *queue) {
+  if (queue->lockFree && queue->head == NULL) {
+    taosMoveQueueInbox(queue);
+  }
+
+  STaosQnode *pNode = queue->head;
+  if (pNode == NULL) return NULL;
+
+  queue->head = pNode->next;
+  if (queue->head == NULL) queue->tail = NULL;
+  if (queue->lockFree) {
+    queue->numOfHeadItems--;
+    queue->memOfHeadItems -= (pNode->size + pNode->dataSize);
+    atomic_sub_fetch_64(&queue->memOfItems, pNode->size + pNode->dataSize);
+  } else {
+    queue->memOfItems -= (pNode->size + pNode->dataSize);
+  }
+  return pNode;
+}
+
+// take all the items out of a queue into qall, called with the queue mutex held
+static int32_t taosTakeQueueItems(STaosQueue *queue, STaosQall *qall) {
+  int32_t numOfItems = 0;
+  if (queue->lockFree) {
+    taosMoveQueueInbox(queue);
+    numOfItems = queue->numOfHeadItems;
+    atomic_sub_fetch_64(&queue->memOfItems, queue->memOfHeadItems);
+    queue->numOfHeadItems = 0;
+    queue->memOfHeadItems = 0;
+  } else {
+    numOfItems = queue->numOfItems;
+    queue->memOfItems = 0;
+  }
+
+  qall->current = queue->head;
+  qall->start = queue->head;
+  qall->numOfItems = numOfItems;
+
+  queue->head = NULL;
+  queue->tail = NULL;
+  return numOfItems;
+}
 
 STaosQueue *taosOpenQueue() {
   STaosQueue *queue = taosMemoryCalloc(1, sizeof(STaosQueue));
@@ -52,6 +127,7 @@ void taosCloseQueue(STaosQueue *queue) {
   STaosQset  *qset;
 
   taosThreadMutexLock(&queue->mutex);
+  if (queue->lockFree) taosMoveQueueInbox(queue);
   STaosQnode *pNode = queue->head;
   queue->head = NULL;
   qset = queue->qset;
@@ -76,6 +152,10 @@ void taosCloseQueue(STaosQueue *queue) {
 bool taosQueueEmpty(STaosQueue *queue) {
   if (queue == NULL) return true;
 
+  if (queue->lockFree) {
+    return atomic_load_32(&queue->numOfItems) == 0 && !taosQueueMayHaveItems(queue);
+  }
+
   bool empty = false;
   taosThreadMutexLock(&queue->mutex);
   if (queue->head == NULL && queue->tail == NULL && queue->numOfItems == 0 /*&& queue->memOfItems == 0*/) {
@@ -88,6 +168,10 @@ bool taosQueueEmpty(STaosQueue *queue) {
 
 void taosUpdateItemSize(STaosQueue *queue, int32_t items) {
   if (queue == NULL) return;
+  if (queue->lockFree) {
+    atomic_sub_fetch_32(&queue->numOfItems, items);
+    return;
+  }
 
   taosThreadMutexLock(&queue->mutex);
   queue->numOfItems -= items;
@@ -96,6 +180,7 @@ void taosUpdateItemSize(STaosQueue *queue, int32_t items) {
 
 int32_t taosQueueItemSize(STaosQueue *queue) {
   if (queue == NULL) return 0;
+  if (queue->lockFree) return atomic_load_32(&queue->numOfItems);
 
   taosThreadMutexLock(&queue->mutex);
   int32_t numOfItems = queue->numOfItems;
@@ -106,6 +191,8 @@ int32_t taosQueueItemSize(STaosQueue *queue) {
 }
 
 int64_t taosQueueMemorySize(STaosQueue *queue) {
+  if (queue->lockFree) return atomic_load_64(&queue->memOfItems);
+
   taosThreadMutexLock(&queue->mutex);
   int64_t memOfItems = queue->memOfItems;
   taosThreadMutexUnlock(&queue->mutex);
@@ -156,11 +243,47 @@ void taosFreeQitem(void *pItem) {
   taosMemoryFree(pNode);
 }
 
+static int32_t taosWriteQitemLockFree(STaosQueue *queue, STaosQnode *pNode) {
+  int32_t code = 0;
+  int64_t size = pNode->size + pNode->dataSize;
+
+  // reserve the room first, the limits are checked against what the others reserved
+  int64_t memOfItems = atomic_add_fetch_64(&queue->memOfItems, size);
+  int32_t numOfItems = atomic_add_fetch_32(&queue->numOfItems, 1);
+  if ((queue->memLimit > 0 && memOfItems > queue->memLimit) ||
+      (queue->itemLimit > 0 && numOfItems > queue->itemLimit)) {
+    atomic_sub_fetch_64(&queue->memOfItems, size);
+    atomic_sub_fetch_32(&queue->numOfItems, 1);
+    code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
+    uError("item:%p failed to put into queue:%p, queue mem limit:%" PRId64 " size limit:%" PRId64 ", reason:%s",
+           pNode->item, queue, queue->memLimit, queue->itemLimit, tstrerror(code));
+    return code;
+  }
+
+  while (1) {
+    STaosQnode *pHead = atomic_load_ptr(&queue->inbox);
+    pNode->next = pHead;
+    if (atomic_val_compare_exchange_ptr(&queue->inbox, pHead, pNode) == pHead) break;
+  }
+
+  STaosQset *qset = queue->qset;
+  if (qset) atomic_add_fetch_32(&qset->numOfItems, 1);
+
+  uTrace("item:%p is put into queue:%p, items:%d mem:%" PRId64, pNode->item, queue, numOfItems, memOfItems);
+
+  if (qset) tsem_post(&qset->sem);
+  return code;
+}
+
 int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
   int32_t     code = 0;
   STaosQnode *pNode = (STaosQnode *)(((char *)pItem) - sizeof(STaosQnode));
   pNode->next = NULL;
 
+  if (queue->lockFree) {
+    return taosWriteQitemLockFree(queue, pNode);
+  }
+
   taosThreadMutexLock(&queue->mutex);
   if (queue->memLimit > 0 && (queue->memOfItems + pNode->size + pNode->dataSize) > queue->memLimit) {
     code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
@@ -202,13 +325,14 @@ int32_t taosReadQitem(STaosQueue *queue, void **ppItem) {
 
   taosThreadMutexLock(&queue->mutex);
 
-  if (queue->head) {
-    pNode = queue->head;
+  pNode = taosTakeQueueHead(queue);
+  if (pNode) {
     *ppItem = pNode->item;
-    queue->head = pNode->next;
-    if (queue->head == NULL) queue->tail = NULL;
-    queue->numOfItems--;
-    queue->memOfItems -= (pNode->size + pNode->dataSize);
+    if (queue->lockFree) {
+      atomic_sub_fetch_32(&queue->numOfItems, 1);
+    } else {
+      queue->numOfItems--;
+    }
     if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, 1);
     code = 1;
     uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems,
@@ -236,18 +360,16 @@ int32_t taosReadAllQitems(STaosQueue *queue, STaosQall *qall) {
 
   taosThreadMutexLock(&queue->mutex);
 
+  if (queue->lockFree) taosMoveQueueInbox(queue);
   empty = queue->head == NULL;
   if (!empty) {
     memset(qall, 0, sizeof(STaosQall));
-    qall->current = queue->head;
-    qall->start = queue->head;
-    qall->numOfItems = queue->numOfItems;
-    numOfItems = qall->numOfItems;
-
-    queue->head = NULL;
-    queue->tail = NULL;
-    queue->numOfItems = 0;
-    queue->memOfItems = 0;
+    numOfItems = taosTakeQueueItems(queue, qall);
+    if (queue->lockFree) {
+      atomic_sub_fetch_32(&queue->numOfItems, numOfItems);
+    } else {
+      queue->numOfItems = 0;
+    }
     uTrace("read %d items from queue:%p, items:%d mem:%" PRId64, numOfItems, queue, queue->numOfItems,
            queue->memOfItems);
     if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, qall->numOfItems);
@@ -398,22 +520,19 @@ int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo)
     STaosQueue *queue = qset->current;
     if (queue) qset->current = queue->next;
     if (queue == NULL) break;
-    if (queue->head == NULL) continue;
+    if (!taosQueueMayHaveItems(queue)) continue;
 
     taosThreadMutexLock(&queue->mutex);
 
-    if (queue->head) {
-      pNode = queue->head;
+    pNode = taosTakeQueueHead(queue);
+    if (pNode) {
       *ppItem = pNode->item;
       qinfo->ahandle = queue->ahandle;
       qinfo->fp = queue->itemFp;
       qinfo->queue = queue;
       qinfo->timestamp = pNode->timestamp;
 
-      queue->head = pNode->next;
-      if (queue->head == NULL) queue->tail = NULL;
       // queue->numOfItems--;
-      queue->memOfItems -= (pNode->size + pNode->dataSize);
       atomic_sub_fetch_32(&qset->numOfItems, 1);
       code = 1;
       uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems - 1,
@@ -441,23 +560,18 @@ int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *
     queue = qset->current;
     if (queue) qset->current = queue->next;
     if (queue == NULL) break;
-    if (queue->head == NULL) continue;
+    if (!taosQueueMayHaveItems(queue)) continue;
 
     taosThreadMutexLock(&queue->mutex);
 
+    if (queue->lockFree) taosMoveQueueInbox(queue);
     if (queue->head) {
-      qall->current = queue->head;
-      qall->start = queue->head;
-      qall->numOfItems = queue->numOfItems;
-      code = qall->numOfItems;
+      code = taosTakeQueueItems(queue, qall);
       qinfo->ahandle = queue->ahandle;
       qinfo->fp = queue->itemsFp;
       qinfo->queue = queue;
 
-      queue->head = NULL;
-      queue->tail = NULL;
       // queue->numOfItems = 0;
-      queue->memOfItems = 0;
       uTrace("read %d items from queue:%p, items:0 mem:%" PRId64, code, queue, queue->memOfItems);
 
       atomic_sub_fetch_32(&qset->numOfItems, qall->numOfItems);
@@ -358,6 +358,7 @@ STaosQueue *tWWorkerAllocQueue(SWWorkerPool *pool, void *ahandle, FItems fp) {
   if (queue == NULL) goto _OVER;
 
   taosSetQueueFp(queue, NULL, fp);
+  taosSetQueueLockFree(queue, pool->lockFree);
   if (worker->qset == NULL) {
     worker->qset = taosOpenQset();
     if (worker->qset == NULL) goto _OVER;
@@ -435,6 +436,7 @@ int32_t tMultiWorkerInit(SMultiWorker *pWorker, const SMultiWorkerCfg *pCfg) {
   SWWorkerPool *pPool = &pWorker->pool;
   pPool->name = pCfg->name;
   pPool->max = pCfg->max;
+  pPool->lockFree = pCfg->lockFree;
   if (tWWorkerInit(pPool) != 0) return -1;
 
   pWorker->queue = tWWorkerAllocQueue(pPool, pCfg->param, pCfg->fp);
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "tcompression.h"
+#include "tutil.h"
+
+namespace {
+
+// a sensor reading every second, a random walk with two decimal digits
+template <typename T>
+std::vector<T> sensorValues(int32_t n, uint32_t seed) {
+  std::vector<T> values(n);
+  double         v = 25.0;
+  taosSeedRand(seed);
+  for (int32_t i = 0; i < n; i++) {
+    v += ((int32_t)(taosRand() % 21) - 10) / 100.0;
+    values[i] = (T)(round(v * 100) / 100);
+  }
+  return values;
+}
+
+template <typename T>
+int32_t compress(const std::vector<T> &values, std::vector<char> &out) {
+  int32_t nIn = values.size() * sizeof(T);
+  out.resize(nIn + COMP_OVERFLOW_BYTES);
+  if (sizeof(T) == sizeof(float)) {
+    return tsCompressFloat((void *)values.data(), nIn, values.size(), out.data(), out.size(), ONE_STAGE_COMP, NULL, 0);
+  } else {
+    return tsCompressDouble((void *)values.data(), nIn, values.size(), out.data(), out.size(), ONE_STAGE_COMP, NULL,
+                            0);
+  }
+}
+
+template <typename T>
+void decompress(const std::vector<char> &in, int32_t nIn, std::vector<T> &values) {
+  int32_t nOut = values.size() * sizeof(T);
+  int32_t len;
+  if (sizeof(T) == sizeof(float)) {
+    len = tsDecompressFloat((void *)in.data(), nIn, values.size(), values.data(), nOut, ONE_STAGE_COMP, NULL, 0);
+  } else {
+    len = tsDecompressDouble((void *)in.data(), nIn, values.size(), values.data(), nOut, ONE_STAGE_COMP, NULL, 0);
+  }
+  ASSERT_EQ(len, nOut);
+}
+
+// compressed size, with the values checked bit for bit after the round trip
+template <typename T>
+int32_t checkRoundTrip(const std::vector<T> &values, bool alp) {
+  tsAlpFloat = alp;
+  tsAlpDouble = alp;
+
+  std::vector<char> out;
+  int32_t           len = compress(values, out);
+  EXPECT_GT(len, 0);
+
+  std::vector<T> restored(values.size());
+  decompress(out, len, restored);
+  EXPECT_EQ(memcmp(restored.data(), values.data(), values.size() * sizeof(T)), 0);
+
+  tsAlpFloat = false;
+  tsAlpDouble = false;
+  return len;
+}
+
+template <typename T>
+void checkExceptions() {
+  std::vector<T> values = sensorValues<T>(4096, 7);
+  values[3] = NAN;
+  values[100] = -0.0;
+  values[101] = INFINITY;
+  values[102] = -INFINITY;
+  values[2000] = (T)M_PI;
+  values[4095] = (T)1e30;
+
+  tsAlpFloat = true;
+  tsAlpDouble = true;
+  std::vector<char> out;
+  int32_t           len = compress(values, out);
+  ASSERT_EQ(out[0], FP_ALP_MODE);
+
+  std::vector<T> restored(values.size());
+  decompress(out, len, restored);
+  ASSERT_EQ(memcmp(restored.data(), values.data(), values.size() * sizeof(T)), 0);
+  tsAlpFloat = false;
+  tsAlpDouble = false;
+}
+
+}  // namespace
+
+TEST(compressTest, alpFloat) {
+  std::vector<float> values = sensorValues<float>(4096, 1);
+  checkRoundTrip(values, false);
+  checkRoundTrip(values, true);
+  checkExceptions<float>();
+
+  // a constant column packs into zero bit integers
+  std::vector<float> constant(1000, 21.5f);
+  tsAlpFloat = true;
+  std::vector<char> out;
+  EXPECT_EQ(compress(constant, out), 16);
+  tsAlpFloat = false;
+}
+
+TEST(compressTest, alpDouble) {
+  std::vector<double> values = sensorValues<double>(4096, 2);
+  checkRoundTrip(values, false);
+  checkRoundTrip(values, true);
+  checkExceptions<double>();
+
+  // random bits do not come back from integers, the XOR encoding is kept
+  std::vector<double> random(4096);
+  taosSeedRand(3);
+  for (auto &v : random) {
+    uint64_t u = ((uint64_t)taosRand() << 32) | taosRand();
+    memcpy(&v, &u, sizeof(v));
+  }
+  tsAlpDouble = true;
+  std::vector<char> out;
+  compress(random, out);
+  EXPECT_NE(out[0], FP_ALP_MODE);
+  tsAlpDouble = false;
+  checkRoundTrip(random, true);
+}
+
+TEST(compressTest, alpStream) {
+  std::vector<double> values = sensorValues<double>(4096, 4);
+  int32_t             size[2];
+
+  for (int32_t alp = 0; alp < 2; alp++) {
+    tsAlpDouble = alp;
+
+    SCompressor *pCmprsor = NULL;
+    ASSERT_EQ(tCompressorCreate(&pCmprsor), 0);
+    ASSERT_EQ(tCompressStart(pCmprsor, TSDB_DATA_TYPE_DOUBLE, ONE_STAGE_COMP), 0);
+    for (double v : values) ASSERT_EQ(tCompress(pCmprsor, &v, sizeof(v)), 0);
+
+    const uint8_t *pOut = NULL;
+    int32_t        nOut = 0, nOrigin = 0;
+    ASSERT_EQ(tCompressEnd(pCmprsor, &pOut, &nOut, &nOrigin), 0);
+    ASSERT_EQ(nOrigin, values.size() * sizeof(double));
+    EXPECT_EQ(pOut[0] == FP_ALP_MODE, alp == 1);
+    size[alp] = nOut;
+
+    std::vector<double> restored(values.size());
+    ASSERT_EQ(tsDecompressDouble((void *)pOut, nOut, values.size(), restored.data(), nOrigin, ONE_STAGE_COMP, NULL, 0),
+              nOrigin);
+    EXPECT_EQ(memcmp(restored.data(), values.data(), nOrigin), 0);
+
+    tCompressorDestroy(pCmprsor);
+  }
+  tsAlpDouble = false;
+
+  EXPECT_LT(size[1], size[0]);
+}
+
+// compression ratio and decoding speed of XOR and ALP on sensor readings, it is left out of the test runs and run by
+// hand with --gtest_also_run_disabled_tests
+TEST(compressTest, DISABLED_alpBench) {
+  const int32_t       nEle = 1000000;
+  const int32_t       nLoop = 20;
+  std::vector<double> values = sensorValues<double>(nEle, 5);
+  std::vector<double> restored(nEle);
+
+  for (int32_t alp = 0; alp < 2; alp++) {
+    tsAlpDouble = alp;
+    std::vector<char> out;
+    int32_t           len = compress(values, out);
+
+    int64_t st = taosGetTimestampUs();
+    for (int32_t i = 0; i < nLoop; i++) decompress(out, len, restored);
+    int64_t et = taosGetTimestampUs();
+    ASSERT_EQ(memcmp(restored.data(), values.data(), nEle * sizeof(double)), 0);
+
+    printf("%s: ratio %.2f, decode %.2f GB/s\n", alp ? "alp" : "xor", (double)nEle * sizeof(double) / len,
+           (double)nLoop * nEle * sizeof(double) / (et - st) / 1000.0);
+  }
+  tsAlpDouble = false;
+}
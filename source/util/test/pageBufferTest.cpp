@@ -219,6 +219,104 @@ void testFlushAndReadBackBuffer() {
   destroyDiskbasedBuf(pBuf);
 }
 
+// pages spilled to disk are compressed and staged, and read back ahead when they are loaded in the flushed order
+void spillReadBackTest() {
+  SDiskbasedBuf* pBuf = NULL;
+  int32_t        pageSize = 4096;
+  int32_t        numOfPages = 64;
+  auto           code = createDiskbasedBuf(&pBuf, pageSize, pageSize * 2, "1", TD_TMP_DIR_PATH);
+  ASSERT_EQ(code, 0);
+
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    int32_t pageId = -1;
+    auto*   pPg = (SFilePage*)getNewBufPage(pBuf, &pageId);
+    ASSERT_TRUE(pPg != nullptr);
+    ASSERT_EQ(pageId, i);
+
+    pPg->num = i;
+    for (int32_t j = 0; j < pageSize / sizeof(int32_t); ++j) {
+      ((int32_t*)pPg->data)[j] = i;
+    }
+    setBufPageDirty(pPg, true);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  // the buffer holds two pages, each page updated in the first round is evicted before it is read in the second one
+  for (int32_t round = 0; round < 2; ++round) {
+    for (int32_t i = 0; i < numOfPages; ++i) {
+      auto* pPg = (SFilePage*)getBufPage(pBuf, i);
+      ASSERT_TRUE(pPg != nullptr);
+      ASSERT_EQ(pPg->num, i);
+      ASSERT_EQ(((int32_t*)pPg->data)[pageSize / sizeof(int32_t) - 1], i);
+
+      bool updated = (i % 8) == 0;
+      if (round == 1 && updated) {
+        ASSERT_EQ(((int32_t*)pPg->data)[0], i + numOfPages);
+      } else {
+        ASSERT_EQ(((int32_t*)pPg->data)[0], i);
+      }
+
+      if (round == 0 && updated) {
+        ((int32_t*)pPg->data)[0] = i + numOfPages;
+        setBufPageDirty(pPg, true);
+      }
+      releaseBufPage(pBuf, pPg);
+    }
+  }
+
+  SDiskbasedBufStatis st = getDBufStatis(pBuf);
+  ASSERT_GT(st.rawBytes, st.flushBytes);
+  ASSERT_LT(st.flushWrites, st.flushPages);
+  ASSERT_GT(st.prefetchPages, 0);
+
+  destroyDiskbasedBuf(pBuf);
+}
+
+// buffers sharing one budget spill their pages instead of allocating new ones once it is used up
+void memBudgetTest() {
+  int32_t        pageSize = 1024;
+  SDBufMemBudget dnode = {0};
+  SDBufMemBudget query = {0};
+  dBufMemBudgetInit(&dnode, 0, NULL);
+  dBufMemBudgetInit(&query, pageSize * 8, &dnode);
+
+  SDiskbasedBuf* pBuf1 = NULL;
+  SDiskbasedBuf* pBuf2 = NULL;
+  ASSERT_EQ(createDiskbasedBuf(&pBuf1, pageSize, pageSize * 16, "1", TD_TMP_DIR_PATH), 0);
+  ASSERT_EQ(createDiskbasedBuf(&pBuf2, pageSize, pageSize * 16, "2", TD_TMP_DIR_PATH), 0);
+  dBufSetMemBudget(pBuf1, &query);
+  dBufSetMemBudget(pBuf2, &query);
+
+  for (int32_t i = 0; i < 16; ++i) {
+    SDiskbasedBuf* pBuf = (i % 2 == 0) ? pBuf1 : pBuf2;
+    int32_t        pageId = -1;
+    auto*          pPg = (SFilePage*)getNewBufPage(pBuf, &pageId);
+    ASSERT_TRUE(pPg != nullptr);
+
+    pPg->num = i;
+    setBufPageDirty(pPg, true);
+    releaseBufPage(pBuf, pPg);
+    ASSERT_LE(query.used, query.limit);
+  }
+
+  ASSERT_GT(query.spillPages, 0);
+  ASSERT_EQ(dnode.used, query.used);
+  ASSERT_EQ(dnode.peak, query.peak);
+
+  for (int32_t i = 0; i < 16; ++i) {
+    SDiskbasedBuf* pBuf = (i % 2 == 0) ? pBuf1 : pBuf2;
+    auto*          pPg = (SFilePage*)getBufPage(pBuf, i / 2);
+    ASSERT_TRUE(pPg != nullptr);
+    ASSERT_EQ(pPg->num, i);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  destroyDiskbasedBuf(pBuf1);
+  destroyDiskbasedBuf(pBuf2);
+  ASSERT_EQ(query.used, 0);
+  ASSERT_EQ(dnode.used, 0);
+}
+
 }  // namespace
 
 TEST(testCase, resultBufferTest) {
@@ -227,6 +325,8 @@ TEST(testCase, resultBufferTest) {
   writeDownTest();
   recyclePageTest();
   testFlushAndReadBackBuffer();
+  spillReadBackTest();
+  memBudgetTest();
 }
 
 #pragma GCC diagnostic pop
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "tqueue.h"
+
+typedef struct {
+  int32_t producer;
+  int32_t seq;
+} SQueueTestItem;
+
+static void writeItems(STaosQueue *queue, int32_t producer, int32_t numOfItems) {
+  for (int32_t i = 0; i < numOfItems; ++i) {
+    SQueueTestItem *pItem = (SQueueTestItem *)taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 0);
+    ASSERT_NE(pItem, nullptr);
+    pItem->producer = producer;
+    pItem->seq = i;
+    ASSERT_EQ(taosWriteQitem(queue, pItem), 0);
+  }
+}
+
+static void checkReadOrder(bool lockFree) {
+  STaosQueue *queue = taosOpenQueue();
+  taosSetQueueLockFree(queue, lockFree);
+
+  writeItems(queue, 0, 10);
+  EXPECT_EQ(taosQueueItemSize(queue), 10);
+  EXPECT_EQ(taosQueueMemorySize(queue), 10 * sizeof(SQueueTestItem));
+
+  void *pItem = NULL;
+  for (int32_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(taosReadQitem(queue, &pItem), 1);
+    EXPECT_EQ(((SQueueTestItem *)pItem)->seq, i);
+    taosFreeQitem(pItem);
+  }
+
+  writeItems(queue, 1, 5);
+
+  STaosQall *qall = taosAllocateQall();
+  ASSERT_EQ(taosReadAllQitems(queue, qall), 12);
+  for (int32_t i = 0; i < 12; ++i) {
+    ASSERT_EQ(taosGetQitem(qall, &pItem), 1);
+    SQueueTestItem *p = (SQueueTestItem *)pItem;
+    EXPECT_EQ(p->producer, i < 7 ? 0 : 1);
+    EXPECT_EQ(p->seq, i < 7 ? i + 3 : i - 7);
+    taosFreeQitem(pItem);
+  }
+  EXPECT_EQ(taosGetQitem(qall, &pItem), 0);
+  EXPECT_TRUE(taosQueueEmpty(queue));
+  EXPECT_EQ(taosQueueMemorySize(queue), 0);
+
+  taosFreeQall(qall);
+  taosCloseQueue(queue);
+}
+
+TEST(queueTest, readOrder) {
+  checkReadOrder(false);
+  checkReadOrder(true);
+}
+
+TEST(queueTest, lockFreeLimit) {
+  STaosQueue *queue = taosOpenQueue();
+  taosSetQueueLockFree(queue, true);
+  taosSetQueueCapacity(queue, 2);
+
+  writeItems(queue, 0, 2);
+  void *pItem = taosAllocateQitem(sizeof(SQueueTestItem), DEF_QITEM, 0);
+  EXPECT_EQ(taosWriteQitem(queue, pItem), TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY);
+  EXPECT_EQ(taosQueueItemSize(queue), 2);
+  taosFreeQitem(pItem);
+
+  taosCloseQueue(queue);
+}
+
+// numOfProducers threads write to one queue of a qset read by a single worker, as a vnode write queue is. The items
+// read of each producer are counted in received, the rate of the items written and read is returned
+static double runProducers(bool lockFree, int32_t numOfProducers, int32_t itemsPerProducer,
+                           std::vector<int32_t> *received) {
+  STaosQset  *qset = taosOpenQset();
+  STaosQueue *queue = taosOpenQueue();
+  taosSetQueueLockFree(queue, lockFree);
+  taosAddIntoQset(qset, queue, NULL);
+
+  int32_t              total = numOfProducers * itemsPerProducer;
+  std::vector<int32_t> nextSeq(numOfProducers, 0);
+  bool                 ordered = true;
+
+  int64_t     st = taosGetTimestampUs();
+  std::thread consumer([&]() {
+    STaosQall *qall = taosAllocateQall();
+    int32_t    received = 0;
+    while (received < total) {
+      SQueueInfo qinfo = {0};
+      int32_t    num = taosReadAllQitemsFromQset(qset, qall, &qinfo);
+      for (int32_t i = 0; i < num; ++i) {
+        void *pItem = NULL;
+        taosGetQitem(qall, &pItem);
+        SQueueTestItem *p = (SQueueTestItem *)pItem;
+        if (p->seq != nextSeq[p->producer]++) ordered = false;
+        taosFreeQitem(pItem);
+      }
+      taosUpdateItemSize((STaosQueue *)qinfo.queue, num);
+      received += num;
+    }
+    taosFreeQall(qall);
+  });
+
+  std::vector<std::thread> producers;
+  for (int32_t i = 0; i < numOfProducers; ++i) {
+    producers.emplace_back(writeItems, queue, i, itemsPerProducer);
+  }
+  for (auto &t : producers) t.join();
+  consumer.join();
+  int64_t elapsed = taosGetTimestampUs() - st;
+
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(taosQueueEmpty(queue));
+  if (received != NULL) *received = nextSeq;
+
+  taosCloseQueue(queue);
+  taosCloseQset(qset);
+  return total * 1000000.0 / (elapsed > 0 ? elapsed : 1);
+}
+
+TEST(queueTest, producerOrder) {
+  // every item of each producer is read once and in the order it was written
+  for (bool lockFree : {false, true}) {
+    for (int32_t numOfProducers : {1, 4, 16}) {
+      const int32_t        itemsPerProducer = 2000;
+      std::vector<int32_t> received;
+      runProducers(lockFree, numOfProducers, itemsPerProducer, &received);
+      ASSERT_EQ(received.size(), numOfProducers);
+      for (int32_t i = 0; i < numOfProducers; ++i) {
+        EXPECT_EQ(received[i], itemsPerProducer) << "lock free " << lockFree << ", producer " << i;
+      }
+    }
+  }
+}
+
+// write rate of the mutex and the lock free queue by the number of producers, it is left out of the test runs and run
+// by hand with --gtest_also_run_disabled_tests
+TEST(queueTest, DISABLED_multiProducers) {
+  for (int32_t numOfProducers : {1, 2, 4, 8, 16, 32, 64}) {
+    int32_t itemsPerProducer = 256 * 1024 / numOfProducers;
+    double  locked = runProducers(false, numOfProducers, itemsPerProducer, NULL);
+    double  lockFree = runProducers(true, numOfProducers, itemsPerProducer, NULL);
+    printf("producers:%2d, mutex:%10.0f ops/s, lock free:%10.0f ops/s\n", numOfProducers, locked, lockFree);
+  }
+}